@@ -0,0 +1,151 @@
+/**
+ * @file addr.h
+ * @brief Public header for the address-to-symbol index of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interval index used by the --addr lookup mode and
+ * by --start-address / --stop-address. The defined FUNC and OBJECT symbols
+ * of a file with a non-zero size are kept as [value, value + size) intervals
+ * sorted by start address, with the starts, ends and a running maximum of
+ * the ends in arrays of their own so a search only touches the starts.
+ */
+
+#ifndef _IG_ADDR_H_
+#define _IG_ADDR_H_
+
+#include "../../Writer/inc_pub/writer.h"  // For writer_line_t, writer_bit_t, writer_ctx_t
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint64_t, SIZE_MAX
+
+/**
+ * @brief Error codes for address index operations
+ */
+enum Addr_Error {
+    AD_SUCCESS = 0,           /**< Success */
+    AD_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    AD_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    AD_ERR_FULL = -3,         /**< Index holds as many symbols as it was created for */
+    AD_ERR_WRITE_FAIL = -4    /**< Writing the lookup results failed */
+};
+
+#define ADDR_NOT_FOUND  SIZE_MAX  /**< Position returned for an address no symbol covers */
+
+/**
+ * @brief Interval index of the sized symbols of a file
+ */
+typedef struct addr_index_s
+{
+    uint64_t *start;        /**< Interval starts (symbol values), sorted once Addr_indexSort ran */
+    uint64_t *end;          /**< Interval ends, past the last covered address */
+    uint64_t *max_end;      /**< Largest end of the intervals up to each position */
+    size_t *idx;            /**< Index in lines of the symbol at each position */
+    writer_line_t *lines;   /**< Symbol lines, in the order they were added */
+    size_t len;             /**< Number of symbols */
+    size_t cap;             /**< Number of symbols the arrays hold */
+} addr_index_t;
+
+/**
+ * @brief Allocates the arrays of an empty index
+ * @param[out] index Index to set up
+ * @param[in] cap Most symbols the index will hold
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT if index is NULL,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Addr_indexCreate(addr_index_t *index, size_t cap);
+
+/**
+ * @brief Adds a symbol to the index if it covers an address range
+ *
+ * Only defined FUNC and OBJECT symbols with a non-zero size are kept; other
+ * lines are skipped. The line is copied, its name left for the writer to
+ * resolve against the string table of the file.
+ *
+ * @param[in,out] index Index to add to
+ * @param[in] line Symbol line
+ * @return int AD_SUCCESS on success or when the line is skipped,
+ *             AD_ERR_NULL_INPUT on invalid input, AD_ERR_FULL if the index is full
+ */
+int Addr_indexAdd(addr_index_t *index, const writer_line_t *line);
+
+/**
+ * @brief Sorts the intervals by start address, ready for lookups
+ *
+ * Intervals starting at the same address are ordered from the widest to
+ * the narrowest, so a lookup settles on the innermost one; symbols with the
+ * same interval are taken in the order they were added.
+ *
+ * @param[in,out] index Index to sort
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT on invalid input,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Addr_indexSort(addr_index_t *index);
+
+/**
+ * @brief Finds the symbol covering an address
+ * @param[in] index Sorted index
+ * @param[in] addr Address to look up
+ * @return size_t Position of the innermost symbol covering addr, or ADDR_NOT_FOUND
+ */
+size_t Addr_lookup(const addr_index_t *index, uint64_t addr);
+
+/**
+ * @brief Finds the symbols covering a batch of addresses
+ *
+ * Small batches are looked up one address at a time; larger ones are sorted
+ * and resolved in a single pass over the index.
+ *
+ * @param[in] index Sorted index
+ * @param[in] addrs Addresses to look up
+ * @param[in] addr_cnt Number of addresses
+ * @param[out] pos Position found for each address, or ADDR_NOT_FOUND
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT on invalid input,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Addr_lookupBatch(const addr_index_t *index, const uint64_t *addrs, size_t addr_cnt, size_t *pos);
+
+/**
+ * @brief Returns the positions of the symbols starting in an address range
+ * @param[in] index Sorted index
+ * @param[in] start First address of the range
+ * @param[in] stop Address past the range
+ * @param[out] first Position of the first symbol starting at or after start
+ * @param[out] end Position past the last symbol starting before stop
+ */
+void Addr_rangeGet(const addr_index_t *index, uint64_t start, uint64_t stop, size_t *first, size_t *end);
+
+/**
+ * @brief Returns the symbol line at a position of the sorted index
+ * @param[in] index Sorted index
+ * @param[in] pos Position, below index->len
+ * @return const writer_line_t* Symbol line
+ */
+const writer_line_t *Addr_lineGet(const addr_index_t *index, size_t pos);
+
+/**
+ * @brief Prints the lookup results of a batch to stdout
+ *
+ * Each address is printed as "address name+0xoffset", or "address ??" when
+ * no symbol covers it, in the order the addresses were given.
+ *
+ * @param[in] index Sorted index
+ * @param[in] addrs Addresses looked up
+ * @param[in] pos Positions found by Addr_lookupBatch
+ * @param[in] addr_cnt Number of addresses
+ * @param[in,out] writer Writer context with the string table of the file loaded;
+ *                       its demangler demangles the names with -C
+ * @param[in] bit_len Bit length of the file, setting the width of the addresses
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT on invalid input,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure, AD_ERR_WRITE_FAIL on write failure
+ */
+int Addr_print(const addr_index_t *index, const uint64_t *addrs, const size_t *pos, size_t addr_cnt,
+               writer_ctx_t *writer, writer_bit_t bit_len);
+
+/**
+ * @brief Frees the arrays of an index
+ * @param[in,out] index Index to free; left empty
+ */
+void Addr_indexFree(addr_index_t *index);
+
+#endif /* _IG_ADDR_H_ */
@@ -0,0 +1,507 @@
+/**
+ * @file addr.c
+ * @brief Address-to-symbol interval index of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the interval index used by --addr and by the address
+ * range options. A lookup finds the last interval starting at or before the
+ * address with a binary search whose only branch is the loop itself, then
+ * walks back while the running maximum of the ends says an earlier interval
+ * may still cover the address, which handles nested and overlapping symbols.
+ * Large batches are sorted and resolved in one merge pass over the starts.
+ */
+
+#include "../inc_pub/addr.h"
+#include "../../Writer/inc_pub/writer_flagprint.h"  // For WRITER_FLAGPRINT_*
+#include "../../Stats/inc_pub/stats.h"              // For STATS_COUNT
+#include <stdlib.h>  // For malloc, free, qsort
+#include <string.h>  // For strlen, memcpy
+#include <unistd.h>  // For write, STDOUT_FILENO
+
+#define AD_BATCH_MIN    64u            /**< Fewest addresses resolved by sorting the batch */
+#define AD_OUT_SIZE     (64u * 1024u)  /**< Size of the lookup output buffer */
+#define AD_VALUE_32     8u             /**< Hex digits of a 32-bit address */
+#define AD_VALUE_64     16u            /**< Hex digits of a 64-bit address */
+
+/**
+ * @brief Bytes of one symbol across all arrays
+ */
+#define AD_SYMBOL_BYTES (sizeof(writer_line_t) + 3u * sizeof(uint64_t) + sizeof(size_t))
+
+/**
+ * @brief Interval sorted by Addr_indexSort, or address of a sorted batch
+ */
+typedef struct addr_key_s
+{
+    uint64_t start;  /**< Interval start, or address looked up */
+    uint64_t end;    /**< Interval end, unused for addresses */
+    size_t idx;      /**< Index of the symbol line, or of the address in the batch */
+} addr_key_t;
+
+/**
+ * @brief Lookup output buffer
+ */
+typedef struct addr_out_s
+{
+    char buf[AD_OUT_SIZE];  /**< Pending bytes */
+    size_t len;             /**< Number of pending bytes */
+    int failed;             /**< Non-zero once a write failed */
+} addr_out_t;
+
+/**
+ * @brief Allocates the arrays of an empty index
+ * @param[out] index Index to set up
+ * @param[in] cap Most symbols the index will hold
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT if index is NULL,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Addr_indexCreate(addr_index_t *index, size_t cap)
+{
+    if (index == NULL)
+    {
+        return AD_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    *index = (addr_index_t){0};
+    if (cap != 0)
+    {
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, cap * AD_SYMBOL_BYTES);
+        index->lines = malloc(cap * AD_SYMBOL_BYTES);
+        if (index->lines == NULL)
+        {
+            return AD_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        index->start = (uint64_t *)&index->lines[cap];
+        index->end = &index->start[cap];
+        index->max_end = &index->end[cap];
+        index->idx = (size_t *)&index->max_end[cap];
+    }
+    index->cap = cap;
+    return AD_SUCCESS;
+}
+
+/**
+ * @brief Adds a symbol to the index if it covers an address range
+ * @param[in,out] index Index to add to
+ * @param[in] line Symbol line
+ * @return int AD_SUCCESS on success or when the line is skipped,
+ *             AD_ERR_NULL_INPUT on invalid input, AD_ERR_FULL if the index is full
+ */
+int Addr_indexAdd(addr_index_t *index, const writer_line_t *line)
+{
+    size_t pos;
+
+    if ((index == NULL) || (line == NULL))
+    {
+        return AD_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (((line->type != WRITER_FLAGPRINT_TYPE_FUNC) && (line->type != WRITER_FLAGPRINT_TYPE_OBJECT)) ||
+        (line->size == 0) || (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED) ||
+        (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_COMMON))
+    {
+        return AD_SUCCESS;  // Covers no address: common values are alignments
+    }
+    if (index->len == index->cap)
+    {
+        return AD_ERR_FULL;
+    }
+    pos = index->len++;
+    index->lines[pos] = *line;
+    index->start[pos] = line->value;
+    index->end[pos] = (line->value > UINT64_MAX - line->size) ? UINT64_MAX : line->value + line->size;
+    return AD_SUCCESS;
+}
+
+/**
+ * @brief Compares two intervals for qsort
+ *
+ * Starts ascend; of equal starts the wider interval comes first, and of
+ * equal intervals the symbol added last comes first, since lookups walk the
+ * index backwards.
+ *
+ * @param[in] a First addr_key_t
+ * @param[in] b Second addr_key_t
+ * @return int Negative, zero or positive as a sorts before, with or after b
+ */
+static int addr_keyCmp(const void *a, const void *b)
+{
+    const addr_key_t *key1 = a;
+    const addr_key_t *key2 = b;
+
+    if (key1->start != key2->start)
+    {
+        return (key1->start < key2->start) ? -1 : 1;
+    }
+    if (key1->end != key2->end)
+    {
+        return (key1->end > key2->end) ? -1 : 1;
+    }
+    return (key1->idx > key2->idx) ? -1 : (key1->idx < key2->idx);
+}
+
+/**
+ * @brief Compares two addresses of a batch for qsort
+ * @param[in] a First addr_key_t
+ * @param[in] b Second addr_key_t
+ * @return int Negative, zero or positive as a is below, equal to or above b
+ */
+static int addr_queryCmp(const void *a, const void *b)
+{
+    const addr_key_t *key1 = a;
+    const addr_key_t *key2 = b;
+
+    return (key1->start < key2->start) ? -1 : (key1->start > key2->start);
+}
+
+/**
+ * @brief Sorts the intervals by start address, ready for lookups
+ * @param[in,out] index Index to sort
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT on invalid input,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Addr_indexSort(addr_index_t *index)
+{
+    addr_key_t *keys;
+    uint64_t max_end = 0;
+
+    if (index == NULL)
+    {
+        return AD_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (index->len == 0)
+    {
+        return AD_SUCCESS;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, index->len * sizeof(addr_key_t));
+    keys = malloc(index->len * sizeof(addr_key_t));
+    if (keys == NULL)
+    {
+        return AD_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    for (size_t i = 0; i < index->len; i++)
+    {
+        keys[i] = (addr_key_t){index->start[i], index->end[i], i};
+    }
+    qsort(keys, index->len, sizeof(addr_key_t), addr_keyCmp);
+
+    // Lay the sorted intervals out again, with the running maximum of the ends
+    for (size_t i = 0; i < index->len; i++)
+    {
+        index->start[i] = keys[i].start;
+        index->end[i] = keys[i].end;
+        index->idx[i] = keys[i].idx;
+        max_end = (keys[i].end > max_end) ? keys[i].end : max_end;
+        index->max_end[i] = max_end;
+    }
+    free(keys);
+    return AD_SUCCESS;
+}
+
+/**
+ * @brief Returns the number of intervals starting at or before an address
+ *
+ * The halving step is a conditional move rather than a branch, so the
+ * search costs the same whatever the address and never mispredicts.
+ *
+ * @param[in] index Sorted index
+ * @param[in] addr Address
+ * @return size_t Position past the last interval starting at or before addr
+ */
+static size_t addr_upperBound(const addr_index_t *index, uint64_t addr)
+{
+    const uint64_t *base = index->start;
+    size_t len = index->len;
+
+    if (len == 0)
+    {
+        return 0;
+    }
+    while (len > 1)
+    {
+        size_t half = len / 2;
+        base = (base[half] <= addr) ? base + half : base;
+        len -= half;
+    }
+    return (size_t)(base - index->start) + (*base <= addr);
+}
+
+/**
+ * @brief Returns the number of intervals starting before an address
+ * @param[in] index Sorted index
+ * @param[in] addr Address
+ * @return size_t Position of the first interval starting at or after addr
+ */
+static size_t addr_lowerBound(const addr_index_t *index, uint64_t addr)
+{
+    const uint64_t *base = index->start;
+    size_t len = index->len;
+
+    if (len == 0)
+    {
+        return 0;
+    }
+    while (len > 1)
+    {
+        size_t half = len / 2;
+        base = (base[half] < addr) ? base + half : base;
+        len -= half;
+    }
+    return (size_t)(base - index->start) + (*base < addr);
+}
+
+/**
+ * @brief Finds the innermost interval covering an address among those before a position
+ * @param[in] index Sorted index
+ * @param[in] bound Position past the last interval starting at or before addr
+ * @param[in] addr Address
+ * @return size_t Position of the covering interval, or ADDR_NOT_FOUND
+ */
+static size_t addr_cover(const addr_index_t *index, size_t bound, uint64_t addr)
+{
+    // No interval up to a position reaches addr once their largest end does not
+    for (size_t i = bound; (i > 0) && (index->max_end[i - 1] > addr); i--)
+    {
+        if (index->end[i - 1] > addr)
+        {
+            return i - 1;
+        }
+    }
+    return ADDR_NOT_FOUND;
+}
+
+/**
+ * @brief Finds the symbol covering an address
+ * @param[in] index Sorted index
+ * @param[in] addr Address to look up
+ * @return size_t Position of the innermost symbol covering addr, or ADDR_NOT_FOUND
+ */
+size_t Addr_lookup(const addr_index_t *index, uint64_t addr)
+{
+    if (index == NULL)
+    {
+        return ADDR_NOT_FOUND;  // Invalid input: NULL pointer
+    }
+    return addr_cover(index, addr_upperBound(index, addr), addr);
+}
+
+/**
+ * @brief Finds the symbols covering a batch of addresses
+ * @param[in] index Sorted index
+ * @param[in] addrs Addresses to look up
+ * @param[in] addr_cnt Number of addresses
+ * @param[out] pos Position found for each address, or ADDR_NOT_FOUND
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT on invalid input,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Addr_lookupBatch(const addr_index_t *index, const uint64_t *addrs, size_t addr_cnt, size_t *pos)
+{
+    addr_key_t *queries;
+    size_t bound = 0;
+
+    if ((index == NULL) || (((addrs == NULL) || (pos == NULL)) && (addr_cnt != 0)))
+    {
+        return AD_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (addr_cnt < AD_BATCH_MIN)
+    {
+        for (size_t i = 0; i < addr_cnt; i++)
+        {
+            pos[i] = Addr_lookup(index, addrs[i]);
+        }
+        return AD_SUCCESS;
+    }
+
+    // Sort the addresses, then move one cursor through the starts for all of them
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, addr_cnt * sizeof(addr_key_t));
+    queries = malloc(addr_cnt * sizeof(addr_key_t));
+    if (queries == NULL)
+    {
+        return AD_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    for (size_t i = 0; i < addr_cnt; i++)
+    {
+        queries[i] = (addr_key_t){addrs[i], 0, i};
+    }
+    qsort(queries, addr_cnt, sizeof(addr_key_t), addr_queryCmp);
+    for (size_t i = 0; i < addr_cnt; i++)
+    {
+        while ((bound < index->len) && (index->start[bound] <= queries[i].start))
+        {
+            bound++;
+        }
+        pos[queries[i].idx] = addr_cover(index, bound, queries[i].start);
+    }
+    free(queries);
+    return AD_SUCCESS;
+}
+
+/**
+ * @brief Returns the positions of the symbols starting in an address range
+ * @param[in] index Sorted index
+ * @param[in] start First address of the range
+ * @param[in] stop Address past the range
+ * @param[out] first Position of the first symbol starting at or after start
+ * @param[out] end Position past the last symbol starting before stop
+ */
+void Addr_rangeGet(const addr_index_t *index, uint64_t start, uint64_t stop, size_t *first, size_t *end)
+{
+    *first = addr_lowerBound(index, start);
+    *end = (stop > start) ? addr_lowerBound(index, stop) : *first;
+}
+
+/**
+ * @brief Returns the symbol line at a position of the sorted index
+ * @param[in] index Sorted index
+ * @param[in] pos Position, below index->len
+ * @return const writer_line_t* Symbol line
+ */
+const writer_line_t *Addr_lineGet(const addr_index_t *index, size_t pos)
+{
+    return &index->lines[index->idx[pos]];
+}
+
+/**
+ * @brief Writes the pending lookup bytes to stdout
+ * @param[in,out] out Output buffer
+ */
+static void addr_outFlush(addr_out_t *out)
+{
+    size_t done = 0;
+
+    while ((done < out->len) && !out->failed)
+    {
+        ssize_t ret;
+
+        STATS_COUNT(STATS_COUNTER_WRITE, 1);
+        ret = write(STDOUT_FILENO, out->buf + done, out->len - done);
+        if (ret <= 0)
+        {
+            out->failed = 1;
+        }
+        else
+        {
+            done += (size_t)ret;
+        }
+    }
+    out->len = 0;
+}
+
+/**
+ * @brief Appends bytes to the lookup output
+ * @param[in,out] out Output buffer
+ * @param[in] str Bytes to append
+ * @param[in] len Number of bytes
+ */
+static void addr_outAppend(addr_out_t *out, const char *str, size_t len)
+{
+    while (len != 0)
+    {
+        size_t chunk = AD_OUT_SIZE - out->len;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        memcpy(out->buf + out->len, str, chunk);
+        out->len += chunk;
+        str += chunk;
+        len -= chunk;
+        if (out->len == AD_OUT_SIZE)
+        {
+            addr_outFlush(out);
+        }
+    }
+}
+
+/**
+ * @brief Appends a value in hex
+ * @param[in,out] out Output buffer
+ * @param[in] value Value to append
+ * @param[in] digits Fixed number of digits, or 0 to drop the leading zeros
+ */
+static void addr_outHex(addr_out_t *out, uint64_t value, size_t digits)
+{
+    char buf[AD_VALUE_64];
+    size_t pos = AD_VALUE_64;
+
+    do
+    {
+        buf[--pos] = "0123456789abcdef"[value & 0xfu];
+        value >>= 4;
+    } while ((pos > 0) && ((value != 0) || ((AD_VALUE_64 - pos) < digits)));
+    addr_outAppend(out, &buf[pos], AD_VALUE_64 - pos);
+}
+
+/**
+ * @brief Prints the lookup results of a batch to stdout
+ * @param[in] index Sorted index
+ * @param[in] addrs Addresses looked up
+ * @param[in] pos Positions found by Addr_lookupBatch
+ * @param[in] addr_cnt Number of addresses
+ * @param[in,out] writer Writer context with the string table of the file loaded
+ * @param[in] bit_len Bit length of the file, setting the width of the addresses
+ * @return int AD_SUCCESS on success, AD_ERR_NULL_INPUT on invalid input,
+ *             AD_ERR_MALLOC_FAIL on memory allocation failure, AD_ERR_WRITE_FAIL on write failure
+ */
+int Addr_print(const addr_index_t *index, const uint64_t *addrs, const size_t *pos, size_t addr_cnt,
+               writer_ctx_t *writer, writer_bit_t bit_len)
+{
+    addr_out_t *out;
+    size_t digits = (bit_len == WRITER_VALUEPRINT_32BIT) ? AD_VALUE_32 : AD_VALUE_64;
+    int failed;
+
+    if ((index == NULL) || (((addrs == NULL) || (pos == NULL)) && (addr_cnt != 0)))
+    {
+        return AD_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(addr_out_t));
+    out = malloc(sizeof(addr_out_t));
+    if (out == NULL)
+    {
+        return AD_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    out->len = 0;
+    out->failed = 0;
+
+    for (size_t i = 0; i < addr_cnt; i++)
+    {
+        const char *name = NULL;
+
+        addr_outHex(out, addrs[i], digits);
+        if (pos[i] != ADDR_NOT_FOUND)
+        {
+            name = Writer_lineDisplayNameGet(writer, Addr_lineGet(index, pos[i]));
+        }
+        if (name == NULL)
+        {
+            addr_outAppend(out, " ??\n", 4);
+            continue;
+        }
+        addr_outAppend(out, " ", 1);
+        addr_outAppend(out, name, strlen(name));
+        addr_outAppend(out, "+0x", 3);
+        addr_outHex(out, addrs[i] - index->start[pos[i]], 0);
+        addr_outAppend(out, "\n", 1);
+    }
+    addr_outFlush(out);
+    failed = out->failed;
+    free(out);
+    return failed ? AD_ERR_WRITE_FAIL : AD_SUCCESS;
+}
+
+/**
+ * @brief Frees the arrays of an index
+ * @param[in,out] index Index to free; left empty
+ */
+void Addr_indexFree(addr_index_t *index)
+{
+    if (index != NULL)
+    {
+        free(index->lines);
+        *index = (addr_index_t){0};
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * @file debugline_priv.h
+ * @brief Private header for the DWARF line table decoder of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header defines the line table handle, the units of .debug_line it
+ * indexes and the rows decoded from them, and declares the decoder of one
+ * unit. It is intended for internal use only by debugline module components.
+ */
+
+#ifndef _IG_DEBUGLINE_PRIV_H_
+#define _IG_DEBUGLINE_PRIV_H_
+
+#include "../inc_pub/debugline.h"
+#include "../../FileHandler/inc_pub/filehandler.h"  // For source_file_t
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint*_t
+
+#define DEBUGLINE_FILE_NONE  UINT32_MAX  /**< File of a row ending a sequence, or naming no file */
+
+/**
+ * @brief Section of the file read by the decoder
+ */
+typedef struct debugline_sect_s
+{
+    const uint8_t *data;  /**< Section contents, or NULL if the file has no such section */
+    size_t len;           /**< Length of the section */
+} debugline_sect_t;
+
+/**
+ * @brief Relocation applied to a field of .debug_line in a relocatable object
+ */
+typedef struct debugline_reloc_s
+{
+    uint64_t off;    /**< Offset of the field in .debug_line */
+    uint64_t value;  /**< Symbol value, plus the addend of a RELA relocation */
+    uint32_t sect;   /**< Section index of the symbol */
+} debugline_reloc_t;
+
+/**
+ * @brief File named by the rows of a unit
+ */
+typedef struct debugline_file_s
+{
+    const char *comp_dir;  /**< Compilation directory, or NULL */
+    const char *dir;       /**< Directory of the file, or NULL */
+    const char *name;      /**< File name */
+} debugline_file_t;
+
+/**
+ * @brief Row of a line table
+ *
+ * A row holds from its address up to the address of the next row; a row
+ * with file DEBUGLINE_FILE_NONE and line 0 ends a sequence.
+ */
+typedef struct debugline_row_s
+{
+    uint64_t addr;   /**< Address of the row */
+    uint32_t sect;   /**< Section index of the address in a relocatable object, 0 otherwise */
+    uint32_t line;   /**< Line number, 0 for code with no line */
+    uint32_t file;   /**< Index of the file, in the unit while decoding and in the handle once merged */
+    uint32_t ord;    /**< Position of the row in decoding order, orders rows of the same address */
+} debugline_row_t;
+
+/**
+ * @brief Unit of .debug_line, the line program of one compilation unit
+ */
+typedef struct debugline_unit_s
+{
+    size_t off;               /**< Offset of the unit in .debug_line */
+    size_t end;               /**< Offset past the unit */
+    uint64_t lo;              /**< Lowest address of its rows, found by the skim */
+    uint64_t hi;              /**< Address past its last sequence, found by the skim */
+    debugline_row_t *rows;    /**< Decoded rows, until merged into the handle */
+    size_t row_cnt;           /**< Number of rows */
+    debugline_file_t *files;  /**< Files named by the rows, until merged into the handle */
+    size_t file_cnt;          /**< Number of files */
+    int ret;                  /**< DL_SUCCESS, or the error the skim or decode stopped at */
+    unsigned short wanted;    /**< Non-zero if a looked up address falls in [lo, hi) */
+    unsigned short decoded;   /**< Non-zero once the rows of the unit were decoded */
+} debugline_unit_t;
+
+/**
+ * @brief Line table handle
+ */
+struct debugline_s
+{
+    source_file_t map;            /**< Mapping of the debug sections, sharing the descriptor of the parsed file */
+    debugline_sect_t line;        /**< .debug_line */
+    debugline_sect_t line_str;    /**< .debug_line_str */
+    debugline_sect_t str;         /**< .debug_str */
+    uint8_t big_endian;           /**< Non-zero for big-endian files */
+    uint8_t addr_size;            /**< Size of an address in the file */
+    debugline_reloc_t *relocs;    /**< Relocations of .debug_line sorted by offset, or NULL */
+    size_t reloc_cnt;             /**< Number of relocations */
+    uint8_t reloc_rela;           /**< Non-zero if the addends are in the relocations */
+    debugline_unit_t *units;      /**< Units of .debug_line, in section order */
+    size_t unit_cnt;              /**< Number of units */
+    unsigned short skimmed;       /**< Non-zero once every unit was indexed and skimmed */
+    debugline_row_t *rows;        /**< Rows of the decoded units, sorted by section and address */
+    size_t row_cnt;               /**< Number of rows */
+    debugline_file_t *files;      /**< Files of the decoded units, indexed by the merged rows */
+    size_t file_cnt;              /**< Number of files */
+};
+
+/**
+ * @brief Reads the extent of every unit of .debug_line
+ * @param[in,out] dl Line table handle; its units are set
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed unit length,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_unitsIndex(debugline_t *dl);
+
+/**
+ * @brief Runs the line program of one unit
+ *
+ * Without rows the program is only skimmed for the range of addresses it
+ * covers; with rows, the file table is read and every row is kept.
+ *
+ * @param[in] dl Line table handle
+ * @param[in,out] unit Unit to run; its range, or its rows and files, are set
+ * @param[in] rows Non-zero to keep the rows and the files
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed unit,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_unitRun(const debugline_t *dl, debugline_unit_t *unit, unsigned short rows);
+
+#endif /* _IG_DEBUGLINE_PRIV_H_ */
@@ -0,0 +1,119 @@
+/**
+ * @file debugline.h
+ * @brief Public header for the DWARF line table decoder of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interface used by the -l option. The line table
+ * of a file is read from .debug_line, located through the section headers
+ * parsed with the symbol table. Each unit is first skimmed for the range of
+ * addresses it covers; only the units covering a printed symbol are then
+ * decoded, in parallel, into one table of rows sorted by address that each
+ * lookup searches.
+ */
+
+#ifndef _IG_DEBUGLINE_H_
+#define _IG_DEBUGLINE_H_
+
+#include "../../ElfParser/inc_pub/elfparser_secthead.h"  // For elfparser_secthead_entry_t
+#include "../../FileHandler/inc_pub/filehandler.h"       // For source_file_t
+#include "../../Writer/inc_pub/writer.h"                 // For writer_source_t
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint64_t, uint32_t
+
+/**
+ * @brief Error codes for line table operations
+ */
+enum DebugLine_Error {
+    DL_SUCCESS = 0,           /**< Success */
+    DL_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    DL_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    DL_ERR_FILE_FAIL = -3,    /**< A debug section could not be mapped */
+    DL_ERR_BAD_FORMAT = -4,   /**< Malformed line table */
+    DL_ERR_NO_SECTION = -5,   /**< File has no .debug_line section */
+    DL_ERR_NOT_FOUND = -6     /**< No row covers the address */
+};
+
+/**
+ * @brief Line table of a file
+ */
+typedef struct debugline_s debugline_t;
+
+/**
+ * @brief Address whose line is looked up, with its section in a relocatable object
+ */
+typedef struct debugline_addr_s
+{
+    uint64_t addr;  /**< Address, or offset in its section for a relocatable object */
+    uint32_t sect;  /**< Section index of the address */
+} debugline_addr_t;
+
+/**
+ * @brief Reads the value and section of a symbol a relocation refers to
+ * @param[in] sym Index of the symbol in the symbol table
+ * @param[out] value Value of the symbol
+ * @param[out] sect Section index of the symbol, extended indices resolved
+ * @param[in,out] arg Argument given to DebugLine_open
+ * @return int DL_SUCCESS if the symbol was read, any other value to leave the relocation unapplied
+ */
+typedef int (*debugline_sym_get_f)(size_t sym, uint64_t *value, uint32_t *sect, void *arg);
+
+/**
+ * @brief Opens the line table of a parsed file
+ *
+ * The debug sections get a mapping of their own on the descriptor of the
+ * file, so the string table mapping of the file stays in place. In a
+ * relocatable object, the relocations of .debug_line are applied with the
+ * symbols read with sym_get, and addresses are looked up in the section they
+ * belong to.
+ *
+ * @param[out] dl Created handle
+ * @param[in] file Source parsed by FtNm_Elf_fileParse; must stay open until DebugLine_close
+ * @param[in] sects Section headers of the file, with names resolved
+ * @param[in] sect_cnt Number of sections
+ * @param[in] sym_get Reads the symbols the relocations refer to, or NULL to leave them unapplied
+ * @param[in,out] sym_arg Argument of sym_get
+ * @return int DL_SUCCESS on success, DL_ERR_NULL_INPUT on invalid input,
+ *             DL_ERR_NO_SECTION if the file has no line table, DL_ERR_FILE_FAIL if it
+ *             cannot be mapped, DL_ERR_BAD_FORMAT if it is malformed,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_open(debugline_t **dl, const source_file_t *file, const elfparser_secthead_entry_t *sects,
+                   uint32_t sect_cnt, debugline_sym_get_f sym_get, void *sym_arg);
+
+/**
+ * @brief Decodes the units covering a set of addresses
+ *
+ * Units already decoded are kept, so the handle answers for the addresses
+ * of every call so far. A unit that turns out to be malformed is left out.
+ *
+ * @param[in,out] dl Line table handle
+ * @param[in] addrs Addresses to be looked up; reordered
+ * @param[in] addr_cnt Number of addresses
+ * @return int DL_SUCCESS on success, DL_ERR_NULL_INPUT on invalid input,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_prepare(debugline_t *dl, debugline_addr_t *addrs, size_t addr_cnt);
+
+/**
+ * @brief Finds the source line of an address
+ *
+ * Only the units decoded by DebugLine_prepare are searched. Safe to call
+ * from several threads at once.
+ *
+ * @param[in] dl Line table handle
+ * @param[in] addr Address to look up
+ * @param[out] source File and line of the row covering the address
+ * @return int DL_SUCCESS on success, DL_ERR_NULL_INPUT on invalid input,
+ *             DL_ERR_NOT_FOUND if no row with a line covers the address
+ */
+int DebugLine_find(const debugline_t *dl, const debugline_addr_t *addr, writer_source_t *source);
+
+/**
+ * @brief Closes a line table, releasing its mapping and rows
+ * @param[in,out] dl Handle to close; set to NULL
+ */
+void DebugLine_close(debugline_t **dl);
+
+#endif /* _IG_DEBUGLINE_H_ */
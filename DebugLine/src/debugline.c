@@ -0,0 +1,649 @@
+/**
+ * @file debugline.c
+ * @brief DWARF line table decoder of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the line table handle behind -l: mapping the debug
+ * sections and the relocations of .debug_line, skimming every unit for its
+ * range of addresses, decoding the units a set of addresses falls in on up
+ * to one thread per online CPU, and looking an address up in the merged
+ * rows. The rows are sorted by section and address, so a lookup is one
+ * binary search for the last row at or below the address.
+ */
+
+#include "../inc_priv/debugline_priv.h"
+#include "../../ElfParser/inc_pub/elfparser_header.h"  // For ElfParser_Header_identParse
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <pthread.h>  // For pthread_create, pthread_join
+#include <stdlib.h>   // For malloc, realloc, free, qsort
+#include <string.h>   // For memset, memcpy
+#include <unistd.h>   // For sysconf
+
+#define DEBUGLINE_IDENT_SIZE      16u             /**< Size of e_ident, holding the class and data encoding */
+#define DEBUGLINE_ELF_DATA_MSB    2u              /**< Big-endian data encoding (ELFDATA2MSB) */
+#define DEBUGLINE_SHT_RELA        4u              /**< Section type of relocations with addends */
+#define DEBUGLINE_SHT_NOBITS      8u              /**< Section type of sections with no contents in the file */
+#define DEBUGLINE_SHT_REL         9u              /**< Section type of relocations without addends */
+#define DEBUGLINE_THREADS_MAX     8u              /**< Most threads running units at once */
+#define DEBUGLINE_PARALLEL_BYTES  (256u * 1024u)  /**< Least bytes of units worth more than one thread */
+
+/**
+ * @brief Share of the units run by one thread
+ */
+typedef struct debugline_job_s
+{
+    debugline_t *dl;       /**< Line table handle */
+    size_t first;          /**< First unit of the share */
+    size_t step;           /**< Distance between the units of the share, the number of threads */
+    unsigned short rows;   /**< Non-zero to decode the wanted units, zero to skim every unit */
+} debugline_job_t;
+
+/**
+ * @brief Reads an unsigned value of a given size in a byte order
+ * @param[in] src Bytes of the value
+ * @param[in] size Size of the value, 1 to 8
+ * @param[in] big_endian Non-zero for big-endian bytes
+ * @return uint64_t Value read
+ */
+static uint64_t debugline_uGet(const uint8_t *src, size_t size, uint8_t big_endian)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= (uint64_t)src[big_endian ? (size - 1 - i) : i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Compares two relocations by the offset they apply to
+ * @param[in] a Pointer to the first relocation
+ * @param[in] b Pointer to the second relocation
+ * @return int Negative, zero or positive as a is below, at or above b
+ */
+static int debugline_relocCmp(const void *a, const void *b)
+{
+    const debugline_reloc_t *ra = a;
+    const debugline_reloc_t *rb = b;
+
+    return (ra->off > rb->off) - (ra->off < rb->off);
+}
+
+/**
+ * @brief Compares two rows by section, address, then decoding order
+ *
+ * At one address a row ending a sequence, or naming no file, comes first,
+ * so the last row found at or below an address is the one describing it.
+ *
+ * @param[in] a Pointer to the first row
+ * @param[in] b Pointer to the second row
+ * @return int Negative, zero or positive as a sorts before, with or after b
+ */
+static int debugline_rowCmp(const void *a, const void *b)
+{
+    const debugline_row_t *ra = a;
+    const debugline_row_t *rb = b;
+    int ea = (ra->file != DEBUGLINE_FILE_NONE);
+    int eb = (rb->file != DEBUGLINE_FILE_NONE);
+
+    if (ra->sect != rb->sect)
+    {
+        return (ra->sect > rb->sect) - (ra->sect < rb->sect);
+    }
+    if (ra->addr != rb->addr)
+    {
+        return (ra->addr > rb->addr) - (ra->addr < rb->addr);
+    }
+    if (ea != eb)
+    {
+        return ea - eb;
+    }
+    return (ra->ord > rb->ord) - (ra->ord < rb->ord);
+}
+
+/**
+ * @brief Compares two looked up addresses
+ * @param[in] a Pointer to the first address
+ * @param[in] b Pointer to the second address
+ * @return int Negative, zero or positive as a is below, at or above b
+ */
+static int debugline_addrCmp(const void *a, const void *b)
+{
+    const debugline_addr_t *aa = a;
+    const debugline_addr_t *ab = b;
+
+    return (aa->addr > ab->addr) - (aa->addr < ab->addr);
+}
+
+/**
+ * @brief Reads the relocations applied to .debug_line
+ * @param[in,out] dl Line table handle; its relocations are set
+ * @param[in] rel Relocation section, mapped
+ * @param[in] rela Non-zero for SHT_RELA entries
+ * @param[in] sym_get Reads the symbols the relocations refer to
+ * @param[in,out] sym_arg Argument of sym_get
+ * @return int DL_SUCCESS on success, DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_relocsRead(debugline_t *dl, const debugline_sect_t *rel, uint8_t rela,
+                                debugline_sym_get_f sym_get, void *sym_arg)
+{
+    size_t word = (dl->addr_size == 8) ? 8 : 4;
+    size_t ent_size = word * (rela ? 3 : 2);
+    size_t cnt = rel->len / ent_size;
+
+    if (cnt == 0)
+    {
+        return DL_SUCCESS;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, cnt * sizeof(debugline_reloc_t));
+    dl->relocs = malloc(cnt * sizeof(debugline_reloc_t));
+    if (dl->relocs == NULL)
+    {
+        return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    dl->reloc_rela = rela;
+    for (size_t i = 0; i < cnt; i++)
+    {
+        const uint8_t *ent = rel->data + i * ent_size;
+        uint64_t info = debugline_uGet(ent + word, word, dl->big_endian);
+        uint64_t sym = (word == 8) ? (info >> 32) : (info >> 8);
+        debugline_reloc_t *reloc = &dl->relocs[dl->reloc_cnt];
+        uint64_t sym_value;
+        uint32_t sym_sect;
+
+        reloc->off = debugline_uGet(ent, word, dl->big_endian);
+        reloc->value = rela ? debugline_uGet(ent + 2 * word, word, dl->big_endian) : 0;
+        if ((word == 4) && rela)
+        {
+            reloc->value = (uint64_t)(int64_t)(int32_t)(uint32_t)reloc->value;  // Sign-extend the addend
+        }
+        reloc->sect = 0;
+        if ((sym != 0) && (sym <= SIZE_MAX) && (sym_get((size_t)sym, &sym_value, &sym_sect, sym_arg) == DL_SUCCESS))
+        {
+            reloc->value += sym_value;
+            reloc->sect = sym_sect;  // Symbols that cannot be read leave the offset unrelocated
+        }
+        if (reloc->off < dl->line.len)
+        {
+            dl->reloc_cnt++;  // Relocations outside the section are dropped
+        }
+    }
+    qsort(dl->relocs, dl->reloc_cnt, sizeof(debugline_reloc_t), debugline_relocCmp);
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Finds a section by name
+ * @param[in] sects Section headers of the file, with names resolved
+ * @param[in] sect_cnt Number of sections
+ * @param[in] name Name of the section
+ * @return int64_t Index of the first section of that name, -1 if there is none
+ */
+static int64_t debugline_sectFind(const elfparser_secthead_entry_t *sects, uint32_t sect_cnt, const char *name)
+{
+    for (uint32_t i = 0; i < sect_cnt; i++)
+    {
+        if ((sects[i].sh_name != NULL) && (strcmp(sects[i].sh_name, name) == 0))
+        {
+            return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Maps the debug sections and reads the relocations of a line table
+ * @param[in,out] dl Line table handle, with its file set
+ * @param[in] sects Section headers of the file
+ * @param[in] sect_cnt Number of sections
+ * @param[in] line_idx Index of .debug_line
+ * @param[in] sym_get Reads the symbols the relocations refer to, or NULL to leave them unapplied
+ * @param[in,out] sym_arg Argument of sym_get
+ * @return int DL_SUCCESS on success, DL_ERR_FILE_FAIL if the sections cannot be mapped,
+ *             DL_ERR_BAD_FORMAT if one lies outside the file, DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_sectsMap(debugline_t *dl, const elfparser_secthead_entry_t *sects, uint32_t sect_cnt,
+                              int64_t line_idx, debugline_sym_get_f sym_get, void *sym_arg)
+{
+    int64_t idx[4] = {line_idx, -1, -1, -1};  // .debug_line, .debug_line_str, .debug_str, relocations
+    debugline_sect_t *debug_sects[4] = {&dl->line, &dl->line_str, &dl->str, NULL};
+    debugline_sect_t rel = {NULL, 0};
+    uint64_t lo = UINT64_MAX, hi = 0;
+    elfparser_header_t header;
+
+    if (FileHandler_mapGet(&dl->map, DEBUGLINE_IDENT_SIZE, 0) != FH_SUCCESS ||
+        ElfParser_Header_identParse(&header, dl->map.map, dl->map.map_len) != 0)
+    {
+        return DL_ERR_FILE_FAIL;
+    }
+    dl->big_endian = (header.elf_ident.elf_data == DEBUGLINE_ELF_DATA_MSB);
+    dl->addr_size = (header.elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT) ? 8 : 4;
+
+    idx[1] = debugline_sectFind(sects, sect_cnt, ".debug_line_str");
+    idx[2] = debugline_sectFind(sects, sect_cnt, ".debug_str");
+    for (uint32_t i = 0; (sym_get != NULL) && (i < sect_cnt); i++)
+    {
+        const elfparser_secthead_entry_t *entry = &sects[i];
+        if (((entry->sh_type == DEBUGLINE_SHT_RELA) || (entry->sh_type == DEBUGLINE_SHT_REL)) &&
+            (entry->sh_info == (uint32_t)line_idx))
+        {
+            idx[3] = i;
+            debug_sects[3] = &rel;
+            break;
+        }
+    }
+
+    // One mapping spans every section read, which sit next to each other in practice
+    for (size_t i = 0; i < 4; i++)
+    {
+        const elfparser_secthead_entry_t *entry;
+
+        if ((idx[i] < 0) || (idx[i] >= (int64_t)sect_cnt))
+        {
+            idx[i] = -1;
+            continue;
+        }
+        entry = &sects[idx[i]];
+        if ((entry->sh_type == DEBUGLINE_SHT_NOBITS) || (entry->sh_size == 0))
+        {
+            idx[i] = -1;  // Stripped to a separate debug file
+            continue;
+        }
+        if ((entry->sh_offset > dl->map.size) || (entry->sh_size > (dl->map.size - entry->sh_offset)))
+        {
+            return DL_ERR_BAD_FORMAT;
+        }
+        lo = (entry->sh_offset < lo) ? entry->sh_offset : lo;
+        hi = ((entry->sh_offset + entry->sh_size) > hi) ? (entry->sh_offset + entry->sh_size) : hi;
+    }
+    if (idx[0] < 0)
+    {
+        return DL_ERR_NO_SECTION;
+    }
+    if (((hi - lo) > SIZE_MAX) || (FileHandler_mapGet(&dl->map, (size_t)(hi - lo), (off_t)lo) != FH_SUCCESS) ||
+        (dl->map.map_len != (size_t)(hi - lo)))
+    {
+        return DL_ERR_FILE_FAIL;
+    }
+    for (size_t i = 0; i < 4; i++)
+    {
+        if (idx[i] >= 0)
+        {
+            const elfparser_secthead_entry_t *entry = &sects[idx[i]];
+            debug_sects[i]->data = (const uint8_t *)dl->map.map + (entry->sh_offset - lo);
+            debug_sects[i]->len = (size_t)entry->sh_size;
+        }
+    }
+    if (idx[3] >= 0)
+    {
+        return debugline_relocsRead(dl, &rel, (sects[idx[3]].sh_type == DEBUGLINE_SHT_RELA), sym_get, sym_arg);
+    }
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Opens the line table of a parsed file
+ * @param[out] dl Created handle
+ * @param[in] file Source parsed by FtNm_Elf_fileParse; must stay open until DebugLine_close
+ * @param[in] sects Section headers of the file, with names resolved
+ * @param[in] sect_cnt Number of sections
+ * @param[in] sym_get Reads the symbols the relocations refer to, or NULL to leave them unapplied
+ * @param[in,out] sym_arg Argument of sym_get
+ * @return int DL_SUCCESS on success, DL_ERR_NULL_INPUT on invalid input,
+ *             DL_ERR_NO_SECTION if the file has no line table, DL_ERR_FILE_FAIL if it
+ *             cannot be mapped, DL_ERR_BAD_FORMAT if it is malformed,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_open(debugline_t **dl, const source_file_t *file, const elfparser_secthead_entry_t *sects,
+                   uint32_t sect_cnt, debugline_sym_get_f sym_get, void *sym_arg)
+{
+    int64_t line_idx;
+    debugline_t *new_dl;
+    int ret;
+
+    if ((dl == NULL) || (file == NULL) || (sects == NULL))
+    {
+        return DL_ERR_NULL_INPUT;
+    }
+    *dl = NULL;
+    line_idx = debugline_sectFind(sects, sect_cnt, ".debug_line");
+    if (line_idx < 0)
+    {
+        return DL_ERR_NO_SECTION;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(debugline_t));
+    new_dl = malloc(sizeof(debugline_t));
+    if (new_dl == NULL)
+    {
+        return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    memset(new_dl, 0, sizeof(debugline_t));
+    new_dl->map = *file;  // Same descriptor, mapping of its own
+    new_dl->map.addr = NULL;
+    new_dl->map.map = NULL;
+    new_dl->map.addr_len = 0;
+    new_dl->map.map_len = 0;
+
+    ret = debugline_sectsMap(new_dl, sects, sect_cnt, line_idx, sym_get, sym_arg);
+    if (ret != DL_SUCCESS)
+    {
+        DebugLine_close(&new_dl);
+        return ret;
+    }
+    *dl = new_dl;
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Runs the units of one thread's share
+ * @param[in,out] arg Share of the units (debugline_job_t)
+ * @return void* NULL
+ */
+static void *debugline_worker(void *arg)
+{
+    debugline_job_t *job = arg;
+    debugline_t *dl = job->dl;
+
+    for (size_t i = job->first; i < dl->unit_cnt; i += job->step)
+    {
+        debugline_unit_t *unit = &dl->units[i];
+
+        if (!job->rows)
+        {
+            unit->ret = DebugLine_unitRun(dl, unit, 0);
+        }
+        else if (unit->wanted && !unit->decoded && (unit->ret == DL_SUCCESS))
+        {
+            unit->ret = DebugLine_unitRun(dl, unit, 1);
+            unit->decoded = 1;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Skims every unit, or decodes the wanted ones, on up to one thread per online CPU
+ *
+ * Units are shared round-robin; each thread only writes the units of its
+ * share, so they need no lock. Small line tables stay on this thread.
+ *
+ * @param[in,out] dl Line table handle
+ * @param[in] rows Non-zero to decode the wanted units, zero to skim every unit
+ */
+static void debugline_unitsRun(debugline_t *dl, unsigned short rows)
+{
+    debugline_job_t jobs[DEBUGLINE_THREADS_MAX];
+    pthread_t threads[DEBUGLINE_THREADS_MAX];
+    unsigned short started[DEBUGLINE_THREADS_MAX] = {0};
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t bytes = 0, units = 0;
+    size_t thread_cnt;
+
+    for (size_t i = 0; i < dl->unit_cnt; i++)
+    {
+        const debugline_unit_t *unit = &dl->units[i];
+        if (!rows || (unit->wanted && !unit->decoded && (unit->ret == DL_SUCCESS)))
+        {
+            bytes += unit->end - unit->off;
+            units++;
+        }
+    }
+    thread_cnt = (cpus > 1) ? (size_t)cpus : 1;
+    thread_cnt = (thread_cnt > DEBUGLINE_THREADS_MAX) ? DEBUGLINE_THREADS_MAX : thread_cnt;
+    thread_cnt = (thread_cnt > units) ? units : thread_cnt;
+    thread_cnt = ((bytes < DEBUGLINE_PARALLEL_BYTES) || (thread_cnt == 0)) ? 1 : thread_cnt;
+
+    for (size_t i = 0; i < thread_cnt; i++)
+    {
+        jobs[i] = (debugline_job_t){dl, i, thread_cnt, rows};
+    }
+    for (size_t i = 1; i < thread_cnt; i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, debugline_worker, &jobs[i]) == 0);
+    }
+    debugline_worker(&jobs[0]);
+    for (size_t i = 1; i < thread_cnt; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            debugline_worker(&jobs[i]);  // Share of a thread that could not start
+        }
+    }
+}
+
+/**
+ * @brief Moves the rows and files of the newly decoded units into the handle
+ *
+ * The rows are numbered in decoding order, which breaks ties between rows
+ * of the same address, and the whole table is sorted again.
+ *
+ * @param[in,out] dl Line table handle
+ * @return int DL_SUCCESS on success, DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_rowsMerge(debugline_t *dl)
+{
+    size_t add_rows = 0, add_files = 0;
+
+    for (size_t i = 0; i < dl->unit_cnt; i++)
+    {
+        const debugline_unit_t *unit = &dl->units[i];
+        if (unit->ret == DL_SUCCESS)
+        {
+            add_rows += unit->row_cnt;
+            add_files += unit->file_cnt;
+        }
+    }
+    if (add_rows != 0)
+    {
+        debugline_row_t *new_rows = realloc(dl->rows, (dl->row_cnt + add_rows) * sizeof(debugline_row_t));
+        debugline_file_t *new_files;
+
+        if (new_rows == NULL)
+        {
+            return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (dl->row_cnt + add_rows) * sizeof(debugline_row_t));
+        dl->rows = new_rows;
+        new_files = realloc(dl->files, (dl->file_cnt + add_files + 1) * sizeof(debugline_file_t));
+        if (new_files == NULL)
+        {
+            return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (dl->file_cnt + add_files + 1) * sizeof(debugline_file_t));
+        dl->files = new_files;
+    }
+
+    for (size_t i = 0; i < dl->unit_cnt; i++)
+    {
+        debugline_unit_t *unit = &dl->units[i];
+
+        if ((unit->ret == DL_SUCCESS) && (add_rows != 0))
+        {
+            for (size_t j = 0; j < unit->row_cnt; j++)
+            {
+                debugline_row_t *row = &dl->rows[dl->row_cnt];
+                *row = unit->rows[j];
+                row->file = (row->file != DEBUGLINE_FILE_NONE) ? (uint32_t)(row->file + dl->file_cnt) : row->file;
+                row->ord = (uint32_t)dl->row_cnt++;
+            }
+            if (unit->file_cnt != 0)
+            {
+                memcpy(&dl->files[dl->file_cnt], unit->files, unit->file_cnt * sizeof(debugline_file_t));
+                dl->file_cnt += unit->file_cnt;
+            }
+        }
+        free(unit->rows);  // Rows of a malformed unit are dropped with it
+        free(unit->files);
+        unit->rows = NULL;
+        unit->row_cnt = 0;
+        unit->files = NULL;
+        unit->file_cnt = 0;
+    }
+    if (add_rows != 0)
+    {
+        qsort(dl->rows, dl->row_cnt, sizeof(debugline_row_t), debugline_rowCmp);
+    }
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Decodes the units covering a set of addresses
+ * @param[in,out] dl Line table handle
+ * @param[in] addrs Addresses to be looked up; reordered
+ * @param[in] addr_cnt Number of addresses
+ * @return int DL_SUCCESS on success, DL_ERR_NULL_INPUT on invalid input,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_prepare(debugline_t *dl, debugline_addr_t *addrs, size_t addr_cnt)
+{
+    unsigned short pending = 0;
+    int ret;
+
+    if ((dl == NULL) || ((addrs == NULL) && (addr_cnt != 0)))
+    {
+        return DL_ERR_NULL_INPUT;
+    }
+    if (!dl->skimmed)
+    {
+        ret = DebugLine_unitsIndex(dl);
+        if (ret == DL_ERR_MALLOC_FAIL)
+        {
+            return ret;
+        }
+        debugline_unitsRun(dl, 0);
+        dl->skimmed = 1;
+    }
+
+    // A unit is wanted if an address falls between its lowest row and the end of its last sequence
+    qsort(addrs, addr_cnt, sizeof(debugline_addr_t), debugline_addrCmp);
+    for (size_t i = 0; i < dl->unit_cnt; i++)
+    {
+        debugline_unit_t *unit = &dl->units[i];
+        size_t lo = 0, hi = addr_cnt;
+
+        if (unit->decoded || (unit->ret != DL_SUCCESS) || (unit->lo >= unit->hi))
+        {
+            continue;
+        }
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if (addrs[mid].addr < unit->lo)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        unit->wanted = (lo < addr_cnt) && (addrs[lo].addr < unit->hi);
+        pending |= unit->wanted;
+    }
+    if (!pending)
+    {
+        return DL_SUCCESS;
+    }
+    debugline_unitsRun(dl, 1);
+    for (size_t i = 0; i < dl->unit_cnt; i++)
+    {
+        if (dl->units[i].ret == DL_ERR_MALLOC_FAIL)
+        {
+            return DL_ERR_MALLOC_FAIL;
+        }
+    }
+    return debugline_rowsMerge(dl);
+}
+
+/**
+ * @brief Finds the source line of an address
+ * @param[in] dl Line table handle
+ * @param[in] addr Address to look up
+ * @param[out] source File and line of the row covering the address
+ * @return int DL_SUCCESS on success, DL_ERR_NULL_INPUT on invalid input,
+ *             DL_ERR_NOT_FOUND if no row with a line covers the address
+ */
+int DebugLine_find(const debugline_t *dl, const debugline_addr_t *addr, writer_source_t *source)
+{
+    debugline_row_t key;
+    const debugline_row_t *row;
+    const debugline_file_t *file;
+    size_t lo = 0, hi;
+
+    if ((dl == NULL) || (addr == NULL) || (source == NULL))
+    {
+        return DL_ERR_NULL_INPUT;
+    }
+    key.addr = addr->addr;
+    key.sect = (dl->reloc_cnt != 0) ? addr->sect : 0;  // Rows only carry sections in relocatable objects
+    key.file = 0;
+    key.ord = UINT32_MAX;
+
+    // Number of rows at or below the address
+    hi = dl->row_cnt;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (debugline_rowCmp(&dl->rows[mid], &key) <= 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo == 0)
+    {
+        return DL_ERR_NOT_FOUND;
+    }
+    row = &dl->rows[lo - 1];
+    if ((row->sect != key.sect) || (row->file == DEBUGLINE_FILE_NONE) || (row->line == 0))
+    {
+        return DL_ERR_NOT_FOUND;
+    }
+    file = &dl->files[row->file];
+    source->comp_dir = file->comp_dir;
+    source->dir = file->dir;
+    source->file = file->name;
+    source->line = row->line;
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Closes a line table, releasing its mapping and rows
+ * @param[in,out] dl Handle to close; set to NULL
+ */
+void DebugLine_close(debugline_t **dl)
+{
+    if ((dl == NULL) || (*dl == NULL))
+    {
+        return;
+    }
+    for (size_t i = 0; i < (*dl)->unit_cnt; i++)
+    {
+        free((*dl)->units[i].rows);
+        free((*dl)->units[i].files);
+    }
+    free((*dl)->units);
+    free((*dl)->rows);
+    free((*dl)->files);
+    free((*dl)->relocs);
+    if ((*dl)->map.addr != NULL)
+    {
+        FileHandler_mapFree(&(*dl)->map);  // Only this mapping; the descriptor stays with the parsed file
+    }
+    free(*dl);
+    *dl = NULL;
+}
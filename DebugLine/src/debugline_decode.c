@@ -0,0 +1,735 @@
+/**
+ * @file debugline_decode.c
+ * @brief DWARF line program decoder of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the reading of .debug_line: the extent of its units,
+ * the header and file table of a unit (DWARF versions 2 to 5, 32 and 64-bit
+ * formats), and the line number program run as the state machine of the
+ * DWARF specification. The same run either only tracks the range of
+ * addresses of a unit or keeps every row it emits. Reads are bounded by the
+ * unit; a malformed unit stops with DL_ERR_BAD_FORMAT and nothing else.
+ */
+
+#include "../inc_priv/debugline_priv.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For malloc, realloc, free
+#include <string.h>  // For memchr
+
+// Standard opcodes of the line number program
+#define DWARF_LNS_COPY              1u
+#define DWARF_LNS_ADVANCE_PC        2u
+#define DWARF_LNS_ADVANCE_LINE      3u
+#define DWARF_LNS_SET_FILE          4u
+#define DWARF_LNS_CONST_ADD_PC      8u
+#define DWARF_LNS_FIXED_ADVANCE_PC  9u
+
+// Extended opcodes of the line number program
+#define DWARF_LNE_END_SEQUENCE      1u
+#define DWARF_LNE_SET_ADDRESS       2u
+
+// Content types and forms of the DWARF 5 directory and file tables
+#define DWARF_LNCT_PATH             1u
+#define DWARF_LNCT_DIRECTORY_INDEX  2u
+#define DWARF_FORM_BLOCK            0x09u
+#define DWARF_FORM_DATA1            0x0bu
+#define DWARF_FORM_DATA2            0x05u
+#define DWARF_FORM_DATA4            0x06u
+#define DWARF_FORM_DATA8            0x07u
+#define DWARF_FORM_DATA16           0x1eu
+#define DWARF_FORM_STRING           0x08u
+#define DWARF_FORM_STRP             0x0eu
+#define DWARF_FORM_UDATA            0x0fu
+#define DWARF_FORM_LINE_STRP        0x1fu
+
+#define DWARF_VERSION_MIN           2u           /**< Oldest line table version read */
+#define DWARF_VERSION_MAX           5u           /**< Newest line table version read */
+#define DWARF_LENGTH_64             0xffffffffu  /**< Unit length escape of the 64-bit format */
+#define DEBUGLINE_ROWS_MIN          64u          /**< Rows allocated first for a unit */
+
+/**
+ * @brief Bounded reader over .debug_line
+ */
+typedef struct debugline_cur_s
+{
+    const debugline_t *dl;  /**< Line table handle, for byte order and relocations */
+    size_t pos;             /**< Offset of the next byte in .debug_line */
+    size_t end;             /**< Offset past the last readable byte */
+    int err;                /**< Non-zero once a read ran past end */
+} debugline_cur_t;
+
+/**
+ * @brief Header of a unit
+ */
+typedef struct debugline_header_s
+{
+    uint16_t version;                /**< Line table version */
+    uint8_t offset_size;             /**< Size of section offsets, 4 or 8 */
+    uint8_t min_inst;                /**< Minimum instruction length */
+    int8_t line_base;                /**< Line advance of the first special opcode */
+    uint8_t line_range;              /**< Number of line advances of special opcodes */
+    uint8_t opcode_base;             /**< Number of the first special opcode */
+    const uint8_t *opcode_lengths;   /**< Operand counts of the standard opcodes */
+    size_t prog;                     /**< Offset of the line number program */
+} debugline_header_t;
+
+/**
+ * @brief Registers of the line number program
+ */
+typedef struct debugline_state_s
+{
+    uint64_t addr;  /**< Address register */
+    uint32_t sect;  /**< Section of the address in a relocatable object */
+    uint64_t file;  /**< File register */
+    int64_t line;   /**< Line register */
+} debugline_state_t;
+
+/**
+ * @brief Reads an unsigned value of a given size in the byte order of the file
+ * @param[in,out] cur Reader
+ * @param[in] size Size of the value, 1 to 8
+ * @return uint64_t Value read, 0 past the end
+ */
+static uint64_t debugline_uRead(debugline_cur_t *cur, size_t size)
+{
+    const uint8_t *src = cur->dl->line.data + cur->pos;
+    uint64_t value = 0;
+
+    if (cur->err || ((cur->end - cur->pos) < size))
+    {
+        cur->err = 1;
+        return 0;
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= (uint64_t)src[cur->dl->big_endian ? (size - 1 - i) : i] << (8 * i);
+    }
+    cur->pos += size;
+    return value;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 value
+ * @param[in,out] cur Reader
+ * @return uint64_t Value read, with the bits past 64 dropped; 0 past the end
+ */
+static uint64_t debugline_ulebRead(debugline_cur_t *cur)
+{
+    uint64_t value = 0;
+    unsigned int shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        byte = (uint8_t)debugline_uRead(cur, 1);
+        if (shift < 64)
+        {
+            value |= (uint64_t)(byte & 0x7fu) << shift;
+        }
+        shift += 7;
+    } while ((byte & 0x80u) && !cur->err);
+    return value;
+}
+
+/**
+ * @brief Reads a signed LEB128 value
+ * @param[in,out] cur Reader
+ * @return int64_t Value read; 0 past the end
+ */
+static int64_t debugline_slebRead(debugline_cur_t *cur)
+{
+    uint64_t value = 0;
+    unsigned int shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        byte = (uint8_t)debugline_uRead(cur, 1);
+        if (shift < 64)
+        {
+            value |= (uint64_t)(byte & 0x7fu) << shift;
+        }
+        shift += 7;
+    } while ((byte & 0x80u) && !cur->err);
+    if ((shift < 64) && (byte & 0x40u))
+    {
+        value |= ~(uint64_t)0 << shift;  // Extend the sign
+    }
+    return (int64_t)value;
+}
+
+/**
+ * @brief Reads a null-terminated string held in .debug_line
+ * @param[in,out] cur Reader
+ * @return const char* String, or NULL past the end
+ */
+static const char *debugline_strRead(debugline_cur_t *cur)
+{
+    const char *str = (const char *)cur->dl->line.data + cur->pos;
+    const char *nul;
+
+    if (cur->err || (cur->pos >= cur->end))
+    {
+        cur->err = 1;
+        return NULL;
+    }
+    nul = memchr(str, '\0', cur->end - cur->pos);
+    if (nul == NULL)
+    {
+        cur->err = 1;
+        return NULL;
+    }
+    cur->pos += (size_t)(nul - str) + 1;
+    return str;
+}
+
+/**
+ * @brief Finds the relocation applied to a field of .debug_line
+ * @param[in] dl Line table handle
+ * @param[in] off Offset of the field
+ * @return const debugline_reloc_t* Relocation, or NULL if the field has none
+ */
+static const debugline_reloc_t *debugline_relocFind(const debugline_t *dl, size_t off)
+{
+    size_t lo = 0, hi = dl->reloc_cnt;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (dl->relocs[mid].off < off)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return ((lo < dl->reloc_cnt) && (dl->relocs[lo].off == off)) ? &dl->relocs[lo] : NULL;
+}
+
+/**
+ * @brief Reads an address or section offset, relocated in a relocatable object
+ * @param[in,out] cur Reader
+ * @param[in] size Size of the field
+ * @param[out] sect Section index of the symbol it is relocated against, 0 if none; may be NULL
+ * @return uint64_t Relocated value
+ */
+static uint64_t debugline_relocRead(debugline_cur_t *cur, size_t size, uint32_t *sect)
+{
+    const debugline_reloc_t *reloc = debugline_relocFind(cur->dl, cur->pos);
+    uint64_t raw = debugline_uRead(cur, size);
+
+    if (sect != NULL)
+    {
+        *sect = (reloc != NULL) ? reloc->sect : 0;
+    }
+    if (reloc == NULL)
+    {
+        return raw;
+    }
+    return cur->dl->reloc_rela ? reloc->value : (reloc->value + raw);
+}
+
+/**
+ * @brief Returns the string at an offset of a string section
+ * @param[in] sect String section
+ * @param[in] off Offset of the string
+ * @return const char* String, or NULL if it does not lie in the section
+ */
+static const char *debugline_sectStrGet(const debugline_sect_t *sect, uint64_t off)
+{
+    if ((sect->data == NULL) || (off >= sect->len) ||
+        (memchr(sect->data + off, '\0', sect->len - (size_t)off) == NULL))
+    {
+        return NULL;
+    }
+    return (const char *)sect->data + off;
+}
+
+/**
+ * @brief Reads one attribute of a DWARF 5 directory or file entry
+ * @param[in,out] cur Reader
+ * @param[in] hdr Unit header
+ * @param[in] form Form of the attribute
+ * @param[out] num Value of a constant form
+ * @param[out] str Value of a string form, NULL for other forms
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for an unknown form or a bad string
+ */
+static int debugline_formRead(debugline_cur_t *cur, const debugline_header_t *hdr, uint64_t form,
+                              uint64_t *num, const char **str)
+{
+    *num = 0;
+    *str = NULL;
+    switch (form)
+    {
+        case DWARF_FORM_STRING:
+            *str = debugline_strRead(cur);
+            break;
+        case DWARF_FORM_LINE_STRP:
+            *str = debugline_sectStrGet(&cur->dl->line_str, debugline_relocRead(cur, hdr->offset_size, NULL));
+            return (*str != NULL) ? DL_SUCCESS : DL_ERR_BAD_FORMAT;
+        case DWARF_FORM_STRP:
+            *str = debugline_sectStrGet(&cur->dl->str, debugline_relocRead(cur, hdr->offset_size, NULL));
+            return (*str != NULL) ? DL_SUCCESS : DL_ERR_BAD_FORMAT;
+        case DWARF_FORM_UDATA:
+            *num = debugline_ulebRead(cur);
+            break;
+        case DWARF_FORM_DATA1:
+            *num = debugline_uRead(cur, 1);
+            break;
+        case DWARF_FORM_DATA2:
+            *num = debugline_uRead(cur, 2);
+            break;
+        case DWARF_FORM_DATA4:
+            *num = debugline_uRead(cur, 4);
+            break;
+        case DWARF_FORM_DATA8:
+            *num = debugline_uRead(cur, 8);
+            break;
+        case DWARF_FORM_DATA16:
+            debugline_uRead(cur, 8);
+            debugline_uRead(cur, 8);
+            break;
+        case DWARF_FORM_BLOCK:
+            *num = debugline_ulebRead(cur);
+            if ((*num > (cur->end - cur->pos)) || cur->err)
+            {
+                return DL_ERR_BAD_FORMAT;
+            }
+            cur->pos += (size_t)*num;
+            break;
+        default:
+            return DL_ERR_BAD_FORMAT;  // Forms needing .debug_str_offsets are not read
+    }
+    return cur->err ? DL_ERR_BAD_FORMAT : DL_SUCCESS;
+}
+
+/**
+ * @brief Reads the entries of a DWARF 5 directory or file table
+ * @param[in,out] cur Reader, at the entry format count
+ * @param[in] hdr Unit header
+ * @param[out] paths Path of each entry; allocated, freed by the caller
+ * @param[out] dir_idx Directory index of each entry, or NULL for the directory table
+ * @param[out] cnt Number of entries
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed table,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_table5Read(debugline_cur_t *cur, const debugline_header_t *hdr, const char ***paths,
+                                uint64_t **dir_idx, size_t *cnt)
+{
+    uint8_t format_cnt = (uint8_t)debugline_uRead(cur, 1);
+    size_t format_pos = cur->pos;
+    uint64_t entry_cnt;
+    int ret = DL_SUCCESS;
+
+    for (uint8_t i = 0; i < format_cnt; i++)
+    {
+        debugline_ulebRead(cur);  // Content type
+        debugline_ulebRead(cur);  // Form
+    }
+    entry_cnt = debugline_ulebRead(cur);
+    if (cur->err || (entry_cnt > (cur->end - cur->pos)))
+    {
+        return DL_ERR_BAD_FORMAT;  // Every entry takes at least one byte
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (entry_cnt + 1) * (sizeof(const char *) + sizeof(uint64_t)));
+    *paths = malloc(((size_t)entry_cnt + 1) * sizeof(const char *));
+    if (dir_idx != NULL)
+    {
+        *dir_idx = malloc(((size_t)entry_cnt + 1) * sizeof(uint64_t));
+    }
+    if ((*paths == NULL) || ((dir_idx != NULL) && (*dir_idx == NULL)))
+    {
+        return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    for (size_t i = 0; (i < entry_cnt) && (ret == DL_SUCCESS); i++)
+    {
+        debugline_cur_t format = {cur->dl, format_pos, cur->end, 0};
+
+        (*paths)[i] = NULL;
+        if (dir_idx != NULL)
+        {
+            (*dir_idx)[i] = 0;
+        }
+        for (uint8_t j = 0; (j < format_cnt) && (ret == DL_SUCCESS); j++)
+        {
+            uint64_t type = debugline_ulebRead(&format);
+            uint64_t num;
+            const char *str;
+
+            ret = debugline_formRead(cur, hdr, debugline_ulebRead(&format), &num, &str);
+            if ((type == DWARF_LNCT_PATH) && (str != NULL))
+            {
+                (*paths)[i] = str;
+            }
+            else if ((type == DWARF_LNCT_DIRECTORY_INDEX) && (dir_idx != NULL))
+            {
+                (*dir_idx)[i] = num;
+            }
+        }
+    }
+    *cnt = (size_t)entry_cnt;
+    return ret;
+}
+
+/**
+ * @brief Reads the entries of a DWARF 2 to 4 directory or file table
+ * @param[in,out] cur Reader, at the first entry
+ * @param[out] paths Path of each entry; allocated, freed by the caller
+ * @param[out] dir_idx Directory index of each entry, or NULL for the directory table
+ * @param[out] cnt Number of entries
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed table,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_table4Read(debugline_cur_t *cur, const char ***paths, uint64_t **dir_idx, size_t *cnt)
+{
+    size_t first = cur->pos;
+    size_t entry_cnt = 0;
+
+    // Count the entries, which end with an empty path
+    for (const char *str = debugline_strRead(cur); (str != NULL) && (*str != '\0'); str = debugline_strRead(cur))
+    {
+        if (dir_idx != NULL)
+        {
+            debugline_ulebRead(cur);  // Directory index
+            debugline_ulebRead(cur);  // Modification time
+            debugline_ulebRead(cur);  // File size
+        }
+        entry_cnt++;
+    }
+    if (cur->err)
+    {
+        return DL_ERR_BAD_FORMAT;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (entry_cnt + 1) * (sizeof(const char *) + sizeof(uint64_t)));
+    *paths = malloc((entry_cnt + 1) * sizeof(const char *));
+    if (dir_idx != NULL)
+    {
+        *dir_idx = malloc((entry_cnt + 1) * sizeof(uint64_t));
+    }
+    if ((*paths == NULL) || ((dir_idx != NULL) && (*dir_idx == NULL)))
+    {
+        return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+
+    // Read them again now they have room
+    cur->pos = first;
+    for (size_t i = 0; i < entry_cnt; i++)
+    {
+        (*paths)[i] = debugline_strRead(cur);
+        if (dir_idx != NULL)
+        {
+            (*dir_idx)[i] = debugline_ulebRead(cur);
+            debugline_ulebRead(cur);
+            debugline_ulebRead(cur);
+        }
+    }
+    debugline_strRead(cur);  // Empty path ending the table
+    *cnt = entry_cnt;
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Reads the directory and file tables of a unit into its files
+ *
+ * A path is split in the parts -l prints: absolute names stand alone, and
+ * relative ones follow their directory, itself following the compilation
+ * directory if relative. Before DWARF 5 the compilation directory is not
+ * part of the line table, so names of directory 0 are printed as they are.
+ *
+ * @param[in,out] cur Reader, at the directory table
+ * @param[in] hdr Unit header
+ * @param[in,out] unit Unit whose files are set
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed table,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_filesRead(debugline_cur_t *cur, const debugline_header_t *hdr, debugline_unit_t *unit)
+{
+    const char **dirs = NULL;
+    const char **names = NULL;
+    uint64_t *dir_idx = NULL;
+    size_t dir_cnt = 0, name_cnt = 0;
+    unsigned short v5 = (hdr->version >= 5);
+    int ret;
+
+    ret = v5 ? debugline_table5Read(cur, hdr, &dirs, NULL, &dir_cnt) : debugline_table4Read(cur, &dirs, NULL, &dir_cnt);
+    if (ret == DL_SUCCESS)
+    {
+        ret = v5 ? debugline_table5Read(cur, hdr, &names, &dir_idx, &name_cnt)
+                 : debugline_table4Read(cur, &names, &dir_idx, &name_cnt);
+    }
+    if (ret == DL_SUCCESS)
+    {
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (name_cnt + 1) * sizeof(debugline_file_t));
+        unit->files = malloc((name_cnt + 1) * sizeof(debugline_file_t));
+        ret = (unit->files == NULL) ? DL_ERR_MALLOC_FAIL : DL_SUCCESS;
+    }
+    for (size_t i = 0; (i < name_cnt) && (ret == DL_SUCCESS); i++)
+    {
+        debugline_file_t *file = &unit->files[i];
+        uint64_t d = dir_idx[i];
+
+        file->name = (names[i] != NULL) ? names[i] : "";
+        file->comp_dir = (v5 && (d != 0) && (dir_cnt != 0)) ? dirs[0] : NULL;
+        file->dir = v5 ? ((d < dir_cnt) ? dirs[d] : NULL) : (((d != 0) && (d <= dir_cnt)) ? dirs[d - 1] : NULL);
+        if (file->name[0] == '/')
+        {
+            file->comp_dir = NULL;  // Absolute name
+            file->dir = NULL;
+        }
+        else if ((file->dir != NULL) && (file->dir[0] == '/'))
+        {
+            file->comp_dir = NULL;  // Absolute directory
+        }
+    }
+    unit->file_cnt = (ret == DL_SUCCESS) ? name_cnt : 0;
+    free(dirs);
+    free(names);
+    free(dir_idx);
+    return ret;
+}
+
+/**
+ * @brief Reads the header of a unit
+ * @param[in,out] cur Reader, at the unit length; left after the standard opcode lengths
+ * @param[out] hdr Header read
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed or unknown header
+ */
+static int debugline_headerRead(debugline_cur_t *cur, debugline_header_t *hdr)
+{
+    uint64_t header_len;
+
+    hdr->offset_size = (debugline_uRead(cur, 4) == DWARF_LENGTH_64) ? 8 : 4;
+    if (hdr->offset_size == 8)
+    {
+        debugline_uRead(cur, 8);  // Unit length, known from the index
+    }
+    hdr->version = (uint16_t)debugline_uRead(cur, 2);
+    if ((hdr->version < DWARF_VERSION_MIN) || (hdr->version > DWARF_VERSION_MAX))
+    {
+        return DL_ERR_BAD_FORMAT;
+    }
+    if (hdr->version >= 5)
+    {
+        debugline_uRead(cur, 1);  // Address size, also given by each DW_LNE_set_address
+        debugline_uRead(cur, 1);  // Segment selector size
+    }
+    header_len = debugline_uRead(cur, hdr->offset_size);
+    if (cur->err || (header_len > (cur->end - cur->pos)))
+    {
+        return DL_ERR_BAD_FORMAT;
+    }
+    hdr->prog = cur->pos + (size_t)header_len;
+    hdr->min_inst = (uint8_t)debugline_uRead(cur, 1);
+    if (hdr->version >= 4)
+    {
+        debugline_uRead(cur, 1);  // Maximum operations per instruction, 1 outside VLIW targets
+    }
+    debugline_uRead(cur, 1);  // Default is_stmt, every row is kept
+    hdr->line_base = (int8_t)debugline_uRead(cur, 1);
+    hdr->line_range = (uint8_t)debugline_uRead(cur, 1);
+    hdr->opcode_base = (uint8_t)debugline_uRead(cur, 1);
+    hdr->opcode_lengths = cur->dl->line.data + cur->pos;
+    if (cur->err || (hdr->line_range == 0) || (hdr->opcode_base == 0) ||
+        ((size_t)(hdr->opcode_base - 1) > (hdr->prog - cur->pos)))
+    {
+        return DL_ERR_BAD_FORMAT;
+    }
+    cur->pos += (size_t)(hdr->opcode_base - 1);
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Emits a row of the program
+ * @param[in,out] unit Unit being run
+ * @param[in] state Registers of the program
+ * @param[in] hdr Unit header
+ * @param[in] rows Non-zero to keep the row, zero to only track the range
+ * @param[in] end_seq Non-zero for the row ending a sequence
+ * @param[in,out] cap Number of rows the unit has room for
+ * @return int DL_SUCCESS on success, DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int debugline_rowEmit(debugline_unit_t *unit, const debugline_state_t *state, const debugline_header_t *hdr,
+                             unsigned short rows, unsigned short end_seq, size_t *cap)
+{
+    debugline_row_t *row;
+    uint64_t file;
+
+    if (!rows)
+    {
+        unit->lo = (state->addr < unit->lo) ? state->addr : unit->lo;
+        unit->hi = (state->addr > unit->hi) ? state->addr : unit->hi;
+        return DL_SUCCESS;
+    }
+    if (unit->row_cnt == *cap)
+    {
+        size_t new_cap = (*cap == 0) ? DEBUGLINE_ROWS_MIN : (*cap * 2);
+        debugline_row_t *new_rows = realloc(unit->rows, new_cap * sizeof(debugline_row_t));
+        if (new_rows == NULL)
+        {
+            return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(debugline_row_t));
+        unit->rows = new_rows;
+        *cap = new_cap;
+    }
+    file = (hdr->version >= 5) ? state->file : (state->file - 1);  // File numbers start at 1 before DWARF 5
+    row = &unit->rows[unit->row_cnt++];
+    row->addr = state->addr;
+    row->sect = state->sect;
+    row->line = (end_seq || (state->line < 0) || (state->line > (int64_t)UINT32_MAX)) ? 0 : (uint32_t)state->line;
+    row->file = (end_seq || (file >= unit->file_cnt)) ? DEBUGLINE_FILE_NONE : (uint32_t)file;
+    row->ord = 0;
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Reads the extent of every unit of .debug_line
+ * @param[in,out] dl Line table handle; its units are set
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed unit length,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_unitsIndex(debugline_t *dl)
+{
+    debugline_cur_t cur = {dl, 0, dl->line.len, 0};
+    size_t cap = 0;
+
+    while (cur.pos < cur.end)
+    {
+        size_t off = cur.pos;
+        uint64_t len = debugline_uRead(&cur, 4);
+
+        if (len == DWARF_LENGTH_64)
+        {
+            len = debugline_uRead(&cur, 8);
+        }
+        if (cur.err || (len > (cur.end - cur.pos)))
+        {
+            return (dl->unit_cnt != 0) ? DL_SUCCESS : DL_ERR_BAD_FORMAT;  // Units before the bad one are kept
+        }
+        if (dl->unit_cnt == cap)
+        {
+            size_t new_cap = (cap == 0) ? DEBUGLINE_ROWS_MIN : (cap * 2);
+            debugline_unit_t *new_units = realloc(dl->units, new_cap * sizeof(debugline_unit_t));
+            if (new_units == NULL)
+            {
+                return DL_ERR_MALLOC_FAIL;  // Memory allocation error
+            }
+            STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+            STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(debugline_unit_t));
+            dl->units = new_units;
+            cap = new_cap;
+        }
+        cur.pos += (size_t)len;
+        dl->units[dl->unit_cnt++] = (debugline_unit_t){off, cur.pos, UINT64_MAX, 0, NULL, 0, NULL, 0, DL_SUCCESS, 0, 0};
+    }
+    return DL_SUCCESS;
+}
+
+/**
+ * @brief Runs the line program of one unit
+ * @param[in] dl Line table handle
+ * @param[in,out] unit Unit to run; its range, or its rows and files, are set
+ * @param[in] rows Non-zero to keep the rows and the files
+ * @return int DL_SUCCESS on success, DL_ERR_BAD_FORMAT for a malformed unit,
+ *             DL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int DebugLine_unitRun(const debugline_t *dl, debugline_unit_t *unit, unsigned short rows)
+{
+    debugline_cur_t cur = {dl, unit->off, unit->end, 0};
+    debugline_header_t hdr;
+    debugline_state_t state = {0, 0, 1, 1};
+    size_t cap = 0;
+    int ret;
+
+    ret = debugline_headerRead(&cur, &hdr);
+    if ((ret == DL_SUCCESS) && rows)
+    {
+        cur.end = hdr.prog;  // File tables end where the program starts
+        ret = debugline_filesRead(&cur, &hdr, unit);
+        cur.end = unit->end;
+    }
+    cur.pos = hdr.prog;
+
+    while ((ret == DL_SUCCESS) && (cur.pos < cur.end) && !cur.err)
+    {
+        uint8_t op = (uint8_t)debugline_uRead(&cur, 1);
+
+        if (op >= hdr.opcode_base)
+        {
+            // Special opcode: advance address and line, then emit a row
+            uint8_t adj = (uint8_t)(op - hdr.opcode_base);
+            state.addr += (uint64_t)(adj / hdr.line_range) * hdr.min_inst;
+            state.line += hdr.line_base + (adj % hdr.line_range);
+            ret = debugline_rowEmit(unit, &state, &hdr, rows, 0, &cap);
+        }
+        else if (op == 0)
+        {
+            // Extended opcode
+            uint64_t len = debugline_ulebRead(&cur);
+            size_t next = cur.pos + (size_t)len;
+            uint8_t sub;
+
+            if (cur.err || (len == 0) || (len > (cur.end - cur.pos)))
+            {
+                ret = DL_ERR_BAD_FORMAT;
+                break;
+            }
+            sub = (uint8_t)debugline_uRead(&cur, 1);
+            if (sub == DWARF_LNE_END_SEQUENCE)
+            {
+                ret = debugline_rowEmit(unit, &state, &hdr, rows, 1, &cap);
+                state = (debugline_state_t){0, 0, 1, 1};
+            }
+            else if ((sub == DWARF_LNE_SET_ADDRESS) && (len >= 2) && (len <= 9))
+            {
+                state.addr = debugline_relocRead(&cur, (size_t)len - 1, &state.sect);
+            }
+            cur.pos = next;  // Other extended opcodes are skipped
+        }
+        else if (op == DWARF_LNS_COPY)
+        {
+            ret = debugline_rowEmit(unit, &state, &hdr, rows, 0, &cap);
+        }
+        else if (op == DWARF_LNS_ADVANCE_PC)
+        {
+            state.addr += debugline_ulebRead(&cur) * hdr.min_inst;
+        }
+        else if (op == DWARF_LNS_ADVANCE_LINE)
+        {
+            state.line += debugline_slebRead(&cur);
+        }
+        else if (op == DWARF_LNS_SET_FILE)
+        {
+            state.file = debugline_ulebRead(&cur);
+        }
+        else if (op == DWARF_LNS_CONST_ADD_PC)
+        {
+            state.addr += (uint64_t)((255u - hdr.opcode_base) / hdr.line_range) * hdr.min_inst;
+        }
+        else if (op == DWARF_LNS_FIXED_ADVANCE_PC)
+        {
+            state.addr += debugline_uRead(&cur, 2);
+        }
+        else
+        {
+            // Other standard opcodes only set registers no row is printed with
+            for (uint8_t i = 0; i < hdr.opcode_lengths[op - 1]; i++)
+            {
+                debugline_ulebRead(&cur);
+            }
+        }
+    }
+    if ((ret == DL_SUCCESS) && cur.err)
+    {
+        ret = DL_ERR_BAD_FORMAT;
+    }
+    return ret;
+}
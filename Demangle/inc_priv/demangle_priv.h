@@ -0,0 +1,338 @@
+/**
+ * @file demangle_priv.h
+ * @brief Private header for the ft_nm demangle module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the arena allocator, the memo cache, the node tree
+ * built by the parser and the printer that turns it into text. It is
+ * intended for internal use only by demangle module components.
+ */
+
+#ifndef _IG_DEMANGLE_PRIV_
+#define _IG_DEMANGLE_PRIV_
+
+#include "../inc_pub/demangle.h"
+#include <stdint.h>  // For uint8_t, uint64_t
+
+/**
+ * @brief Demangle macros
+ */
+#define DM_ARENA_BLOCK_SIZE     65536u      /**< Default size of an arena block */
+#define DM_CACHE_BUCKETS_MIN    1024u       /**< Initial buckets of each memo hash table (power of two) */
+#define DM_CACHE_KEY_MIN        12u         /**< Minimum length of a cached prefix, also its hashed length */
+#define DM_CACHE_MAX_BYTES      (64u << 20) /**< Cache memory above which no entries are added */
+#define DM_DEPTH_MAX            256u        /**< Maximum parser and printer recursion depth */
+#define DM_OUTPUT_MAX           (1u << 20)  /**< Maximum length of a demangled name */
+
+/**
+ * @brief Bump allocator made of chained blocks
+ */
+typedef struct dm_arena_block_s
+{
+    struct dm_arena_block_s *next;  /**< Previously filled block */
+    size_t size;                    /**< Usable bytes in data */
+    size_t used;                    /**< Bytes handed out from data */
+    char data[];                    /**< Block storage */
+} dm_arena_block_t;
+
+typedef struct dm_arena_s
+{
+    dm_arena_block_t *head;  /**< Block currently allocated from */
+    size_t total;            /**< Bytes held by all blocks */
+} dm_arena_t;
+
+/**
+ * @brief Node kinds of the demangled name tree
+ */
+typedef enum
+{
+    DM_NODE_NAME = 0,      /**< Plain text */
+    DM_NODE_TEXT,          /**< Cached text with left/right parts and the ctor base name in c */
+    DM_NODE_QUAL,          /**< a::b */
+    DM_NODE_TEMPLATE,      /**< a<b>, b being the ARGS node of the arguments */
+    DM_NODE_ARGS,          /**< Comma separated list, or template argument pack with DM_FLAG_PACK */
+    DM_NODE_CTOR,          /**< Constructor, or destructor with DM_FLAG_DTOR, of base name a */
+    DM_NODE_ABI_TAG,       /**< a[abi:text] */
+    DM_NODE_CV,            /**< a qualified by quals */
+    DM_NODE_POINTER,       /**< a* */
+    DM_NODE_LREF,          /**< a& */
+    DM_NODE_RREF,          /**< a&& */
+    DM_NODE_PTRMEM,        /**< Pointer to member of class a with type b */
+    DM_NODE_FUNC_TYPE,     /**< Function type returning a with parameters list */
+    DM_NODE_ARRAY,         /**< Array of a with dimension text, or expression b */
+    DM_NODE_ENCODING,      /**< Function a, return type b or NULL, parameters list */
+    DM_NODE_LOCAL,         /**< Entity b local to function a */
+    DM_NODE_SPECIAL,       /**< text followed by a, e.g. "vtable for " */
+    DM_NODE_CTOR_VTABLE,   /**< Construction vtable of b in a */
+    DM_NODE_CONVERSION,    /**< Conversion operator to type a */
+    DM_NODE_EXPANSION,     /**< Pack expansion of a */
+    DM_NODE_LAMBDA,        /**< Closure type with parameters list and number text */
+    DM_NODE_LITERAL,       /**< Literal text, printed as a cast to type a if a is set */
+    DM_NODE_CLONE,         /**< Function a with clone suffix text, e.g. ".cold" */
+    DM_NODE_PACK_REF,      /**< Template parameter referring to argument pack a */
+    DM_NODE_PARAM,         /**< Template parameter len resolved to a, as a substitution candidate or an operand */
+    DM_NODE_PAREN,         /**< (a), an operand c++filt parenthesizes */
+    DM_NODE_UNARY,         /**< Prefix operator text applied to a */
+    DM_NODE_BINARY,        /**< a text b rtext, e.g. a==b or a[b] */
+    DM_NODE_TRINARY,       /**< a?b : c */
+    DM_NODE_CALL,          /**< Call of a with argument list */
+    DM_NODE_CAST,          /**< (a)b, or text<a>(b) for a named cast */
+    DM_NODE_DECLTYPE,      /**< decltype (a) */
+    DM_NODE_POSTFIX        /**< a followed by text, e.g. "double _Complex" */
+} dm_node_kind_e;
+
+/**
+ * @brief Node flags
+ */
+#define DM_FLAG_PACK        0x01u  /**< ARGS node is a template argument pack */
+#define DM_FLAG_DTOR        0x02u  /**< CTOR node is a destructor */
+#define DM_FLAG_FUNC        0x04u  /**< TEXT node holds a function type */
+#define DM_FLAG_ARRAY       0x08u  /**< TEXT node holds an array type */
+#define DM_FLAG_VOID        0x10u  /**< NAME node is the builtin void */
+#define DM_FLAG_NEGATIVE    0x20u  /**< LITERAL node value is negative */
+#define DM_FLAG_NOEXCEPT    0x40u  /**< FUNC_TYPE node is noexcept */
+#define DM_FLAG_UNNAMED     0x80u  /**< NAME node is an unnamed type, not used as a constructor name */
+
+/**
+ * @brief Qualifiers of CV, FUNC_TYPE and ENCODING nodes
+ */
+#define DM_QUAL_CONST       0x01u  /**< const */
+#define DM_QUAL_VOLATILE    0x02u  /**< volatile */
+#define DM_QUAL_RESTRICT    0x04u  /**< restrict */
+#define DM_QUAL_LREF        0x08u  /**< & member function */
+#define DM_QUAL_RREF        0x10u  /**< && member function */
+
+typedef struct dm_node_s
+{
+    uint8_t kind;               /**< dm_node_kind_e */
+    uint8_t flags;              /**< DM_FLAG_* */
+    uint8_t quals;              /**< DM_QUAL_* */
+    const char *text;           /**< Text of NAME, TEXT (left part), ABI_TAG, ARRAY, SPECIAL, LAMBDA, LITERAL, operators */
+    size_t len;                 /**< Length of text */
+    const char *rtext;          /**< Right part of TEXT, closing text of BINARY */
+    size_t rlen;                /**< Length of rtext */
+    struct dm_node_s *a;        /**< First child */
+    struct dm_node_s *b;        /**< Second child */
+    struct dm_node_s *c;        /**< Base name of TEXT, for constructors, third operand of TRINARY */
+    struct dm_node_s **list;    /**< Child list of ARGS, FUNC_TYPE, ENCODING, LAMBDA, CALL */
+    size_t list_len;            /**< Number of nodes in list */
+} dm_node_t;
+
+/**
+ * @brief Growable output buffer
+ */
+typedef struct dm_out_s
+{
+    char *buf;      /**< Output storage */
+    size_t len;     /**< Bytes written */
+    size_t cap;     /**< Bytes allocated */
+    int failed;     /**< Non-zero after an allocation failure or overflow */
+    char last;      /**< Last character appended, kept when an empty element is dropped */
+} dm_out_t;
+
+/**
+ * @brief Cached substitution candidate of a nested-name prefix
+ */
+typedef struct dm_cache_sub_s
+{
+    const char *left;     /**< Text printed before a declarator */
+    size_t left_len;      /**< Length of left */
+    const char *right;    /**< Text printed after a declarator */
+    size_t right_len;     /**< Length of right */
+    const char *simple;   /**< Base name used by a following constructor */
+    size_t simple_len;    /**< Length of simple */
+    uint8_t flags;        /**< DM_FLAG_FUNC / DM_FLAG_ARRAY */
+} dm_cache_sub_t;
+
+/**
+ * @brief Memo cache entry, either a whole name or a nested-name prefix
+ */
+typedef struct dm_cache_entry_s
+{
+    struct dm_cache_entry_s *next;  /**< Next entry in the bucket */
+    uint64_t hash;                  /**< Hash the entry is bucketed by */
+    const char *key;                /**< Mangled text */
+    size_t key_len;                 /**< Length of key */
+    const char *text;               /**< Demangled name, or NULL if the name failed to demangle */
+    dm_cache_sub_t *subs;           /**< Substitution candidates added by a prefix, the last one is the prefix */
+    size_t sub_cnt;                 /**< Number of subs */
+    int status;                     /**< Demangle result of a whole name */
+} dm_cache_entry_t;
+
+typedef struct dm_cache_s
+{
+    dm_arena_t arena;                    /**< Storage of entries and their text */
+    dm_cache_entry_t **names;            /**< Whole names by mangled name */
+    dm_cache_entry_t **prefixes;         /**< Nested-name prefixes by their first DM_CACHE_KEY_MIN bytes */
+    size_t name_buckets;                 /**< Buckets of names (power of two) */
+    size_t name_cnt;                     /**< Entries in names */
+    size_t prefix_buckets;               /**< Buckets of prefixes (power of two) */
+    size_t prefix_cnt;                   /**< Entries in prefixes */
+} dm_cache_t;
+
+/**
+ * @brief Parser state for one name
+ */
+typedef struct dm_parser_s
+{
+    const char *cur;            /**< Next character to parse */
+    const char *end;            /**< End of the mangled name */
+    dm_arena_t *arena;          /**< Scratch arena for nodes */
+    dm_cache_t *cache;          /**< Prefix memo cache */
+    dm_out_t *out;              /**< Buffer used to print cached prefixes */
+    dm_node_t **subs;           /**< Substitution candidates */
+    size_t sub_len;             /**< Number of substitution candidates */
+    size_t sub_cap;             /**< Capacity of subs */
+    dm_node_t *tmpl_args;       /**< Template arguments T_ refers to */
+    dm_node_t *last_simple;     /**< Last unqualified name, base name of constructors */
+    unsigned int backrefs;      /**< Number of S_ / T_ references parsed */
+    unsigned int depth;         /**< Current recursion depth */
+    int nomem;                  /**< Non-zero after a memory allocation failure */
+} dm_parser_t;
+
+struct demangle_ctx_s
+{
+    dm_arena_t scratch;   /**< Nodes of the name being demangled, reset per name */
+    dm_arena_t results;   /**< Results not held by the cache, reset by Demangle_ctxReset */
+    dm_cache_t cache;     /**< Memo cache */
+    dm_out_t out;         /**< Output buffer */
+};
+
+/**
+ * @brief Allocates memory from an arena
+ * @param[in,out] arena Arena to allocate from
+ * @param[in] size Number of bytes, aligned to 8
+ * @return void* Allocated memory, or NULL on failure
+ */
+void *Demangle_Arena_alloc(dm_arena_t *arena, size_t size);
+
+/**
+ * @brief Copies a string into an arena and terminates it
+ * @param[in,out] arena Arena to allocate from
+ * @param[in] str String to copy
+ * @param[in] len Length of str
+ * @return char* Copy, or NULL on failure
+ */
+char *Demangle_Arena_strDup(dm_arena_t *arena, const char *str, size_t len);
+
+/**
+ * @brief Releases all but the first block of an arena and empties it
+ * @param[in,out] arena Arena to reset
+ */
+void Demangle_Arena_reset(dm_arena_t *arena);
+
+/**
+ * @brief Frees every block of an arena
+ * @param[in,out] arena Arena to free
+ */
+void Demangle_Arena_free(dm_arena_t *arena);
+
+/**
+ * @brief Sets up an empty cache
+ * @param[out] cache Cache to set up
+ * @return int DM_SUCCESS on success, DM_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Demangle_Cache_init(dm_cache_t *cache);
+
+/**
+ * @brief Frees a cache and all its entries
+ * @param[in,out] cache Cache to free
+ */
+void Demangle_Cache_free(dm_cache_t *cache);
+
+/**
+ * @brief Looks up a whole mangled name
+ * @param[in] cache Cache to search
+ * @param[in] key Mangled name
+ * @param[in] key_len Length of key
+ * @return const dm_cache_entry_t* Entry, or NULL if the name is not cached
+ */
+const dm_cache_entry_t *Demangle_Cache_nameFind(const dm_cache_t *cache, const char *key, size_t key_len);
+
+/**
+ * @brief Adds the result of a whole mangled name
+ * @param[in,out] cache Cache to add to
+ * @param[in] key Mangled name
+ * @param[in] key_len Length of key
+ * @param[in] text Demangled name, ignored unless status is DM_SUCCESS
+ * @param[in] text_len Length of text
+ * @param[in] status Demangle result
+ * @return const dm_cache_entry_t* New entry, or NULL if it was not added
+ */
+const dm_cache_entry_t *Demangle_Cache_nameAdd(dm_cache_t *cache, const char *key, size_t key_len,
+                                               const char *text, size_t text_len, int status);
+
+/**
+ * @brief Finds the longest cached nested-name prefix the text starts with
+ * @param[in] cache Cache to search
+ * @param[in] str Text following the nested-name qualifiers
+ * @param[in] str_len Length of str
+ * @return const dm_cache_entry_t* Entry, or NULL if none matches
+ */
+const dm_cache_entry_t *Demangle_Cache_prefixFind(const dm_cache_t *cache, const char *str, size_t str_len);
+
+/**
+ * @brief Adds a nested-name prefix with its substitution candidates
+ * @param[in,out] cache Cache to add to
+ * @param[in] key Mangled prefix, at least DM_CACHE_KEY_MIN long
+ * @param[in] key_len Length of key
+ * @param[in] subs Substitution candidates the prefix adds, the last being the prefix itself
+ * @param[in] sub_cnt Number of subs
+ * @param[in,out] out Buffer used to print the candidates
+ */
+void Demangle_Cache_prefixAdd(dm_cache_t *cache, const char *key, size_t key_len,
+                              dm_node_t *const *subs, size_t sub_cnt, dm_out_t *out);
+
+/**
+ * @brief Parses a mangled name into a node tree
+ * @param[in,out] parser Parser set up on the mangled name
+ * @return dm_node_t* Root node, or NULL if the name is malformed or not supported
+ */
+dm_node_t *Demangle_Parse_mangled(dm_parser_t *parser);
+
+/**
+ * @brief Appends text to an output buffer
+ * @param[in,out] out Output buffer
+ * @param[in] str Text to append
+ * @param[in] len Length of str
+ */
+void Demangle_Print_append(dm_out_t *out, const char *str, size_t len);
+
+/**
+ * @brief Prints a node tree
+ * @param[in,out] out Output buffer
+ * @param[in] node Root node
+ */
+void Demangle_Print_node(dm_out_t *out, const dm_node_t *node);
+
+/**
+ * @brief Prints the part of a type before its declarator
+ * @param[in,out] out Output buffer
+ * @param[in] node Type node
+ */
+void Demangle_Print_left(dm_out_t *out, const dm_node_t *node);
+
+/**
+ * @brief Prints the part of a type after its declarator
+ * @param[in,out] out Output buffer
+ * @param[in] node Type node
+ */
+void Demangle_Print_right(dm_out_t *out, const dm_node_t *node);
+
+/**
+ * @brief Returns the function/array flags of a type, as stored for cached text
+ * @param[in] node Type node
+ * @return uint8_t DM_FLAG_FUNC, DM_FLAG_ARRAY or 0
+ */
+uint8_t Demangle_Print_declFlags(const dm_node_t *node);
+
+/**
+ * @brief Returns the base name used by a constructor following a prefix
+ * @param[in] node Prefix node
+ * @return const dm_node_t* Base name node, or NULL if there is none
+ */
+const dm_node_t *Demangle_Print_simpleName(const dm_node_t *node);
+
+#endif /* _IG_DEMANGLE_PRIV_ */
@@ -0,0 +1,86 @@
+/**
+ * @file demangle.h
+ * @brief Public header for Itanium C++ ABI symbol demangling in ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interface of the demangler used by the -C option.
+ * A context owns the scratch memory of the parser and a memo cache of whole
+ * names and of nested-name prefixes, so repeated namespace and template
+ * prefixes are demangled once per context. A context must only be used by
+ * one thread at a time; parallel callers use one context each.
+ */
+
+#ifndef _IG_DEMANGLE_H_
+#define _IG_DEMANGLE_H_
+
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Error codes for demangle operations
+ */
+enum Demangle_Error {
+    DM_SUCCESS = 0,           /**< Success */
+    DM_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    DM_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    DM_ERR_NOT_MANGLED = -3,  /**< Name is not an Itanium mangled name */
+    DM_ERR_BAD_NAME = -4      /**< Mangled name is malformed or not supported */
+};
+
+/**
+ * @brief Opaque demangler context
+ */
+typedef struct demangle_ctx_s demangle_ctx_t;
+
+/**
+ * @brief Creates a demangler context
+ * @param[out] ctx Pointer to store the new context
+ * @return int DM_SUCCESS on success, DM_ERR_NULL_INPUT if ctx is NULL,
+ *             DM_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Demangle_ctxCreate(demangle_ctx_t **ctx);
+
+/**
+ * @brief Frees a demangler context and every name it returned
+ * @param[in,out] ctx Pointer to the context; set to NULL
+ */
+void Demangle_ctxFree(demangle_ctx_t **ctx);
+
+/**
+ * @brief Releases names returned by a context that are not held in its cache
+ *
+ * Names returned before the call may be invalidated; the memo cache is kept.
+ *
+ * @param[in] ctx Demangler context
+ */
+void Demangle_ctxReset(demangle_ctx_t *ctx);
+
+/**
+ * @brief Demangles one symbol name
+ * @param[in] ctx Demangler context
+ * @param[in] mangled Null-terminated symbol name
+ * @param[out] demangled Pointer to store the demangled name, owned by ctx and
+ *                       valid until Demangle_ctxReset or Demangle_ctxFree
+ * @return int DM_SUCCESS on success, DM_ERR_NULL_INPUT on invalid input,
+ *             DM_ERR_NOT_MANGLED or DM_ERR_BAD_NAME if the name is to be
+ *             printed as it is, DM_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Demangle_name(demangle_ctx_t *ctx, const char *mangled, const char **demangled);
+
+/**
+ * @brief Demangles the start of a symbol name, keeping the rest of it as it is
+ *
+ * For versioned names like _ZNSo3putEc@GLIBCXX_3.4, demangled up to the '@'
+ * with the version appended unchanged.
+ *
+ * @param[in] ctx Demangler context
+ * @param[in] mangled Null-terminated symbol name
+ * @param[in] len Length of the part to demangle, at most strlen(mangled)
+ * @param[out] demangled Pointer to store the demangled name, owned by ctx and
+ *                       valid until Demangle_ctxReset or Demangle_ctxFree
+ * @return int Same as Demangle_name
+ */
+int Demangle_namePart(demangle_ctx_t *ctx, const char *mangled, size_t len, const char **demangled);
+
+#endif /* _IG_DEMANGLE_H_ */
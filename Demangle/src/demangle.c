@@ -0,0 +1,181 @@
+/**
+ * @file demangle.c
+ * @brief Demangler contexts of the ft_nm demangle module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the functions creating and freeing demangler contexts
+ * and the entry point demangling one name. Whole names are looked up in the
+ * memo cache first; names parsed are added to it, so a name is demangled once
+ * per context however many files list it.
+ */
+
+#include "../inc_priv/demangle_priv.h"
+#include <stdlib.h>  // For malloc, free
+#include <string.h>  // For strlen
+
+/**
+ * @brief Creates a demangler context
+ * @param[out] ctx Pointer to store the new context
+ * @return int DM_SUCCESS on success, DM_ERR_NULL_INPUT if ctx is NULL,
+ *             DM_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Demangle_ctxCreate(demangle_ctx_t **ctx)
+{
+    demangle_ctx_t *new_ctx;
+
+    if (ctx == NULL)
+    {
+        return DM_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    new_ctx = malloc(sizeof(demangle_ctx_t));
+    if (new_ctx == NULL)
+    {
+        return DM_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    new_ctx->scratch.head = NULL;
+    new_ctx->scratch.total = 0;
+    new_ctx->results.head = NULL;
+    new_ctx->results.total = 0;
+    new_ctx->out.buf = NULL;
+    new_ctx->out.len = 0;
+    new_ctx->out.cap = 0;
+    new_ctx->out.failed = 0;
+    new_ctx->out.last = '\0';
+    if (Demangle_Cache_init(&new_ctx->cache) != DM_SUCCESS)
+    {
+        free(new_ctx);
+        return DM_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    *ctx = new_ctx;
+    return DM_SUCCESS;
+}
+
+/**
+ * @brief Frees a demangler context and every name it returned
+ * @param[in,out] ctx Pointer to the context; set to NULL
+ */
+void Demangle_ctxFree(demangle_ctx_t **ctx)
+{
+    if ((ctx == NULL) || (*ctx == NULL))
+    {
+        return;
+    }
+    Demangle_Cache_free(&(*ctx)->cache);
+    Demangle_Arena_free(&(*ctx)->scratch);
+    Demangle_Arena_free(&(*ctx)->results);
+    free((*ctx)->out.buf);
+    free(*ctx);
+    *ctx = NULL;
+}
+
+/**
+ * @brief Releases names returned by a context that are not held in its cache
+ * @param[in] ctx Demangler context
+ */
+void Demangle_ctxReset(demangle_ctx_t *ctx)
+{
+    if (ctx != NULL)
+    {
+        Demangle_Arena_reset(&ctx->results);
+    }
+}
+
+/**
+ * @brief Demangles one symbol name
+ * @param[in] ctx Demangler context
+ * @param[in] mangled Null-terminated symbol name
+ * @param[out] demangled Pointer to store the demangled name, owned by ctx and
+ *                       valid until Demangle_ctxReset or Demangle_ctxFree
+ * @return int DM_SUCCESS on success, DM_ERR_NULL_INPUT on invalid input,
+ *             DM_ERR_NOT_MANGLED or DM_ERR_BAD_NAME if the name is to be
+ *             printed as it is, DM_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Demangle_name(demangle_ctx_t *ctx, const char *mangled, const char **demangled)
+{
+    if (mangled == NULL)
+    {
+        return DM_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    return Demangle_namePart(ctx, mangled, strlen(mangled), demangled);
+}
+
+/**
+ * @brief Demangles the start of a symbol name, keeping the rest of it as it is
+ * @param[in] ctx Demangler context
+ * @param[in] mangled Null-terminated symbol name
+ * @param[in] len Length of the part to demangle, at most strlen(mangled)
+ * @param[out] demangled Pointer to store the demangled name, owned by ctx and
+ *                       valid until Demangle_ctxReset or Demangle_ctxFree
+ * @return int Same as Demangle_name
+ */
+int Demangle_namePart(demangle_ctx_t *ctx, const char *mangled, size_t len, const char **demangled)
+{
+    const dm_cache_entry_t *entry;
+    dm_parser_t parser = {0};
+    dm_node_t *root;
+    size_t full_len;
+    int status = DM_SUCCESS;
+
+    if ((ctx == NULL) || (mangled == NULL) || (demangled == NULL))
+    {
+        return DM_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if ((len < 2) || (mangled[0] != '_') || (mangled[1] != 'Z'))
+    {
+        return DM_ERR_NOT_MANGLED;  // Not an Itanium C++ name
+    }
+    full_len = len + strlen(&mangled[len]);
+
+    // Name seen before by this context, keyed with its kept part
+    entry = Demangle_Cache_nameFind(&ctx->cache, mangled, full_len);
+    if (entry != NULL)
+    {
+        *demangled = entry->text;
+        return entry->status;
+    }
+
+    // Parse and print the name, then append the kept part
+    Demangle_Arena_reset(&ctx->scratch);
+    parser.cur = mangled;
+    parser.end = mangled + len;
+    parser.arena = &ctx->scratch;
+    parser.cache = &ctx->cache;
+    parser.out = &ctx->out;
+    root = Demangle_Parse_mangled(&parser);
+    if (parser.nomem)
+    {
+        return DM_ERR_MALLOC_FAIL;  // Memory allocation error, not cached
+    }
+    ctx->out.len = 0;
+    ctx->out.failed = 0;
+    ctx->out.last = '\0';
+    if (root == NULL)
+    {
+        status = DM_ERR_BAD_NAME;
+    }
+    else
+    {
+        Demangle_Print_node(&ctx->out, root);
+        Demangle_Print_append(&ctx->out, &mangled[len], full_len - len);
+        status = ctx->out.failed ? DM_ERR_BAD_NAME : DM_SUCCESS;
+    }
+
+    // Keep the result in the cache, or in the result arena once the cache is full
+    entry = Demangle_Cache_nameAdd(&ctx->cache, mangled, full_len, ctx->out.buf, ctx->out.len, status);
+    if (entry != NULL)
+    {
+        *demangled = entry->text;
+        return status;
+    }
+    if (status == DM_SUCCESS)
+    {
+        *demangled = Demangle_Arena_strDup(&ctx->results, ctx->out.buf, ctx->out.len);
+        if (*demangled == NULL)
+        {
+            return DM_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+    }
+    return status;
+}
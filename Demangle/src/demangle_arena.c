@@ -0,0 +1,108 @@
+/**
+ * @file demangle_arena.c
+ * @brief Arena allocator of the ft_nm demangle module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains a bump allocator made of chained blocks. Nodes of the
+ * name being demangled, cached entries and returned names are allocated from
+ * arenas and released together, never one by one.
+ */
+
+#include "../inc_priv/demangle_priv.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <stdlib.h>  // For malloc, free
+#include <string.h>  // For memcpy
+
+#define DM_ARENA_ALIGN 8u  /**< Alignment of every allocation */
+
+/**
+ * @brief Allocates memory from an arena
+ * @param[in,out] arena Arena to allocate from
+ * @param[in] size Number of bytes, aligned to 8
+ * @return void* Allocated memory, or NULL on failure
+ */
+void *Demangle_Arena_alloc(dm_arena_t *arena, size_t size)
+{
+    dm_arena_block_t *block = arena->head;
+    void *mem;
+
+    size = (size + DM_ARENA_ALIGN - 1) & ~(size_t)(DM_ARENA_ALIGN - 1);
+    if ((block == NULL) || ((block->size - block->used) < size))
+    {
+        size_t block_size = (size > DM_ARENA_BLOCK_SIZE) ? size : DM_ARENA_BLOCK_SIZE;
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(dm_arena_block_t) + block_size);
+        block = malloc(sizeof(dm_arena_block_t) + block_size);
+        if (block == NULL)
+        {
+            return NULL;  // Memory allocation error
+        }
+        block->size = block_size;
+        block->used = 0;
+        block->next = arena->head;
+        arena->head = block;
+        arena->total += block_size;
+    }
+    mem = &block->data[block->used];
+    block->used += size;
+    return mem;
+}
+
+/**
+ * @brief Copies a string into an arena and terminates it
+ * @param[in,out] arena Arena to allocate from
+ * @param[in] str String to copy
+ * @param[in] len Length of str
+ * @return char* Copy, or NULL on failure
+ */
+char *Demangle_Arena_strDup(dm_arena_t *arena, const char *str, size_t len)
+{
+    char *copy = Demangle_Arena_alloc(arena, len + 1);
+
+    if (copy != NULL)
+    {
+        memcpy(copy, str, len);
+        copy[len] = '\0';
+    }
+    return copy;
+}
+
+/**
+ * @brief Releases all but the first block of an arena and empties it
+ * @param[in,out] arena Arena to reset
+ */
+void Demangle_Arena_reset(dm_arena_t *arena)
+{
+    dm_arena_block_t *block = arena->head;
+
+    if (block == NULL)
+    {
+        return;
+    }
+    // Keep the newest block, which is the one allocated from
+    while (block->next != NULL)
+    {
+        dm_arena_block_t *next = block->next->next;
+        arena->total -= block->next->size;
+        free(block->next);
+        block->next = next;
+    }
+    block->used = 0;
+}
+
+/**
+ * @brief Frees every block of an arena
+ * @param[in,out] arena Arena to free
+ */
+void Demangle_Arena_free(dm_arena_t *arena)
+{
+    while (arena->head != NULL)
+    {
+        dm_arena_block_t *next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    arena->total = 0;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file demangle_cache.c
+ * @brief Memo cache of the ft_nm demangle module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains two hash tables kept in an arena. The first maps whole
+ * mangled names to their result, so names repeated across files (undefined
+ * library symbols) are demangled once. The second maps nested-name prefixes
+ * that contain no substitution or template parameter reference, and so mean
+ * the same in every name, to their printed text and to the substitution
+ * candidates they add. Prefixes are bucketed by their first DM_CACHE_KEY_MIN
+ * bytes, so the longest cached prefix of a name is found without knowing its
+ * length in advance. Both tables double their buckets when they hold more
+ * entries than buckets, rehashing from the hash kept in each entry.
+ */
+
+#include "../inc_priv/demangle_priv.h"
+#include <stdlib.h>  // For calloc, free
+#include <string.h>  // For memcmp
+
+#define DM_FNV_OFFSET 14695981039346656037ull  /**< FNV-1a offset basis */
+#define DM_FNV_PRIME  1099511628211ull         /**< FNV-1a prime */
+
+/**
+ * @brief Hashes a byte string with FNV-1a
+ * @param[in] str Bytes to hash
+ * @param[in] len Number of bytes
+ * @return uint64_t Hash
+ */
+static uint64_t cache_hash(const char *str, size_t len)
+{
+    uint64_t hash = DM_FNV_OFFSET;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= (unsigned char)str[i];
+        hash *= DM_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Links an entry into a table, doubling the table when it is full
+ * @param[in,out] table Pointer to the bucket array
+ * @param[in,out] buckets Number of buckets (power of two)
+ * @param[in,out] cnt Number of entries
+ * @param[in] entry Entry to link, its hash set
+ */
+static void cache_link(dm_cache_entry_t ***table, size_t *buckets, size_t *cnt, dm_cache_entry_t *entry)
+{
+    size_t bucket;
+
+    if (*cnt >= *buckets)
+    {
+        size_t new_buckets = *buckets * 2;
+        dm_cache_entry_t **new_table = calloc(new_buckets, sizeof(dm_cache_entry_t *));
+        if (new_table != NULL)  // Otherwise keep the longer chains
+        {
+            for (size_t i = 0; i < *buckets; i++)
+            {
+                while ((*table)[i] != NULL)
+                {
+                    dm_cache_entry_t *moved = (*table)[i];
+                    (*table)[i] = moved->next;
+                    bucket = (size_t)(moved->hash & (new_buckets - 1));
+                    moved->next = new_table[bucket];
+                    new_table[bucket] = moved;
+                }
+            }
+            free(*table);
+            *table = new_table;
+            *buckets = new_buckets;
+        }
+    }
+    bucket = (size_t)(entry->hash & (*buckets - 1));
+    entry->next = (*table)[bucket];
+    (*table)[bucket] = entry;
+    (*cnt)++;
+}
+
+/**
+ * @brief Sets up an empty cache
+ * @param[out] cache Cache to set up
+ * @return int DM_SUCCESS on success, DM_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Demangle_Cache_init(dm_cache_t *cache)
+{
+    cache->arena.head = NULL;
+    cache->arena.total = 0;
+    cache->names = calloc(DM_CACHE_BUCKETS_MIN, sizeof(dm_cache_entry_t *));
+    cache->prefixes = calloc(DM_CACHE_BUCKETS_MIN, sizeof(dm_cache_entry_t *));
+    cache->name_buckets = DM_CACHE_BUCKETS_MIN;
+    cache->name_cnt = 0;
+    cache->prefix_buckets = DM_CACHE_BUCKETS_MIN;
+    cache->prefix_cnt = 0;
+    if ((cache->names == NULL) || (cache->prefixes == NULL))
+    {
+        Demangle_Cache_free(cache);
+        return DM_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    return DM_SUCCESS;
+}
+
+/**
+ * @brief Frees a cache and all its entries
+ * @param[in,out] cache Cache to free
+ */
+void Demangle_Cache_free(dm_cache_t *cache)
+{
+    free(cache->names);
+    free(cache->prefixes);
+    cache->names = NULL;
+    cache->prefixes = NULL;
+    Demangle_Arena_free(&cache->arena);
+}
+
+/**
+ * @brief Looks up a whole mangled name
+ * @param[in] cache Cache to search
+ * @param[in] key Mangled name
+ * @param[in] key_len Length of key
+ * @return const dm_cache_entry_t* Entry, or NULL if the name is not cached
+ */
+const dm_cache_entry_t *Demangle_Cache_nameFind(const dm_cache_t *cache, const char *key, size_t key_len)
+{
+    uint64_t hash = cache_hash(key, key_len);
+
+    for (const dm_cache_entry_t *entry = cache->names[hash & (cache->name_buckets - 1)]; entry != NULL; entry = entry->next)
+    {
+        if ((entry->hash == hash) && (entry->key_len == key_len) && (memcmp(entry->key, key, key_len) == 0))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Adds the result of a whole mangled name
+ * @param[in,out] cache Cache to add to
+ * @param[in] key Mangled name
+ * @param[in] key_len Length of key
+ * @param[in] text Demangled name, ignored unless status is DM_SUCCESS
+ * @param[in] text_len Length of text
+ * @param[in] status Demangle result
+ * @return const dm_cache_entry_t* New entry, or NULL if it was not added
+ */
+const dm_cache_entry_t *Demangle_Cache_nameAdd(dm_cache_t *cache, const char *key, size_t key_len,
+                                               const char *text, size_t text_len, int status)
+{
+    dm_cache_entry_t *entry;
+
+    if (cache->arena.total >= DM_CACHE_MAX_BYTES)
+    {
+        return NULL;  // Cache is full
+    }
+    entry = Demangle_Arena_alloc(&cache->arena, sizeof(dm_cache_entry_t));
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+    entry->key = Demangle_Arena_strDup(&cache->arena, key, key_len);
+    entry->text = (status == DM_SUCCESS) ? Demangle_Arena_strDup(&cache->arena, text, text_len) : NULL;
+    if ((entry->key == NULL) || ((status == DM_SUCCESS) && (entry->text == NULL)))
+    {
+        return NULL;
+    }
+    entry->key_len = key_len;
+    entry->subs = NULL;
+    entry->sub_cnt = 0;
+    entry->status = status;
+    entry->hash = cache_hash(key, key_len);
+    cache_link(&cache->names, &cache->name_buckets, &cache->name_cnt, entry);
+    return entry;
+}
+
+/**
+ * @brief Finds the longest cached nested-name prefix the text starts with
+ * @param[in] cache Cache to search
+ * @param[in] str Text following the nested-name qualifiers
+ * @param[in] str_len Length of str
+ * @return const dm_cache_entry_t* Entry, or NULL if none matches
+ */
+const dm_cache_entry_t *Demangle_Cache_prefixFind(const dm_cache_t *cache, const char *str, size_t str_len)
+{
+    const dm_cache_entry_t *best = NULL;
+    uint64_t hash;
+
+    if (str_len < DM_CACHE_KEY_MIN)
+    {
+        return NULL;
+    }
+    hash = cache_hash(str, DM_CACHE_KEY_MIN);
+    for (const dm_cache_entry_t *entry = cache->prefixes[hash & (cache->prefix_buckets - 1)]; entry != NULL; entry = entry->next)
+    {
+        if ((entry->hash == hash) && (entry->key_len <= str_len) && ((best == NULL) || (entry->key_len > best->key_len)) &&
+            (memcmp(entry->key, str, entry->key_len) == 0))
+        {
+            best = entry;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Prints a node into the cache arena
+ * @param[in,out] cache Cache owning the arena
+ * @param[in,out] out Buffer used to print
+ * @param[in] node Node to print
+ * @param[in] right Non-zero to print the part after the declarator
+ * @param[out] len Length of the copy
+ * @return const char* Copy in the cache arena, or NULL on failure
+ */
+static const char *cache_nodeCopy(dm_cache_t *cache, dm_out_t *out, const dm_node_t *node, int right, size_t *len)
+{
+    out->len = 0;
+    out->failed = 0;
+    out->last = '\0';
+    if (node != NULL)
+    {
+        if (right)
+        {
+            Demangle_Print_right(out, node);
+        }
+        else
+        {
+            Demangle_Print_left(out, node);
+        }
+    }
+    if (out->failed)
+    {
+        return NULL;
+    }
+    *len = out->len;
+    return Demangle_Arena_strDup(&cache->arena, (out->len != 0) ? out->buf : "", out->len);
+}
+
+/**
+ * @brief Adds a nested-name prefix with its substitution candidates
+ * @param[in,out] cache Cache to add to
+ * @param[in] key Mangled prefix, at least DM_CACHE_KEY_MIN long
+ * @param[in] key_len Length of key
+ * @param[in] subs Substitution candidates the prefix adds, the last being the prefix itself
+ * @param[in] sub_cnt Number of subs
+ * @param[in,out] out Buffer used to print the candidates
+ */
+void Demangle_Cache_prefixAdd(dm_cache_t *cache, const char *key, size_t key_len,
+                              dm_node_t *const *subs, size_t sub_cnt, dm_out_t *out)
+{
+    dm_cache_entry_t *entry;
+
+    if ((key_len < DM_CACHE_KEY_MIN) || (sub_cnt == 0) || (cache->arena.total >= DM_CACHE_MAX_BYTES))
+    {
+        return;  // Too short to be worth caching, or cache is full
+    }
+    entry = Demangle_Arena_alloc(&cache->arena, sizeof(dm_cache_entry_t));
+    if (entry == NULL)
+    {
+        return;
+    }
+    entry->subs = Demangle_Arena_alloc(&cache->arena, sub_cnt * sizeof(dm_cache_sub_t));
+    entry->key = Demangle_Arena_strDup(&cache->arena, key, key_len);
+    if ((entry->subs == NULL) || (entry->key == NULL))
+    {
+        return;
+    }
+    for (size_t i = 0; i < sub_cnt; i++)
+    {
+        dm_cache_sub_t *sub = &entry->subs[i];
+        const dm_node_t *simple = Demangle_Print_simpleName(subs[i]);
+
+        sub->flags = Demangle_Print_declFlags(subs[i]);
+        sub->left = cache_nodeCopy(cache, out, subs[i], 0, &sub->left_len);
+        sub->right = cache_nodeCopy(cache, out, subs[i], 1, &sub->right_len);
+        sub->simple = cache_nodeCopy(cache, out, simple, 0, &sub->simple_len);
+        if ((sub->left == NULL) || (sub->right == NULL) || (sub->simple == NULL))
+        {
+            return;  // Entry is not linked, its memory stays unused in the arena
+        }
+    }
+    entry->key_len = key_len;
+    entry->sub_cnt = sub_cnt;
+    entry->text = entry->subs[sub_cnt - 1].left;
+    entry->status = DM_SUCCESS;
+    entry->hash = cache_hash(key, DM_CACHE_KEY_MIN);
+    cache_link(&cache->prefixes, &cache->prefix_buckets, &cache->prefix_cnt, entry);
+}
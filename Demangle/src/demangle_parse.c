@@ -0,0 +1,2165 @@
+/**
+ * @file demangle_parse.c
+ * @brief Itanium C++ ABI name parser of the ft_nm demangle module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains a recursive descent parser of Itanium mangled names that
+ * builds a node tree in the scratch arena. Substitution candidates are
+ * recorded in the order the ABI defines, and template parameters are resolved
+ * against the template arguments of the function being parsed. The longest
+ * nested-name prefix free of substitution and template parameter references
+ * is kept in the memo cache together with the candidates it adds, so the next
+ * name sharing it skips parsing that prefix. Expressions are supported for
+ * the forms compilers emit in template arguments and decltype return types;
+ * other constructs (new-expressions, fold expressions, vendor qualifiers) make
+ * the name fail, and it is then printed as it is, like c++filt does for names
+ * it does not understand.
+ */
+
+#include "../inc_priv/demangle_priv.h"
+#include <string.h>  // For memcpy, memset, strlen
+
+#define DM_SUBS_MIN_CAP     32u  /**< Initial capacity of the substitution table */
+#define DM_NUMBER_MAX       (1u << 30)  /**< Largest number accepted in a name */
+
+#define DM_IS_DIGIT(c)  (((c) >= '0') && ((c) <= '9'))
+#define DM_IS_UPPER(c)  (((c) >= 'A') && ((c) <= 'Z'))
+#define DM_IS_LOWER(c)  (((c) >= 'a') && ((c) <= 'z'))
+
+/**
+ * @brief Text of a builtin or operator code
+ */
+typedef struct dm_code_s
+{
+    const char *code;  /**< Mangled code */
+    const char *text;  /**< Demangled text */
+} dm_code_t;
+
+/**
+ * @brief Standard substitution (Sa, Sb, Ss, Si, So, Sd)
+ */
+typedef struct dm_std_sub_s
+{
+    char code;             /**< Character following S */
+    const char *simple;    /**< Text of the abbreviation */
+    const char *full;      /**< Text used before a constructor or destructor */
+    const char *base;      /**< Base name of constructors */
+} dm_std_sub_t;
+
+/**
+ * @brief Information about the name of an encoding
+ */
+typedef struct dm_name_info_s
+{
+    uint8_t quals;  /**< Qualifiers of a member function */
+} dm_name_info_t;
+
+/**
+ * @brief Growable list of nodes in the scratch arena
+ */
+typedef struct dm_vec_s
+{
+    dm_node_t **items;  /**< Nodes */
+    size_t len;         /**< Number of nodes */
+    size_t cap;         /**< Capacity of items */
+} dm_vec_t;
+
+// Builtin types by their one letter code, indexed by letter - 'a'
+static const char *const g_builtins[26] = {
+    "signed char", "bool", "char", "double", "long double", "float", "__float128", "unsigned char",
+    "int", "unsigned int", NULL, "long", "unsigned long", "__int128", "unsigned __int128", NULL,
+    NULL, NULL, "short", "unsigned short", NULL, "void", "wchar_t", "long long", "unsigned long long", "..."
+};
+
+// Builtin types with a two letter code starting with D
+static const dm_code_t g_builtins_d[] = {
+    {"Da", "auto"}, {"Dc", "decltype(auto)"}, {"Dd", "decimal64"}, {"De", "decimal128"},
+    {"Df", "decimal32"}, {"Dh", "half"}, {"Di", "char32_t"}, {"Dn", "decltype(nullptr)"},
+    {"Ds", "char16_t"}, {"Du", "char8_t"}
+};
+
+// Operator names
+static const dm_code_t g_operators[] = {
+    {"aN", "operator&="}, {"aS", "operator="}, {"aa", "operator&&"}, {"ad", "operator&"},
+    {"an", "operator&"}, {"aw", "operator co_await"}, {"cl", "operator()"}, {"cm", "operator,"},
+    {"co", "operator~"}, {"dV", "operator/="}, {"da", "operator delete[]"}, {"de", "operator*"},
+    {"dl", "operator delete"}, {"dt", "operator."}, {"dv", "operator/"}, {"eO", "operator^="},
+    {"eo", "operator^"}, {"eq", "operator=="}, {"ge", "operator>="}, {"gt", "operator>"},
+    {"ix", "operator[]"}, {"lS", "operator<<="}, {"le", "operator<="}, {"ls", "operator<<"},
+    {"lt", "operator<"}, {"mI", "operator-="}, {"mL", "operator*="}, {"mi", "operator-"},
+    {"ml", "operator*"}, {"mm", "operator--"}, {"na", "operator new[]"}, {"ne", "operator!="},
+    {"ng", "operator-"}, {"nt", "operator!"}, {"nw", "operator new"}, {"oR", "operator|="},
+    {"oo", "operator||"}, {"or", "operator|"}, {"pL", "operator+="}, {"pl", "operator+"},
+    {"pm", "operator->*"}, {"pp", "operator++"}, {"ps", "operator+"}, {"pt", "operator->"},
+    {"qu", "operator?"}, {"rM", "operator%="}, {"rS", "operator>>="}, {"rm", "operator%"},
+    {"rs", "operator>>"}, {"ss", "operator<=>"}
+};
+
+// Operators of expressions, spelled like c++filt; pp and mm are prefix when followed by '_'
+static const dm_code_t g_unary_ops[] = {
+    {"ad", "&"}, {"az", "alignof "}, {"co", "~"}, {"de", "*"}, {"mm", "--"}, {"ng", "-"},
+    {"nt", "!"}, {"nx", "noexcept"}, {"pp", "++"}, {"ps", "+"}, {"sz", "sizeof "}, {"tw", "throw "}
+};
+
+static const dm_code_t g_binary_ops[] = {
+    {"aN", "&="}, {"aS", "="}, {"aa", "&&"}, {"an", "&"}, {"cm", ","}, {"dV", "/="}, {"dt", "."},
+    {"dv", "/"}, {"eO", "^="}, {"eo", "^"}, {"eq", "=="}, {"ge", ">="}, {"gt", ">"}, {"ix", "["},
+    {"lS", "<<="}, {"le", "<="}, {"ls", "<<"}, {"lt", "<"}, {"mI", "-="}, {"mL", "*="}, {"mi", "-"},
+    {"ml", "*"}, {"ne", "!="}, {"oR", "|="}, {"oo", "||"}, {"or", "|"}, {"pL", "+="}, {"pl", "+"},
+    {"pm", "->*"}, {"pt", "->"}, {"rM", "%="}, {"rS", ">>="}, {"rm", "%"}, {"rs", ">>"}, {"ss", "<=>"}
+};
+
+static const dm_code_t g_named_casts[] = {
+    {"cc", "const_cast"}, {"dc", "dynamic_cast"}, {"rc", "reinterpret_cast"}, {"sc", "static_cast"}
+};
+
+// Standard substitutions
+static const dm_std_sub_t g_std_subs[] = {
+    {'a', "std::allocator", "std::allocator", "allocator"},
+    {'b', "std::basic_string", "std::basic_string", "basic_string"},
+    {'s', "std::string", "std::basic_string<char, std::char_traits<char>, std::allocator<char> >", "basic_string"},
+    {'i', "std::istream", "std::basic_istream<char, std::char_traits<char> >", "basic_istream"},
+    {'o', "std::ostream", "std::basic_ostream<char, std::char_traits<char> >", "basic_ostream"},
+    {'d', "std::iostream", "std::basic_iostream<char, std::char_traits<char> >", "basic_iostream"}
+};
+
+static dm_node_t *parse_type(dm_parser_t *p);
+static dm_node_t *parse_name(dm_parser_t *p, dm_name_info_t *info);
+static dm_node_t *parse_encoding(dm_parser_t *p);
+static int parse_isCtorDtorConv(const dm_node_t *node);
+static dm_node_t *parse_templateArg(dm_parser_t *p, size_t idx);
+static dm_node_t *parse_expression(dm_parser_t *p);
+
+/**
+ * @brief Returns the character at an offset from the current position
+ * @param[in] p Parser state
+ * @param[in] off Offset from the current position
+ * @return char Character, or '\0' past the end of the name
+ */
+static char parse_peek(const dm_parser_t *p, size_t off)
+{
+    return (off < (size_t)(p->end - p->cur)) ? p->cur[off] : '\0';
+}
+
+/**
+ * @brief Consumes a character if it is the next one
+ * @param[in,out] p Parser state
+ * @param[in] c Expected character
+ * @return int Non-zero if the character was consumed
+ */
+static int parse_eat(dm_parser_t *p, char c)
+{
+    if ((p->cur < p->end) && (*p->cur == c))
+    {
+        p->cur++;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Allocates a zeroed node
+ * @param[in,out] p Parser state
+ * @param[in] kind Node kind
+ * @return dm_node_t* New node, or NULL on failure
+ */
+static dm_node_t *parse_node(dm_parser_t *p, dm_node_kind_e kind)
+{
+    dm_node_t *node = Demangle_Arena_alloc(p->arena, sizeof(dm_node_t));
+
+    if (node == NULL)
+    {
+        p->nomem = 1;
+        return NULL;
+    }
+    memset(node, 0, sizeof(dm_node_t));
+    node->kind = (uint8_t)kind;
+    return node;
+}
+
+/**
+ * @brief Allocates a node with text
+ * @param[in,out] p Parser state
+ * @param[in] kind Node kind
+ * @param[in] text Text, must outlive the parse
+ * @param[in] len Length of text
+ * @return dm_node_t* New node, or NULL on failure
+ */
+static dm_node_t *parse_textNode(dm_parser_t *p, dm_node_kind_e kind, const char *text, size_t len)
+{
+    dm_node_t *node = parse_node(p, kind);
+
+    if (node != NULL)
+    {
+        node->text = text;
+        node->len = len;
+    }
+    return node;
+}
+
+/**
+ * @brief Allocates a node with up to two children
+ * @param[in,out] p Parser state
+ * @param[in] kind Node kind
+ * @param[in] a First child, NULL fails the parse
+ * @param[in] b Second child
+ * @return dm_node_t* New node, or NULL on failure
+ */
+static dm_node_t *parse_pairNode(dm_parser_t *p, dm_node_kind_e kind, dm_node_t *a, dm_node_t *b)
+{
+    dm_node_t *node;
+
+    if (a == NULL)
+    {
+        return NULL;
+    }
+    node = parse_node(p, kind);
+    if (node != NULL)
+    {
+        node->a = a;
+        node->b = b;
+    }
+    return node;
+}
+
+/**
+ * @brief Concatenates strings into the scratch arena
+ * @param[in,out] p Parser state
+ * @param[in] s1 First string
+ * @param[in] l1 Length of s1
+ * @param[in] s2 Second string
+ * @param[in] l2 Length of s2
+ * @param[out] len Length of the result
+ * @return const char* Result, or NULL on failure
+ */
+static const char *parse_concat(dm_parser_t *p, const char *s1, size_t l1, const char *s2, size_t l2, size_t *len)
+{
+    char *str = Demangle_Arena_alloc(p->arena, l1 + l2 + 1);
+
+    if (str == NULL)
+    {
+        p->nomem = 1;
+        return NULL;
+    }
+    memcpy(str, s1, l1);
+    memcpy(&str[l1], s2, l2);
+    str[l1 + l2] = '\0';
+    *len = l1 + l2;
+    return str;
+}
+
+/**
+ * @brief Appends a node to a list
+ * @param[in,out] p Parser state
+ * @param[in,out] vec List to append to
+ * @param[in] node Node to append, NULL fails
+ * @return int Non-zero on success
+ */
+static int parse_vecPush(dm_parser_t *p, dm_vec_t *vec, dm_node_t *node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    if (vec->len == vec->cap)
+    {
+        size_t cap = (vec->cap != 0) ? (vec->cap * 2) : 4u;
+        dm_node_t **items = Demangle_Arena_alloc(p->arena, cap * sizeof(dm_node_t *));
+        if (items == NULL)
+        {
+            p->nomem = 1;
+            return 0;
+        }
+        if (vec->len != 0)
+        {
+            memcpy(items, vec->items, vec->len * sizeof(dm_node_t *));
+        }
+        vec->items = items;
+        vec->cap = cap;
+    }
+    vec->items[vec->len++] = node;
+    return 1;
+}
+
+/**
+ * @brief Adds a substitution candidate
+ * @param[in,out] p Parser state
+ * @param[in] node Candidate, NULL fails
+ * @return int Non-zero on success
+ */
+static int parse_subAdd(dm_parser_t *p, dm_node_t *node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    if (p->sub_len == p->sub_cap)
+    {
+        size_t cap = (p->sub_cap != 0) ? (p->sub_cap * 2) : DM_SUBS_MIN_CAP;
+        dm_node_t **subs = Demangle_Arena_alloc(p->arena, cap * sizeof(dm_node_t *));
+        if (subs == NULL)
+        {
+            p->nomem = 1;
+            return 0;
+        }
+        if (p->sub_len != 0)
+        {
+            memcpy(subs, p->subs, p->sub_len * sizeof(dm_node_t *));
+        }
+        p->subs = subs;
+        p->sub_cap = cap;
+    }
+    p->subs[p->sub_len++] = node;
+    return 1;
+}
+
+/**
+ * @brief Parses a non-negative decimal number
+ * @param[in,out] p Parser state
+ * @param[out] value Parsed number
+ * @return int Non-zero if a number was parsed
+ */
+static int parse_number(dm_parser_t *p, size_t *value)
+{
+    size_t num = 0;
+
+    if (!DM_IS_DIGIT(parse_peek(p, 0)))
+    {
+        return 0;
+    }
+    while (DM_IS_DIGIT(parse_peek(p, 0)))
+    {
+        num = num * 10 + (size_t)(*p->cur - '0');
+        if (num > DM_NUMBER_MAX)
+        {
+            return 0;  // Longer than any name
+        }
+        p->cur++;
+    }
+    *value = num;
+    return 1;
+}
+
+/**
+ * @brief Parses an optional number followed by '_', as in T_, S_ and Ut_
+ * @param[in,out] p Parser state
+ * @param[in] base Base of the number, 10 or 36
+ * @param[out] value 0 for a lone '_', otherwise the number plus one
+ * @return int Non-zero on success
+ */
+static int parse_seqId(dm_parser_t *p, unsigned int base, size_t *value)
+{
+    size_t num = 0;
+
+    if (parse_eat(p, '_'))
+    {
+        *value = 0;
+        return 1;
+    }
+    while ((p->cur < p->end) && (*p->cur != '_'))
+    {
+        char c = *p->cur++;
+        if (DM_IS_DIGIT(c))
+        {
+            num = num * base + (size_t)(c - '0');
+        }
+        else if ((base == 36) && DM_IS_UPPER(c))
+        {
+            num = num * base + (size_t)(c - 'A' + 10);
+        }
+        else
+        {
+            return 0;
+        }
+        if (num > DM_NUMBER_MAX)
+        {
+            return 0;
+        }
+    }
+    if (!parse_eat(p, '_'))
+    {
+        return 0;
+    }
+    *value = num + 1;
+    return 1;
+}
+
+/**
+ * @brief Skips a discriminator of a local entity (_N or __N_)
+ * @param[in,out] p Parser state
+ */
+static void parse_discriminator(dm_parser_t *p)
+{
+    size_t num;
+
+    if (parse_peek(p, 0) != '_')
+    {
+        return;
+    }
+    if (DM_IS_DIGIT(parse_peek(p, 1)))
+    {
+        p->cur += 2;
+    }
+    else if ((parse_peek(p, 1) == '_') && DM_IS_DIGIT(parse_peek(p, 2)))
+    {
+        p->cur += 2;
+        parse_number(p, &num);
+        parse_eat(p, '_');
+    }
+}
+
+/**
+ * @brief Allocates a NAME node numbering an entity, e.g. "{parm#2}"
+ * @param[in,out] p Parser state
+ * @param[in] prefix Text before the number
+ * @param[in] prefix_len Length of prefix
+ * @param[in] num Number, printed in decimal followed by '}'
+ * @return dm_node_t* New node, or NULL on failure
+ */
+static dm_node_t *parse_numberedName(dm_parser_t *p, const char *prefix, size_t prefix_len, size_t num)
+{
+    char num_buf[24];
+    size_t num_len = 0;
+    const char *text;
+    size_t len;
+
+    do
+    {
+        num_buf[sizeof(num_buf) - 1 - num_len++] = (char)('0' + (num % 10));
+        num /= 10;
+    } while (num != 0);
+    text = parse_concat(p, prefix, prefix_len, &num_buf[sizeof(num_buf) - num_len], num_len, &len);
+    text = (text != NULL) ? parse_concat(p, text, len, "}", 1, &len) : NULL;
+    return (text != NULL) ? parse_textNode(p, DM_NODE_NAME, text, len) : NULL;
+}
+
+/**
+ * @brief Parses CV qualifiers (r V K)
+ * @param[in,out] p Parser state
+ * @return uint8_t DM_QUAL_* bits
+ */
+static uint8_t parse_cvQuals(dm_parser_t *p)
+{
+    uint8_t quals = 0;
+
+    if (parse_eat(p, 'r'))
+    {
+        quals |= DM_QUAL_RESTRICT;
+    }
+    if (parse_eat(p, 'V'))
+    {
+        quals |= DM_QUAL_VOLATILE;
+    }
+    if (parse_eat(p, 'K'))
+    {
+        quals |= DM_QUAL_CONST;
+    }
+    return quals;
+}
+
+/**
+ * @brief Parses a source name (<length> <identifier>)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* NAME node, or NULL on failure
+ */
+static dm_node_t *parse_sourceName(dm_parser_t *p)
+{
+    static const char anon[] = "(anonymous namespace)";
+    const char *text;
+    size_t len;
+    dm_node_t *node;
+
+    if (!parse_number(p, &len) || (len == 0) || (len > (size_t)(p->end - p->cur)))
+    {
+        return NULL;
+    }
+    text = p->cur;
+    p->cur += len;
+    if ((len >= 10) && (memcmp(text, "_GLOBAL_", 8) == 0) &&
+        ((text[8] == '.') || (text[8] == '_') || (text[8] == '$')) && (text[9] == 'N'))
+    {
+        node = parse_textNode(p, DM_NODE_NAME, anon, sizeof(anon) - 1);
+    }
+    else
+    {
+        node = parse_textNode(p, DM_NODE_NAME, text, len);
+    }
+    p->last_simple = node;
+    return node;
+}
+
+/**
+ * @brief Parses a parameter list up to 'E', an empty list for a lone void
+ * @param[in,out] p Parser state
+ * @param[out] vec Parameter list
+ * @param[out] quals Reference qualifier of a function type, or NULL if not allowed
+ * @return int Non-zero on success
+ */
+static int parse_params(dm_parser_t *p, dm_vec_t *vec, uint8_t *quals)
+{
+    while (!parse_eat(p, 'E'))
+    {
+        if ((quals != NULL) && ((parse_peek(p, 0) == 'R') || (parse_peek(p, 0) == 'O')) && (parse_peek(p, 1) == 'E'))
+        {
+            *quals |= (parse_peek(p, 0) == 'R') ? DM_QUAL_LREF : DM_QUAL_RREF;
+            p->cur++;
+            continue;
+        }
+        if ((p->cur >= p->end) || !parse_vecPush(p, vec, parse_type(p)))
+        {
+            return 0;
+        }
+    }
+    if ((vec->len == 1) && (vec->items[0]->flags & DM_FLAG_VOID))
+    {
+        vec->len = 0;  // f(void) prints as f()
+    }
+    return 1;
+}
+
+/**
+ * @brief Parses a closure or unnamed type name (Ul...E_ / Ut_)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* LAMBDA or NAME node, or NULL on failure
+ */
+static dm_node_t *parse_unnamedType(dm_parser_t *p)
+{
+    static const char unnamed[] = "{unnamed type#";
+    char num_buf[24];
+    size_t num_len = 0;
+    size_t num;
+    dm_vec_t params = {0};
+    dm_node_t *node;
+    int lambda = (parse_peek(p, 1) == 'l');
+
+    p->cur += 2;
+    if (lambda && !parse_params(p, &params, NULL))
+    {
+        return NULL;
+    }
+    if (!parse_seqId(p, 10, &num))
+    {
+        return NULL;
+    }
+    num += 1;  // Numbered from 1
+    do
+    {
+        num_buf[sizeof(num_buf) - 1 - num_len++] = (char)('0' + (num % 10));
+        num /= 10;
+    } while (num != 0);
+    if (lambda)
+    {
+        const char *text = Demangle_Arena_strDup(p->arena, &num_buf[sizeof(num_buf) - num_len], num_len);
+        node = parse_node(p, DM_NODE_LAMBDA);
+        if ((node == NULL) || (text == NULL))
+        {
+            p->nomem = 1;
+            return NULL;
+        }
+        node->text = text;
+        node->len = num_len;
+        node->list = params.items;
+        node->list_len = params.len;
+    }
+    else
+    {
+        size_t len;
+        const char *text = parse_concat(p, unnamed, sizeof(unnamed) - 1, &num_buf[sizeof(num_buf) - num_len], num_len, &len);
+        text = (text != NULL) ? parse_concat(p, text, len, "}", 1, &len) : NULL;
+        node = (text != NULL) ? parse_textNode(p, DM_NODE_NAME, text, len) : NULL;
+        if (node != NULL)
+        {
+            node->flags |= DM_FLAG_UNNAMED;
+        }
+    }
+    return node;  // Constructors keep the name of the last source name
+}
+
+/**
+ * @brief Parses an operator name
+ * @param[in,out] p Parser state
+ * @return dm_node_t* NAME or CONVERSION node, or NULL on failure
+ */
+static dm_node_t *parse_operatorName(dm_parser_t *p)
+{
+    static const char literal[] = "operator\"\" ";
+    static const char vendor[] = "operator ";
+    char c0 = parse_peek(p, 0);
+    char c1 = parse_peek(p, 1);
+    dm_node_t *name;
+    const char *text;
+    size_t len;
+
+    p->cur += 2;
+    if ((c0 == 'c') && (c1 == 'v'))
+    {
+        return parse_pairNode(p, DM_NODE_CONVERSION, parse_type(p), NULL);
+    }
+    if (((c0 == 'l') && (c1 == 'i')) || ((c0 == 'v') && DM_IS_DIGIT(c1)))
+    {
+        name = parse_sourceName(p);
+        if (name == NULL)
+        {
+            return NULL;
+        }
+        text = (c0 == 'l') ? parse_concat(p, literal, sizeof(literal) - 1, name->text, name->len, &len)
+                           : parse_concat(p, vendor, sizeof(vendor) - 1, name->text, name->len, &len);
+        return (text != NULL) ? parse_textNode(p, DM_NODE_NAME, text, len) : NULL;
+    }
+    for (size_t i = 0; i < (sizeof(g_operators) / sizeof(g_operators[0])); i++)
+    {
+        if ((g_operators[i].code[0] == c0) && (g_operators[i].code[1] == c1))
+        {
+            return parse_textNode(p, DM_NODE_NAME, g_operators[i].text, strlen(g_operators[i].text));
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parses an unqualified name with its ABI tags
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Name node, or NULL on failure
+ */
+static dm_node_t *parse_unqualifiedName(dm_parser_t *p)
+{
+    char c = parse_peek(p, 0);
+    char c1 = parse_peek(p, 1);
+    dm_node_t *node = NULL;
+    dm_node_t *simple;
+
+    if (DM_IS_DIGIT(c))
+    {
+        node = parse_sourceName(p);
+    }
+    else if (DM_IS_LOWER(c))
+    {
+        node = parse_operatorName(p);
+    }
+    else if ((c == 'C') && (((c1 >= '1') && (c1 <= '5')) || ((c1 == 'I') && DM_IS_DIGIT(parse_peek(p, 2)))))
+    {
+        dm_node_t *base = p->last_simple;
+        p->cur += (c1 == 'I') ? 3 : 2;
+        if ((c1 == 'I') && (parse_type(p) == NULL))
+        {
+            return NULL;  // Inheriting constructor names its base type
+        }
+        node = parse_pairNode(p, DM_NODE_CTOR, base, NULL);
+    }
+    else if ((c == 'D') && (c1 >= '0') && (c1 <= '5'))
+    {
+        p->cur += 2;
+        node = parse_pairNode(p, DM_NODE_CTOR, p->last_simple, NULL);
+        if (node != NULL)
+        {
+            node->flags |= DM_FLAG_DTOR;
+        }
+    }
+    else if ((c == 'U') && ((c1 == 'l') || (c1 == 't')))
+    {
+        node = parse_unnamedType(p);
+    }
+    else if ((c == 'L') && DM_IS_DIGIT(c1))
+    {
+        p->cur++;
+        node = parse_sourceName(p);  // Internal linkage name
+        parse_discriminator(p);
+    }
+    // Attach ABI tags, which do not name a constructor
+    simple = p->last_simple;
+    while ((node != NULL) && parse_eat(p, 'B'))
+    {
+        dm_node_t *tag = parse_sourceName(p);
+        node = parse_pairNode(p, DM_NODE_ABI_TAG, node, NULL);
+        if ((tag == NULL) || (node == NULL))
+        {
+            return NULL;
+        }
+        node->text = tag->text;
+        node->len = tag->len;
+    }
+    p->last_simple = simple;
+    return node;
+}
+
+/**
+ * @brief Parses a substitution (S_, S<seq>_, St, Sa, Sb, Ss, Si, So, Sd)
+ * @param[in,out] p Parser state
+ * @param[in] prefix Non-zero inside a nested name, where a following
+ *                   constructor selects the full form of Ss, Si, So and Sd
+ * @return dm_node_t* Substituted node, or NULL on failure
+ */
+static dm_node_t *parse_substitution(dm_parser_t *p, int prefix)
+{
+    char c;
+    size_t idx;
+
+    if (!parse_eat(p, 'S'))
+    {
+        return NULL;
+    }
+    c = parse_peek(p, 0);
+    if ((c == '_') || DM_IS_DIGIT(c) || DM_IS_UPPER(c))
+    {
+        if (!parse_seqId(p, 36, &idx) || (idx >= p->sub_len))
+        {
+            return NULL;
+        }
+        p->backrefs++;
+        if (p->subs[idx]->kind == DM_NODE_PARAM)
+        {
+            // Like c++filt, a template parameter means the argument of the current template
+            dm_node_t *arg = parse_templateArg(p, p->subs[idx]->len);
+            return (arg != NULL) ? arg : p->subs[idx]->a;
+        }
+        return p->subs[idx];
+    }
+    p->cur++;
+    if (c == 't')
+    {
+        return parse_textNode(p, DM_NODE_NAME, "std", 3);
+    }
+    for (size_t i = 0; i < (sizeof(g_std_subs) / sizeof(g_std_subs[0])); i++)
+    {
+        if (g_std_subs[i].code == c)
+        {
+            char next = parse_peek(p, 0);
+            const char *text = (prefix && ((next == 'C') || (next == 'D'))) ? g_std_subs[i].full : g_std_subs[i].simple;
+            dm_node_t *node = parse_textNode(p, DM_NODE_TEXT, text, strlen(text));
+            dm_node_t *base = parse_textNode(p, DM_NODE_NAME, g_std_subs[i].base, strlen(g_std_subs[i].base));
+            if ((node == NULL) || (base == NULL))
+            {
+                return NULL;
+            }
+            node->rtext = "";
+            node->c = base;
+            p->last_simple = base;
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Looks up a template argument of the innermost template function
+ * @param[in,out] p Parser state
+ * @param[in] idx Argument index
+ * @return dm_node_t* Argument, a PACK_REF node for an argument pack, or NULL if there is none
+ */
+static dm_node_t *parse_templateArg(dm_parser_t *p, size_t idx)
+{
+    dm_node_t *arg;
+
+    if ((p->tmpl_args == NULL) || (idx >= p->tmpl_args->list_len))
+    {
+        return NULL;  // Forward reference, e.g. from a templated conversion operator
+    }
+    arg = p->tmpl_args->list[idx];
+    if ((arg->kind == DM_NODE_ARGS) && (arg->flags & DM_FLAG_PACK))
+    {
+        arg = parse_pairNode(p, DM_NODE_PACK_REF, arg, NULL);  // Expanded by an enclosing Dp
+    }
+    return arg;
+}
+
+/**
+ * @brief Parses a template parameter reference (T_, T<n>_)
+ * @param[in,out] p Parser state
+ * @param[out] idx Parameter index
+ * @return dm_node_t* Referenced template argument, or NULL on failure
+ */
+static dm_node_t *parse_templateParam(dm_parser_t *p, size_t *idx)
+{
+    if (!parse_eat(p, 'T') || !parse_seqId(p, 10, idx))
+    {
+        return NULL;
+    }
+    p->backrefs++;
+    return parse_templateArg(p, *idx);
+}
+
+/**
+ * @brief Parses a literal (L <type> <value> E, L_Z <encoding> E)
+ * @param[in,out] p Parser state, positioned after 'L'
+ * @return dm_node_t* Literal node, or NULL on failure
+ */
+static dm_node_t *parse_literal(dm_parser_t *p)
+{
+    static const dm_code_t suffixes[] = {
+        {"i", ""}, {"j", "u"}, {"l", "l"}, {"m", "ul"}, {"x", "ll"}, {"y", "ull"}
+    };
+    const char *suffix = NULL;
+    const char *value;
+    dm_node_t *type = NULL;
+    dm_node_t *node;
+    int negative;
+
+    if ((parse_peek(p, 0) == '_') && (parse_peek(p, 1) == 'Z'))
+    {
+        p->cur += 2;
+        node = parse_encoding(p);
+        return parse_eat(p, 'E') ? node : NULL;
+    }
+    for (size_t i = 0; i < (sizeof(suffixes) / sizeof(suffixes[0])); i++)
+    {
+        if (parse_peek(p, 0) == suffixes[i].code[0])
+        {
+            suffix = suffixes[i].text;
+            p->cur++;
+            break;
+        }
+    }
+    if ((suffix == NULL) && (parse_peek(p, 0) != 'b'))
+    {
+        type = parse_type(p);
+        if (type == NULL)
+        {
+            return NULL;
+        }
+    }
+    else if (suffix == NULL)
+    {
+        p->cur++;  // bool
+    }
+    negative = parse_eat(p, 'n');
+    value = p->cur;
+    while ((p->cur < p->end) && (*p->cur != 'E'))
+    {
+        p->cur++;
+    }
+    if (!parse_eat(p, 'E'))
+    {
+        return NULL;
+    }
+    if ((suffix == NULL) && (type == NULL))
+    {
+        // bool prints as true/false, other values as a cast
+        if (!negative && ((p->cur - value) == 2) && ((*value == '0') || (*value == '1')))
+        {
+            return (*value == '1') ? parse_textNode(p, DM_NODE_NAME, "true", 4) : parse_textNode(p, DM_NODE_NAME, "false", 5);
+        }
+        type = parse_textNode(p, DM_NODE_NAME, "bool", 4);
+        if (type == NULL)
+        {
+            return NULL;
+        }
+    }
+    node = parse_node(p, DM_NODE_LITERAL);
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    node->a = type;
+    node->flags |= negative ? DM_FLAG_NEGATIVE : 0;
+    if (suffix != NULL)
+    {
+        node->text = parse_concat(p, value, (size_t)(p->cur - 1 - value), suffix, strlen(suffix), &node->len);
+        return (node->text != NULL) ? node : NULL;
+    }
+    node->text = value;
+    node->len = (size_t)(p->cur - 1 - value);
+    return node;
+}
+
+/**
+ * @brief Parses template arguments (I <arg>+ E)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* ARGS node, or NULL on failure
+ */
+static dm_node_t *parse_templateArgs(dm_parser_t *p)
+{
+    dm_node_t *saved_simple = p->last_simple;  // Arguments do not name a constructor
+    dm_vec_t args = {0};
+    dm_node_t *node;
+
+    if (!parse_eat(p, 'I') && !parse_eat(p, 'J'))
+    {
+        return NULL;
+    }
+    while (!parse_eat(p, 'E'))
+    {
+        char c = parse_peek(p, 0);
+        dm_node_t *arg;
+        if (c == 'L')
+        {
+            p->cur++;
+            arg = parse_literal(p);
+        }
+        else if ((c == 'J') || (c == 'I'))  // I...E is the pack of older compilers
+        {
+            arg = parse_templateArgs(p);
+            if (arg != NULL)
+            {
+                arg->flags |= DM_FLAG_PACK;
+            }
+        }
+        else if (c == 'X')
+        {
+            p->cur++;
+            arg = parse_expression(p);
+            arg = parse_eat(p, 'E') ? arg : NULL;
+        }
+        else if (c == '\0')
+        {
+            arg = NULL;
+        }
+        else
+        {
+            arg = parse_type(p);
+        }
+        if (!parse_vecPush(p, &args, arg))
+        {
+            return NULL;
+        }
+    }
+    p->last_simple = saved_simple;
+    node = parse_node(p, DM_NODE_ARGS);
+    if (node != NULL)
+    {
+        node->list = args.items;
+        node->list_len = args.len;
+    }
+    return node;
+}
+
+/**
+ * @brief Finds a two letter code in a table
+ * @param[in] table Codes and their text
+ * @param[in] len Number of entries
+ * @param[in] c0 First letter
+ * @param[in] c1 Second letter
+ * @return const char* Text of the code, or NULL if it is not in the table
+ */
+static const char *parse_codeFind(const dm_code_t *table, size_t len, char c0, char c1)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if ((table[i].code[0] == c0) && (table[i].code[1] == c1))
+        {
+            return table[i].text;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parenthesizes an operand the way c++filt does, leaving names bare
+ * @param[in,out] p Parser state
+ * @param[in] node Operand, NULL fails
+ * @return dm_node_t* Operand or PAREN node, or NULL on failure
+ */
+static dm_node_t *parse_operand(dm_parser_t *p, dm_node_t *node)
+{
+    if ((node != NULL) && ((node->kind == DM_NODE_NAME) || (node->kind == DM_NODE_QUAL)))
+    {
+        return node;
+    }
+    return parse_pairNode(p, DM_NODE_PAREN, node, NULL);
+}
+
+/**
+ * @brief Parses expressions up to 'E' into a list
+ * @param[in,out] p Parser state
+ * @param[out] vec Expression list
+ * @return int Non-zero on success
+ */
+static int parse_exprList(dm_parser_t *p, dm_vec_t *vec)
+{
+    while (!parse_eat(p, 'E'))
+    {
+        if (!parse_vecPush(p, vec, parse_expression(p)))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Parses an unqualified name used in an expression, with its template arguments
+ * @param[in,out] p Parser state
+ * @param[in] scope Qualifying scope, or NULL
+ * @return dm_node_t* Name node, or NULL on failure
+ */
+static dm_node_t *parse_exprName(dm_parser_t *p, dm_node_t *scope)
+{
+    dm_node_t *name;
+
+    if ((parse_peek(p, 0) == 'o') && (parse_peek(p, 1) == 'n'))
+    {
+        p->cur += 2;
+        name = parse_operatorName(p);
+    }
+    else
+    {
+        name = parse_sourceName(p);
+    }
+    if ((name != NULL) && (scope != NULL))
+    {
+        name = parse_pairNode(p, DM_NODE_QUAL, scope, name);
+    }
+    if ((name != NULL) && (parse_peek(p, 0) == 'I'))
+    {
+        name = parse_pairNode(p, DM_NODE_TEMPLATE, name, parse_templateArgs(p));
+        if ((name != NULL) && (name->b == NULL))
+        {
+            return NULL;
+        }
+    }
+    return name;
+}
+
+/**
+ * @brief Parses an unresolved name (sr <type> <name>, sr <qualifier>+ E <name>)
+ * @param[in,out] p Parser state, positioned after "sr"
+ * @return dm_node_t* Name node, or NULL on failure
+ */
+static dm_node_t *parse_unresolvedName(dm_parser_t *p)
+{
+    dm_node_t *scope = NULL;
+
+    if (DM_IS_DIGIT(parse_peek(p, 0)))
+    {
+        while (!parse_eat(p, 'E'))
+        {
+            scope = parse_exprName(p, scope);  // Qualifier levels are not candidates
+            if (scope == NULL)
+            {
+                return NULL;
+            }
+        }
+    }
+    else
+    {
+        scope = parse_type(p);
+        if (scope == NULL)
+        {
+            return NULL;
+        }
+    }
+    return parse_exprName(p, scope);
+}
+
+/**
+ * @brief Parses a function parameter reference (fp_, fp<n>_, fpT)
+ * @param[in,out] p Parser state, positioned after "fp"
+ * @return dm_node_t* NAME node, or NULL on failure
+ */
+static dm_node_t *parse_functionParam(dm_parser_t *p)
+{
+    static const char parm[] = "{parm#";
+    size_t num;
+
+    if (parse_eat(p, 'T'))
+    {
+        return parse_textNode(p, DM_NODE_NAME, "this", 4);
+    }
+    parse_cvQuals(p);
+    if (!parse_seqId(p, 10, &num))
+    {
+        return NULL;
+    }
+    return parse_numberedName(p, parm, sizeof(parm) - 1, num + 1);  // Numbered from 1
+}
+
+/**
+ * @brief Parses an operator expression
+ * @param[in,out] p Parser state, positioned on the operator code
+ * @return dm_node_t* Expression node, or NULL on failure or an unsupported operator
+ */
+static dm_node_t *parse_operatorExpr(dm_parser_t *p)
+{
+    char c0 = parse_peek(p, 0);
+    char c1 = parse_peek(p, 1);
+    const char *text;
+    dm_node_t *node;
+    dm_node_t *arg;
+
+    p->cur += 2;
+    if (((c0 == 's') || (c0 == 'a')) && (c1 == 't'))
+    {
+        // sizeof (type), alignof (type)
+        node = parse_textNode(p, DM_NODE_UNARY, (c0 == 's') ? "sizeof " : "alignof ", (c0 == 's') ? 7 : 8);
+        if (node != NULL)
+        {
+            node->a = parse_pairNode(p, DM_NODE_PAREN, parse_type(p), NULL);
+        }
+        return ((node != NULL) && (node->a != NULL)) ? node : NULL;
+    }
+    if ((c0 == 'c') && (c1 == 'l'))
+    {
+        dm_vec_t args = {0};
+        arg = parse_expression(p);
+        if ((arg != NULL) && (arg->kind == DM_NODE_ENCODING))
+        {
+            arg = arg->a;  // A called function prints without its parameter types
+        }
+        node = parse_pairNode(p, DM_NODE_CALL, parse_operand(p, arg), NULL);
+        if ((node == NULL) || !parse_exprList(p, &args))
+        {
+            return NULL;
+        }
+        node->list = args.items;
+        node->list_len = args.len;
+        return node;
+    }
+    if ((c0 == 'c') && (c1 == 'v'))
+    {
+        node = parse_pairNode(p, DM_NODE_CAST, parse_type(p), NULL);
+        if ((node != NULL) && parse_eat(p, '_'))
+        {
+            dm_vec_t args = {0};
+            node->b = parse_node(p, DM_NODE_ARGS);
+            if ((node->b == NULL) || !parse_exprList(p, &args))
+            {
+                return NULL;
+            }
+            node->b->list = args.items;
+            node->b->list_len = args.len;
+            node->b = parse_pairNode(p, DM_NODE_PAREN, node->b, NULL);
+        }
+        else if (node != NULL)
+        {
+            node->b = parse_operand(p, parse_expression(p));
+        }
+        return ((node != NULL) && (node->b != NULL)) ? node : NULL;
+    }
+    text = parse_codeFind(g_named_casts, sizeof(g_named_casts) / sizeof(g_named_casts[0]), c0, c1);
+    if (text != NULL)
+    {
+        node = parse_pairNode(p, DM_NODE_CAST, parse_type(p), NULL);
+        if (node != NULL)
+        {
+            node->text = text;
+            node->len = strlen(text);
+            node->b = parse_expression(p);
+        }
+        return ((node != NULL) && (node->b != NULL)) ? node : NULL;
+    }
+    if ((c0 == 'q') && (c1 == 'u'))
+    {
+        node = parse_pairNode(p, DM_NODE_TRINARY, parse_operand(p, parse_expression(p)), NULL);
+        if (node != NULL)
+        {
+            node->b = parse_operand(p, parse_expression(p));
+            node->c = (node->b != NULL) ? parse_operand(p, parse_expression(p)) : NULL;
+        }
+        return ((node != NULL) && (node->c != NULL)) ? node : NULL;
+    }
+    if ((c0 == 't') && (c1 == 'r'))
+    {
+        return parse_textNode(p, DM_NODE_NAME, "throw", 5);
+    }
+    text = parse_codeFind(g_unary_ops, sizeof(g_unary_ops) / sizeof(g_unary_ops[0]), c0, c1);
+    if (text != NULL)
+    {
+        if ((c0 == c1) && !parse_eat(p, '_'))
+        {
+            // Postfix increment and decrement
+            node = parse_pairNode(p, DM_NODE_BINARY, parse_operand(p, parse_expression(p)), NULL);
+            if (node != NULL)
+            {
+                node->text = text;
+                node->len = strlen(text);
+            }
+            return node;
+        }
+        arg = parse_expression(p);
+        if ((c0 == 'a') && (c1 == 'd') && (arg != NULL) && (arg->kind == DM_NODE_ENCODING) &&
+            (arg->a->kind == DM_NODE_QUAL))
+        {
+            arg = arg->a;  // Address of a member function prints without its parameter types
+        }
+        node = parse_pairNode(p, DM_NODE_UNARY, parse_operand(p, arg), NULL);
+        if (node != NULL)
+        {
+            node->text = text;
+            node->len = strlen(text);
+        }
+        return node;
+    }
+    text = parse_codeFind(g_binary_ops, sizeof(g_binary_ops) / sizeof(g_binary_ops[0]), c0, c1);
+    if (text == NULL)
+    {
+        return NULL;  // Not supported
+    }
+    node = parse_pairNode(p, DM_NODE_BINARY, parse_operand(p, parse_expression(p)), NULL);
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    node->text = text;
+    node->len = strlen(text);
+    if ((c0 == 'i') && (c1 == 'x'))
+    {
+        node->b = parse_expression(p);
+        node->rtext = "]";
+        node->rlen = 1;
+    }
+    else if (((c0 == 'd') || (c0 == 'p')) && (c1 == 't') && DM_IS_DIGIT(parse_peek(p, 0)))
+    {
+        node->b = parse_operand(p, parse_exprName(p, NULL));  // Member name
+    }
+    else
+    {
+        node->b = parse_operand(p, parse_expression(p));
+    }
+    if (node->b == NULL)
+    {
+        return NULL;
+    }
+    if ((c0 == 'g') && (c1 == 't'))
+    {
+        node = parse_pairNode(p, DM_NODE_PAREN, node, NULL);  // Kept apart from the closing '>' of template arguments
+    }
+    return node;
+}
+
+/**
+ * @brief Parses an expression
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Expression node, or NULL on failure or an unsupported expression
+ */
+static dm_node_t *parse_expressionInner(dm_parser_t *p)
+{
+    char c0 = parse_peek(p, 0);
+    char c1 = parse_peek(p, 1);
+    size_t idx;
+
+    if (c0 == 'L')
+    {
+        p->cur++;
+        return parse_literal(p);
+    }
+    if (c0 == 'T')
+    {
+        return parse_pairNode(p, DM_NODE_PARAM, parse_templateParam(p, &idx), NULL);  // Parenthesized as an operand
+    }
+    if (DM_IS_DIGIT(c0) || ((c0 == 'o') && (c1 == 'n')))
+    {
+        return parse_exprName(p, NULL);
+    }
+    if ((c0 == 's') && (c1 == 'r'))
+    {
+        p->cur += 2;
+        return parse_unresolvedName(p);
+    }
+    if ((c0 == 'f') && (c1 == 'p'))
+    {
+        p->cur += 2;
+        return parse_functionParam(p);
+    }
+    if (DM_IS_LOWER(c0) && (DM_IS_LOWER(c1) || DM_IS_UPPER(c1)))
+    {
+        return parse_operatorExpr(p);
+    }
+    return NULL;  // Not supported
+}
+
+/**
+ * @brief Parses an expression, bounding the recursion depth
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Expression node, or NULL on failure
+ */
+static dm_node_t *parse_expression(dm_parser_t *p)
+{
+    dm_node_t *saved_simple = p->last_simple;  // Expressions do not name a constructor
+    dm_node_t *node;
+
+    if (++p->depth > DM_DEPTH_MAX)
+    {
+        return NULL;
+    }
+    node = parse_expressionInner(p);
+    p->depth--;
+    p->last_simple = saved_simple;
+    return node;
+}
+
+/**
+ * @brief Wraps a name in a TEMPLATE node with the following template arguments
+ * @param[in,out] p Parser state
+ * @param[in] name Template name
+ * @param[in] info Encoding information, non-NULL if the arguments are the ones T_ refers to
+ * @return dm_node_t* TEMPLATE node, or NULL on failure
+ */
+static dm_node_t *parse_templateId(dm_parser_t *p, dm_node_t *name, const dm_name_info_t *info)
+{
+    dm_node_t *args = parse_templateArgs(p);
+    dm_node_t *node = parse_pairNode(p, DM_NODE_TEMPLATE, (args != NULL) ? name : NULL, args);
+
+    if ((node != NULL) && (info != NULL))
+    {
+        p->tmpl_args = args;
+    }
+    return node;
+}
+
+/**
+ * @brief Replays a cached nested-name prefix
+ * @param[in,out] p Parser state
+ * @param[in] entry Cached prefix
+ * @return dm_node_t* TEXT node of the prefix, or NULL on failure
+ */
+static dm_node_t *parse_prefixReplay(dm_parser_t *p, const dm_cache_entry_t *entry)
+{
+    dm_node_t *node = NULL;
+
+    for (size_t i = 0; i < entry->sub_cnt; i++)
+    {
+        const dm_cache_sub_t *sub = &entry->subs[i];
+        node = parse_textNode(p, DM_NODE_TEXT, sub->left, sub->left_len);
+        if (node == NULL)
+        {
+            return NULL;
+        }
+        node->rtext = sub->right;
+        node->rlen = sub->right_len;
+        node->flags = sub->flags;
+        node->c = parse_textNode(p, DM_NODE_NAME, sub->simple, sub->simple_len);
+        if (!parse_subAdd(p, node))
+        {
+            return NULL;
+        }
+    }
+    if (node != NULL)
+    {
+        p->last_simple = node->c;
+    }
+    p->cur += entry->key_len;
+    return node;
+}
+
+/**
+ * @brief Parses a nested name (N [quals] <prefix> <unqualified-name> E)
+ * @param[in,out] p Parser state
+ * @param[out] info Encoding information, or NULL if not the name of an encoding
+ * @return dm_node_t* Name node, or NULL on failure
+ */
+static dm_node_t *parse_nestedName(dm_parser_t *p, dm_name_info_t *info)
+{
+    const dm_cache_entry_t *hit = NULL;
+    const char *start;
+    const char *cand_end = NULL;
+    size_t sub_start;
+    size_t cand_subs = 0;
+    unsigned int backrefs_start;
+    unsigned int cand_backrefs = 0;
+    dm_node_t *ret = NULL;
+    uint8_t quals;
+
+    p->cur++;  // N
+    quals = parse_cvQuals(p);
+    if (parse_eat(p, 'R'))
+    {
+        quals |= DM_QUAL_LREF;
+    }
+    else if (parse_eat(p, 'O'))
+    {
+        quals |= DM_QUAL_RREF;
+    }
+    if (info != NULL)
+    {
+        info->quals = quals;
+    }
+    start = p->cur;
+    sub_start = p->sub_len;
+    backrefs_start = p->backrefs;
+
+    // Replay the longest cached prefix, unless it is the whole name or its last component goes on with ABI tags
+    if (p->cache != NULL)
+    {
+        hit = Demangle_Cache_prefixFind(p->cache, p->cur, (size_t)(p->end - p->cur));
+        if ((hit != NULL) && (parse_peek(p, hit->key_len) != 'E') && (parse_peek(p, hit->key_len) != '\0') &&
+            (parse_peek(p, hit->key_len) != 'B'))
+        {
+            ret = parse_prefixReplay(p, hit);
+            if (ret == NULL)
+            {
+                return NULL;
+            }
+            cand_end = p->cur;
+            cand_subs = p->sub_len;
+            cand_backrefs = p->backrefs;
+        }
+        else
+        {
+            hit = NULL;
+        }
+    }
+
+    while (!parse_eat(p, 'E'))
+    {
+        char c = parse_peek(p, 0);
+        if (c == 'S')
+        {
+            dm_node_t *comp;
+            if ((parse_peek(p, 1) == 't') && (ret == NULL))
+            {
+                p->cur += 2;
+                comp = parse_textNode(p, DM_NODE_NAME, "std", 3);
+            }
+            else
+            {
+                comp = parse_substitution(p, 1);
+            }
+            ret = (ret != NULL) ? parse_pairNode(p, DM_NODE_QUAL, ret, comp) : comp;
+            if ((comp == NULL) || (ret == NULL))
+            {
+                return NULL;
+            }
+            continue;  // A substitution is not a new candidate
+        }
+        if (c == 'M')
+        {
+            p->cur++;  // Data member prefix of a closure
+            if (ret == NULL)
+            {
+                return NULL;
+            }
+            continue;
+        }
+        if (c == 'I')
+        {
+            ret = (ret != NULL) ? parse_templateId(p, ret, NULL) : NULL;
+            if ((ret != NULL) && (info != NULL) && (parse_peek(p, 0) == 'E'))
+            {
+                p->tmpl_args = ret->b;  // Arguments of the function itself
+            }
+        }
+        else
+        {
+            size_t idx;
+            dm_node_t *comp = (c == 'T') ? parse_templateParam(p, &idx) : parse_unqualifiedName(p);
+            ret = (ret != NULL) ? parse_pairNode(p, DM_NODE_QUAL, ret, comp) : comp;
+            if (comp == NULL)
+            {
+                return NULL;
+            }
+        }
+        if (ret == NULL)
+        {
+            return NULL;
+        }
+        if (parse_peek(p, 0) != 'E')
+        {
+            if (!parse_subAdd(p, ret))
+            {
+                return NULL;
+            }
+            if (parse_isCtorDtorConv(ret))
+            {
+                continue;  // Cached text would hide that no return type follows
+            }
+            cand_end = p->cur;
+            cand_subs = p->sub_len;
+            cand_backrefs = p->backrefs;
+        }
+    }
+    if (ret == NULL)
+    {
+        return NULL;
+    }
+
+    // Cache the longest prefix if it means the same in every name
+    if ((p->cache != NULL) && (cand_end != NULL) && (cand_backrefs == backrefs_start) &&
+        ((hit == NULL) || ((size_t)(cand_end - start) > hit->key_len)))
+    {
+        Demangle_Cache_prefixAdd(p->cache, start, (size_t)(cand_end - start), &p->subs[sub_start],
+                                 cand_subs - sub_start, p->out);
+    }
+    return ret;
+}
+
+/**
+ * @brief Parses a local name (Z <encoding> E <entity> [<discriminator>])
+ * @param[in,out] p Parser state
+ * @param[out] info Encoding information, or NULL if not the name of an encoding
+ * @return dm_node_t* LOCAL node, or NULL on failure
+ */
+static dm_node_t *parse_localName(dm_parser_t *p, dm_name_info_t *info)
+{
+    static const char defarg[] = "{default arg#";
+    dm_node_t *function;
+    dm_node_t *entity;
+
+    p->cur++;  // Z
+    function = parse_encoding(p);
+    if ((function == NULL) || !parse_eat(p, 'E'))
+    {
+        return NULL;
+    }
+    if (function->kind == DM_NODE_ENCODING)
+    {
+        function->b = NULL;  // The return type of the enclosing function is not printed
+    }
+    if (parse_eat(p, 's'))
+    {
+        entity = parse_textNode(p, DM_NODE_NAME, "string literal", 14);
+    }
+    else if (parse_eat(p, 'd'))
+    {
+        // Entity in a default argument (Z <encoding> E d [<number>] _ <name>)
+        size_t num;
+        if (!parse_seqId(p, 10, &num))
+        {
+            return NULL;
+        }
+        function = parse_pairNode(p, DM_NODE_LOCAL, function, parse_numberedName(p, defarg, sizeof(defarg) - 1, num + 1));
+        entity = ((function != NULL) && (function->b != NULL)) ? parse_name(p, info) : NULL;
+    }
+    else
+    {
+        entity = parse_name(p, info);
+    }
+    parse_discriminator(p);
+    return parse_pairNode(p, DM_NODE_LOCAL, function, entity);
+}
+
+/**
+ * @brief Parses a name
+ * @param[in,out] p Parser state
+ * @param[out] info Encoding information, or NULL if not the name of an encoding
+ * @return dm_node_t* Name node, or NULL on failure
+ */
+static dm_node_t *parse_name(dm_parser_t *p, dm_name_info_t *info)
+{
+    dm_node_t *node;
+    char c = parse_peek(p, 0);
+
+    if (c == 'N')
+    {
+        return parse_nestedName(p, info);
+    }
+    if (c == 'Z')
+    {
+        return parse_localName(p, info);
+    }
+    if ((c == 'S') && (parse_peek(p, 1) != 't'))
+    {
+        node = parse_substitution(p, 0);
+        return ((node != NULL) && (parse_peek(p, 0) == 'I')) ? parse_templateId(p, node, info) : node;
+    }
+    if (c == 'S')
+    {
+        p->cur += 2;
+        node = parse_pairNode(p, DM_NODE_QUAL, parse_textNode(p, DM_NODE_NAME, "std", 3), NULL);
+        if (node == NULL)
+        {
+            return NULL;
+        }
+        node->b = parse_unqualifiedName(p);
+        if (node->b == NULL)
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        node = parse_unqualifiedName(p);
+    }
+    if ((node != NULL) && (parse_peek(p, 0) == 'I'))
+    {
+        // Unscoped template name is a candidate
+        return parse_subAdd(p, node) ? parse_templateId(p, node, info) : NULL;
+    }
+    return node;
+}
+
+/**
+ * @brief Parses a function type (F [Y] <return> <params> [R|O] E)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* FUNC_TYPE node, or NULL on failure
+ */
+static dm_node_t *parse_functionType(dm_parser_t *p)
+{
+    dm_vec_t params = {0};
+    dm_node_t *node;
+    uint8_t quals = 0;
+
+    p->cur++;  // F
+    parse_eat(p, 'Y');
+    node = parse_pairNode(p, DM_NODE_FUNC_TYPE, parse_type(p), NULL);
+    if ((node == NULL) || !parse_params(p, &params, &quals))
+    {
+        return NULL;
+    }
+    node->list = params.items;
+    node->list_len = params.len;
+    node->quals = quals;
+    return node;
+}
+
+/**
+ * @brief Parses an array type (A [<dimension>] _ <type>, A <expression> _ <type>)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* ARRAY node, or NULL on failure
+ */
+static dm_node_t *parse_arrayType(dm_parser_t *p)
+{
+    const char *dim;
+    size_t dim_len;
+    dm_node_t *dim_expr = NULL;
+    dm_node_t *node;
+
+    p->cur++;  // A
+    dim = p->cur;
+    while (DM_IS_DIGIT(parse_peek(p, 0)))
+    {
+        p->cur++;
+    }
+    dim_len = (size_t)(p->cur - dim);
+    if ((dim_len == 0) && (parse_peek(p, 0) != '_'))
+    {
+        dim_expr = parse_expression(p);  // Dependent dimension, e.g. RAT__Kc
+        if (dim_expr == NULL)
+        {
+            return NULL;
+        }
+    }
+    if (!parse_eat(p, '_'))
+    {
+        return NULL;
+    }
+    node = parse_pairNode(p, DM_NODE_ARRAY, parse_type(p), dim_expr);
+    if ((node != NULL) && (node->a == NULL))
+    {
+        return NULL;
+    }
+    if (node != NULL)
+    {
+        node->text = dim;
+        node->len = dim_len;
+    }
+    return node;
+}
+
+/**
+ * @brief Parses a type
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Type node, or NULL on failure
+ */
+static dm_node_t *parse_typeInner(dm_parser_t *p)
+{
+    char c = parse_peek(p, 0);
+    char c1 = parse_peek(p, 1);
+    dm_node_t *node = NULL;
+    uint8_t quals;
+
+    if (DM_IS_LOWER(c) && (g_builtins[c - 'a'] != NULL))
+    {
+        p->cur++;
+        node = parse_textNode(p, DM_NODE_NAME, g_builtins[c - 'a'], strlen(g_builtins[c - 'a']));
+        if ((node != NULL) && (c == 'v'))
+        {
+            node->flags |= DM_FLAG_VOID;
+        }
+        return node;  // Builtin types are not candidates
+    }
+    switch (c)
+    {
+        case 'r':
+        case 'V':
+        case 'K':
+            quals = parse_cvQuals(p);
+            if (parse_peek(p, 0) == 'F')
+            {
+                node = parse_functionType(p);  // Qualifies this; the unqualified type is no candidate
+                if (node != NULL)
+                {
+                    node->quals |= quals;
+                }
+                break;
+            }
+            node = parse_type(p);
+            if ((node != NULL) && (node->kind == DM_NODE_FUNC_TYPE))
+            {
+                dm_node_t *func = parse_node(p, DM_NODE_FUNC_TYPE);
+                if (func == NULL)
+                {
+                    return NULL;
+                }
+                *func = *node;
+                func->quals |= quals;  // Qualified member function type
+                node = func;
+            }
+            else
+            {
+                node = parse_pairNode(p, DM_NODE_CV, node, NULL);
+                if (node != NULL)
+                {
+                    node->quals = quals;
+                }
+            }
+            break;
+        case 'u':
+            p->cur++;
+            node = parse_sourceName(p);  // Vendor extended type
+            break;
+        case 'C':
+        case 'G':
+            p->cur++;
+            node = parse_pairNode(p, DM_NODE_POSTFIX, parse_type(p), NULL);
+            if ((node == NULL) || (node->a == NULL))
+            {
+                return NULL;
+            }
+            node->text = (c == 'C') ? " _Complex" : " _Imaginary";
+            node->len = strlen(node->text);
+            break;
+        case 'F':
+            node = parse_functionType(p);
+            break;
+        case 'N':
+        case 'Z':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            node = parse_name(p, NULL);
+            break;
+        case 'A':
+            node = parse_arrayType(p);
+            break;
+        case 'M':
+            p->cur++;
+            node = parse_type(p);
+            node = parse_pairNode(p, DM_NODE_PTRMEM, node, (node != NULL) ? parse_type(p) : NULL);
+            if ((node != NULL) && (node->b == NULL))
+            {
+                return NULL;
+            }
+            break;
+        case 'T':
+        {
+            size_t idx;
+            dm_node_t *param;
+            node = parse_templateParam(p, &idx);
+            param = parse_pairNode(p, DM_NODE_PARAM, node, NULL);
+            if (param == NULL)
+            {
+                return NULL;
+            }
+            param->len = idx;
+            if (!parse_subAdd(p, param))
+            {
+                return NULL;
+            }
+            if (parse_peek(p, 0) == 'I')
+            {
+                node = parse_templateId(p, node, NULL);
+                break;
+            }
+            return node;
+        }
+        case 'S':
+            if ((c1 == '_') || DM_IS_DIGIT(c1) || DM_IS_UPPER(c1))
+            {
+                node = parse_substitution(p, 0);
+                if ((node != NULL) && (parse_peek(p, 0) == 'I'))
+                {
+                    node = parse_templateId(p, node, NULL);
+                    break;
+                }
+                return node;  // A substituted type is not a new candidate
+            }
+            node = parse_name(p, NULL);
+            if ((node != NULL) && (node->kind == DM_NODE_TEXT))
+            {
+                return node;  // Standard abbreviation on its own
+            }
+            break;
+        case 'P':
+            p->cur++;
+            node = parse_pairNode(p, DM_NODE_POINTER, parse_type(p), NULL);
+            break;
+        case 'R':
+            p->cur++;
+            node = parse_pairNode(p, DM_NODE_LREF, parse_type(p), NULL);
+            break;
+        case 'O':
+            p->cur++;
+            node = parse_pairNode(p, DM_NODE_RREF, parse_type(p), NULL);
+            break;
+        case 'D':
+            if (c1 == 'p')
+            {
+                p->cur += 2;
+                node = parse_pairNode(p, DM_NODE_EXPANSION, parse_type(p), NULL);
+                break;
+            }
+            if (c1 == 'o')
+            {
+                p->cur += 2;
+                node = (parse_peek(p, 0) == 'F') ? parse_functionType(p) : NULL;
+                if (node != NULL)
+                {
+                    node->flags |= DM_FLAG_NOEXCEPT;
+                }
+                break;
+            }
+            for (size_t i = 0; i < (sizeof(g_builtins_d) / sizeof(g_builtins_d[0])); i++)
+            {
+                if (g_builtins_d[i].code[1] == c1)
+                {
+                    p->cur += 2;
+                    return parse_textNode(p, DM_NODE_NAME, g_builtins_d[i].text, strlen(g_builtins_d[i].text));
+                }
+            }
+            if (c1 == 'F')
+            {
+                const char *bits;
+                size_t len;
+                p->cur += 2;
+                bits = p->cur;
+                while (DM_IS_DIGIT(parse_peek(p, 0)))
+                {
+                    p->cur++;
+                }
+                len = (size_t)(p->cur - bits);
+                if ((len == 0) || !parse_eat(p, '_'))
+                {
+                    return NULL;
+                }
+                bits = parse_concat(p, "_Float", 6, bits, len, &len);
+                return (bits != NULL) ? parse_textNode(p, DM_NODE_NAME, bits, len) : NULL;
+            }
+            if ((c1 == 'T') || (c1 == 't'))
+            {
+                p->cur += 2;
+                node = parse_pairNode(p, DM_NODE_DECLTYPE, parse_expression(p), NULL);
+                if (!parse_eat(p, 'E'))
+                {
+                    return NULL;
+                }
+                break;
+            }
+            return NULL;  // Vectors and other D types are not supported
+        default:
+            return NULL;
+    }
+    return parse_subAdd(p, node) ? node : NULL;
+}
+
+/**
+ * @brief Parses a type, bounding the recursion depth
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Type node, or NULL on failure
+ */
+static dm_node_t *parse_type(dm_parser_t *p)
+{
+    dm_node_t *node;
+
+    if (++p->depth > DM_DEPTH_MAX)
+    {
+        return NULL;
+    }
+    node = parse_typeInner(p);
+    p->depth--;
+    return node;
+}
+
+/**
+ * @brief Parses a call offset of a thunk (h <offset> _ / v <offset> _ <offset> _)
+ * @param[in,out] p Parser state
+ * @param[in] kind 'h' or 'v', already consumed
+ * @return int Non-zero on success
+ */
+static int parse_callOffset(dm_parser_t *p, char kind)
+{
+    size_t num;
+
+    for (int i = (kind == 'v') ? 2 : 1; i > 0; i--)
+    {
+        parse_eat(p, 'n');
+        if (!parse_number(p, &num) || !parse_eat(p, '_'))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Parses a special name (vtables, typeinfo, thunks, guard variables)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* SPECIAL or CTOR_VTABLE node, or NULL on failure
+ */
+static dm_node_t *parse_specialName(dm_parser_t *p)
+{
+    char c0 = parse_peek(p, 0);
+    char c1 = parse_peek(p, 1);
+    const char *text = NULL;
+    dm_node_t *child = NULL;
+    size_t num;
+
+    p->cur += 2;
+    if (c0 == 'T')
+    {
+        switch (c1)
+        {
+            case 'V': text = "vtable for "; child = parse_type(p); break;
+            case 'T': text = "VTT for "; child = parse_type(p); break;
+            case 'I': text = "typeinfo for "; child = parse_type(p); break;
+            case 'S': text = "typeinfo name for "; child = parse_type(p); break;
+            case 'H': text = "TLS init function for "; child = parse_name(p, NULL); break;
+            case 'W': text = "TLS wrapper function for "; child = parse_name(p, NULL); break;
+            case 'h':
+            case 'v':
+                text = (c1 == 'h') ? "non-virtual thunk to " : "virtual thunk to ";
+                child = parse_callOffset(p, c1) ? parse_encoding(p) : NULL;
+                break;
+            case 'c':
+                text = "covariant return thunk to ";
+                if ((p->cur < p->end) && parse_callOffset(p, *p->cur++) && (p->cur < p->end) && parse_callOffset(p, *p->cur++))
+                {
+                    child = parse_encoding(p);
+                }
+                break;
+            case 'C':
+            {
+                dm_node_t *derived = parse_type(p);
+                dm_node_t *base;
+                if ((derived == NULL) || !parse_number(p, &num) || !parse_eat(p, '_'))
+                {
+                    return NULL;
+                }
+                base = parse_type(p);
+                return (base != NULL) ? parse_pairNode(p, DM_NODE_CTOR_VTABLE, derived, base) : NULL;
+            }
+            default:
+                return NULL;
+        }
+    }
+    else if (c0 == 'G')
+    {
+        switch (c1)
+        {
+            case 'V': text = "guard variable for "; child = parse_name(p, NULL); break;
+            case 'A': text = "hidden alias for "; child = parse_encoding(p); break;
+            case 'R':
+                text = "reference temporary #";
+                child = parse_name(p, NULL);
+                if ((child == NULL) || !parse_seqId(p, 36, &num))
+                {
+                    return NULL;
+                }
+                {
+                    char buf[32];
+                    size_t len = 0;
+                    const char *str;
+                    size_t str_len;
+                    do
+                    {
+                        buf[sizeof(buf) - 1 - len++] = (char)('0' + (num % 10));
+                        num /= 10;
+                    } while (num != 0);
+                    str = parse_concat(p, text, strlen(text), &buf[sizeof(buf) - len], len, &str_len);
+                    str = (str != NULL) ? parse_concat(p, str, str_len, " for ", 5, &str_len) : NULL;
+                    if (str == NULL)
+                    {
+                        return NULL;
+                    }
+                    child = parse_pairNode(p, DM_NODE_SPECIAL, child, NULL);
+                    if (child != NULL)
+                    {
+                        child->text = str;
+                        child->len = str_len;
+                    }
+                    return child;
+                }
+            case 'T':
+                if ((p->cur < p->end) && ((*p->cur == 'n') || (*p->cur == 't')))
+                {
+                    text = (*p->cur++ == 'n') ? "non-transaction clone for " : "transaction clone for ";
+                    child = parse_encoding(p);
+                }
+                break;
+            default:
+                return NULL;
+        }
+    }
+    child = parse_pairNode(p, DM_NODE_SPECIAL, child, NULL);
+    if (child != NULL)
+    {
+        child->text = text;
+        child->len = strlen(text);
+    }
+    return child;
+}
+
+/**
+ * @brief Checks whether a name is a constructor, destructor or conversion operator
+ * @param[in] node Name node
+ * @return int Non-zero if it is
+ */
+static int parse_isCtorDtorConv(const dm_node_t *node)
+{
+    while (node != NULL)
+    {
+        switch (node->kind)
+        {
+            case DM_NODE_QUAL:
+            case DM_NODE_LOCAL:
+                node = node->b;
+                break;
+            case DM_NODE_ABI_TAG:
+                node = node->a;
+                break;
+            case DM_NODE_CTOR:
+            case DM_NODE_CONVERSION:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Checks whether the function name is followed by a return type
+ * @param[in] node Name node
+ * @return int Non-zero for template functions other than constructors,
+ *             destructors and conversion operators
+ */
+static int parse_hasReturnType(const dm_node_t *node)
+{
+    while (node != NULL)
+    {
+        switch (node->kind)
+        {
+            case DM_NODE_LOCAL:
+                node = node->b;
+                break;
+            case DM_NODE_TEMPLATE:
+                return !parse_isCtorDtorConv(node->a);
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Parses an encoding (function, data or special name)
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Encoding node, or NULL on failure
+ */
+static dm_node_t *parse_encodingInner(dm_parser_t *p)
+{
+    dm_name_info_t info = {0};
+    dm_vec_t params = {0};
+    dm_node_t *name;
+    dm_node_t *ret = NULL;
+    dm_node_t *node;
+    char c = parse_peek(p, 0);
+
+    if ((c == 'T') || (c == 'G'))
+    {
+        return parse_specialName(p);
+    }
+    name = parse_name(p, &info);
+    c = parse_peek(p, 0);
+    if ((name == NULL) || (c == '\0') || (c == 'E') || (c == '.'))
+    {
+        return name;  // Data object
+    }
+    if (parse_hasReturnType(name))
+    {
+        ret = parse_type(p);
+        if (ret == NULL)
+        {
+            return NULL;
+        }
+    }
+    while (((c = parse_peek(p, 0)) != '\0') && (c != 'E') && (c != '.'))
+    {
+        if (!parse_vecPush(p, &params, parse_type(p)))
+        {
+            return NULL;
+        }
+    }
+    if ((params.len == 1) && (params.items[0]->flags & DM_FLAG_VOID))
+    {
+        params.len = 0;  // f(void) prints as f()
+    }
+    node = parse_pairNode(p, DM_NODE_ENCODING, name, ret);
+    if (node != NULL)
+    {
+        node->list = params.items;
+        node->list_len = params.len;
+        node->quals = info.quals;
+    }
+    return node;
+}
+
+/**
+ * @brief Parses an encoding, bounding the recursion depth
+ * @param[in,out] p Parser state
+ * @return dm_node_t* Encoding node, or NULL on failure
+ */
+static dm_node_t *parse_encoding(dm_parser_t *p)
+{
+    dm_node_t *saved_args = p->tmpl_args;
+    dm_node_t *node;
+
+    if (++p->depth > DM_DEPTH_MAX)
+    {
+        return NULL;
+    }
+    node = parse_encodingInner(p);
+    p->depth--;
+    if (p->depth != 0)
+    {
+        p->tmpl_args = saved_args;  // Nested encodings have their own template arguments
+    }
+    return node;
+}
+
+/**
+ * @brief Parses a mangled name into a node tree
+ * @param[in,out] parser Parser set up on the mangled name
+ * @return dm_node_t* Root node, or NULL if the name is malformed or not supported
+ */
+dm_node_t *Demangle_Parse_mangled(dm_parser_t *parser)
+{
+    dm_node_t *node;
+
+    if (((parser->end - parser->cur) < 2) || (parser->cur[0] != '_') || (parser->cur[1] != 'Z'))
+    {
+        return NULL;
+    }
+    parser->cur += 2;
+    node = parse_encoding(parser);
+
+    // Clone suffixes (.cold, .isra.0, .constprop.1, ...)
+    while ((node != NULL) && (parse_peek(parser, 0) == '.') &&
+           (DM_IS_LOWER(parse_peek(parser, 1)) || DM_IS_DIGIT(parse_peek(parser, 1)) || (parse_peek(parser, 1) == '_')))
+    {
+        const char *start = parser->cur;
+        parser->cur += 2;
+        while (DM_IS_LOWER(parse_peek(parser, 0)) || DM_IS_DIGIT(parse_peek(parser, 0)) || (parse_peek(parser, 0) == '_'))
+        {
+            parser->cur++;
+        }
+        while ((parse_peek(parser, 0) == '.') && DM_IS_DIGIT(parse_peek(parser, 1)))
+        {
+            parser->cur += 2;
+            while (DM_IS_DIGIT(parse_peek(parser, 0)))
+            {
+                parser->cur++;
+            }
+        }
+        node = parse_pairNode(parser, DM_NODE_CLONE, node, NULL);
+        if (node != NULL)
+        {
+            node->text = start;
+            node->len = (size_t)(parser->cur - start);
+        }
+    }
+    if (parser->cur != parser->end)
+    {
+        return NULL;  // Trailing characters
+    }
+    return node;
+}
@@ -0,0 +1,776 @@
+/**
+ * @file demangle_print.c
+ * @brief Printer of the ft_nm demangle module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the functions turning a node tree into text in the
+ * format of c++filt. Types are printed in two parts around their declarator,
+ * so that pointers to functions and arrays come out as "void (*)(int)" and
+ * "int (&) [4]".
+ */
+
+#include "../inc_priv/demangle_priv.h"
+#include <stdlib.h>  // For realloc
+#include <string.h>  // For memcpy, strlen
+
+#define DM_OUT_MIN_CAP 256u  /**< Initial capacity of an output buffer */
+
+/**
+ * @brief Printer state threaded through the recursion
+ */
+typedef struct dm_printer_s
+{
+    dm_out_t *out;          /**< Output buffer */
+    long pack_idx;          /**< Element of argument packs being expanded, or -1 */
+    unsigned int depth;     /**< Current recursion depth */
+    uint8_t cv_pending;     /**< Qualifiers an enclosing CV node prints, not repeated inside */
+} dm_printer_t;
+
+static void print_left(dm_printer_t *pr, const dm_node_t *node);
+static void print_right(dm_printer_t *pr, const dm_node_t *node);
+
+/**
+ * @brief Appends text to an output buffer
+ * @param[in,out] out Output buffer
+ * @param[in] str Text to append
+ * @param[in] len Length of str
+ */
+void Demangle_Print_append(dm_out_t *out, const char *str, size_t len)
+{
+    if (out->failed || (len == 0))
+    {
+        return;
+    }
+    if ((out->len + len) > DM_OUTPUT_MAX)
+    {
+        out->failed = 1;  // Name grows without bound through substitutions
+        return;
+    }
+    if ((out->len + len) > out->cap)
+    {
+        size_t cap = (out->cap != 0) ? out->cap : DM_OUT_MIN_CAP;
+        char *buf;
+        while (cap < (out->len + len))
+        {
+            cap *= 2;
+        }
+        buf = realloc(out->buf, cap);
+        if (buf == NULL)
+        {
+            out->failed = 1;  // Memory allocation error
+            return;
+        }
+        out->buf = buf;
+        out->cap = cap;
+    }
+    memcpy(&out->buf[out->len], str, len);
+    out->len += len;
+    out->last = str[len - 1];
+}
+
+/**
+ * @brief Appends a null-terminated string
+ * @param[in,out] pr Printer state
+ * @param[in] str String to append
+ */
+static void print_str(dm_printer_t *pr, const char *str)
+{
+    Demangle_Print_append(pr->out, str, strlen(str));
+}
+
+/**
+ * @brief Returns the last character appended
+ * @param[in] pr Printer state
+ * @return char Last character, or '\0' if nothing was printed; like c++filt,
+ *              a dropped separator still counts as appended
+ */
+static char print_lastChar(const dm_printer_t *pr)
+{
+    return pr->out->last;
+}
+
+/**
+ * @brief Returns the function/array flags of a type
+ * @param[in] node Type node
+ * @param[in] pack_idx Element of argument packs being expanded, or -1
+ * @return uint8_t DM_FLAG_FUNC, DM_FLAG_ARRAY or 0
+ */
+static uint8_t print_declFlags(const dm_node_t *node, long pack_idx)
+{
+    for (unsigned int i = 0; (node != NULL) && (i < DM_DEPTH_MAX); i++)
+    {
+        switch (node->kind)
+        {
+            case DM_NODE_PACK_REF:
+                if ((pack_idx < 0) || ((size_t)pack_idx >= node->a->list_len))
+                {
+                    return 0;
+                }
+                node = node->a->list[pack_idx];
+                break;
+            case DM_NODE_FUNC_TYPE:
+                return DM_FLAG_FUNC;
+            case DM_NODE_ARRAY:
+                return DM_FLAG_ARRAY;
+            case DM_NODE_TEXT:
+                return node->flags & (DM_FLAG_FUNC | DM_FLAG_ARRAY);
+            case DM_NODE_CV:
+                node = node->a;  // Qualifiers print next to the inner type
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the function/array flags of a type, as stored for cached text
+ * @param[in] node Type node
+ * @return uint8_t DM_FLAG_FUNC, DM_FLAG_ARRAY or 0
+ */
+uint8_t Demangle_Print_declFlags(const dm_node_t *node)
+{
+    return print_declFlags(node, -1);
+}
+
+/**
+ * @brief Checks whether a type prints anything after its declarator
+ * @param[in] node Type node
+ * @return int Non-zero if the type has a right part
+ */
+static int print_hasRight(const dm_node_t *node)
+{
+    for (unsigned int i = 0; (node != NULL) && (i < DM_DEPTH_MAX); i++)
+    {
+        switch (node->kind)
+        {
+            case DM_NODE_FUNC_TYPE:
+            case DM_NODE_ARRAY:
+                return 1;
+            case DM_NODE_TEXT:
+                return (node->rlen != 0);
+            case DM_NODE_CV:
+            case DM_NODE_POINTER:
+            case DM_NODE_LREF:
+            case DM_NODE_RREF:
+                node = node->a;
+                break;
+            case DM_NODE_PTRMEM:
+                node = node->b;
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the base name used by a constructor following a prefix
+ * @param[in] node Prefix node
+ * @return const dm_node_t* Base name node, or NULL if there is none
+ */
+const dm_node_t *Demangle_Print_simpleName(const dm_node_t *node)
+{
+    for (unsigned int i = 0; (node != NULL) && (i < DM_DEPTH_MAX); i++)
+    {
+        switch (node->kind)
+        {
+            case DM_NODE_TEMPLATE:
+            case DM_NODE_ABI_TAG:
+                node = node->a;
+                break;
+            case DM_NODE_QUAL:
+            case DM_NODE_LOCAL:
+                if ((node->b->kind == DM_NODE_LAMBDA) || (node->b->flags & DM_FLAG_UNNAMED))
+                {
+                    node = node->a;  // Unnamed types do not name constructors
+                }
+                else
+                {
+                    node = node->b;
+                }
+                break;
+            case DM_NODE_TEXT:
+                return node->c;
+            default:
+                return node;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Finds the argument pack expanded by a pack expansion
+ * @param[in] node Pattern of the expansion
+ * @param[in] depth Current search depth
+ * @return const dm_node_t* Pack node, or NULL if the pattern holds none
+ */
+static const dm_node_t *print_packFind(const dm_node_t *node, unsigned int depth)
+{
+    const dm_node_t *pack = NULL;
+
+    if ((node == NULL) || (depth > DM_DEPTH_MAX))
+    {
+        return NULL;
+    }
+    switch (node->kind)
+    {
+        case DM_NODE_TEMPLATE:
+            pack = print_packFind(node->b, depth + 1);
+            return (pack != NULL) ? pack : print_packFind(node->a, depth + 1);
+        case DM_NODE_QUAL:
+            pack = print_packFind(node->a, depth + 1);
+            return (pack != NULL) ? pack : print_packFind(node->b, depth + 1);
+        case DM_NODE_PACK_REF:
+            return node->a;
+        case DM_NODE_ARGS:
+        case DM_NODE_FUNC_TYPE:
+            for (size_t i = 0; (pack == NULL) && (i < node->list_len); i++)
+            {
+                pack = print_packFind(node->list[i], depth + 1);
+            }
+            if ((pack == NULL) && (node->kind != DM_NODE_ARGS))
+            {
+                pack = print_packFind(node->a, depth + 1);
+            }
+            return pack;
+        case DM_NODE_CV:
+        case DM_NODE_POINTER:
+        case DM_NODE_LREF:
+        case DM_NODE_RREF:
+        case DM_NODE_POSTFIX:
+            return print_packFind(node->a, depth + 1);
+        case DM_NODE_ARRAY:
+            pack = print_packFind(node->a, depth + 1);
+            return (pack != NULL) ? pack : print_packFind(node->b, depth + 1);
+        case DM_NODE_PTRMEM:
+            pack = print_packFind(node->a, depth + 1);
+            return (pack != NULL) ? pack : print_packFind(node->b, depth + 1);
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Collapses a reference to a reference, as a template argument substituted into T& or T&& does
+ * @param[in] pr Printer state
+ * @param[in] node POINTER, LREF or RREF node
+ * @param[out] kind Kind of the collapsed node
+ * @return const dm_node_t* Type pointed or referred to after collapsing
+ */
+static const dm_node_t *print_refCollapse(const dm_printer_t *pr, const dm_node_t *node, dm_node_kind_e *kind)
+{
+    const dm_node_t *inner = node->a;
+
+    *kind = node->kind;
+    if (node->kind == DM_NODE_POINTER)
+    {
+        return inner;
+    }
+    for (unsigned int i = 0; (inner != NULL) && (i < DM_DEPTH_MAX); i++)
+    {
+        if ((inner->kind == DM_NODE_PACK_REF) && (pr->pack_idx >= 0) && ((size_t)pr->pack_idx < inner->a->list_len))
+        {
+            inner = inner->a->list[pr->pack_idx];  // Element of the pack being expanded
+        }
+        else if ((inner->kind == DM_NODE_LREF) || (inner->kind == DM_NODE_RREF))
+        {
+            if (inner->kind == DM_NODE_LREF)
+            {
+                *kind = DM_NODE_LREF;  // & wins over &&
+            }
+            inner = inner->a;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return inner;
+}
+
+/**
+ * @brief Prints a node completely
+ * @param[in,out] pr Printer state
+ * @param[in] node Node to print
+ */
+static void print_node(dm_printer_t *pr, const dm_node_t *node)
+{
+    print_left(pr, node);
+    print_right(pr, node);
+}
+
+/**
+ * @brief Prints a comma separated list
+ *
+ * Like c++filt, the separator is dropped only before a run of elements that
+ * print nothing up to the end of the list (empty argument packs), so
+ * "f(int, , long)" keeps its empty element.
+ *
+ * @param[in,out] pr Printer state
+ * @param[in] list Nodes to print
+ * @param[in] len Number of nodes
+ */
+static void print_list(dm_printer_t *pr, dm_node_t *const *list, size_t len)
+{
+    size_t empty_from = SIZE_MAX;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        size_t mark = pr->out->len;
+        if (i != 0)
+        {
+            print_str(pr, ", ");
+        }
+        print_node(pr, list[i]);
+        if (pr->out->failed)
+        {
+            return;
+        }
+        if (pr->out->len == (mark + ((i != 0) ? 2u : 0u)))
+        {
+            empty_from = (empty_from == SIZE_MAX) ? mark : empty_from;
+        }
+        else
+        {
+            empty_from = SIZE_MAX;
+        }
+    }
+    if (empty_from != SIZE_MAX)
+    {
+        pr->out->len = empty_from;
+    }
+}
+
+/**
+ * @brief Prints function parameters in parentheses
+ * @param[in,out] pr Printer state
+ * @param[in] list Parameter nodes
+ * @param[in] len Number of parameters
+ */
+static void print_params(dm_printer_t *pr, dm_node_t *const *list, size_t len)
+{
+    print_str(pr, "(");
+    print_list(pr, list, len);
+    print_str(pr, ")");
+}
+
+/**
+ * @brief Prints qualifiers of a type or member function
+ * @param[in,out] pr Printer state
+ * @param[in] quals DM_QUAL_* bits
+ */
+static void print_quals(dm_printer_t *pr, uint8_t quals)
+{
+    if (quals & DM_QUAL_CONST)
+    {
+        print_str(pr, " const");
+    }
+    if (quals & DM_QUAL_VOLATILE)
+    {
+        print_str(pr, " volatile");
+    }
+    if (quals & DM_QUAL_RESTRICT)
+    {
+        print_str(pr, " restrict");
+    }
+    if (quals & DM_QUAL_LREF)
+    {
+        print_str(pr, " &");
+    }
+    if (quals & DM_QUAL_RREF)
+    {
+        print_str(pr, " &&");
+    }
+}
+
+/**
+ * @brief Prints the part of a node before its declarator
+ * @param[in,out] pr Printer state
+ * @param[in] node Node to print
+ */
+static void print_left(dm_printer_t *pr, const dm_node_t *node)
+{
+    uint8_t cv_pending = pr->cv_pending;
+    uint8_t decl;
+
+    pr->cv_pending = 0;
+    if ((node == NULL) || pr->out->failed)
+    {
+        return;
+    }
+    if (++pr->depth > DM_DEPTH_MAX)
+    {
+        pr->out->failed = 1;  // Recursion too deep
+        return;
+    }
+    switch (node->kind)
+    {
+        case DM_NODE_NAME:
+        case DM_NODE_TEXT:
+            Demangle_Print_append(pr->out, node->text, node->len);
+            break;
+        case DM_NODE_QUAL:
+            print_node(pr, node->a);
+            print_str(pr, "::");
+            print_node(pr, node->b);
+            break;
+        case DM_NODE_TEMPLATE:
+            print_node(pr, node->a);
+            if (print_lastChar(pr) == '<')
+            {
+                print_str(pr, " ");  // operator< <int>
+            }
+            print_str(pr, "<");
+            print_list(pr, node->b->list, node->b->list_len);
+            if (print_lastChar(pr) == '>')
+            {
+                print_str(pr, " ");  // a<b<c> >
+            }
+            print_str(pr, ">");
+            break;
+        case DM_NODE_ARGS:
+            print_list(pr, node->list, node->list_len);
+            break;
+        case DM_NODE_PACK_REF:
+            if (pr->pack_idx < 0)
+            {
+                print_list(pr, node->a->list, node->a->list_len);
+            }
+            else if ((size_t)pr->pack_idx < node->a->list_len)
+            {
+                pr->cv_pending = cv_pending;
+                print_left(pr, node->a->list[pr->pack_idx]);
+            }
+            break;
+        case DM_NODE_CTOR:
+            if (node->flags & DM_FLAG_DTOR)
+            {
+                print_str(pr, "~");
+            }
+            print_node(pr, node->a);
+            break;
+        case DM_NODE_ABI_TAG:
+            print_node(pr, node->a);
+            print_str(pr, "[abi:");
+            Demangle_Print_append(pr->out, node->text, node->len);
+            print_str(pr, "]");
+            break;
+        case DM_NODE_CV:
+            pr->cv_pending = cv_pending | node->quals;
+            print_left(pr, node->a);
+            print_quals(pr, node->quals & (uint8_t)~cv_pending);  // c++filt prints "T const" once
+            break;
+        case DM_NODE_POINTER:
+        case DM_NODE_LREF:
+        case DM_NODE_RREF:
+        {
+            dm_node_kind_e kind;
+            const dm_node_t *inner = print_refCollapse(pr, node, &kind);
+            print_left(pr, inner);
+            decl = print_declFlags(inner, pr->pack_idx);
+            if (decl & DM_FLAG_ARRAY)
+            {
+                print_str(pr, " (");
+            }
+            else if (decl & DM_FLAG_FUNC)
+            {
+                print_str(pr, "(");
+            }
+            print_str(pr, (kind == DM_NODE_POINTER) ? "*" : ((kind == DM_NODE_LREF) ? "&" : "&&"));
+            break;
+        }
+        case DM_NODE_PTRMEM:
+            print_left(pr, node->b);
+            decl = print_declFlags(node->b, pr->pack_idx);
+            if (decl & DM_FLAG_ARRAY)
+            {
+                print_str(pr, " (");
+            }
+            else if (decl & DM_FLAG_FUNC)
+            {
+                print_str(pr, "(");
+            }
+            else
+            {
+                print_str(pr, " ");
+            }
+            print_node(pr, node->a);
+            print_str(pr, "::*");
+            break;
+        case DM_NODE_FUNC_TYPE:
+            print_left(pr, node->a);
+            if (!print_hasRight(node->a))
+            {
+                print_str(pr, " ");  // No space in "int (*(long))(char)"
+            }
+            break;
+        case DM_NODE_ARRAY:
+            print_left(pr, node->a);
+            break;
+        case DM_NODE_ENCODING:
+            if (node->b != NULL)
+            {
+                print_left(pr, node->b);
+                if (!print_hasRight(node->b))
+                {
+                    print_str(pr, " ");
+                }
+            }
+            print_node(pr, node->a);
+            print_params(pr, node->list, node->list_len);
+            if (node->b != NULL)
+            {
+                print_right(pr, node->b);
+            }
+            print_quals(pr, node->quals);
+            break;
+        case DM_NODE_LOCAL:
+            print_node(pr, node->a);
+            print_str(pr, "::");
+            print_node(pr, node->b);
+            break;
+        case DM_NODE_SPECIAL:
+            Demangle_Print_append(pr->out, node->text, node->len);
+            print_node(pr, node->a);
+            break;
+        case DM_NODE_CTOR_VTABLE:
+            print_str(pr, "construction vtable for ");
+            print_node(pr, node->b);
+            print_str(pr, "-in-");
+            print_node(pr, node->a);
+            break;
+        case DM_NODE_CONVERSION:
+            print_str(pr, "operator ");
+            print_node(pr, node->a);
+            break;
+        case DM_NODE_EXPANSION:
+        {
+            const dm_node_t *pack = print_packFind(node->a, 0);
+            long saved_idx = pr->pack_idx;
+            if (pack == NULL)
+            {
+                print_node(pr, node->a);
+                print_str(pr, "...");
+                break;
+            }
+            for (size_t i = 0; i < pack->list_len; i++)
+            {
+                if (i != 0)
+                {
+                    print_str(pr, ", ");
+                }
+                pr->pack_idx = (long)i;
+                print_node(pr, node->a);
+            }
+            pr->pack_idx = saved_idx;
+            break;
+        }
+        case DM_NODE_LAMBDA:
+            print_str(pr, "{lambda");
+            print_params(pr, node->list, node->list_len);
+            print_str(pr, "#");
+            Demangle_Print_append(pr->out, node->text, node->len);
+            print_str(pr, "}");
+            break;
+        case DM_NODE_LITERAL:
+            if (node->a != NULL)
+            {
+                print_str(pr, "(");
+                print_node(pr, node->a);
+                print_str(pr, ")");
+            }
+            if (node->flags & DM_FLAG_NEGATIVE)
+            {
+                print_str(pr, "-");
+            }
+            Demangle_Print_append(pr->out, node->text, node->len);
+            break;
+        case DM_NODE_CLONE:
+            print_node(pr, node->a);
+            print_str(pr, " [clone ");
+            Demangle_Print_append(pr->out, node->text, node->len);
+            print_str(pr, "]");
+            break;
+        case DM_NODE_PARAM:
+            print_node(pr, node->a);
+            break;
+        case DM_NODE_PAREN:
+            print_str(pr, "(");
+            print_node(pr, node->a);
+            print_str(pr, ")");
+            break;
+        case DM_NODE_UNARY:
+            Demangle_Print_append(pr->out, node->text, node->len);
+            print_node(pr, node->a);
+            break;
+        case DM_NODE_BINARY:
+            print_node(pr, node->a);
+            Demangle_Print_append(pr->out, node->text, node->len);
+            print_node(pr, node->b);
+            Demangle_Print_append(pr->out, node->rtext, node->rlen);
+            break;
+        case DM_NODE_TRINARY:
+            print_node(pr, node->a);
+            print_str(pr, "?");
+            print_node(pr, node->b);
+            print_str(pr, " : ");
+            print_node(pr, node->c);
+            break;
+        case DM_NODE_CALL:
+            print_node(pr, node->a);
+            print_params(pr, node->list, node->list_len);
+            break;
+        case DM_NODE_CAST:
+            if (node->text != NULL)
+            {
+                Demangle_Print_append(pr->out, node->text, node->len);
+                print_str(pr, "<");
+                print_node(pr, node->a);
+                print_str(pr, ">(");
+                print_node(pr, node->b);
+                print_str(pr, ")");
+                break;
+            }
+            print_str(pr, "(");
+            print_node(pr, node->a);
+            print_str(pr, ")");
+            print_node(pr, node->b);
+            break;
+        case DM_NODE_DECLTYPE:
+            print_str(pr, "decltype (");
+            print_node(pr, node->a);
+            print_str(pr, ")");
+            break;
+        case DM_NODE_POSTFIX:
+            print_node(pr, node->a);
+            Demangle_Print_append(pr->out, node->text, node->len);
+            break;
+        default:
+            pr->out->failed = 1;  // Unknown node
+            break;
+    }
+    pr->depth--;
+}
+
+/**
+ * @brief Prints the part of a node after its declarator
+ * @param[in,out] pr Printer state
+ * @param[in] node Node to print
+ */
+static void print_right(dm_printer_t *pr, const dm_node_t *node)
+{
+    if ((node == NULL) || pr->out->failed)
+    {
+        return;
+    }
+    if (++pr->depth > DM_DEPTH_MAX)
+    {
+        pr->out->failed = 1;  // Recursion too deep
+        return;
+    }
+    switch (node->kind)
+    {
+        case DM_NODE_TEXT:
+            Demangle_Print_append(pr->out, node->rtext, node->rlen);
+            break;
+        case DM_NODE_PACK_REF:
+            if ((pr->pack_idx >= 0) && ((size_t)pr->pack_idx < node->a->list_len))
+            {
+                print_right(pr, node->a->list[pr->pack_idx]);
+            }
+            break;
+        case DM_NODE_CV:
+            print_right(pr, node->a);
+            break;
+        case DM_NODE_POINTER:
+        case DM_NODE_LREF:
+        case DM_NODE_RREF:
+        {
+            dm_node_kind_e kind;
+            const dm_node_t *inner = print_refCollapse(pr, node, &kind);
+            if (print_declFlags(inner, pr->pack_idx) != 0)
+            {
+                print_str(pr, ")");
+            }
+            print_right(pr, inner);
+            break;
+        }
+        case DM_NODE_PTRMEM:
+            if (print_declFlags(node->b, pr->pack_idx) != 0)
+            {
+                print_str(pr, ")");
+            }
+            print_right(pr, node->b);
+            break;
+        case DM_NODE_FUNC_TYPE:
+            print_params(pr, node->list, node->list_len);
+            print_right(pr, node->a);
+            print_quals(pr, node->quals);
+            if (node->flags & DM_FLAG_NOEXCEPT)
+            {
+                print_str(pr, " noexcept");
+            }
+            break;
+        case DM_NODE_ARRAY:
+            if (print_lastChar(pr) != ']')
+            {
+                print_str(pr, " ");
+            }
+            print_str(pr, "[");
+            if (node->b != NULL)
+            {
+                print_node(pr, node->b);
+            }
+            else
+            {
+                Demangle_Print_append(pr->out, node->text, node->len);
+            }
+            print_str(pr, "]");
+            print_right(pr, node->a);
+            break;
+        default:
+            break;
+    }
+    pr->depth--;
+}
+
+/**
+ * @brief Prints a node tree
+ * @param[in,out] out Output buffer
+ * @param[in] node Root node
+ */
+void Demangle_Print_node(dm_out_t *out, const dm_node_t *node)
+{
+    dm_printer_t pr = {out, -1, 0, 0};
+
+    print_node(&pr, node);
+}
+
+/**
+ * @brief Prints the part of a type before its declarator
+ * @param[in,out] out Output buffer
+ * @param[in] node Type node
+ */
+void Demangle_Print_left(dm_out_t *out, const dm_node_t *node)
+{
+    dm_printer_t pr = {out, -1, 0, 0};
+
+    print_left(&pr, node);
+}
+
+/**
+ * @brief Prints the part of a type after its declarator
+ * @param[in,out] out Output buffer
+ * @param[in] node Type node
+ */
+void Demangle_Print_right(dm_out_t *out, const dm_node_t *node)
+{
+    dm_printer_t pr = {out, -1, 0, 0};
+
+    print_right(&pr, node);
+}
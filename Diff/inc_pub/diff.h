@@ -0,0 +1,90 @@
+/**
+ * @file diff.h
+ * @brief Public header for the symbol table diff (--diff OLD NEW) in ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interface used by the --diff option. Each side
+ * gathers the symbol lines of one file with their flag character, computed
+ * while the section headers of that file are loaded, and sorts them in the
+ * nm name order. The report is produced by one linear merge of both sides.
+ */
+
+#ifndef _IG_DIFF_H_
+#define _IG_DIFF_H_
+
+#include "../../LinkedList/inc_pub/linkedlist.h"  // For dl_list_t
+#include "../../Writer/inc_pub/writer.h"          // For writer_line_t, writer_bit_t, writer_ctx_t
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Error codes for diff operations
+ */
+enum Diff_Error {
+    DF_SUCCESS = 0,           /**< Success */
+    DF_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    DF_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    DF_ERR_WRITE_FAIL = -3    /**< Writing the report failed */
+};
+
+/**
+ * @brief Symbol line with the flag character it is printed with
+ */
+typedef struct diff_sym_s
+{
+    const writer_line_t *line;  /**< Symbol line, owned by the caller's list */
+    char flag;                  /**< Flag character (Writer_FlagPrint_flagGet) */
+} diff_sym_t;
+
+/**
+ * @brief Sorted symbols of one file
+ */
+typedef struct diff_side_s
+{
+    diff_sym_t *syms;     /**< Symbols in nm name order */
+    size_t sym_cnt;       /**< Number of symbols */
+    writer_bit_t bit_len; /**< Bit length the values of the file are printed with */
+} diff_side_t;
+
+/**
+ * @brief Builds one side of the diff from a symbol list
+ *
+ * The section headers of the file must be loaded in the writer context
+ * (Writer_FlagPrint_sectionHeadLoad) and the names of the lines must not depend on its string table, i.e. be
+ * interned (see intern.h), as the side is used after the file is closed.
+ * Symbols are sorted in the lineCmp name order, then by exact name, keeping
+ * the list order of equal names.
+ *
+ * @param[out] side Side to build
+ * @param[in] writer Writer context with the section headers of the file loaded
+ * @param[in] head Head of the symbol list of the file; must outlive the side
+ * @param[in] bit_len Bit length of the file
+ * @return int DF_SUCCESS on success, DF_ERR_NULL_INPUT on invalid input or a
+ *             line with no resolved name, DF_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Diff_sideBuild(diff_side_t *side, const writer_ctx_t *writer, const dl_list_t *head, writer_bit_t bit_len);
+
+/**
+ * @brief Frees a side
+ * @param[in,out] side Side to free
+ */
+void Diff_sideFree(diff_side_t *side);
+
+/**
+ * @brief Prints the differences between two sides to stdout
+ *
+ * Each symbol only in the old file is printed as "- value flag name", each
+ * symbol only in the new file as "+ value flag name", and each symbol whose
+ * value, flag, binding or type changed as
+ * "! old_value old_flag -> new_value new_flag name".
+ *
+ * @param[in] old_side Symbols of the old file
+ * @param[in] new_side Symbols of the new file
+ * @param[in,out] writer Writer context the printed names are demangled in (-C)
+ * @return int DF_SUCCESS on success, DF_ERR_NULL_INPUT on invalid input,
+ *             DF_ERR_MALLOC_FAIL on memory allocation failure, DF_ERR_WRITE_FAIL on write failure
+ */
+int Diff_print(const diff_side_t *old_side, const diff_side_t *new_side, writer_ctx_t *writer);
+
+#endif /* _IG_DIFF_H_ */
@@ -0,0 +1,386 @@
+/**
+ * @file diff.c
+ * @brief Symbol table diff of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the --diff implementation. Both files are put in the nm
+ * name order, made total by falling back to the exact name, with a stable
+ * bottom-up merge sort of an array of lines. A single merge of the
+ * two arrays then pairs equal names and reports the symbols added, removed or
+ * changed, in O(n log n) overall for files with millions of symbols.
+ */
+
+#include "../inc_pub/diff.h"
+#include "../../Writer/inc_pub/writer_flagprint.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <stdlib.h>  // For malloc, free
+#include <string.h>  // For strcmp, strlen, memcpy
+#include <unistd.h>  // For write, STDOUT_FILENO
+
+#define DF_OUT_SIZE     (64u * 1024u)  /**< Size of the report output buffer */
+#define DF_VALUE_32     8u             /**< Hex digits of a 32-bit value */
+#define DF_VALUE_64     16u            /**< Hex digits of a 64-bit value */
+
+/**
+ * @brief Report output buffer
+ */
+typedef struct diff_out_s
+{
+    char buf[DF_OUT_SIZE];  /**< Pending bytes */
+    size_t len;             /**< Number of pending bytes */
+    int failed;             /**< Non-zero once a write failed */
+    writer_ctx_t *writer;   /**< Writer context the printed names are demangled in */
+} diff_out_t;
+
+/**
+ * @brief Returns the next character of a name in the nm name order
+ *
+ * Underscores are skipped and lowercase letters are folded to uppercase, as
+ * lineCmp does.
+ *
+ * @param[in,out] name Position in the name, moved past the character
+ * @return unsigned char Folded character, '\0' at the end of the name
+ */
+static unsigned char diff_nameChar(const char **name)
+{
+    unsigned char c;
+
+    while (**name == '_')
+    {
+        (*name)++;
+    }
+    c = (unsigned char)**name;
+    if (c != '\0')
+    {
+        (*name)++;
+    }
+    return ((c >= 'a') && (c <= 'z')) ? (unsigned char)(c - ('a' - 'A')) : c;
+}
+
+/**
+ * @brief Compares two symbols in the diff order
+ *
+ * This is the lineCmp order made total: a name that is a prefix of another
+ * sorts first, and names equal once folded are ordered by their bytes, so
+ * the merge can rely on it.
+ *
+ * @param[in] sym1 First symbol
+ * @param[in] sym2 Second symbol
+ * @return int Negative, zero or positive as sym1 sorts before, with or after sym2
+ */
+static int diff_symCmp(const diff_sym_t *sym1, const diff_sym_t *sym2)
+{
+    const char *name1 = sym1->line->name;  // Resolved, checked by Diff_sideBuild
+    const char *name2 = sym2->line->name;
+    const char *pos1 = name1;
+    const char *pos2 = name2;
+    unsigned char char1, char2;
+
+    if (name1 == name2)
+    {
+        return (0);  // Same interned name
+    }
+    do
+    {
+        char1 = diff_nameChar(&pos1);
+        char2 = diff_nameChar(&pos2);
+    } while ((char1 == char2) && (char1 != '\0'));
+    if (char1 != char2)
+    {
+        return (char1 < char2) ? -1 : 1;
+    }
+    return strcmp(name1, name2);  // Equal once folded
+}
+
+/**
+ * @brief Sorts symbols with a stable bottom-up merge sort
+ * @param[in,out] syms Symbols to sort
+ * @param[in] sym_cnt Number of symbols
+ * @return int DF_SUCCESS on success, DF_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int diff_sort(diff_sym_t *syms, size_t sym_cnt)
+{
+    diff_sym_t *tmp;
+    diff_sym_t *src = syms;
+    diff_sym_t *dst;
+
+    if (sym_cnt < 2)
+    {
+        return DF_SUCCESS;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sym_cnt * sizeof(diff_sym_t));
+    tmp = malloc(sym_cnt * sizeof(diff_sym_t));
+    if (tmp == NULL)
+    {
+        return DF_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    dst = tmp;
+    for (size_t width = 1; width < sym_cnt; width *= 2)
+    {
+        for (size_t lo = 0; lo < sym_cnt; lo += 2 * width)
+        {
+            size_t mid = (lo + width < sym_cnt) ? lo + width : sym_cnt;
+            size_t hi = (mid + width < sym_cnt) ? mid + width : sym_cnt;
+            size_t i = lo, j = mid, k = lo;
+
+            while ((i < mid) && (j < hi))
+            {
+                dst[k++] = (diff_symCmp(&src[j], &src[i]) < 0) ? src[j++] : src[i++];  // Ties keep the left run first
+            }
+            while (i < mid)
+            {
+                dst[k++] = src[i++];
+            }
+            while (j < hi)
+            {
+                dst[k++] = src[j++];
+            }
+        }
+        diff_sym_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != syms)
+    {
+        memcpy(syms, src, sym_cnt * sizeof(diff_sym_t));
+    }
+    free(tmp);
+    return DF_SUCCESS;
+}
+
+/**
+ * @brief Builds one side of the diff from a symbol list
+ * @param[out] side Side to build
+ * @param[in] writer Writer context with the section headers of the file loaded
+ * @param[in] head Head of the symbol list of the file; must outlive the side
+ * @param[in] bit_len Bit length of the file
+ * @return int DF_SUCCESS on success, DF_ERR_NULL_INPUT on invalid input or a
+ *             line with no resolved name, DF_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Diff_sideBuild(diff_side_t *side, const writer_ctx_t *writer, const dl_list_t *head, writer_bit_t bit_len)
+{
+    size_t sym_cnt = 0;
+
+    if (side == NULL)
+    {
+        return DF_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    side->syms = NULL;
+    side->sym_cnt = 0;
+    side->bit_len = bit_len;
+    for (const dl_list_t *node = head; node != NULL; node = node->next)
+    {
+        sym_cnt++;
+    }
+    if (sym_cnt == 0)
+    {
+        return DF_SUCCESS;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sym_cnt * sizeof(diff_sym_t));
+    side->syms = malloc(sym_cnt * sizeof(diff_sym_t));
+    if (side->syms == NULL)
+    {
+        return DF_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    for (const dl_list_t *node = head; node != NULL; node = node->next)
+    {
+        diff_sym_t *sym = &side->syms[side->sym_cnt++];
+
+        if (node->line->name == NULL)
+        {
+            Diff_sideFree(side);
+            return DF_ERR_NULL_INPUT;  // Name still refers to the string table of the file
+        }
+        sym->line = node->line;
+        if (Writer_FlagPrint_flagGet(writer, node->line->bind, node->line->sect_head_idx, node->line->type, &sym->flag) != WR_SUCCESS)
+        {
+            sym->flag = '?';
+        }
+    }
+    if (diff_sort(side->syms, side->sym_cnt) != DF_SUCCESS)
+    {
+        Diff_sideFree(side);
+        return DF_ERR_MALLOC_FAIL;
+    }
+    return DF_SUCCESS;
+}
+
+/**
+ * @brief Frees a side
+ * @param[in,out] side Side to free
+ */
+void Diff_sideFree(diff_side_t *side)
+{
+    if (side != NULL)
+    {
+        free(side->syms);
+        side->syms = NULL;
+        side->sym_cnt = 0;
+    }
+}
+
+/**
+ * @brief Writes the pending report bytes to stdout
+ * @param[in,out] out Output buffer
+ */
+static void diff_outFlush(diff_out_t *out)
+{
+    size_t done = 0;
+
+    while ((done < out->len) && !out->failed)
+    {
+        ssize_t ret;
+
+        STATS_COUNT(STATS_COUNTER_WRITE, 1);
+        ret = write(STDOUT_FILENO, out->buf + done, out->len - done);
+        if (ret <= 0)
+        {
+            out->failed = 1;
+        }
+        else
+        {
+            done += (size_t)ret;
+        }
+    }
+    out->len = 0;
+}
+
+/**
+ * @brief Appends bytes to the report
+ * @param[in,out] out Output buffer
+ * @param[in] str Bytes to append
+ * @param[in] len Number of bytes
+ */
+static void diff_outAppend(diff_out_t *out, const char *str, size_t len)
+{
+    while (len != 0)
+    {
+        size_t chunk = DF_OUT_SIZE - out->len;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        memcpy(out->buf + out->len, str, chunk);
+        out->len += chunk;
+        str += chunk;
+        len -= chunk;
+        if (out->len == DF_OUT_SIZE)
+        {
+            diff_outFlush(out);
+        }
+    }
+}
+
+/**
+ * @brief Appends the value and flag of a symbol as nm prints them
+ * @param[in,out] out Output buffer
+ * @param[in] sym Symbol
+ * @param[in] bit_len Bit length of its file
+ */
+static void diff_outValueFlag(diff_out_t *out, const diff_sym_t *sym, writer_bit_t bit_len)
+{
+    char buf[DF_VALUE_64 + 3];
+    size_t digits = (bit_len == WRITER_VALUEPRINT_32BIT) ? DF_VALUE_32 : DF_VALUE_64;
+    uint64_t value = sym->line->value;
+
+    for (size_t i = digits; i > 0; i--)
+    {
+        buf[i - 1] = (sym->line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED) ? ' ' : "0123456789abcdef"[value & 0xfu];
+        value >>= 4;
+    }
+    buf[digits] = ' ';
+    buf[digits + 1] = sym->flag;
+    diff_outAppend(out, buf, digits + 2);
+}
+
+/**
+ * @brief Appends the printed name of a symbol and ends the line
+ * @param[in,out] out Output buffer
+ * @param[in] sym Symbol
+ */
+static void diff_outName(diff_out_t *out, const diff_sym_t *sym)
+{
+    const char *name = Writer_lineDisplayNameGet(out->writer, sym->line);
+
+    diff_outAppend(out, " ", 1);
+    diff_outAppend(out, name, strlen(name));
+    diff_outAppend(out, "\n", 1);
+}
+
+/**
+ * @brief Prints the differences between two sides to stdout
+ * @param[in] old_side Symbols of the old file
+ * @param[in] new_side Symbols of the new file
+ * @param[in,out] writer Writer context the printed names are demangled in
+ * @return int DF_SUCCESS on success, DF_ERR_NULL_INPUT on invalid input,
+ *             DF_ERR_MALLOC_FAIL on memory allocation failure, DF_ERR_WRITE_FAIL on write failure
+ */
+int Diff_print(const diff_side_t *old_side, const diff_side_t *new_side, writer_ctx_t *writer)
+{
+    diff_out_t *out;
+    size_t i = 0, j = 0;
+    int failed;
+
+    if ((old_side == NULL) || (new_side == NULL))
+    {
+        return DF_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(diff_out_t));
+    out = malloc(sizeof(diff_out_t));
+    if (out == NULL)
+    {
+        return DF_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    out->len = 0;
+    out->failed = 0;
+    out->writer = writer;
+
+    // Merge both sides, pairing equal names in order
+    while ((i < old_side->sym_cnt) || (j < new_side->sym_cnt))
+    {
+        const diff_sym_t *old_sym = (i < old_side->sym_cnt) ? &old_side->syms[i] : NULL;
+        const diff_sym_t *new_sym = (j < new_side->sym_cnt) ? &new_side->syms[j] : NULL;
+        int order = (old_sym == NULL) ? 1 : (new_sym == NULL) ? -1 : diff_symCmp(old_sym, new_sym);
+
+        if (order < 0)
+        {
+            // Removed
+            diff_outAppend(out, "- ", 2);
+            diff_outValueFlag(out, old_sym, old_side->bit_len);
+            diff_outName(out, old_sym);
+            i++;
+        }
+        else if (order > 0)
+        {
+            // Added
+            diff_outAppend(out, "+ ", 2);
+            diff_outValueFlag(out, new_sym, new_side->bit_len);
+            diff_outName(out, new_sym);
+            j++;
+        }
+        else
+        {
+            // Present in both: changed if anything nm shows or keeps differs
+            if ((old_sym->flag != new_sym->flag) || (old_sym->line->value != new_sym->line->value) ||
+                (old_sym->line->bind != new_sym->line->bind) || (old_sym->line->type != new_sym->line->type))
+            {
+                diff_outAppend(out, "! ", 2);
+                diff_outValueFlag(out, old_sym, old_side->bit_len);
+                diff_outAppend(out, " -> ", 4);
+                diff_outValueFlag(out, new_sym, new_side->bit_len);
+                diff_outName(out, new_sym);
+            }
+            i++;
+            j++;
+        }
+    }
+    diff_outFlush(out);
+    failed = out->failed;
+    free(out);
+    return failed ? DF_ERR_WRITE_FAIL : DF_SUCCESS;
+}
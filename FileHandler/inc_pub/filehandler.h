@@ -7,12 +7,14 @@
  *
  * This header declares structures and functions for managing file operations
  * in ft_nm, including opening, closing, and memory mapping files for parsing
- * symbol data.
+ * symbol data. A source can also be a buffer already in memory, in which case
+ * mapping a part of it only points into the buffer.
  */
 
 #ifndef _IG_FILEHANDLER_H_
 #define _IG_FILEHANDLER_H_
 
+#include <stdint.h>     // For uint64_t
 #include <sys/types.h>  // For off_t, size_t
 
 /**
@@ -33,12 +35,13 @@ enum FileHandler_Error {
 typedef struct source_file_s
 {
     int fd;                /**< File descriptor */
+    const void *buf;       /**< Buffer read instead of a file (FileHandler_bufferOpen), or NULL */
     void* addr;            /**< Starting address of the memory-mapped region */
     void* map;             /**< Pointer to the requested offset within the mapped region */
     size_t addr_len;       /**< Length of the entire mapped region */
     size_t map_len;        /**< Length of the requested data within the mapped region */
     off_t page_offset;     /**< Page-aligned offset used for mapping */
-    size_t size;           /**< Total size of the file */
+    uint64_t size;         /**< Total size of the file, which may exceed size_t on 32-bit hosts */
     int page_size;         /**< System page size */
 } source_file_t;
 
@@ -58,6 +61,18 @@ int FileHandler_structSetup(source_file_t *file);
  */
 int FileHandler_fileOpen(source_file_t *file, const char *path);
 
+/**
+ * @brief Opens a buffer in memory as a source
+ *
+ * The buffer is not copied and must stay valid until the source is closed.
+ *
+ * @param[in,out] file Pointer to the source_file_t structure
+ * @param[in] buf Buffer holding the file contents
+ * @param[in] size Length of the buffer
+ * @return int FH_SUCCESS on success, FH_ERR_NULL_INPUT if file or buf is NULL
+ */
+int FileHandler_bufferOpen(source_file_t *file, const void *buf, uint64_t size);
+
 /**
  * @brief Closes an open file and frees associated resources
  * @param[in,out] file Pointer to the source_file_t structure
@@ -68,6 +83,10 @@ int FileHandler_fileClose(source_file_t *file);
 
 /**
  * @brief Maps a portion of the file into memory
+ *
+ * Offsets are 64-bit (off_t with _FILE_OFFSET_BITS=64), so any part of a file
+ * larger than 4 GiB can be mapped as long as the part itself fits in size_t.
+ *
  * @param[in,out] file Pointer to the source_file_t structure
  * @param[in] length Length of the data to map
  * @param[in] offset Offset within the file to start mapping
@@ -10,6 +10,8 @@
  */
 
 #include "../inc_pub/filehandler.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include "../../Probe/inc_pub/probe.h"  // For FT_NM_PROBE2
 #include <fcntl.h>      // For open, O_RDONLY
 #include <stdlib.h>     // For NULL
 #include <sys/mman.h>   // For mmap, munmap, MAP_FAILED
@@ -34,6 +36,7 @@ int FileHandler_structSetup(source_file_t *file)
         return FH_ERR_NULL_INPUT;  // Invalid input: NULL pointer
     }
     file->fd = -1;                 // Initialize file descriptor as invalid
+    file->buf = NULL;              // Not a buffer source
     file->addr = NULL;             // No mapped address yet
     file->map = NULL;              // No mapped data pointer
     file->size = 0;                // File size unknown
@@ -82,6 +85,13 @@ int FileHandler_fileClose(source_file_t *file)
     {
         return FH_ERR_NULL_INPUT;  // Invalid input: NULL pointer
     }
+    if (file->buf != NULL)
+    {
+        file->buf = NULL;           // Buffer belongs to the caller
+        file->map = NULL;
+        file->map_len = 0;
+        return FH_SUCCESS;
+    }
     if (file->fd == -1)
     {
         return FH_ERR_NOT_OPEN;    // File not open
@@ -110,7 +120,7 @@ int FileHandler_fileOpen(source_file_t *file, const char *path)
     {
         return FH_ERR_NULL_INPUT;  // Invalid input: NULL pointer
     }
-    if (file->fd != -1)
+    if ((file->fd != -1) || (file->buf != NULL))
     {
         FileHandler_fileClose(file);  // Close any existing open file
     }
@@ -125,7 +135,7 @@ int FileHandler_fileOpen(source_file_t *file, const char *path)
         return ret ? ret : FH_ERR_INTERNAL;     // Return close error or internal failure
     }
 
-    file->size = sb.st_size;          // Set file size
+    file->size = (uint64_t)sb.st_size;  // Set file size
     file->page_size = getpagesize();  // Get system page size
     file->addr = NULL;                // No mapped address yet
     file->map = NULL;                 // No mapped data pointer
@@ -134,6 +144,32 @@ int FileHandler_fileOpen(source_file_t *file, const char *path)
     return FH_SUCCESS;                // Success
 }
 
+/**
+ * @brief Opens a buffer in memory as a source
+ * @param[in,out] file Pointer to the source_file_t structure
+ * @param[in] buf Buffer holding the file contents
+ * @param[in] size Length of the buffer
+ * @return int FH_SUCCESS on success, FH_ERR_NULL_INPUT if file or buf is NULL
+ */
+int FileHandler_bufferOpen(source_file_t *file, const void *buf, uint64_t size)
+{
+    if ((file == NULL) || (buf == NULL))
+    {
+        return FH_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if ((file->fd != -1) || (file->buf != NULL))
+    {
+        FileHandler_fileClose(file);  // Close any existing open file
+    }
+    file->buf = buf;                  // Mappings point into the buffer
+    file->size = size;
+    file->addr = NULL;                // Nothing is ever unmapped
+    file->addr_len = 0;
+    file->map = NULL;
+    file->map_len = 0;
+    return FH_SUCCESS;
+}
+
 /**
  * @brief Maps a portion of the file into memory
  * @param[in,out] file Pointer to the source_file_t structure
@@ -149,11 +185,11 @@ int FileHandler_mapGet(source_file_t *file, size_t length, off_t offset)
     {
         return FH_ERR_NULL_INPUT;  // Invalid input: NULL pointer
     }
-    if (file->fd == FH_CALL_FAILED)
+    if ((file->fd == FH_CALL_FAILED) && (file->buf == NULL))
     {
         return FH_ERR_NOT_OPEN;    // File not open
     }
-    if ((size_t)offset >= file->size)
+    if ((offset < 0) || ((uint64_t)offset >= file->size))
     {
         return FH_ERR_NULL_INPUT;  // Offset beyond file size
     }
@@ -165,13 +201,21 @@ int FileHandler_mapGet(source_file_t *file, size_t length, off_t offset)
     {
         FileHandler_mapFree(file);  // Free existing mapping
     }
-    if (offset + length > file->size)  // Truncate to file size if beyond end
+    if ((uint64_t)length > file->size - (uint64_t)offset)  // Truncate to file size if beyond end
+    {
+        length = (size_t)(file->size - (uint64_t)offset);
+    }
+    if (file->buf != NULL)
     {
-        length = file->size - offset;
+        file->map = (void *)((const char *)file->buf + offset);  // Buffer is already in memory, and only read
+        file->map_len = length;
+        return FH_SUCCESS;
     }
-    file->page_offset = offset & ~(file->page_size - 1);  // Align offset to page boundary
+    FT_NM_PROBE2(map_get, offset, length);
+    file->page_offset = offset & ~((off_t)file->page_size - 1);  // Align offset to page boundary
     file->map_len = length;                               // Set mapped data length
     file->addr_len = length + (offset - file->page_offset);  // Total mapped region length
+    STATS_COUNT(STATS_COUNTER_MMAP, 1);
     file->addr = mmap(NULL, file->addr_len, PROT_READ, MAP_PRIVATE, file->fd, file->page_offset);  // Map file
     if (file->addr == MAP_FAILED)
     {
@@ -0,0 +1,183 @@
+/**
+ * @file ftnm.h
+ * @brief Public header of libftnm, the embeddable symbol listing library
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the handle API of libftnm. A handle is opened on an
+ * ELF file or on an ELF image already in memory, its symbols are read with a
+ * filter, optionally sorted in nm order, and then read back one by one as
+ * structures, without spawning nm or parsing its text. Every call works on
+ * its handle only, so different handles can be used from different threads.
+ *
+ * @section usage Usage
+ * @code
+ * ftnm_t *nm;
+ * ftnm_symbol_t sym;
+ * if (FtNm_fileOpen(&nm, "a.out", NULL) == FN_SUCCESS)
+ * {
+ *     FtNm_load(nm, NULL);
+ *     FtNm_sort(nm, FTNM_SORT_NAME, 0);
+ *     for (size_t i = 0; FtNm_symbolGet(nm, i, &sym) == FN_SUCCESS; i++)
+ *     {
+ *         printf("%c %s\n", sym.flag, sym.name);
+ *     }
+ *     FtNm_close(&nm);
+ * }
+ * @endcode
+ */
+
+#ifndef _IG_FTNM_H_
+#define _IG_FTNM_H_
+
+#include "../../Match/inc_pub/match.h"  // For match_t
+#include "../../Writer/inc_pub/writer_flagprint.h"  // For writer_flagprint_bind_e, writer_flagprint_type_e
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint64_t, uint32_t
+
+/**
+ * @brief Error codes for libftnm operations
+ */
+enum FtNm_Error {
+    FN_FILTERED = 1,           /**< Symbol is valid but rejected by the filter (FtNm_Elf_entryRead) */
+    FN_SUCCESS = 0,            /**< Success */
+    FN_ERR_NULL_INPUT = -1,    /**< Invalid input (NULL pointer) */
+    FN_ERR_MALLOC_FAIL = -2,   /**< Memory allocation failed */
+    FN_ERR_FILE_FAIL = -3,     /**< File could not be opened or mapped, errno is set */
+    FN_ERR_BAD_FORMAT = -4,    /**< Input is not an ELF file with the requested symbol table */
+    FN_ERR_RANGE = -5          /**< Symbol index past the loaded symbols */
+};
+
+/**
+ * @brief Sort orders of FtNm_sort
+ */
+typedef enum
+{
+    FTNM_SORT_NONE  = 0,  /**< Symbol table order (nm -p) */
+    FTNM_SORT_NAME  = 1,  /**< Name order of nm */
+    FTNM_SORT_VALUE = 2,  /**< Symbol value, undefined symbols first (nm -n) */
+    FTNM_SORT_SIZE  = 3   /**< Symbol size, undefined symbols first (nm --size-sort) */
+} ftnm_sort_e;
+
+/**
+ * @brief Symbols kept by FtNm_load
+ */
+typedef struct ftnm_filter_s
+{
+    unsigned short global_only;     /**< Drop local symbols (nm -g) */
+    unsigned short undefined_only;  /**< Keep only undefined symbols (nm -u) */
+    unsigned short sized_only;      /**< Keep only defined symbols with a non-zero size (nm --size-sort) */
+    const match_t *match;           /**< Keep only the names a compiled pattern set matches (--match), or NULL */
+} ftnm_filter_t;
+
+/**
+ * @brief One symbol read back from a handle
+ */
+typedef struct ftnm_symbol_s
+{
+    const char *name;                /**< Symbol name; valid until the handle is closed */
+    uint64_t value;                  /**< Symbol value */
+    uint64_t size;                   /**< Symbol size */
+    uint32_t sect_head_idx;          /**< Section header index, extended indices resolved */
+    writer_flagprint_bind_e bind;    /**< Symbol binding */
+    writer_flagprint_type_e type;    /**< Symbol type */
+    char flag;                       /**< Type letter nm prints, like 'T' or 'u' */
+} ftnm_symbol_t;
+
+/**
+ * @brief Opaque libftnm handle
+ */
+typedef struct ftnm_s ftnm_t;
+
+/**
+ * @brief Opens an ELF file
+ * @param[out] nm Handle to create; closed with FtNm_close
+ * @param[in] path Path of the file
+ * @param[in] symtab_name Symbol table section to read, NULL for ".symtab"
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT on invalid input,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, FN_ERR_FILE_FAIL if the
+ *             file cannot be read (errno set), FN_ERR_BAD_FORMAT if it is not a valid ELF file
+ */
+int FtNm_fileOpen(ftnm_t **nm, const char *path, const char *symtab_name);
+
+/**
+ * @brief Opens an ELF image held in memory
+ *
+ * The buffer is not copied and must stay valid until the handle is closed.
+ *
+ * @param[out] nm Handle to create; closed with FtNm_close
+ * @param[in] buf ELF image
+ * @param[in] len Length of the image
+ * @param[in] symtab_name Symbol table section to read, NULL for ".symtab"
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT on invalid input,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, FN_ERR_BAD_FORMAT if
+ *             the image is not a valid ELF file
+ */
+int FtNm_bufferOpen(ftnm_t **nm, const void *buf, size_t len, const char *symtab_name);
+
+/**
+ * @brief Returns the class of the opened file
+ * @param[in] nm Handle
+ * @return unsigned int 32 or 64, or 0 if nm is NULL
+ */
+unsigned int FtNm_bitsGet(const ftnm_t *nm);
+
+/**
+ * @brief Reads the symbols kept by a filter, in symbol table order
+ *
+ * Section and file symbols are never kept. Loading again replaces the symbols
+ * and any order set by FtNm_sort.
+ *
+ * @param[in,out] nm Handle
+ * @param[in] filter Symbols to keep, NULL to keep all
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT if nm is NULL,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, FN_ERR_BAD_FORMAT for a malformed symbol
+ */
+int FtNm_load(ftnm_t *nm, const ftnm_filter_t *filter);
+
+/**
+ * @brief Orders the loaded symbols
+ * @param[in,out] nm Handle
+ * @param[in] sort Sort order
+ * @param[in] reverse Non-zero to reverse the order (nm -r); ignored for FTNM_SORT_NONE
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT if nm is NULL,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, the previous order being kept
+ */
+int FtNm_sort(ftnm_t *nm, ftnm_sort_e sort, int reverse);
+
+/**
+ * @brief Returns the number of loaded symbols
+ * @param[in] nm Handle
+ * @return size_t Number of symbols, 0 if nm is NULL or nothing is loaded
+ */
+size_t FtNm_countGet(const ftnm_t *nm);
+
+/**
+ * @brief Reads back a loaded symbol, in the order set by FtNm_sort
+ * @param[in] nm Handle
+ * @param[in] idx Position of the symbol, from 0 to FtNm_countGet() - 1
+ * @param[out] sym Symbol
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT on invalid input,
+ *             FN_ERR_RANGE if idx is past the loaded symbols
+ */
+int FtNm_symbolGet(const ftnm_t *nm, size_t idx, ftnm_symbol_t *sym);
+
+/**
+ * @brief Closes a handle and frees everything it holds
+ * @param[in,out] nm Handle; set to NULL
+ */
+void FtNm_close(ftnm_t **nm);
+
+/**
+ * @brief Compares two symbol names in nm order
+ *
+ * Case is folded and underscores are skipped, like nm without a locale.
+ *
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+int FtNm_nameCmp(const char *name1, const char *name2);
+
+#endif /* _IG_FTNM_H_ */
@@ -0,0 +1,205 @@
+/**
+ * @file ftnm_elf.h
+ * @brief Public header of the ELF reading layer of libftnm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the functions libftnm handles are built on, for
+ * clients that work on the parsed tables directly, like nm.out itself: a
+ * source is parsed up to its mapped symbol string table, and symbol table
+ * entries are read into writer lines through a filter.
+ */
+
+#ifndef _IG_FTNM_ELF_H_
+#define _IG_FTNM_ELF_H_
+
+#include "ftnm.h"
+#include "../../ElfParser/inc_pub/elfparser_secthead.h"
+#include "../../ElfParser/inc_pub/elfparser_symtable.h"
+#include "../../FileHandler/inc_pub/filehandler.h"
+#include "../../Writer/inc_pub/writer.h"
+
+#define FTNM_SLICE_ENTRIES  4096u  /**< Entries of a slice read by FtNm_Elf_sliceEntryRead */
+
+/**
+ * @brief Section header table of a file, held by libftnm
+ *
+ * Decoded by FtNm_Elf_sourceParse rather than the parser, so that the
+ * extended section count and name table index of files with 0xff00 sections
+ * or more are held whole.
+ */
+typedef struct ftnm_sects_s
+{
+    elfparser_secthead_entry_t *table;  /**< Section headers, their names pointing into names */
+    uint32_t table_len;                 /**< Number of sections */
+    uint32_t string_table_idx;          /**< Section index of the section name table */
+    char *names;                        /**< Copy of the section name table, null-terminated */
+} ftnm_sects_t;
+
+/**
+ * @brief Symbol table left in the file and read a slice of entries at a time
+ *
+ * Set up by FtNm_Elf_sourceParse instead of parsing the whole table. The
+ * slice read last is in symtab, its entries numbered from 0, with the
+ * extended section indices of its entries in shndx when one of them needs it.
+ */
+typedef struct ftnm_symslice_s
+{
+    source_file_t file;                  /**< Descriptor of the parsed source, mapping the slice being read */
+    uint64_t offset;                     /**< File offset of the symbol table */
+    uint64_t shndx_offset;               /**< File offset of the extended section index table */
+    size_t sym_cnt;                      /**< Number of entries of the whole table */
+    size_t entry_size;                   /**< Size of one entry in the file */
+    uint32_t strtab_idx;                 /**< Section index of the symbol string table */
+    uint32_t sect_cnt;                   /**< Number of sections, bounding the extended indices */
+    uint8_t elf_class;                   /**< ELF class of the file */
+    uint8_t elf_data;                    /**< Data encoding of the file */
+    uint8_t has_shndx;                   /**< Non-zero if an extended index table covers the symbol table */
+    elfparser_symtable_t symtab;         /**< Entries of the slice read last */
+    uint32_t *shndx;                     /**< Extended indices of the slice, or NULL if none of its entries needs one */
+    uint32_t *shndx_buf;                 /**< Allocated extended indices */
+    size_t cap;                          /**< Entries allocated for a slice */
+    size_t first;                        /**< Index of the first entry of the slice read last */
+    size_t end;                          /**< Index past the last entry of the slice read last, 0 if none */
+} ftnm_symslice_t;
+
+/**
+ * @brief Parses an opened source up to its symbol string table
+ *
+ * Symbol names are not resolved, and no entry of the symbol table is read
+ * here: the entries are read a slice at a time with FtNm_Elf_sliceRead and
+ * FtNm_Elf_sliceEntryRead, through a mapping of their own on the source, so
+ * memory does not grow with the size of the table. On success the source
+ * stays open with its symbol string table mapped (file->map, file->map_len),
+ * so that names are only looked up for symbols that are sorted or printed;
+ * the caller closes it after FtNm_Elf_sliceFree. On failure the source is
+ * closed before returning.
+ *
+ * @param[in,out] file Source opened with FileHandler_fileOpen or FileHandler_bufferOpen
+ * @param[out] sects Section table; freed by the caller with FtNm_Elf_sectsFree
+ * @param[out] file_bit File bit width (32/64)
+ * @param[in] symtab_name Name of the symbol table section (".symtab" or ".dynsym")
+ * @param[out] slices Symbol table to read; freed by the caller with FtNm_Elf_sliceFree
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL if a part of the file cannot be mapped,
+ *             FN_ERR_BAD_FORMAT for parsing errors, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int FtNm_Elf_sourceParse(source_file_t *file, ftnm_sects_t *sects, writer_bit_t *file_bit,
+                         const char *symtab_name, ftnm_symslice_t *slices);
+
+/**
+ * @brief Opens and parses an ELF file up to its symbol string table
+ *
+ * Same as FtNm_Elf_sourceParse on the file opened from file_name.
+ *
+ * @param[in] file_name Path to the ELF file to parse
+ * @param[out] file File structure; left holding the symbol string table mapping
+ * @param[out] sects Section table; freed by the caller with FtNm_Elf_sectsFree
+ * @param[out] file_bit File bit width (32/64)
+ * @param[in] symtab_name Name of the symbol table section (".symtab" or ".dynsym")
+ * @param[out] slices Symbol table to read; freed by the caller with FtNm_Elf_sliceFree
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL for file errors (errno set),
+ *             FN_ERR_BAD_FORMAT for parsing errors, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int FtNm_Elf_fileParse(const char *file_name, source_file_t *file, ftnm_sects_t *sects, writer_bit_t *file_bit,
+                       const char *symtab_name, ftnm_symslice_t *slices);
+
+/**
+ * @brief Frees a section table
+ * @param[in,out] sects Section table filled by FtNm_Elf_sourceParse
+ */
+void FtNm_Elf_sectsFree(ftnm_sects_t *sects);
+
+/**
+ * @brief Reads a slice of the entries of a symbol table from the file
+ *
+ * The previous slice is replaced. Entry i of the table becomes entry
+ * i - first of slices->symtab, to be read with FtNm_Elf_entryRead and
+ * slices->shndx.
+ *
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] first Index of the first entry
+ * @param[in] end Index past the last entry, at most slices->sym_cnt
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL if the slice cannot be mapped,
+ *             FN_ERR_BAD_FORMAT for a malformed extended index, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int FtNm_Elf_sliceRead(ftnm_symslice_t *slices, size_t first, size_t end);
+
+/**
+ * @brief Reads one entry of a symbol table left in the file, applying a filter
+ *
+ * Same as FtNm_Elf_entryRead on entry i of the whole table. When the entry
+ * is not in the slice read last, the slice of FTNM_SLICE_ENTRIES entries
+ * holding it is read first, so reading the table keeps memory bounded
+ * whatever its size.
+ *
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] i Index of the entry, at most slices->sym_cnt - 1
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab Symbol string table, read when the filter has name patterns
+ * @param[in] strtab_len Length of the symbol string table
+ * @param[out] line Line filled when the symbol is kept
+ * @return int FN_SUCCESS if the symbol is kept, FN_FILTERED if it is not, FN_ERR_BAD_FORMAT for a
+ *             malformed entry, FN_ERR_FILE_FAIL or FN_ERR_MALLOC_FAIL if its slice cannot be read
+ */
+int FtNm_Elf_sliceEntryRead(ftnm_symslice_t *slices, size_t i, const ftnm_filter_t *filter,
+                            const char *strtab, size_t strtab_len, writer_line_t *line);
+
+/**
+ * @brief Checks every entry of a symbol table left in the file the way FtNm_Elf_sliceEntryRead reads it
+ *
+ * Lets a listing printed while the table is read fail before its first line,
+ * as a sorted listing does. The table is read a slice at a time, and name
+ * patterns of the filter are not tested.
+ *
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab_len Length of the symbol string table
+ * @return int FN_SUCCESS if every entry can be read, FN_ERR_BAD_FORMAT for a malformed entry,
+ *             FN_ERR_FILE_FAIL or FN_ERR_MALLOC_FAIL if a slice cannot be read
+ */
+int FtNm_Elf_sliceCheck(ftnm_symslice_t *slices, const ftnm_filter_t *filter, size_t strtab_len);
+
+/**
+ * @brief Reads the value and section of one entry of a symbol table left in the file
+ *
+ * For entries looked up out of order, like the symbols of relocations. The
+ * section is the raw st_shndx, or the extended index for SHN_XINDEX.
+ *
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] i Index of the entry
+ * @param[out] value Value of the symbol
+ * @param[out] sect Section index of the symbol
+ * @return int FN_SUCCESS on success, FN_ERR_BAD_FORMAT if there is no such entry,
+ *             FN_ERR_FILE_FAIL or FN_ERR_MALLOC_FAIL if its slice cannot be read
+ */
+int FtNm_Elf_sliceSymbolGet(ftnm_symslice_t *slices, size_t i, uint64_t *value, uint32_t *sect);
+
+/**
+ * @brief Frees the slice buffers of a symbol table and its mapping of the file
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ */
+void FtNm_Elf_sliceFree(ftnm_symslice_t *slices);
+
+/**
+ * @brief Reads one symbol table entry into a symbol line, applying a filter
+ *
+ * Section and file symbols and the symbols rejected by the filter are not
+ * kept. The name is not looked up: the line keeps the st_name offset, which
+ * is only checked against the string table length. Name patterns of the
+ * filter are tested last, on the raw name in the string table.
+ *
+ * @param[in] elf_symbol_table Symbol table to read
+ * @param[in] i Index of the entry
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab Symbol string table, read when the filter has name patterns
+ * @param[in] strtab_len Length of the symbol string table
+ * @param[in] shndx_table Extended section indices of the slice (slices->shndx), or NULL
+ * @param[out] line Line filled when the symbol is kept
+ * @return int FN_SUCCESS if the symbol is kept, FN_FILTERED if it is not,
+ *             FN_ERR_BAD_FORMAT for a malformed entry
+ */
+int FtNm_Elf_entryRead(const elfparser_symtable_t *elf_symbol_table, size_t i, const ftnm_filter_t *filter,
+                       const char *strtab, size_t strtab_len, const uint32_t *shndx_table, writer_line_t *line);
+
+#endif /* _IG_FTNM_ELF_H_ */
@@ -0,0 +1,278 @@
+/**
+ * @file ftnm.c
+ * @brief Handle API of libftnm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the libftnm handles. A handle owns its source, the
+ * parsed tables and the loaded symbols, kept in a structure-of-arrays symbol
+ * table whose names point into the source's string table mapping. Sorting
+ * uses the same table sort as nm.out, so a sorted handle reads back in the
+ * order nm.out prints; type letters are looked up against the handle's own
+ * section headers rather than the table loaded in the writer.
+ */
+
+#include "../inc_pub/ftnm_elf.h"
+#include "../../SymTab/inc_pub/symtab.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For malloc, free
+
+#define FTNM_SYMTAB_DEFAULT ".symtab"  /**< Symbol table read when none is named */
+
+/**
+ * @brief libftnm handle
+ */
+struct ftnm_s
+{
+    source_file_t file;                /**< Source, holding the symbol string table mapping */
+    ftnm_symslice_t slices;            /**< Symbol table, read a slice at a time */
+    ftnm_sects_t sects;                /**< Section headers */
+    writer_bit_t file_bit;             /**< File bit width */
+    symtab_t tab;                      /**< Loaded symbols */
+    ftnm_sort_e sort;                  /**< Order set by FtNm_sort */
+    int reverse;                       /**< Non-zero if the order is reversed */
+};
+
+/**
+ * @brief Allocates a handle and parses its opened source
+ * @param[out] nm Handle to create
+ * @param[in,out] file Opened source, moved into the handle; closed on failure
+ * @param[in] symtab_name Symbol table section to read, NULL for ".symtab"
+ * @return int FN_SUCCESS on success, FtNm_Elf_sourceParse error or FN_ERR_MALLOC_FAIL on failure
+ */
+static int ftnm_create(ftnm_t **nm, source_file_t *file, const char *symtab_name)
+{
+    ftnm_t *handle;
+    int ret;
+
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(ftnm_t));
+    handle = malloc(sizeof(ftnm_t));
+    if (handle == NULL)
+    {
+        FileHandler_fileClose(file);
+        return FN_ERR_MALLOC_FAIL;
+    }
+    handle->file = *file;
+    handle->tab = (symtab_t){0};
+    handle->sort = FTNM_SORT_NONE;
+    handle->reverse = 0;
+    ret = FtNm_Elf_sourceParse(&handle->file, &handle->sects, &handle->file_bit,
+                               (symtab_name != NULL) ? symtab_name : FTNM_SYMTAB_DEFAULT, &handle->slices);
+    if (ret != FN_SUCCESS)
+    {
+        free(handle);
+        return ret;
+    }
+    *nm = handle;
+    return FN_SUCCESS;
+}
+
+/**
+ * @brief Opens an ELF file
+ * @param[out] nm Handle to create; closed with FtNm_close
+ * @param[in] path Path of the file
+ * @param[in] symtab_name Symbol table section to read, NULL for ".symtab"
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT on invalid input,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, FN_ERR_FILE_FAIL if the
+ *             file cannot be read (errno set), FN_ERR_BAD_FORMAT if it is not a valid ELF file
+ */
+int FtNm_fileOpen(ftnm_t **nm, const char *path, const char *symtab_name)
+{
+    source_file_t file;
+
+    if ((nm == NULL) || (path == NULL))
+    {
+        return FN_ERR_NULL_INPUT;
+    }
+    *nm = NULL;
+    FileHandler_structSetup(&file);
+    if (FileHandler_fileOpen(&file, path) != FH_SUCCESS)
+    {
+        return FN_ERR_FILE_FAIL;
+    }
+    return ftnm_create(nm, &file, symtab_name);
+}
+
+/**
+ * @brief Opens an ELF image held in memory
+ * @param[out] nm Handle to create; closed with FtNm_close
+ * @param[in] buf ELF image
+ * @param[in] len Length of the image
+ * @param[in] symtab_name Symbol table section to read, NULL for ".symtab"
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT on invalid input,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, FN_ERR_BAD_FORMAT if
+ *             the image is not a valid ELF file
+ */
+int FtNm_bufferOpen(ftnm_t **nm, const void *buf, size_t len, const char *symtab_name)
+{
+    source_file_t file;
+    int ret;
+
+    if ((nm == NULL) || (buf == NULL))
+    {
+        return FN_ERR_NULL_INPUT;
+    }
+    *nm = NULL;
+    FileHandler_structSetup(&file);
+    FileHandler_bufferOpen(&file, buf, (uint64_t)len);
+    ret = ftnm_create(nm, &file, symtab_name);
+    return (ret == FN_ERR_FILE_FAIL) ? FN_ERR_BAD_FORMAT : ret;  // Only a part past the end cannot be mapped
+}
+
+/**
+ * @brief Returns the class of the opened file
+ * @param[in] nm Handle
+ * @return unsigned int 32 or 64, or 0 if nm is NULL
+ */
+unsigned int FtNm_bitsGet(const ftnm_t *nm)
+{
+    if (nm == NULL)
+    {
+        return 0;
+    }
+    return (nm->file_bit == WRITER_VALUEPRINT_32BIT) ? 32u : 64u;
+}
+
+/**
+ * @brief Reads the symbols kept by a filter, in symbol table order
+ * @param[in,out] nm Handle
+ * @param[in] filter Symbols to keep, NULL to keep all
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT if nm is NULL,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, FN_ERR_BAD_FORMAT for a malformed symbol
+ */
+int FtNm_load(ftnm_t *nm, const ftnm_filter_t *filter)
+{
+    static const ftnm_filter_t keep_all = {0, 0, 0, NULL};
+    size_t sym_cnt;
+    writer_line_t line;
+    int ret = FN_SUCCESS;
+
+    if (nm == NULL)
+    {
+        return FN_ERR_NULL_INPUT;
+    }
+    filter = (filter != NULL) ? filter : &keep_all;
+    SymTab_free(&nm->tab);
+    nm->sort = FTNM_SORT_NONE;
+    nm->reverse = 0;
+
+    // Sized for every entry but the null symbol, which is skipped
+    sym_cnt = nm->slices.sym_cnt;
+    if (SymTab_create(&nm->tab, (sym_cnt > 1) ? (sym_cnt - 1) : 0, nm->file.map, nm->file.map_len) != ST_SUCCESS)
+    {
+        return FN_ERR_MALLOC_FAIL;
+    }
+    for (size_t i = 1; (i < sym_cnt) && (ret == FN_SUCCESS); i++)
+    {
+        ret = FtNm_Elf_sliceEntryRead(&nm->slices, i, filter, nm->file.map, nm->file.map_len, &line);
+        if (ret == FN_SUCCESS)
+        {
+            SymTab_push(&nm->tab, &line);
+        }
+        else if (ret == FN_FILTERED)
+        {
+            ret = FN_SUCCESS;
+        }
+    }
+    if (ret != FN_SUCCESS)
+    {
+        SymTab_free(&nm->tab);
+    }
+    return ret;
+}
+
+/**
+ * @brief Orders the loaded symbols
+ * @param[in,out] nm Handle
+ * @param[in] sort Sort order
+ * @param[in] reverse Non-zero to reverse the order (nm -r); ignored for FTNM_SORT_NONE
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT if nm is NULL,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure, the previous order being kept
+ */
+int FtNm_sort(ftnm_t *nm, ftnm_sort_e sort, int reverse)
+{
+    if (nm == NULL)
+    {
+        return FN_ERR_NULL_INPUT;
+    }
+    if (sort != FTNM_SORT_NONE)
+    {
+        if (SymTab_sort(&nm->tab, (sort == FTNM_SORT_VALUE) ? SYMTAB_KEY_VALUE :
+                                  (sort == FTNM_SORT_SIZE) ? SYMTAB_KEY_SIZE : SYMTAB_KEY_NAME, FtNm_nameCmp) != ST_SUCCESS)
+        {
+            return FN_ERR_MALLOC_FAIL;
+        }
+    }
+    nm->sort = sort;
+    nm->reverse = reverse;
+    return FN_SUCCESS;
+}
+
+/**
+ * @brief Returns the number of loaded symbols
+ * @param[in] nm Handle
+ * @return size_t Number of symbols, 0 if nm is NULL or nothing is loaded
+ */
+size_t FtNm_countGet(const ftnm_t *nm)
+{
+    return (nm != NULL) ? nm->tab.len : 0;
+}
+
+/**
+ * @brief Reads back a loaded symbol, in the order set by FtNm_sort
+ * @param[in] nm Handle
+ * @param[in] idx Position of the symbol, from 0 to FtNm_countGet() - 1
+ * @param[out] sym Symbol
+ * @return int FN_SUCCESS on success, FN_ERR_NULL_INPUT on invalid input,
+ *             FN_ERR_RANGE if idx is past the loaded symbols
+ */
+int FtNm_symbolGet(const ftnm_t *nm, size_t idx, ftnm_symbol_t *sym)
+{
+    writer_line_t line;
+
+    if ((nm == NULL) || (sym == NULL))
+    {
+        return FN_ERR_NULL_INPUT;
+    }
+    if (idx >= nm->tab.len)
+    {
+        return FN_ERR_RANGE;
+    }
+    if ((nm->sort != FTNM_SORT_NONE) && (nm->tab.order != NULL))
+    {
+        idx = (nm->reverse == 0) ? nm->tab.order[idx] : nm->tab.order[nm->tab.len - 1 - idx];
+    }
+    SymTab_lineGet(&nm->tab, idx, &line);
+    sym->name = line.name;
+    sym->value = line.value;
+    sym->size = line.size;
+    sym->sect_head_idx = line.sect_head_idx;
+    sym->bind = line.bind;
+    sym->type = line.type;
+    if (Writer_FlagPrint_flagFind(nm->sects.table, nm->sects.table_len, line.bind, line.sect_head_idx, line.type,
+                                  &sym->flag) != WR_SUCCESS)
+    {
+        sym->flag = '?';  // Section index names no section
+    }
+    return FN_SUCCESS;
+}
+
+/**
+ * @brief Closes a handle and frees everything it holds
+ * @param[in,out] nm Handle; set to NULL
+ */
+void FtNm_close(ftnm_t **nm)
+{
+    if ((nm == NULL) || (*nm == NULL))
+    {
+        return;
+    }
+    SymTab_free(&(*nm)->tab);
+    FtNm_Elf_sliceFree(&(*nm)->slices);
+    FtNm_Elf_sectsFree(&(*nm)->sects);
+    FileHandler_fileClose(&(*nm)->file);
+    free(*nm);
+    *nm = NULL;
+}
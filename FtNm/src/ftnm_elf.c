@@ -0,0 +1,986 @@
+/**
+ * @file ftnm_elf.c
+ * @brief ELF reading layer of libftnm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the parsing of an ELF source up to its mapped symbol
+ * string table, the section header table being decoded here so its count
+ * and indices are never narrowed, the reading of the symbol table left in
+ * the file a slice at a time, and the filtered reading of symbol table
+ * entries into writer lines. It is shared by the libftnm handles and by
+ * nm.out, so both read a file the same way; nothing here prints or uses
+ * state loaded in the writer.
+ */
+
+#include "../inc_pub/ftnm_elf.h"
+#include "../../ElfParser/inc_pub/elfparser_header.h"
+#include "../../Stats/inc_pub/stats.h"  // For Stats_stageBegin, STATS_COUNT
+#include "../../Probe/inc_pub/probe.h"  // For FT_NM_PROBE1
+#include <stdlib.h>  // For malloc, realloc, free
+#include <string.h>  // For memset, memcpy, strcmp
+
+// ELF constants the parser does not provide
+#define ELF_SHT_SYMTAB_SHNDX    18u   /**< Section type of the extended section index table */
+#define ELF_DATA_MSB            2u    /**< Big-endian data encoding (ELFDATA2MSB) */
+#define ELF_SHNDX_ENTRY_SIZE    4u    /**< Size of one extended section index */
+#define ELF_SHDR32_SIZE         40u   /**< Size of an Elf32_Shdr entry */
+#define ELF_SHDR64_SIZE         64u   /**< Size of an Elf64_Shdr entry */
+#define ELF_SYM32_SIZE          16u   /**< Size of an Elf32_Sym entry */
+#define ELF_SYM64_SIZE          24u   /**< Size of an Elf64_Sym entry */
+#define ELF_STB_LOCAL           0u    /**< Local binding */
+#define ELF_STB_GLOBAL          1u    /**< Global binding */
+#define ELF_STB_WEAK            2u    /**< Weak binding */
+#define ELF_STB_GNU_UNIQUE      10u   /**< GNU unique binding */
+#define ELF_STT_NOTYPE          0u    /**< Symbol without a type */
+#define ELF_STT_OBJECT          1u    /**< Data object */
+#define ELF_STT_FUNC            2u    /**< Function */
+#define ELF_STT_SECTION         3u    /**< Section symbol */
+#define ELF_STT_FILE            4u    /**< Source file symbol */
+#define ELF_STT_COMMON          5u    /**< Common data object */
+#define ELF_STT_TLS             6u    /**< Thread-local data object */
+#define ELF_STT_GNU_IFUNC       10u   /**< Indirect function */
+#define ELF_ST_UNKNOWN          0xffu /**< Binding or type the parser has no constant for */
+
+/**
+ * @brief Section header table fields of the ELF header, widened past what e_shnum and e_shstrndx hold
+ */
+typedef struct elf_shtab_s
+{
+    uint64_t offset;      /**< File offset of the section header table */
+    size_t entry_size;    /**< Size of one section header in the file */
+    uint32_t sect_cnt;    /**< Number of sections */
+    uint32_t strtab_idx;  /**< Section index of the section name table */
+} elf_shtab_t;
+
+/**
+ * @brief Reads an unsigned field of the file in its data encoding
+ * @param[in] src First byte of the field
+ * @param[in] len Size of the field: 1, 2, 4 or 8 bytes
+ * @param[in] elf_data Data encoding of the file
+ * @return uint64_t Value of the field
+ */
+static uint64_t elf_uintRead(const uint8_t *src, size_t len, uint8_t elf_data)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        value = (value << 8) | src[(elf_data == ELF_DATA_MSB) ? i : (len - 1 - i)];
+    }
+    return (value);
+}
+
+/**
+ * @brief Decodes one raw symbol table entry the way the parser does
+ * @param[in] src First byte of the entry
+ * @param[in] slices Symbol table giving the class and data encoding
+ * @param[out] entry Decoded entry; its name is not resolved
+ */
+static void elf_symDecode(const uint8_t *src, const ftnm_symslice_t *slices, elfparser_symtable_entry_t *entry)
+{
+    uint8_t info;
+
+    memset(entry, 0, sizeof(*entry));
+    entry->sym_name_idx = (uint32_t)elf_uintRead(src, 4, slices->elf_data);
+    if (slices->elf_class == ELFPARSER_HEADER_CLASS_32_BIT)
+    {
+        entry->sym_value = elf_uintRead(src + 4, 4, slices->elf_data);
+        entry->sym_size = elf_uintRead(src + 8, 4, slices->elf_data);
+        info = src[12];
+        entry->sym_other = src[13];
+        entry->sym_sect_idx = (uint16_t)elf_uintRead(src + 14, 2, slices->elf_data);
+    }
+    else
+    {
+        info = src[4];
+        entry->sym_other = src[5];
+        entry->sym_sect_idx = (uint16_t)elf_uintRead(src + 6, 2, slices->elf_data);
+        entry->sym_value = elf_uintRead(src + 8, 8, slices->elf_data);
+        entry->sym_size = elf_uintRead(src + 16, 8, slices->elf_data);
+    }
+    switch (info >> 4)
+    {
+        case (ELF_STB_LOCAL): entry->sym_bind = ELFPARSER_SYMTABLE_BIND_LOCAL; break;
+        case (ELF_STB_GLOBAL): entry->sym_bind = ELFPARSER_SYMTABLE_BIND_GLOBAL; break;
+        case (ELF_STB_WEAK): entry->sym_bind = ELFPARSER_SYMTABLE_BIND_WEAK; break;
+        case (ELF_STB_GNU_UNIQUE): entry->sym_bind = ELFPARSER_SYMTABLE_BIND_GNU_UNIQUE; break;
+        default: entry->sym_bind = ELF_ST_UNKNOWN; break;  // Rejected by FtNm_Elf_entryRead
+    }
+    switch (info & 0xf)
+    {
+        case (ELF_STT_NOTYPE): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_NOTYPE; break;
+        case (ELF_STT_OBJECT): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_OBJECT; break;
+        case (ELF_STT_FUNC): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_FUNC; break;
+        case (ELF_STT_SECTION): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_SECT; break;
+        case (ELF_STT_FILE): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_FILE; break;
+        case (ELF_STT_COMMON): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_COMMON; break;
+        case (ELF_STT_TLS): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_TLS; break;
+        case (ELF_STT_GNU_IFUNC): entry->sym_type = ELFPARSER_SYMTABLE_TYPE_GNU_IFUNC; break;
+        default: entry->sym_type = ELF_ST_UNKNOWN; break;  // Rejected by FtNm_Elf_entryRead
+    }
+}
+
+/**
+ * @brief Takes the section header table fields of the ELF header, from section 0 when they do not fit it
+ *
+ * A file with SHN_LORESERVE (0xff00) sections or more sets e_shnum to 0 and
+ * keeps the count in sh_size of section 0; a section name table at such an
+ * index sets e_shstrndx to SHN_XINDEX and keeps the index in sh_link. Both
+ * are kept here in 32 bits, whatever width the parser gives the header.
+ *
+ * @param[in,out] file Opened file, its mapping replaced
+ * @param[in] elf_header Parsed ELF header
+ * @param[out] shtab Section header table fields
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL if section 0 cannot be mapped,
+ *             FN_ERR_BAD_FORMAT if there is no section 0 or the table does not fit the file
+ */
+static int elf_shtabGet(source_file_t *file, const elfparser_header_t *elf_header, elf_shtab_t *shtab)
+{
+    int is_32 = (elf_header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_32_BIT);
+    size_t shdr_size = is_32 ? ELF_SHDR32_SIZE : ELF_SHDR64_SIZE;
+    uint8_t elf_data = elf_header->elf_ident.elf_data;
+    const uint8_t *sect0;
+    uint64_t sect_cnt;
+
+    shtab->offset = elf_header->elf_section_header_off;
+    shtab->entry_size = elf_header->elf_section_header_entry_size;
+    shtab->sect_cnt = elf_header->elf_section_header_entry_num;
+    shtab->strtab_idx = elf_header->elf_section_header_string_idx;
+    if ((shtab->offset == 0) || (shtab->entry_size < shdr_size))
+    {
+        return (FN_ERR_BAD_FORMAT);  // No section header table to read
+    }
+    if ((shtab->sect_cnt == 0) || (shtab->strtab_idx == WRITER_FLAGPRINT_SHIDX_XINDEX))
+    {
+        if (FileHandler_mapGet(file, shdr_size, (off_t)shtab->offset) != FH_SUCCESS)
+        {
+            return (FN_ERR_FILE_FAIL);
+        }
+        if (file->map_len < shdr_size)
+        {
+            return (FN_ERR_BAD_FORMAT);  // Section 0 runs past the end of the file
+        }
+        sect0 = file->map;
+        if (shtab->sect_cnt == 0)
+        {
+            sect_cnt = is_32 ? elf_uintRead(sect0 + 20, 4, elf_data) : elf_uintRead(sect0 + 32, 8, elf_data);
+            if (sect_cnt > UINT32_MAX)
+            {
+                return (FN_ERR_BAD_FORMAT);  // More sections than indices can name
+            }
+            shtab->sect_cnt = (uint32_t)sect_cnt;
+        }
+        if (shtab->strtab_idx == WRITER_FLAGPRINT_SHIDX_XINDEX)
+        {
+            shtab->strtab_idx = (uint32_t)elf_uintRead(sect0 + (is_32 ? 24 : 40), 4, elf_data);
+        }
+    }
+    if ((shtab->sect_cnt == 0) || (shtab->strtab_idx >= shtab->sect_cnt) ||
+        (shtab->offset > file->size) || ((file->size - shtab->offset) / shtab->entry_size < shtab->sect_cnt))
+    {
+        return (FN_ERR_BAD_FORMAT);  // No name table, or the table runs past the end of the file
+    }
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Decodes the mapped section header table
+ * @param[in] file Opened file, mapping the section header table
+ * @param[in] shtab Section header table fields
+ * @param[in] elf_class ELF class of the file
+ * @param[in] elf_data Data encoding of the file
+ * @param[out] sects Section table; its names are left unresolved
+ * @return int FN_SUCCESS on success, FN_ERR_BAD_FORMAT if the table is not mapped whole,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int elf_sectsDecode(const source_file_t *file, const elf_shtab_t *shtab, uint8_t elf_class,
+                           uint8_t elf_data, ftnm_sects_t *sects)
+{
+    int is_32 = (elf_class == ELFPARSER_HEADER_CLASS_32_BIT);
+    size_t word = is_32 ? 4 : 8;
+    const uint8_t *src = file->map;
+
+    if (file->map_len < ((size_t)shtab->sect_cnt * shtab->entry_size))
+    {
+        return (FN_ERR_BAD_FORMAT);  // Table runs past the end of the file
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (size_t)shtab->sect_cnt * sizeof(elfparser_secthead_entry_t));
+    sects->table = malloc((size_t)shtab->sect_cnt * sizeof(elfparser_secthead_entry_t));
+    if (sects->table == NULL)
+    {
+        return (FN_ERR_MALLOC_FAIL);  // Memory allocation error
+    }
+    sects->table_len = shtab->sect_cnt;
+    sects->string_table_idx = shtab->strtab_idx;
+    for (uint32_t i = 0; i < shtab->sect_cnt; i++, src += shtab->entry_size)
+    {
+        elfparser_secthead_entry_t *entry = &sects->table[i];
+
+        // Elf32_Shdr and Elf64_Shdr differ in the width of flags, addr, offset, size, addralign and entsize
+        memset(entry, 0, sizeof(*entry));
+        entry->sh_name_idx = (uint32_t)elf_uintRead(src, 4, elf_data);
+        entry->sh_type = (uint32_t)elf_uintRead(src + 4, 4, elf_data);
+        entry->sh_flags = elf_uintRead(src + 8, word, elf_data);
+        entry->sh_addr = elf_uintRead(src + 8 + word, word, elf_data);
+        entry->sh_offset = elf_uintRead(src + 8 + 2 * word, word, elf_data);
+        entry->sh_size = elf_uintRead(src + 8 + 3 * word, word, elf_data);
+        entry->sh_link = (uint32_t)elf_uintRead(src + 8 + 4 * word, 4, elf_data);
+        entry->sh_info = (uint32_t)elf_uintRead(src + 12 + 4 * word, 4, elf_data);
+        entry->sh_entsize = elf_uintRead(src + 16 + 5 * word, word, elf_data);
+    }
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Copies the mapped section name table and points every section at its name
+ * @param[in] file Opened file, mapping the section name table
+ * @param[in,out] sects Decoded section table
+ * @return int FN_SUCCESS on success, FN_ERR_BAD_FORMAT for a name outside the table,
+ *             FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int elf_sectsNameResolve(const source_file_t *file, ftnm_sects_t *sects)
+{
+    size_t len = file->map_len;
+
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, len + 1);
+    sects->names = malloc(len + 1);
+    if (sects->names == NULL)
+    {
+        return (FN_ERR_MALLOC_FAIL);  // Memory allocation error
+    }
+    memcpy(sects->names, file->map, len);
+    sects->names[len] = '\0';  // The last name ends inside the copy
+    for (uint32_t i = 0; i < sects->table_len; i++)
+    {
+        if (sects->table[i].sh_name_idx >= len)
+        {
+            return (FN_ERR_BAD_FORMAT);
+        }
+        sects->table[i].sh_name = sects->names + sects->table[i].sh_name_idx;
+    }
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Finds a section by name
+ * @param[in] sects Section table, with names resolved
+ * @param[in] name Name of the section
+ * @param[out] idx Index of the first section of that name
+ * @return int FN_SUCCESS if found, FN_ERR_BAD_FORMAT if no section has that name
+ */
+static int elf_sectFind(const ftnm_sects_t *sects, const char *name, uint32_t *idx)
+{
+    for (uint32_t i = 0; i < sects->table_len; i++)
+    {
+        if (strcmp(sects->table[i].sh_name, name) == 0)
+        {
+            *idx = i;
+            return (FN_SUCCESS);
+        }
+    }
+    return (FN_ERR_BAD_FORMAT);
+}
+
+/**
+ * @brief Describes a mapped symbol table to be read a slice at a time
+ * @param[in] file Opened file, mapping the symbol table
+ * @param[in] sects Section table
+ * @param[in] symtab_sect_index Section index of the symbol table
+ * @param[in] elf_header Parsed ELF header
+ * @param[out] slices Symbol table description
+ * @return int FN_SUCCESS on success, FN_ERR_BAD_FORMAT for a malformed table
+ */
+static int elf_sliceSetup(const source_file_t *file, const ftnm_sects_t *sects, uint32_t symtab_sect_index,
+                          const elfparser_header_t *elf_header, ftnm_symslice_t *slices)
+{
+    const elfparser_secthead_entry_t *symtab = &(sects->table)[symtab_sect_index];
+
+    slices->elf_class = elf_header->elf_ident.elf_class;
+    slices->elf_data = elf_header->elf_ident.elf_data;
+    slices->entry_size = (slices->elf_class == ELFPARSER_HEADER_CLASS_32_BIT) ? ELF_SYM32_SIZE : ELF_SYM64_SIZE;
+    slices->sym_cnt = (size_t)(symtab->sh_size / slices->entry_size);
+    slices->offset = symtab->sh_offset;
+    slices->strtab_idx = symtab->sh_link;
+    slices->sect_cnt = sects->table_len;
+    if ((slices->strtab_idx >= slices->sect_cnt) || (file->map_len < (slices->sym_cnt * slices->entry_size)))
+    {
+        return (FN_ERR_BAD_FORMAT);  // No string table, or the table runs past the end of the file
+    }
+
+    // Find the index table linked to the symbol table; it is checked when a slice needs it
+    for (uint32_t sect = 0; sect < slices->sect_cnt; sect++)
+    {
+        if (((sects->table)[sect].sh_type == ELF_SHT_SYMTAB_SHNDX) &&
+            ((sects->table)[sect].sh_link == symtab_sect_index) &&
+            (((sects->table)[sect].sh_size / ELF_SHNDX_ENTRY_SIZE) >= slices->sym_cnt))
+        {
+            slices->shndx_offset = (sects->table)[sect].sh_offset;
+            slices->has_shndx = 1;
+            break;
+        }
+    }
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Parses an opened source up to its symbol string table
+ * @param[in,out] file Source opened with FileHandler_fileOpen or FileHandler_bufferOpen
+ * @param[out] sects Section table; freed by the caller with FtNm_Elf_sectsFree
+ * @param[out] file_bit File bit width (32/64)
+ * @param[in] symtab_name Name of the symbol table section (".symtab" or ".dynsym")
+ * @param[out] slices Symbol table to read; freed by the caller with FtNm_Elf_sliceFree
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL if a part of the file cannot be mapped,
+ *             FN_ERR_BAD_FORMAT for parsing errors, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int FtNm_Elf_sourceParse(source_file_t *file, ftnm_sects_t *sects, writer_bit_t *file_bit,
+                         const char *symtab_name, ftnm_symslice_t *slices)
+{
+    elfparser_header_t elf_header = {0};
+    elf_shtab_t shtab = {0};
+    uint32_t symtab_sect_index = 0;
+    int ret = FN_SUCCESS;
+    uint64_t stage_start;
+
+    memset(sects, 0, sizeof(*sects));
+    memset(slices, 0, sizeof(*slices));
+    FileHandler_structSetup(&slices->file);
+
+    // Get initial file mapping (16 bytes for ELF ident)
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_MAP_IDENT);
+        ret = FileHandler_mapGet(file, 16, 0);
+        Stats_stageEnd(STATS_STAGE_MAP_IDENT, stage_start);
+        if (ret != FN_SUCCESS)
+        {
+            ret = FN_ERR_FILE_FAIL;
+        }
+    }
+
+    // Parse ELF identification header
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_HEADER_PARSE);
+        ret = ElfParser_Header_identParse(&elf_header, file->map, file->map_len);
+        Stats_stageEnd(STATS_STAGE_HEADER_PARSE, stage_start);
+        if (ret)
+        {
+            ret = FN_ERR_BAD_FORMAT;
+        }
+        else
+        {
+            // Set writer bit width based on ELF class (32-bit or 64-bit)
+            *file_bit = (elf_header.elf_ident.elf_class == ELFPARSER_HEADER_CLASS_32_BIT) 
+                       ? (WRITER_VALUEPRINT_32BIT) : (WRITER_VALUEPRINT_64BIT);
+        }
+    }
+
+    // Map full ELF header
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_MAP_HEADER);
+        ret = FileHandler_mapGet(file, ElfParser_Header_sizeGet(&elf_header), 0);
+        Stats_stageEnd(STATS_STAGE_MAP_HEADER, stage_start);
+        if (ret)
+        {
+            ret = FN_ERR_FILE_FAIL;
+        }
+    }
+
+    // Parse complete ELF header
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_HEADER_PARSE);
+        ret = ElfParser_Header_parse(&elf_header, file->map, file->map_len);
+        if (ret)
+        {
+            ret = FN_ERR_BAD_FORMAT;
+        }
+        else
+        {
+            ret = elf_shtabGet(file, &elf_header, &shtab);  // 0xff00 sections or more
+        }
+        Stats_stageEnd(STATS_STAGE_HEADER_PARSE, stage_start);
+    }
+
+    // Map section header table
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_MAP_SECTHEAD);
+        ret = FileHandler_mapGet(file, ((size_t)shtab.sect_cnt * shtab.entry_size), (off_t)shtab.offset);
+        Stats_stageEnd(STATS_STAGE_MAP_SECTHEAD, stage_start);
+        if (ret)
+        {
+            ret = FN_ERR_FILE_FAIL;
+        }
+    }
+
+    // Parse section headers
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_SECT_PARSE);
+        ret = elf_sectsDecode(file, &shtab, elf_header.elf_ident.elf_class, elf_header.elf_ident.elf_data, sects);
+        Stats_stageEnd(STATS_STAGE_SECT_PARSE, stage_start);
+    }
+
+    // Map string table for section names
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_MAP_SHSTRTAB);
+        ret = FileHandler_mapGet(file, 
+            (sects->table)[sects->string_table_idx].sh_size,
+            (sects->table)[sects->string_table_idx].sh_offset);
+        Stats_stageEnd(STATS_STAGE_MAP_SHSTRTAB, stage_start);
+        if (ret)
+        {
+            ret = FN_ERR_FILE_FAIL;
+        }
+    }
+
+    // Resolve section names
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_SECT_NAME_RESOLVE);
+        ret = elf_sectsNameResolve(file, sects);
+        Stats_stageEnd(STATS_STAGE_SECT_NAME_RESOLVE, stage_start);
+    }
+
+    // Find symbol table section
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_SECT_NAME_RESOLVE);
+        ret = elf_sectFind(sects, symtab_name, &symtab_sect_index);
+        Stats_stageEnd(STATS_STAGE_SECT_NAME_RESOLVE, stage_start);
+    }
+
+    // Map symbol table
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_MAP_SYMTAB);
+        ret = FileHandler_mapGet(file, 
+            sects->table[symtab_sect_index].sh_size,
+            sects->table[symtab_sect_index].sh_offset);
+        Stats_stageEnd(STATS_STAGE_MAP_SYMTAB, stage_start);
+        if (ret)
+        {
+            ret = FN_ERR_FILE_FAIL;
+        }
+    }
+
+    // Describe the symbol table, its entries left in the file to be read a slice at a time
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_SYMTAB_PARSE);
+        ret = elf_sliceSetup(file, sects, symtab_sect_index, &elf_header, slices);
+        Stats_stageEnd(STATS_STAGE_SYMTAB_PARSE, stage_start);
+        FT_NM_PROBE1(symtable_parse, slices->sym_cnt);
+    }
+
+    // Map string table for symbol names
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_MAP_STRTAB);
+        ret = FileHandler_mapGet(file, 
+            (sects->table)[slices->strtab_idx].sh_size,
+            (sects->table)[slices->strtab_idx].sh_offset);
+        Stats_stageEnd(STATS_STAGE_MAP_STRTAB, stage_start);
+        if (ret)
+        {
+            ret = FN_ERR_FILE_FAIL;
+        }
+    }
+
+    // Check that symbol names can be resolved within the string table
+    if (ret == FN_SUCCESS)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_SYM_NAME_RESOLVE);
+        if (((const char *)file->map)[file->map_len - 1] != '\0')
+        {
+            ret = FN_ERR_BAD_FORMAT;  // Last name is not terminated inside the table
+        }
+        Stats_stageEnd(STATS_STAGE_SYM_NAME_RESOLVE, stage_start);
+    }
+
+    // Clean up file resources on failure, keep the string table mapped otherwise
+    if (ret != FN_SUCCESS)
+    {
+        FtNm_Elf_sectsFree(sects);
+        stage_start = Stats_stageBegin(STATS_STAGE_CLOSE);
+        FileHandler_fileClose(file);
+        Stats_stageEnd(STATS_STAGE_CLOSE, stage_start);
+    }
+    else
+    {
+        slices->file = *file;  // Same descriptor or buffer, mapping of its own
+        slices->file.addr = NULL;
+        slices->file.map = NULL;
+        slices->file.addr_len = 0;
+        slices->file.map_len = 0;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Opens and parses an ELF file up to its symbol string table
+ * @param[in] file_name Path to the ELF file to parse
+ * @param[out] file File structure; left holding the symbol string table mapping
+ * @param[out] sects Section table; freed by the caller with FtNm_Elf_sectsFree
+ * @param[out] file_bit File bit width (32/64)
+ * @param[in] symtab_name Name of the symbol table section (".symtab" or ".dynsym")
+ * @param[out] slices Symbol table to read; freed by the caller with FtNm_Elf_sliceFree
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL for file errors (errno set),
+ *             FN_ERR_BAD_FORMAT for parsing errors, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int FtNm_Elf_fileParse(const char *file_name, source_file_t *file, ftnm_sects_t *sects, writer_bit_t *file_bit,
+                       const char *symtab_name, ftnm_symslice_t *slices)
+{
+    uint64_t stage_start;
+    int ret;
+
+    memset(sects, 0, sizeof(*sects));
+    memset(slices, 0, sizeof(*slices));
+
+    // Initialize file handler structure
+    FileHandler_structSetup(file);
+    FileHandler_structSetup(&slices->file);
+
+    // Attempt to open the file
+    stage_start = Stats_stageBegin(STATS_STAGE_OPEN);
+    ret = FileHandler_fileOpen(file, file_name);
+    Stats_stageEnd(STATS_STAGE_OPEN, stage_start);
+    if (ret != FH_SUCCESS)
+    {
+        return (FN_ERR_FILE_FAIL);
+    }
+    return (FtNm_Elf_sourceParse(file, sects, file_bit, symtab_name, slices));
+}
+
+/**
+ * @brief Frees a section table
+ * @param[in,out] sects Section table filled by FtNm_Elf_sourceParse
+ */
+void FtNm_Elf_sectsFree(ftnm_sects_t *sects)
+{
+    free(sects->table);
+    free(sects->names);
+    memset(sects, 0, sizeof(*sects));
+}
+
+/**
+ * @brief Makes room for a slice of a number of entries
+ * @param[in,out] slices Symbol table
+ * @param[in] cnt Number of entries of the slice
+ * @return int FN_SUCCESS on success, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int elf_sliceReserve(ftnm_symslice_t *slices, size_t cnt)
+{
+    elfparser_symtable_entry_t *new_table;
+    uint32_t *new_shndx;
+
+    if (cnt <= slices->cap)
+    {
+        return (FN_SUCCESS);
+    }
+    new_table = realloc(slices->symtab.table, cnt * sizeof(elfparser_symtable_entry_t));
+    if (new_table == NULL)
+    {
+        return (FN_ERR_MALLOC_FAIL);  // Memory allocation error
+    }
+    slices->symtab.table = new_table;
+    new_shndx = realloc(slices->shndx_buf, cnt * sizeof(uint32_t));
+    if (new_shndx == NULL)
+    {
+        return (FN_ERR_MALLOC_FAIL);  // Memory allocation error
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, cnt * (sizeof(elfparser_symtable_entry_t) + sizeof(uint32_t)));
+    slices->shndx_buf = new_shndx;
+    slices->cap = cnt;
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Reads a slice of the entries of a symbol table from the file
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] first Index of the first entry
+ * @param[in] end Index past the last entry, at most slices->sym_cnt
+ * @return int FN_SUCCESS on success, FN_ERR_FILE_FAIL if the slice cannot be mapped,
+ *             FN_ERR_BAD_FORMAT for a malformed extended index, FN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int FtNm_Elf_sliceRead(ftnm_symslice_t *slices, size_t first, size_t end)
+{
+    size_t cnt = end - first;
+    elfparser_symtable_entry_t *table;
+    const uint8_t *src;
+    int xindex = 0;
+    int ret;
+
+    slices->first = 0;
+    slices->end = 0;  // Until the new slice is read whole
+    if ((first >= end) || (end > slices->sym_cnt))
+    {
+        return (FN_ERR_BAD_FORMAT);
+    }
+    if ((ret = elf_sliceReserve(slices, cnt)) != FN_SUCCESS)
+    {
+        return (ret);
+    }
+    table = slices->symtab.table;
+    if (FileHandler_mapGet(&slices->file, cnt * slices->entry_size,
+                           (off_t)(slices->offset + first * slices->entry_size)) != FH_SUCCESS)
+    {
+        return (FN_ERR_FILE_FAIL);
+    }
+    if (slices->file.map_len < (cnt * slices->entry_size))
+    {
+        return (FN_ERR_BAD_FORMAT);  // Table runs past the end of the file
+    }
+    src = slices->file.map;
+    for (size_t i = 0; i < cnt; i++, src += slices->entry_size)
+    {
+        elf_symDecode(src, slices, &table[i]);
+        xindex |= (table[i].sym_sect_idx == WRITER_FLAGPRINT_SHIDX_XINDEX);
+    }
+    slices->shndx = NULL;
+
+    // Load the extended indices of the slice when one of its symbols needs them
+    if (xindex)
+    {
+        if (!slices->has_shndx)
+        {
+            return (FN_ERR_BAD_FORMAT);
+        }
+        if (FileHandler_mapGet(&slices->file, cnt * ELF_SHNDX_ENTRY_SIZE,
+                               (off_t)(slices->shndx_offset + first * ELF_SHNDX_ENTRY_SIZE)) != FH_SUCCESS)
+        {
+            return (FN_ERR_FILE_FAIL);
+        }
+        if (slices->file.map_len < (cnt * ELF_SHNDX_ENTRY_SIZE))
+        {
+            return (FN_ERR_BAD_FORMAT);  // Table runs past the end of the file
+        }
+        src = slices->file.map;
+        for (size_t i = 0; i < cnt; i++, src += ELF_SHNDX_ENTRY_SIZE)
+        {
+            slices->shndx_buf[i] = (uint32_t)elf_uintRead(src, ELF_SHNDX_ENTRY_SIZE, slices->elf_data);
+            if ((table[i].sym_sect_idx == WRITER_FLAGPRINT_SHIDX_XINDEX) && (slices->shndx_buf[i] >= slices->sect_cnt))
+            {
+                return (FN_ERR_BAD_FORMAT);  // Extended index names no section
+            }
+        }
+        slices->shndx = slices->shndx_buf;
+    }
+    slices->first = first;
+    slices->end = end;
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Frees the slice buffers of a symbol table and its mapping of the file
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ */
+void FtNm_Elf_sliceFree(ftnm_symslice_t *slices)
+{
+    free(slices->symtab.table);
+    free(slices->shndx_buf);
+    slices->symtab.table = NULL;
+    slices->shndx = NULL;
+    slices->shndx_buf = NULL;
+    slices->cap = 0;
+    slices->first = 0;
+    slices->end = 0;
+    if (slices->file.addr != NULL)
+    {
+        FileHandler_mapFree(&slices->file);  // Only this mapping; the descriptor stays with the parsed source
+    }
+}
+
+/**
+ * @brief Checks a symbol against the -g / -u / --size-sort filter
+ * @param[in] filter Active symbol filter
+ * @param[in] bind Symbol binding type
+ * @param[in] sect_head_idx Section header index of the symbol
+ * @param[in] size Size of the symbol
+ * @return int Non-zero if the symbol is kept
+ */
+static int elf_filterAccept(const ftnm_filter_t *filter, writer_flagprint_bind_e bind,
+                            uint32_t sect_head_idx, uint64_t size)
+{
+    // Skip non-global symbols if global_only flag is set
+    if ((filter->global_only != 0) && (bind == WRITER_FLAGPRINT_BIND_LOCAL)) // to be equal to nm v2.42 on linux
+    {
+        return (0);
+    }
+    // Skip defined symbols if undefined_only flag is set
+    if ((filter->undefined_only != 0) && (sect_head_idx != WRITER_FLAGPRINT_SHIDX_UNDEFINED))
+    {
+        return (0);
+    }
+    // Skip undefined and zero sized symbols if sized_only flag is set
+    if ((filter->sized_only != 0) && ((sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED) || (size == 0)))
+    {
+        return (0);
+    }
+    return (1);
+}
+
+/**
+ * @brief Decodes one symbol table entry and applies the filter, name patterns aside
+ * @param[in] elf_symbol_table Symbol table to read
+ * @param[in] i Index of the entry
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab_len Length of the symbol string table
+ * @param[in] shndx_table Extended section indices of the slice (slices->shndx), or NULL
+ * @param[out] bind Binding of the symbol
+ * @param[out] type Type of the symbol
+ * @param[out] sect_head_idx Section index of the symbol
+ * @return int FN_SUCCESS if the symbol is kept, FN_FILTERED if it is not,
+ *             FN_ERR_BAD_FORMAT for a malformed entry
+ */
+static int elf_entryDecode(const elfparser_symtable_t *elf_symbol_table, size_t i, const ftnm_filter_t *filter,
+                           size_t strtab_len, const uint32_t *shndx_table, writer_flagprint_bind_e *bind,
+                           writer_flagprint_type_e *type, uint32_t *sect_head_idx)
+{
+    const elfparser_symtable_entry_t *entry = &(elf_symbol_table->table)[i];
+
+    // Skip section and file symbols
+    if ((entry->sym_type == ELFPARSER_SYMTABLE_TYPE_SECT) || (entry->sym_type == ELFPARSER_SYMTABLE_TYPE_FILE))
+    {
+        return (FN_FILTERED);
+    }
+
+    // Set symbol binding type
+    switch (entry->sym_bind)
+    {
+        case (ELFPARSER_SYMTABLE_BIND_LOCAL):
+            *bind = WRITER_FLAGPRINT_BIND_LOCAL;
+            break;
+        case (ELFPARSER_SYMTABLE_BIND_GLOBAL):
+            *bind = WRITER_FLAGPRINT_BIND_GLOBAL;
+            break;
+        case (ELFPARSER_SYMTABLE_BIND_WEAK):
+            *bind = WRITER_FLAGPRINT_BIND_WEAK;
+            break;
+        case (ELFPARSER_SYMTABLE_BIND_GNU_UNIQUE):
+            *bind = WRITER_FLAGPRINT_BIND_GNU;
+            break;
+        default:
+            return (FN_ERR_BAD_FORMAT);
+    }
+
+    // Skip non-global symbols early if global_only flag is set
+    if ((filter->global_only != 0) && (*bind == WRITER_FLAGPRINT_BIND_LOCAL))
+    {
+        return (FN_FILTERED);
+    }
+
+    // Set symbol type
+    switch (entry->sym_type)
+    {
+        case (ELFPARSER_SYMTABLE_TYPE_NOTYPE):
+            *type = WRITER_FLAGPRINT_TYPE_NOTYPE;
+            break;
+        case (ELFPARSER_SYMTABLE_TYPE_OBJECT):
+            *type = WRITER_FLAGPRINT_TYPE_OBJECT;
+            break;
+        case (ELFPARSER_SYMTABLE_TYPE_FUNC):
+            *type = WRITER_FLAGPRINT_TYPE_FUNC;
+            break;
+        case (ELFPARSER_SYMTABLE_TYPE_SECT):
+            *type = WRITER_FLAGPRINT_TYPE_TLS;
+            break;
+        case (ELFPARSER_SYMTABLE_TYPE_GNU_IFUNC):
+            *type = WRITER_FLAGPRINT_TYPE_GNU;
+            break;
+        default:
+            return (FN_ERR_BAD_FORMAT);
+    }
+
+    // Take the section index from the extended table when it does not fit st_shndx; a
+    // reserved index is moved past every section, which can then number 0xff00 and up
+    *sect_head_idx = entry->sym_sect_idx;
+    if ((*sect_head_idx == WRITER_FLAGPRINT_SHIDX_XINDEX) && (shndx_table != NULL))
+    {
+        *sect_head_idx = shndx_table[i];
+    }
+    else if (*sect_head_idx >= WRITER_FLAGPRINT_SHIDX_LORESERVE)
+    {
+        *sect_head_idx |= WRITER_FLAGPRINT_SHIDX_RESERVED;
+    }
+
+    // Skip symbols rejected by the filter
+    if (elf_filterAccept(filter, *bind, *sect_head_idx, entry->sym_size) == 0)
+    {
+        return (FN_FILTERED);
+    }
+
+    // Check the symbol name lies within the string table
+    if (entry->sym_name_idx >= strtab_len)
+    {
+        return (FN_ERR_BAD_FORMAT);
+    }
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Reads one symbol table entry into a symbol line, applying a filter
+ * @param[in] elf_symbol_table Symbol table to read
+ * @param[in] i Index of the entry
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab Symbol string table, read when the filter has name patterns
+ * @param[in] strtab_len Length of the symbol string table
+ * @param[in] shndx_table Extended section indices of the slice (slices->shndx), or NULL
+ * @param[out] line Line filled when the symbol is kept
+ * @return int FN_SUCCESS if the symbol is kept, FN_FILTERED if it is not,
+ *             FN_ERR_BAD_FORMAT for a malformed entry
+ */
+int FtNm_Elf_entryRead(const elfparser_symtable_t *elf_symbol_table, size_t i, const ftnm_filter_t *filter,
+                       const char *strtab, size_t strtab_len, const uint32_t *shndx_table, writer_line_t *line)
+{
+    const elfparser_symtable_entry_t *entry = &(elf_symbol_table->table)[i];
+    writer_flagprint_bind_e bind;
+    writer_flagprint_type_e type;
+    uint32_t sect_head_idx;
+    int ret;
+
+    STATS_COUNT(STATS_COUNTER_SYM_SEEN, 1);
+
+    ret = elf_entryDecode(elf_symbol_table, i, filter, strtab_len, shndx_table, &bind, &type, &sect_head_idx);
+    if (ret == FN_FILTERED)
+    {
+        STATS_COUNT(STATS_COUNTER_SYM_FILTERED, 1);
+    }
+    if (ret != FN_SUCCESS)
+    {
+        return (ret);
+    }
+
+    // Skip names no pattern matches
+    if ((filter->match != NULL) &&
+        !Match_name(filter->match, strtab + entry->sym_name_idx, strtab_len - entry->sym_name_idx))
+    {
+        STATS_COUNT(STATS_COUNTER_SYM_FILTERED, 1);
+        return (FN_FILTERED);
+    }
+
+    // Set symbol attributes, name, value and size
+    line->bind = bind;
+    line->type = type;
+    line->sect_head_idx = sect_head_idx;
+    line->name_off = entry->sym_name_idx;
+    line->name = NULL;       // Resolved lazily from name_off
+    line->value = entry->sym_value;
+    line->size = entry->sym_size;
+    line->demangled = NULL;  // Demangled after sorting with -C
+    return (FN_SUCCESS);
+}
+
+/**
+ * @brief Reads the slice of a symbol table holding an entry, unless it is the slice read last
+ *
+ * Slices start at multiples of FTNM_SLICE_ENTRIES, so entries looked up out
+ * of order, like the symbols of relocations, share the slices they fall in.
+ *
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] i Index of the entry
+ * @return int FN_SUCCESS on success, FN_ERR_BAD_FORMAT if there is no such entry, or the error of FtNm_Elf_sliceRead
+ */
+static int elf_sliceFind(ftnm_symslice_t *slices, size_t i)
+{
+    size_t first = i - (i % FTNM_SLICE_ENTRIES);
+    size_t end;
+
+    if ((i >= slices->first) && (i < slices->end))
+    {
+        return (FN_SUCCESS);
+    }
+    if (i >= slices->sym_cnt)
+    {
+        return (FN_ERR_BAD_FORMAT);
+    }
+    end = ((slices->sym_cnt - first) > FTNM_SLICE_ENTRIES) ? (first + FTNM_SLICE_ENTRIES) : slices->sym_cnt;
+    return (FtNm_Elf_sliceRead(slices, first, end));
+}
+
+/**
+ * @brief Reads one entry of a symbol table left in the file, applying a filter
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] i Index of the entry, at most slices->sym_cnt - 1
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab Symbol string table, read when the filter has name patterns
+ * @param[in] strtab_len Length of the symbol string table
+ * @param[out] line Line filled when the symbol is kept
+ * @return int FN_SUCCESS if the symbol is kept, FN_FILTERED if it is not, FN_ERR_BAD_FORMAT for a
+ *             malformed entry, FN_ERR_FILE_FAIL or FN_ERR_MALLOC_FAIL if its slice cannot be read
+ */
+int FtNm_Elf_sliceEntryRead(ftnm_symslice_t *slices, size_t i, const ftnm_filter_t *filter,
+                            const char *strtab, size_t strtab_len, writer_line_t *line)
+{
+    int ret = elf_sliceFind(slices, i);
+
+    if (ret != FN_SUCCESS)
+    {
+        return (ret);
+    }
+    return (FtNm_Elf_entryRead(&slices->symtab, i - slices->first, filter, strtab, strtab_len, slices->shndx, line));
+}
+
+/**
+ * @brief Checks every entry of a symbol table left in the file the way FtNm_Elf_sliceEntryRead reads it
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] filter Symbol filter to apply; its name patterns are not tested
+ * @param[in] strtab_len Length of the symbol string table
+ * @return int FN_SUCCESS if every entry can be read, FN_ERR_BAD_FORMAT for a malformed entry,
+ *             FN_ERR_FILE_FAIL or FN_ERR_MALLOC_FAIL if a slice cannot be read
+ */
+int FtNm_Elf_sliceCheck(ftnm_symslice_t *slices, const ftnm_filter_t *filter, size_t strtab_len)
+{
+    writer_flagprint_bind_e bind;
+    writer_flagprint_type_e type;
+    uint32_t sect_head_idx;
+    int ret = FN_SUCCESS;
+
+    for (size_t i = 1; (i < slices->sym_cnt) && (ret == FN_SUCCESS); i++)
+    {
+        ret = elf_sliceFind(slices, i);
+        if ((ret == FN_SUCCESS) &&
+            (elf_entryDecode(&slices->symtab, i - slices->first, filter, strtab_len, slices->shndx, &bind, &type,
+                             &sect_head_idx) == FN_ERR_BAD_FORMAT))
+        {
+            ret = FN_ERR_BAD_FORMAT;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Reads the value and section of one entry of a symbol table left in the file
+ * @param[in,out] slices Symbol table set up by FtNm_Elf_sourceParse
+ * @param[in] i Index of the entry
+ * @param[out] value Value of the symbol
+ * @param[out] sect Section index of the symbol, taken from the extended table for SHN_XINDEX
+ * @return int FN_SUCCESS on success, FN_ERR_BAD_FORMAT if there is no such entry,
+ *             FN_ERR_FILE_FAIL or FN_ERR_MALLOC_FAIL if its slice cannot be read
+ */
+int FtNm_Elf_sliceSymbolGet(ftnm_symslice_t *slices, size_t i, uint64_t *value, uint32_t *sect)
+{
+    const elfparser_symtable_entry_t *entry;
+    int ret = elf_sliceFind(slices, i);
+
+    if (ret != FN_SUCCESS)
+    {
+        return (ret);
+    }
+    entry = &(slices->symtab.table)[i - slices->first];
+    *value = entry->sym_value;
+    *sect = entry->sym_sect_idx;
+    if ((*sect == WRITER_FLAGPRINT_SHIDX_XINDEX) && (slices->shndx != NULL))
+    {
+        *sect = slices->shndx[i - slices->first];
+    }
+    return (FN_SUCCESS);
+}
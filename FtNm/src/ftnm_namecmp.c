@@ -0,0 +1,333 @@
+/**
+ * @file ftnm_namecmp.c
+ * @brief Symbol name comparison in nm order for libftnm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the name comparison behind the nm name sort: case is
+ * folded and underscores are skipped. The scalar loop takes one byte of each
+ * name per step. On x86, the SSE2 and AVX2 variants fold and compare 16 or 32
+ * bytes of both names at once and find with movemask the first position that
+ * needs the scalar rules (a mismatch, which includes an underscore facing
+ * another byte, or the end of the first name); everything before it is
+ * skipped and a single scalar step is taken there. Results are the same as
+ * the scalar loop. The variant is selected once, when the program or library
+ * is loaded, from the features of the CPU.
+ */
+
+#include "../inc_pub/ftnm.h"
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NAMECMP_X86
+#endif
+
+#define NAMECMP_PAGE_SIZE  4096u  // Smallest page size; vector loads never cross a page boundary
+#define NAMECMP_CASE_BIT   ('a' - 'A')
+#define NAMECMP_VEC_MAX    32u      // Widest vector, in bytes
+
+/**
+ * @brief Name comparison variant
+ */
+typedef int (*namecmp_f)(const char *name1, const char *name2);
+
+/**
+ * @brief Skips the leading bytes two names share, before the end of the first name
+ *
+ * Underscores at the same position in both names are skipped by both sides,
+ * so they are shared bytes like any other; an underscore facing another byte
+ * is a mismatch, since no byte folds to one.
+ */
+typedef size_t (*namecmp_skip_f)(const char *name1, const char *name2);
+
+/**
+ * @brief Position of a comparison in both names
+ */
+typedef struct namecmp_pos_s
+{
+    size_t cnt1;  /**< Position in the first name */
+    size_t cnt2;  /**< Position in the second name */
+    char char1;   /**< Last compared character of the first name, case folded */
+    char char2;   /**< Last compared character of the second name, case folded */
+} namecmp_pos_t;
+
+/**
+ * @brief Takes one step of the scalar comparison
+ *
+ * An underscore of the first name, then of the second, is skipped; otherwise
+ * the case folded characters are compared and both positions advance if they
+ * are equal.
+ *
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @param[in,out] pos Position of the comparison
+ * @return int Non-zero while the names are equal so far, 0 once the result is known
+ */
+static inline __attribute__((always_inline)) int namecmp_step(const char *name1, const char *name2, namecmp_pos_t *pos)
+{
+    char char1 = name1[pos->cnt1];
+    char char2 = name2[pos->cnt2];
+
+    if (char1 == '\0')
+    {
+        return (0);  // End of the first name
+    }
+    // Skip underscores in first name
+    if (char1 == '_')
+    {
+        pos->cnt1++;
+        return (1);
+    }
+    // Skip underscores in second name
+    if (char2 == '_')
+    {
+        pos->cnt2++;
+        return (1);
+    }
+    // Convert lowercase to uppercase
+    if ((char1 >= 'a') && (char1 <= 'z'))
+    {
+        char1 -= NAMECMP_CASE_BIT;
+    }
+    if ((char2 >= 'a') && (char2 <= 'z'))
+    {
+        char2 -= NAMECMP_CASE_BIT;
+    }
+    // Compare characters
+    pos->char1 = char1;
+    pos->char2 = char2;
+    if (char1 != char2)
+    {
+        return (0);
+    }
+    pos->cnt1++;
+    pos->cnt2++;
+    return (1);
+}
+
+/**
+ * @brief Compares two names with the scalar loop
+ *
+ * A first name made only of underscores compares equal, like a first name
+ * that is a prefix of the second one.
+ *
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+static int namecmp_scalar(const char *name1, const char *name2)
+{
+    namecmp_pos_t pos = {0, 0, 0, 0};
+
+    while (namecmp_step(name1, name2, &pos))
+    {
+        ;
+    }
+    return (pos.char1 - pos.char2);
+}
+
+#ifdef NAMECMP_X86
+/**
+ * @brief Byte constants of the vector variants, loaded rather than built on every call
+ */
+static const char g_namecmp_before_a[NAMECMP_VEC_MAX] __attribute__((aligned(NAMECMP_VEC_MAX))) = {[0 ... NAMECMP_VEC_MAX - 1] = 'a' - 1};
+static const char g_namecmp_after_z[NAMECMP_VEC_MAX] __attribute__((aligned(NAMECMP_VEC_MAX))) = {[0 ... NAMECMP_VEC_MAX - 1] = 'z' + 1};
+static const char g_namecmp_case_bit[NAMECMP_VEC_MAX] __attribute__((aligned(NAMECMP_VEC_MAX))) = {[0 ... NAMECMP_VEC_MAX - 1] = NAMECMP_CASE_BIT};
+
+/**
+ * @brief Compares two names, skipping shared bytes with a vector variant between scalar steps
+ *
+ * A first name made only of underscores compares equal, like a first name
+ * that is a prefix of the second one.
+ *
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @param[in] skip Vector skip
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+static int namecmp_run(const char *name1, const char *name2, namecmp_skip_f skip)
+{
+    namecmp_pos_t pos = {0, 0, 0, 0};
+    size_t shared;
+
+    do
+    {
+        shared = skip(name1 + pos.cnt1, name2 + pos.cnt2);
+        pos.cnt1 += shared;
+        pos.cnt2 += shared;
+    } while (namecmp_step(name1, name2, &pos));
+    return (pos.char1 - pos.char2);
+}
+
+/**
+ * @brief Tells whether a vector load stays within the page of its first byte
+ * @param[in] ptr Address of the load
+ * @param[in] width Width of the load in bytes
+ * @return int Non-zero if the load does not cross a page boundary
+ */
+static inline __attribute__((always_inline)) int namecmp_loadSafe(const char *ptr, size_t width)
+{
+    return (((uintptr_t)ptr & (NAMECMP_PAGE_SIZE - 1u)) <= (NAMECMP_PAGE_SIZE - width));
+}
+
+/**
+ * @brief Folds lowercase letters to uppercase, 16 bytes at a time
+ * @param[in] bytes Bytes to fold
+ * @param[in] before_a Every byte set to 'a' - 1
+ * @param[in] after_z Every byte set to 'z' + 1
+ * @param[in] case_bit Every byte set to the case bit
+ * @return __m128i Folded bytes
+ */
+__attribute__((target("sse2"), always_inline))
+static inline __m128i namecmp_foldSse2(__m128i bytes, __m128i before_a, __m128i after_z, __m128i case_bit)
+{
+    __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(bytes, before_a), _mm_cmpgt_epi8(after_z, bytes));
+
+    return (_mm_sub_epi8(bytes, _mm_and_si128(lower, case_bit)));
+}
+
+/**
+ * @brief Skips the leading bytes two names share, 16 bytes at a time
+ * @param[in] name1 First symbol name, from the current position
+ * @param[in] name2 Second symbol name, from the current position
+ * @return size_t Number of bytes equal once folded, before the end of the first name
+ */
+__attribute__((target("sse2")))
+static size_t namecmp_skipSse2(const char *name1, const char *name2)
+{
+    const __m128i before_a = _mm_load_si128((const __m128i *)(const void *)g_namecmp_before_a);
+    const __m128i after_z = _mm_load_si128((const __m128i *)(const void *)g_namecmp_after_z);
+    const __m128i case_bit = _mm_load_si128((const __m128i *)(const void *)g_namecmp_case_bit);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bytes1, bytes2, equal;
+    unsigned int mask;
+    size_t shared = 0;
+
+    while (namecmp_loadSafe(name1 + shared, sizeof(__m128i)) && namecmp_loadSafe(name2 + shared, sizeof(__m128i)))
+    {
+        bytes1 = _mm_loadu_si128((const __m128i *)(const void *)(name1 + shared));
+        bytes2 = _mm_loadu_si128((const __m128i *)(const void *)(name2 + shared));
+        equal = _mm_cmpeq_epi8(namecmp_foldSse2(bytes1, before_a, after_z, case_bit),
+                               namecmp_foldSse2(bytes2, before_a, after_z, case_bit));
+        mask = ((unsigned int)_mm_movemask_epi8(equal) ^ 0xFFFFu)                  // Mismatches
+               | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes1, zero));  // End of the first name
+        if (mask != 0)
+        {
+            return (shared + (size_t)__builtin_ctz(mask));
+        }
+        shared += sizeof(__m128i);
+    }
+    return (shared);
+}
+
+/**
+ * @brief Compares two names with the SSE2 skip
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+static int namecmp_sse2(const char *name1, const char *name2)
+{
+    return (namecmp_run(name1, name2, namecmp_skipSse2));
+}
+
+/**
+ * @brief Folds lowercase letters to uppercase, 32 bytes at a time
+ * @param[in] bytes Bytes to fold
+ * @param[in] before_a Every byte set to 'a' - 1
+ * @param[in] after_z Every byte set to 'z' + 1
+ * @param[in] case_bit Every byte set to the case bit
+ * @return __m256i Folded bytes
+ */
+__attribute__((target("avx2"), always_inline))
+static inline __m256i namecmp_foldAvx2(__m256i bytes, __m256i before_a, __m256i after_z, __m256i case_bit)
+{
+    __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, before_a), _mm256_cmpgt_epi8(after_z, bytes));
+
+    return (_mm256_sub_epi8(bytes, _mm256_and_si256(lower, case_bit)));
+}
+
+/**
+ * @brief Skips the leading bytes two names share, 32 bytes at a time
+ * @param[in] name1 First symbol name, from the current position
+ * @param[in] name2 Second symbol name, from the current position
+ * @return size_t Number of bytes equal once folded, before the end of the first name
+ */
+__attribute__((target("avx2")))
+static size_t namecmp_skipAvx2(const char *name1, const char *name2)
+{
+    const __m256i before_a = _mm256_load_si256((const __m256i *)(const void *)g_namecmp_before_a);
+    const __m256i after_z = _mm256_load_si256((const __m256i *)(const void *)g_namecmp_after_z);
+    const __m256i case_bit = _mm256_load_si256((const __m256i *)(const void *)g_namecmp_case_bit);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i bytes1, bytes2, equal;
+    uint32_t mask;
+    size_t shared = 0;
+
+    while (namecmp_loadSafe(name1 + shared, sizeof(__m256i)) && namecmp_loadSafe(name2 + shared, sizeof(__m256i)))
+    {
+        bytes1 = _mm256_loadu_si256((const __m256i *)(const void *)(name1 + shared));
+        bytes2 = _mm256_loadu_si256((const __m256i *)(const void *)(name2 + shared));
+        equal = _mm256_cmpeq_epi8(namecmp_foldAvx2(bytes1, before_a, after_z, case_bit),
+                                  namecmp_foldAvx2(bytes2, before_a, after_z, case_bit));
+        mask = ~(uint32_t)_mm256_movemask_epi8(equal)                            // Mismatches
+               | (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes1, zero));  // End of the first name
+        if (mask != 0)
+        {
+            return (shared + (size_t)__builtin_ctz(mask));
+        }
+        shared += sizeof(__m256i);
+    }
+    return (shared + namecmp_skipSse2(name1 + shared, name2 + shared));  // Last bytes of the page
+}
+
+/**
+ * @brief Compares two names with the AVX2 skip
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+static int namecmp_avx2(const char *name1, const char *name2)
+{
+    return (namecmp_run(name1, name2, namecmp_skipAvx2));
+}
+#endif /* NAMECMP_X86 */
+
+static namecmp_f g_namecmp = namecmp_scalar;  /* Variant selected for the CPU */
+
+/**
+ * @brief Selects the comparison variant supported by the CPU, when the program or library is loaded
+ */
+__attribute__((constructor))
+static void namecmp_select(void)
+{
+#ifdef NAMECMP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        g_namecmp = namecmp_avx2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        g_namecmp = namecmp_sse2;
+    }
+#endif
+}
+
+/**
+ * @brief Compares two symbol names in nm order
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+int FtNm_nameCmp(const char *name1, const char *name2)
+{
+    // The same copy is the same name; equal names may still be different copies, one interned and one not
+    if (name1 == name2)
+    {
+        return (0);
+    }
+    return (g_namecmp(name1, name2));
+}
@@ -0,0 +1,59 @@
+/**
+ * @file intern.h
+ * @brief Public header for cross-file symbol name interning in ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the global intern table enabled by --resolve and --diff,
+ * whose symbol lists of several files live together. Every distinct symbol name
+ * is stored once for the whole invocation, so names repeated across files
+ * (library imports, template instantiations) share one copy that outlives the
+ * string table of the file they came from. Two interned names are equal if and
+ * only if they are the same pointer; a name that could not be interned is a
+ * different copy and must be compared by content. The table may be used from
+ * several threads.
+ */
+
+#ifndef _IG_INTERN_H_
+#define _IG_INTERN_H_
+
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Error codes for intern operations
+ */
+enum Intern_Error {
+    IN_SUCCESS = 0,          /**< Success */
+    IN_ERR_NULL_INPUT = -1,  /**< Invalid input (NULL pointer) */
+    IN_ERR_MALLOC_FAIL = -2  /**< Memory allocation failed */
+};
+
+/**
+ * @brief Creates the global intern table
+ * @return int IN_SUCCESS on success, IN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Intern_enable(void);
+
+/**
+ * @brief Tells whether the global intern table was created
+ * @return int Non-zero if names are interned, 0 otherwise
+ */
+int Intern_isEnabled(void);
+
+/**
+ * @brief Returns the interned copy of a string, adding it if it is new
+ * @param[in] str String to intern, need not be null-terminated
+ * @param[in] len Length of str
+ * @return const char* Null-terminated copy shared by every equal string, valid
+ *                     until Intern_free, or NULL if the table is not enabled or
+ *                     memory allocation failed
+ */
+const char *Intern_string(const char *str, size_t len);
+
+/**
+ * @brief Frees the global intern table and every string it returned
+ */
+void Intern_free(void);
+
+#endif /* _IG_INTERN_H_ */
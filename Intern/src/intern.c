@@ -0,0 +1,265 @@
+/**
+ * @file intern.c
+ * @brief Global symbol name intern table of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains a concurrent hash set of strings. The set is split into
+ * shards selected by the top bits of the hash, each with its own lock, bucket
+ * array and arena, so threads interning different names rarely contend.
+ * Strings are copied into the arena of their shard next to their entry and
+ * are released together with the table, never one by one.
+ */
+
+#include "../inc_pub/intern.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <pthread.h>  // For pthread_mutex_t
+#include <stdint.h>   // For uint64_t
+#include <stdlib.h>   // For malloc, calloc, free
+#include <string.h>   // For memcmp, memcpy
+
+#define IN_SHARD_BITS     6u                       /**< Number of hash bits selecting a shard */
+#define IN_SHARD_NUM      (1u << IN_SHARD_BITS)    /**< Number of shards */
+#define IN_BUCKETS_MIN    256u                     /**< Initial buckets of each shard (power of two) */
+#define IN_BLOCK_SIZE     (64u * 1024u)            /**< Default size of an arena block */
+#define IN_ALIGN          8u                       /**< Alignment of every entry */
+#define IN_FNV_OFFSET     14695981039346656037ull  /**< FNV-1a offset basis */
+#define IN_FNV_PRIME      1099511628211ull         /**< FNV-1a prime */
+
+/**
+ * @brief Interned string, followed in memory by its bytes and a terminator
+ */
+typedef struct intern_entry_s
+{
+    struct intern_entry_s *next;  /**< Next entry in the bucket */
+    uint64_t hash;                /**< Hash of the string */
+    size_t len;                   /**< Length of the string */
+    char str[];                   /**< String bytes */
+} intern_entry_t;
+
+/**
+ * @brief Arena block holding entries
+ */
+typedef struct intern_block_s
+{
+    struct intern_block_s *next;  /**< Previously filled block */
+    size_t size;                  /**< Usable bytes in data */
+    size_t used;                  /**< Bytes handed out */
+    unsigned char data[];         /**< Entry storage */
+} intern_block_t;
+
+/**
+ * @brief One lock-protected part of the table
+ */
+typedef struct intern_shard_s
+{
+    pthread_mutex_t lock;      /**< Serializes lookups and insertions */
+    intern_entry_t **buckets;  /**< Bucket array */
+    size_t bucket_num;         /**< Number of buckets (power of two) */
+    size_t entry_cnt;          /**< Number of entries */
+    intern_block_t *blocks;    /**< Arena blocks, newest first */
+} intern_shard_t;
+
+static intern_shard_t *g_intern_shards = NULL;  /* Shards of the global table, NULL while disabled */
+
+/**
+ * @brief Hashes a byte string with FNV-1a
+ * @param[in] str Bytes to hash
+ * @param[in] len Number of bytes
+ * @return uint64_t Hash
+ */
+static uint64_t intern_hash(const char *str, size_t len)
+{
+    uint64_t hash = IN_FNV_OFFSET;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= (unsigned char)str[i];
+        hash *= IN_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Allocates an entry from the arena of a shard
+ * @param[in,out] shard Shard owning the arena, locked
+ * @param[in] size Number of bytes
+ * @return void* Allocated memory, or NULL on failure
+ */
+static void *intern_alloc(intern_shard_t *shard, size_t size)
+{
+    intern_block_t *block = shard->blocks;
+    void *mem;
+
+    size = (size + IN_ALIGN - 1) & ~(size_t)(IN_ALIGN - 1);
+    if ((block == NULL) || ((block->size - block->used) < size))
+    {
+        size_t block_size = (size > IN_BLOCK_SIZE) ? size : IN_BLOCK_SIZE;
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(intern_block_t) + block_size);
+        block = malloc(sizeof(intern_block_t) + block_size);
+        if (block == NULL)
+        {
+            return NULL;  // Memory allocation error
+        }
+        block->size = block_size;
+        block->used = 0;
+        block->next = shard->blocks;
+        shard->blocks = block;
+    }
+    mem = &block->data[block->used];
+    block->used += size;
+    return mem;
+}
+
+/**
+ * @brief Doubles the buckets of a shard once it holds more entries than buckets
+ * @param[in,out] shard Shard to grow, locked
+ */
+static void intern_grow(intern_shard_t *shard)
+{
+    size_t new_num = shard->bucket_num * 2;
+    intern_entry_t **new_buckets = calloc(new_num, sizeof(intern_entry_t *));
+
+    if (new_buckets == NULL)
+    {
+        return;  // Keep the longer chains
+    }
+    for (size_t i = 0; i < shard->bucket_num; i++)
+    {
+        while (shard->buckets[i] != NULL)
+        {
+            intern_entry_t *moved = shard->buckets[i];
+            size_t bucket = (size_t)(moved->hash & (new_num - 1));
+            shard->buckets[i] = moved->next;
+            moved->next = new_buckets[bucket];
+            new_buckets[bucket] = moved;
+        }
+    }
+    free(shard->buckets);
+    shard->buckets = new_buckets;
+    shard->bucket_num = new_num;
+}
+
+/**
+ * @brief Creates the global intern table
+ * @return int IN_SUCCESS on success, IN_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Intern_enable(void)
+{
+    if (g_intern_shards != NULL)
+    {
+        return IN_SUCCESS;  // Already enabled
+    }
+    g_intern_shards = calloc(IN_SHARD_NUM, sizeof(intern_shard_t));
+    if (g_intern_shards == NULL)
+    {
+        return IN_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    for (size_t i = 0; i < IN_SHARD_NUM; i++)
+    {
+        pthread_mutex_init(&g_intern_shards[i].lock, NULL);
+        g_intern_shards[i].bucket_num = IN_BUCKETS_MIN;
+        g_intern_shards[i].buckets = calloc(IN_BUCKETS_MIN, sizeof(intern_entry_t *));
+        if (g_intern_shards[i].buckets == NULL)
+        {
+            Intern_free();
+            return IN_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+    }
+    return IN_SUCCESS;
+}
+
+/**
+ * @brief Tells whether the global intern table was created
+ * @return int Non-zero if names are interned, 0 otherwise
+ */
+int Intern_isEnabled(void)
+{
+    return (g_intern_shards != NULL);
+}
+
+/**
+ * @brief Returns the interned copy of a string, adding it if it is new
+ * @param[in] str String to intern, need not be null-terminated
+ * @param[in] len Length of str
+ * @return const char* Null-terminated copy shared by every equal string, valid
+ *                     until Intern_free, or NULL if the table is not enabled or
+ *                     memory allocation failed
+ */
+const char *Intern_string(const char *str, size_t len)
+{
+    intern_shard_t *shard;
+    intern_entry_t *entry;
+    uint64_t hash;
+    size_t bucket;
+
+    if ((g_intern_shards == NULL) || (str == NULL))
+    {
+        return NULL;  // Not enabled or invalid input
+    }
+    hash = intern_hash(str, len);
+    shard = &g_intern_shards[hash >> (64u - IN_SHARD_BITS)];
+    pthread_mutex_lock(&shard->lock);
+
+    // Name seen before, in this file or an earlier one
+    bucket = (size_t)(hash & (shard->bucket_num - 1));
+    for (entry = shard->buckets[bucket]; entry != NULL; entry = entry->next)
+    {
+        if ((entry->hash == hash) && (entry->len == len) && (memcmp(entry->str, str, len) == 0))
+        {
+            pthread_mutex_unlock(&shard->lock);
+            STATS_COUNT(STATS_COUNTER_INTERN_HIT, 1);
+            return entry->str;
+        }
+    }
+
+    // New name: copy it next to its entry
+    entry = intern_alloc(shard, sizeof(intern_entry_t) + len + 1);
+    if (entry == NULL)
+    {
+        pthread_mutex_unlock(&shard->lock);
+        return NULL;  // Memory allocation error
+    }
+    entry->hash = hash;
+    entry->len = len;
+    memcpy(entry->str, str, len);
+    entry->str[len] = '\0';
+    if (shard->entry_cnt >= shard->bucket_num)
+    {
+        intern_grow(shard);
+        bucket = (size_t)(hash & (shard->bucket_num - 1));
+    }
+    entry->next = shard->buckets[bucket];
+    shard->buckets[bucket] = entry;
+    shard->entry_cnt++;
+    pthread_mutex_unlock(&shard->lock);
+    STATS_COUNT(STATS_COUNTER_INTERN_BYTES, len + 1);
+    return entry->str;
+}
+
+/**
+ * @brief Frees the global intern table and every string it returned
+ */
+void Intern_free(void)
+{
+    if (g_intern_shards == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < IN_SHARD_NUM; i++)
+    {
+        intern_block_t *block = g_intern_shards[i].blocks;
+        while (block != NULL)
+        {
+            intern_block_t *next = block->next;
+            free(block);
+            block = next;
+        }
+        free(g_intern_shards[i].buckets);
+        pthread_mutex_destroy(&g_intern_shards[i].lock);
+    }
+    free(g_intern_shards);
+    g_intern_shards = NULL;
+}
@@ -14,6 +14,7 @@
 #define _IG_LINKEDLIST_H_
 
 #include "../../Writer/inc_pub/writer.h"  // For writer_line_t
+#include <stddef.h>  // For size_t
 
 /**
  * @brief Error codes for linked list operations
@@ -23,9 +24,19 @@ enum LinkedList_Error {
     LL_ERR_NULL_INPUT = -1,    /**< Invalid input (NULL pointer) */
     LL_ERR_EMPTY_LIST = -2,    /**< List is empty */
     LL_ERR_MALLOC_FAIL = -3,   /**< Memory allocation failed */
-    LL_ERR_NOT_FRONT = -4      /**< Head is not the first node */
+    LL_ERR_NOT_FRONT = -4,     /**< Head is not the first node */
+    LL_ERR_IO_FAIL = -5        /**< Temporary run file could not be created, written or read */
 };
 
+/**
+ * @brief Keys supported by LinkedList_radixSort
+ */
+typedef enum
+{
+    LL_SORT_KEY_VALUE = 0,  /**< Sort by symbol value */
+    LL_SORT_KEY_SIZE  = 1   /**< Sort by symbol size */
+} linkedlist_key_e;
+
 /**
  * @brief Structure representing a node in the doubly-linked list
  */
@@ -36,6 +47,15 @@ typedef struct dl_list_s
     writer_line_t *line;    /**< Pointer to the symbol line data */
 } dl_list_t;
 
+/**
+ * @brief Compares two symbol lines of a list being sorted
+ * @param[in] line1 First symbol line
+ * @param[in] line2 Second symbol line
+ * @param[in] arg Argument given to the sort
+ * @return int <0, 0, or >0
+ */
+typedef int (*linkedlist_cmp_f)(const writer_line_t *line1, const writer_line_t *line2, const void *arg);
+
 /**
  * @brief Removes and returns the front node from the list
  * @param[in,out] head Pointer to the head of the list; updated to next node on success
@@ -58,10 +78,75 @@ int LinkedList_nodePushFront(dl_list_t** head, writer_line_t* const line);
  * @brief Sorts the linked list using a comparison function
  * @param[in,out] head Pointer to the head of the list; updated to sorted head
  * @param[in] cmp Comparison function for writer_line_t elements; returns <0, 0, or >0
+ * @param[in] arg Argument of cmp
  * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT if head or cmp is NULL,
  *             LL_ERR_EMPTY_LIST if list is empty, LL_ERR_MALLOC_FAIL if allocation fails
  */
-int LinkedList_sort(dl_list_t** head, int (*cmp)(const writer_line_t*, const writer_line_t*));
+int LinkedList_sort(dl_list_t** head, linkedlist_cmp_f cmp, const void *arg);
+
+/**
+ * @brief Sorts the linked list by symbol value or size with a radix sort, undefined symbols first
+ * @param[in,out] head Pointer to head of the list; updated to sorted head
+ * @param[in] key Sort key (LL_SORT_KEY_VALUE or LL_SORT_KEY_SIZE)
+ * @param[in] cmp Comparison function ordering symbols with equal keys; returns <0, 0, or >0
+ * @param[in] arg Argument of cmp
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT if head or cmp is NULL,
+ *             LL_ERR_MALLOC_FAIL if allocation fails
+ */
+int LinkedList_radixSort(dl_list_t** head, linkedlist_key_e key, linkedlist_cmp_f cmp, const void *arg);
+
+/**
+ * @brief External sorter building sorted runs in temporary files (--max-memory)
+ */
+typedef struct ll_extsort_s ll_extsort_t;
+
+/**
+ * @brief Creates an external sorter
+ * @param[out] sorter Pointer to store the new sorter
+ * @param[in] mem_limit Memory the merge may use for its run buffers, in bytes
+ * @param[in] reverse Non-zero to produce the reverse order (-r)
+ * @param[in] cmp Comparison function of the symbol order; returns <0, 0, or >0
+ * @param[in] arg Argument of cmp; must stay valid until the sorter is freed
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT if sorter or cmp is NULL,
+ *             LL_ERR_MALLOC_FAIL if allocation fails
+ */
+int LinkedList_extSortCreate(ll_extsort_t **sorter, size_t mem_limit, int reverse,
+                             linkedlist_cmp_f cmp, const void *arg);
+
+/**
+ * @brief Sorts a list, writes it as the next run and deletes it
+ *
+ * Runs must be added in the order their symbols appear in the symbol table.
+ * Only the fields of the lines are kept; names are resolved again from
+ * name_off while merging, so the string table must stay loaded.
+ *
+ * @param[in,out] sorter External sorter
+ * @param[in,out] head Pointer to the head of the list; set to NULL, lines freed
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT on invalid input,
+ *             LL_ERR_MALLOC_FAIL if allocation fails, LL_ERR_IO_FAIL if the run cannot be written
+ */
+int LinkedList_extSortRunAdd(ll_extsort_t *sorter, dl_list_t **head);
+
+/**
+ * @brief Merges the runs and passes every line to a callback in sorted order
+ *
+ * The order is the one LinkedList_sort gives the whole list built from the
+ * runs in symbol table order. When there are more runs than the memory limit
+ * allows buffers for, groups of runs are first merged into longer runs.
+ *
+ * @param[in,out] sorter External sorter
+ * @param[in] emit Callback receiving each line; the line is only valid during the call
+ * @param[in] arg Argument passed to emit
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT on invalid input,
+ *             LL_ERR_MALLOC_FAIL if allocation fails, LL_ERR_IO_FAIL if a run cannot be read or written
+ */
+int LinkedList_extSortMerge(ll_extsort_t *sorter, void (*emit)(const writer_line_t *line, void *arg), void *arg);
+
+/**
+ * @brief Frees an external sorter and removes its runs
+ * @param[in,out] sorter Pointer to the sorter; set to NULL
+ */
+void LinkedList_extSortFree(ll_extsort_t **sorter);
 
 /**
  * @brief Deletes the entire linked list
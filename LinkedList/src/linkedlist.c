@@ -10,6 +10,7 @@
  */
 
 #include "../inc_pub/linkedlist.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
 #include <stdlib.h>
 
 /**
@@ -68,6 +69,8 @@ int LinkedList_nodePushFront(dl_list_t** head, writer_line_t* const line)
             return LL_ERR_NOT_FRONT;  // Ensure head is the first node
         }
     }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(dl_list_t));
     new_node = malloc(sizeof(dl_list_t));
     if (new_node == NULL)
     {
@@ -0,0 +1,475 @@
+/**
+ * @file linkedlist_extsort.c
+ * @brief External sorting of symbol lines for ft_nm (--max-memory)
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains a sort whose memory use does not grow with the number
+ * of symbols. The caller builds the symbol list in slices of the symbol
+ * table; each slice is sorted with LinkedList_sort and written to an unlinked
+ * temporary file as fixed-size records, and the slice is freed. The runs are
+ * then merged through a heap of one cursor per run and handed line by line
+ * to a callback, so only one buffer per run is held while printing. Equal
+ * lines are taken from the earlier run first, which together with the order
+ * LinkedList_sort gives equal lines inside a run reproduces the order of
+ * sorting the whole list at once.
+ */
+
+#include "../inc_pub/linkedlist.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdint.h>
+#include <stdio.h>   // For FILE, fdopen, fread, fwrite
+#include <stdlib.h>  // For malloc, realloc, free, getenv, mkstemp
+#include <string.h>  // For strlen, memcpy, memset
+#include <unistd.h>  // For unlink, close
+
+#define EXTSORT_BUF_SIZE    (64u * 1024u)  /**< Buffer of each open run */
+#define EXTSORT_FAN_IN_MIN  2u             /**< Fewest runs merged at once */
+#define EXTSORT_TMP_DIR     "/tmp"         /**< Directory of the runs when TMPDIR is not set */
+#define EXTSORT_TMP_NAME    "/ft_nm.XXXXXX" /**< mkstemp template of a run file name */
+
+/**
+ * @brief Line as stored in a run
+ */
+typedef struct extsort_rec_s
+{
+    uint64_t value;          /**< Symbol value */
+    uint64_t size;           /**< Symbol size */
+    uint32_t name_off;       /**< Offset of the name in the string table */
+    uint32_t sect_head_idx;  /**< Section header index */
+    uint8_t bind;            /**< Symbol binding (writer_flagprint_bind_e) */
+    uint8_t type;            /**< Symbol type (writer_flagprint_type_e) */
+} extsort_rec_t;
+
+/**
+ * @brief Read position in one run during a merge
+ */
+typedef struct extsort_cursor_s
+{
+    FILE *file;           /**< Run file */
+    size_t run;           /**< Position of the run in the merge, orders equal lines */
+    writer_line_t line;   /**< Current line of the run */
+} extsort_cursor_t;
+
+/**
+ * @brief External sorter
+ */
+struct ll_extsort_s
+{
+    FILE **runs;          /**< Run files in symbol table order */
+    size_t run_cnt;       /**< Number of runs */
+    size_t run_cap;       /**< Allocated run slots */
+    size_t fan_in;        /**< Most runs merged at once */
+    int reverse;          /**< Non-zero for the reverse order */
+    linkedlist_cmp_f cmp;  /**< Symbol order */
+    const void *cmp_arg;   /**< Argument of cmp */
+};
+
+/**
+ * @brief Creates an unlinked temporary file for a run
+ * @return FILE* Open file, or NULL on failure
+ */
+static FILE *extsort_tmpOpen(void)
+{
+    const char *dir = getenv("TMPDIR");
+    size_t dir_len;
+    char *path;
+    FILE *file = NULL;
+    int fd;
+
+    if ((dir == NULL) || (*dir == '\0'))
+    {
+        dir = EXTSORT_TMP_DIR;
+    }
+    dir_len = strlen(dir);
+    path = malloc(dir_len + sizeof(EXTSORT_TMP_NAME));
+    if (path == NULL)
+    {
+        return NULL;  // Memory allocation error
+    }
+    memcpy(path, dir, dir_len);
+    memcpy(path + dir_len, EXTSORT_TMP_NAME, sizeof(EXTSORT_TMP_NAME));
+    fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        unlink(path);  // Removed from the directory, freed on close
+        file = fdopen(fd, "w+b");
+        if (file == NULL)
+        {
+            close(fd);
+        }
+        else
+        {
+            setvbuf(file, NULL, _IOFBF, EXTSORT_BUF_SIZE);
+        }
+    }
+    free(path);
+    return file;
+}
+
+/**
+ * @brief Reads the next line of a cursor
+ * @param[in,out] cursor Cursor to advance
+ * @return int 1 if a line was read, 0 at the end of the run
+ */
+static int extsort_cursorNext(extsort_cursor_t *cursor)
+{
+    extsort_rec_t rec;
+
+    if (fread(&rec, sizeof(rec), 1, cursor->file) != 1)
+    {
+        return 0;
+    }
+    cursor->line.bind = (writer_flagprint_bind_e)rec.bind;
+    cursor->line.type = (writer_flagprint_type_e)rec.type;
+    cursor->line.sect_head_idx = rec.sect_head_idx;
+    cursor->line.name_off = rec.name_off;
+    cursor->line.name = NULL;       // Resolved from the loaded string table
+    cursor->line.value = rec.value;
+    cursor->line.size = rec.size;
+    cursor->line.demangled = NULL;  // Demangled when printed
+    return 1;
+}
+
+/**
+ * @brief Checks whether the line of cursor a is to be emitted before the one of b
+ * @param[in] sorter External sorter
+ * @param[in] a First cursor
+ * @param[in] b Second cursor
+ * @return int Non-zero if a goes first
+ */
+static int extsort_before(const ll_extsort_t *sorter, const extsort_cursor_t *a, const extsort_cursor_t *b)
+{
+    const extsort_cursor_t *low = sorter->reverse ? b : a;
+    const extsort_cursor_t *high = sorter->reverse ? a : b;
+
+    if (sorter->cmp(&high->line, &low->line, sorter->cmp_arg) > 0)
+    {
+        return 1;   // a is strictly before b in the requested direction
+    }
+    if (sorter->cmp(&low->line, &high->line, sorter->cmp_arg) > 0)
+    {
+        return 0;
+    }
+    return sorter->reverse ? (a->run > b->run) : (a->run < b->run);  // Equal: keep the run order
+}
+
+/**
+ * @brief Restores the heap order from a position towards the leaves
+ * @param[in] sorter External sorter
+ * @param[in,out] heap Cursors ordered as a min-heap
+ * @param[in] len Number of cursors in the heap
+ * @param[in] pos Position of the cursor to move down
+ */
+static void extsort_siftDown(const ll_extsort_t *sorter, extsort_cursor_t **heap, size_t len, size_t pos)
+{
+    extsort_cursor_t *entry = heap[pos];
+
+    while ((2 * pos + 1) < len)
+    {
+        size_t child = 2 * pos + 1;
+        if (((child + 1) < len) && extsort_before(sorter, heap[child + 1], heap[child]))
+        {
+            child++;  // Take the child going first
+        }
+        if (!extsort_before(sorter, heap[child], entry))
+        {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = entry;
+}
+
+/**
+ * @brief Writes a line to a run
+ * @param[in] file Run file
+ * @param[in] line Line to write
+ * @return int 1 on success, 0 on write failure
+ */
+static int extsort_recWrite(FILE *file, const writer_line_t *line)
+{
+    extsort_rec_t rec;
+
+    memset(&rec, 0, sizeof(rec));  // Padding is written too
+    rec.value = line->value;
+    rec.size = line->size;
+    rec.name_off = line->name_off;
+    rec.sect_head_idx = line->sect_head_idx;
+    rec.bind = (uint8_t)line->bind;
+    rec.type = (uint8_t)line->type;
+    return (fwrite(&rec, sizeof(rec), 1, file) == 1);
+}
+
+/**
+ * @brief Merges consecutive runs into a run file or into the callback
+ * @param[in] sorter External sorter
+ * @param[in] runs Runs to merge, in symbol table order; closed on return
+ * @param[in] run_cnt Number of runs
+ * @param[in] out Run file receiving the merge, or NULL to use emit
+ * @param[in] emit Callback receiving each line when out is NULL
+ * @param[in] arg Argument passed to emit
+ * @return int LL_SUCCESS on success, LL_ERR_MALLOC_FAIL if allocation fails,
+ *             LL_ERR_IO_FAIL if a run cannot be read or written
+ */
+static int extsort_mergeGroup(const ll_extsort_t *sorter, FILE **runs, size_t run_cnt, FILE *out,
+                              void (*emit)(const writer_line_t *line, void *arg), void *arg)
+{
+    extsort_cursor_t *cursors;
+    extsort_cursor_t **heap;
+    size_t heap_len = 0;
+    int ret = LL_SUCCESS;
+
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, run_cnt * (sizeof(extsort_cursor_t) + sizeof(extsort_cursor_t *)));
+    cursors = malloc(run_cnt * (sizeof(extsort_cursor_t) + sizeof(extsort_cursor_t *)));
+    if (cursors == NULL)
+    {
+        return LL_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    heap = (extsort_cursor_t **)&cursors[run_cnt];
+
+    // Start every run at its first line
+    for (size_t i = 0; i < run_cnt; i++)
+    {
+        cursors[i].file = runs[i];
+        cursors[i].run = i;
+        if ((fseek(runs[i], 0, SEEK_SET) != 0) || ferror(runs[i]))
+        {
+            ret = LL_ERR_IO_FAIL;
+        }
+        else if (extsort_cursorNext(&cursors[i]))
+        {
+            heap[heap_len++] = &cursors[i];
+        }
+    }
+    for (size_t i = heap_len / 2; i-- > 0;)
+    {
+        extsort_siftDown(sorter, heap, heap_len, i);
+    }
+
+    // Take the first line of the heap until every run is consumed
+    while ((heap_len != 0) && (ret == LL_SUCCESS))
+    {
+        extsort_cursor_t *first = heap[0];
+
+        if (out != NULL)
+        {
+            if (!extsort_recWrite(out, &first->line))
+            {
+                ret = LL_ERR_IO_FAIL;
+            }
+        }
+        else
+        {
+            emit(&first->line, arg);
+        }
+        if (!extsort_cursorNext(first))
+        {
+            if (ferror(first->file))
+            {
+                ret = LL_ERR_IO_FAIL;
+            }
+            heap[0] = heap[--heap_len];  // Run consumed
+        }
+        if (heap_len != 0)
+        {
+            extsort_siftDown(sorter, heap, heap_len, 0);
+        }
+    }
+    if ((out != NULL) && (fflush(out) != 0))
+    {
+        ret = LL_ERR_IO_FAIL;
+    }
+    for (size_t i = 0; i < run_cnt; i++)
+    {
+        fclose(runs[i]);
+        runs[i] = NULL;
+    }
+    free(cursors);
+    return ret;
+}
+
+/**
+ * @brief Creates an external sorter
+ * @param[out] sorter Pointer to store the new sorter
+ * @param[in] mem_limit Memory the merge may use for its run buffers, in bytes
+ * @param[in] reverse Non-zero to produce the reverse order (-r)
+ * @param[in] cmp Comparison function of the symbol order; returns <0, 0, or >0
+ * @param[in] arg Argument of cmp; must stay valid until the sorter is freed
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT if sorter or cmp is NULL,
+ *             LL_ERR_MALLOC_FAIL if allocation fails
+ */
+int LinkedList_extSortCreate(ll_extsort_t **sorter, size_t mem_limit, int reverse,
+                             linkedlist_cmp_f cmp, const void *arg)
+{
+    ll_extsort_t *new_sorter;
+
+    if ((sorter == NULL) || (cmp == NULL))
+    {
+        return LL_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(ll_extsort_t));
+    new_sorter = malloc(sizeof(ll_extsort_t));
+    if (new_sorter == NULL)
+    {
+        return LL_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    new_sorter->runs = NULL;
+    new_sorter->run_cnt = 0;
+    new_sorter->run_cap = 0;
+    new_sorter->fan_in = mem_limit / EXTSORT_BUF_SIZE;
+    if (new_sorter->fan_in < EXTSORT_FAN_IN_MIN)
+    {
+        new_sorter->fan_in = EXTSORT_FAN_IN_MIN;
+    }
+    new_sorter->reverse = reverse;
+    new_sorter->cmp = cmp;
+    new_sorter->cmp_arg = arg;
+    *sorter = new_sorter;
+    return LL_SUCCESS;
+}
+
+/**
+ * @brief Sorts a list, writes it as the next run and deletes it
+ * @param[in,out] sorter External sorter
+ * @param[in,out] head Pointer to the head of the list; set to NULL, lines freed
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT on invalid input,
+ *             LL_ERR_MALLOC_FAIL if allocation fails, LL_ERR_IO_FAIL if the run cannot be written
+ */
+int LinkedList_extSortRunAdd(ll_extsort_t *sorter, dl_list_t **head)
+{
+    const dl_list_t *node;
+    FILE *run;
+    int ret = LL_SUCCESS;
+
+    if ((sorter == NULL) || (head == NULL))
+    {
+        return LL_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (*head == NULL)
+    {
+        return LL_SUCCESS;  // Nothing to keep
+    }
+    if (sorter->run_cnt == sorter->run_cap)
+    {
+        size_t new_cap = (sorter->run_cap == 0) ? 16 : sorter->run_cap * 2;
+        FILE **new_runs = realloc(sorter->runs, new_cap * sizeof(FILE *));
+        if (new_runs == NULL)
+        {
+            return LL_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        sorter->runs = new_runs;
+        sorter->run_cap = new_cap;
+    }
+    run = extsort_tmpOpen();
+    if (run == NULL)
+    {
+        return LL_ERR_IO_FAIL;
+    }
+    LinkedList_sort(head, sorter->cmp, sorter->cmp_arg);
+
+    // Write the run in the requested direction
+    node = *head;
+    if (sorter->reverse)
+    {
+        for (; node->next != NULL; node = node->next)
+        {
+            ;
+        }
+    }
+    for (; (node != NULL) && (ret == LL_SUCCESS); node = sorter->reverse ? node->prev : node->next)
+    {
+        if (!extsort_recWrite(run, node->line))
+        {
+            ret = LL_ERR_IO_FAIL;
+        }
+    }
+    if ((ret != LL_SUCCESS) || (fflush(run) != 0))
+    {
+        fclose(run);
+        return LL_ERR_IO_FAIL;
+    }
+    sorter->runs[sorter->run_cnt++] = run;
+    LinkedList_delete(head, free);
+    return LL_SUCCESS;
+}
+
+/**
+ * @brief Merges the runs and passes every line to a callback in sorted order
+ * @param[in,out] sorter External sorter
+ * @param[in] emit Callback receiving each line; the line is only valid during the call
+ * @param[in] arg Argument passed to emit
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT on invalid input,
+ *             LL_ERR_MALLOC_FAIL if allocation fails, LL_ERR_IO_FAIL if a run cannot be read or written
+ */
+int LinkedList_extSortMerge(ll_extsort_t *sorter, void (*emit)(const writer_line_t *line, void *arg), void *arg)
+{
+    int ret = LL_SUCCESS;
+
+    if ((sorter == NULL) || (emit == NULL))
+    {
+        return LL_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+
+    // Merge groups of consecutive runs until one merge can take them all
+    while ((sorter->run_cnt > sorter->fan_in) && (ret == LL_SUCCESS))
+    {
+        size_t merged_cnt = 0;
+
+        for (size_t first = 0; (first < sorter->run_cnt) && (ret == LL_SUCCESS); first += sorter->fan_in)
+        {
+            size_t group_cnt = sorter->run_cnt - first;
+            FILE *out;
+
+            if (group_cnt > sorter->fan_in)
+            {
+                group_cnt = sorter->fan_in;
+            }
+            out = extsort_tmpOpen();
+            if (out == NULL)
+            {
+                ret = LL_ERR_IO_FAIL;
+                break;
+            }
+            ret = extsort_mergeGroup(sorter, &sorter->runs[first], group_cnt, out, NULL, NULL);
+            sorter->runs[merged_cnt++] = out;  // Slot is below first, already consumed
+        }
+        if (ret != LL_SUCCESS)
+        {
+            break;
+        }
+        sorter->run_cnt = merged_cnt;
+    }
+    if (ret == LL_SUCCESS)
+    {
+        ret = extsort_mergeGroup(sorter, sorter->runs, sorter->run_cnt, NULL, emit, arg);
+        sorter->run_cnt = 0;
+    }
+    return ret;
+}
+
+/**
+ * @brief Frees an external sorter and removes its runs
+ * @param[in,out] sorter Pointer to the sorter; set to NULL
+ */
+void LinkedList_extSortFree(ll_extsort_t **sorter)
+{
+    if ((sorter == NULL) || (*sorter == NULL))
+    {
+        return;
+    }
+    for (size_t i = 0; i < (*sorter)->run_cnt; i++)
+    {
+        if ((*sorter)->runs[i] != NULL)
+        {
+            fclose((*sorter)->runs[i]);
+        }
+    }
+    free((*sorter)->runs);
+    free(*sorter);
+    *sorter = NULL;
+}
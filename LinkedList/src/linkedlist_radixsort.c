@@ -0,0 +1,254 @@
+/**
+ * @file linkedlist_radixsort.c
+ * @brief Radix sorting of the doubly linked list by symbol value or size for ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the numeric (-n) and size (--size-sort) sorts of a
+ * doubly linked list of writer_line_t structures. Undefined symbols are placed
+ * first, the rest is ordered by key with an LSD radix sort over (key, node)
+ * pairs kept in a flat array, and runs of equal keys are ordered stably by the
+ * comparison function. Passes over bytes that are equal for every key are
+ * skipped.
+ */
+
+#include "../inc_pub/linkedlist.h"
+#include "../../Probe/inc_pub/probe.h"  // For FT_NM_PROBE2
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>
+
+/**
+ * @brief Radix macros
+ */
+#define RADIX_BITS          8u                    /**< Bits per radix digit */
+#define RADIX_BUCKETS       (1u << RADIX_BITS)    /**< Buckets per digit */
+#define RADIX_DIGITS        (64u / RADIX_BITS)    /**< Digits in a 64-bit key */
+#define RADIX_INSERTION_MAX 16u                   /**< Runs up to this length use insertion sort */
+
+/**
+ * @brief Sort element: key and the node it belongs to
+ */
+typedef struct radix_pair_s
+{
+    uint64_t key;      /**< Sort key (symbol value or size) */
+    dl_list_t *node;   /**< List node */
+} radix_pair_t;
+
+/**
+ * @brief Sorts pairs by key with an LSD radix sort
+ * @param[in,out] arr Pairs to sort; holds the result on return
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] n Number of pairs
+ */
+static void radixsort_keySort(radix_pair_t *arr, radix_pair_t *tmp, size_t n)
+{
+    size_t count[RADIX_DIGITS][RADIX_BUCKETS] = {{0}};
+    radix_pair_t *src = arr, *dst = tmp, *swap;
+    size_t pos, cnt;
+
+    // Build the histograms of all digits in one pass
+    for (size_t i = 0; i < n; i++)
+    {
+        for (unsigned int d = 0; d < RADIX_DIGITS; d++)
+        {
+            count[d][(arr[i].key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+    for (unsigned int d = 0; d < RADIX_DIGITS; d++)
+    {
+        // Skip digits that are the same for every key
+        if (count[d][(arr[0].key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)] == n)
+        {
+            continue;
+        }
+        // Turn counts into bucket start offsets
+        pos = 0;
+        for (unsigned int b = 0; b < RADIX_BUCKETS; b++)
+        {
+            cnt = count[d][b];
+            count[d][b] = pos;
+            pos += cnt;
+        }
+        // Scatter stably into the buckets
+        for (size_t i = 0; i < n; i++)
+        {
+            dst[count[d][(src[i].key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++] = src[i];
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != arr)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            arr[i] = src[i];  // Odd number of passes, move result back
+        }
+    }
+}
+
+/**
+ * @brief Sorts a run of pairs stably with the comparison function
+ * @param[in,out] arr Pairs to sort
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] n Number of pairs
+ * @param[in] cmp Comparison function
+ * @param[in] arg Argument of cmp
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ */
+static void radixsort_runSort(radix_pair_t *arr, radix_pair_t *tmp, size_t n, linkedlist_cmp_f cmp, const void *arg,
+                              size_t *cmp_cnt)
+{
+    radix_pair_t curr;
+    size_t left, right, mid, out;
+    size_t j;
+
+    if (n <= RADIX_INSERTION_MAX)
+    {
+        for (size_t i = 1; i < n; i++)
+        {
+            curr = arr[i];
+            for (j = i; j > 0; j--)
+            {
+                (*cmp_cnt)++;
+                if (cmp(curr.node->line, arr[j - 1].node->line, arg) >= 0)
+                {
+                    break;  // Equal elements keep their order
+                }
+                arr[j] = arr[j - 1];
+            }
+            arr[j] = curr;
+        }
+        return;
+    }
+    mid = n / 2;
+    radixsort_runSort(arr, tmp, mid, cmp, arg, cmp_cnt);
+    radixsort_runSort(&arr[mid], &tmp[mid], n - mid, cmp, arg, cmp_cnt);
+    left = 0;
+    right = mid;
+    out = 0;
+    while ((left < mid) && (right < n))
+    {
+        (*cmp_cnt)++;
+        if (cmp(arr[right].node->line, arr[left].node->line, arg) < 0)
+        {
+            tmp[out++] = arr[right++];
+        }
+        else
+        {
+            tmp[out++] = arr[left++];  // Ties taken from the left keep their order
+        }
+    }
+    while (left < mid)
+    {
+        tmp[out++] = arr[left++];
+    }
+    while (right < n)
+    {
+        tmp[out++] = arr[right++];
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        arr[i] = tmp[i];
+    }
+}
+
+/**
+ * @brief Sorts each run of equal keys in a key-sorted range by the comparison function
+ * @param[in,out] arr Key-sorted pairs
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] n Number of pairs
+ * @param[in] cmp Comparison function
+ * @param[in] arg Argument of cmp
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ */
+static void radixsort_tieSort(radix_pair_t *arr, radix_pair_t *tmp, size_t n, linkedlist_cmp_f cmp, const void *arg,
+                              size_t *cmp_cnt)
+{
+    size_t start = 0;
+
+    for (size_t i = 1; i <= n; i++)
+    {
+        if ((i == n) || (arr[i].key != arr[start].key))
+        {
+            if (i - start > 1)
+            {
+                radixsort_runSort(&arr[start], &tmp[start], i - start, cmp, arg, cmp_cnt);
+            }
+            start = i;
+        }
+    }
+}
+
+/**
+ * @brief Sorts the doubly linked list by symbol value or size, undefined symbols first
+ * @param[in,out] head Pointer to the head of the list
+ * @param[in] key Sort key (LL_SORT_KEY_VALUE or LL_SORT_KEY_SIZE)
+ * @param[in] cmp Function pointer used to order symbols with equal keys
+ * @param[in] arg Argument of cmp
+ * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT on invalid input,
+ *             LL_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int LinkedList_radixSort(dl_list_t** head, linkedlist_key_e key, linkedlist_cmp_f cmp, const void *arg)
+{
+    radix_pair_t *arr, *tmp;
+    size_t node_cnt = 0, undef_cnt = 0, def_pos;
+    size_t cmp_cnt = 0;
+
+    if ((head == NULL) || (cmp == NULL))
+    {
+        return LL_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    for (const dl_list_t *node = *head; node != NULL; node = node->next)
+    {
+        node_cnt++;
+        undef_cnt += (node->line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED);
+    }
+    if (node_cnt < 2)
+    {
+        return LL_SUCCESS;  // Nothing to sort
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, 2 * node_cnt * sizeof(radix_pair_t));
+    arr = malloc(2 * node_cnt * sizeof(radix_pair_t));
+    if (arr == NULL)
+    {
+        return LL_ERR_MALLOC_FAIL;  // Memory allocation failure
+    }
+    tmp = &arr[node_cnt];
+
+    // Undefined symbols go first, the rest follows in list order
+    def_pos = undef_cnt;
+    undef_cnt = 0;
+    for (dl_list_t *node = *head; node != NULL; node = node->next)
+    {
+        if (node->line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED)
+        {
+            arr[undef_cnt].key = 0;
+            arr[undef_cnt++].node = node;
+        }
+        else
+        {
+            arr[def_pos].key = (key == LL_SORT_KEY_SIZE) ? node->line->size : node->line->value;
+            arr[def_pos++].node = node;
+        }
+    }
+    if (node_cnt - undef_cnt > 1)
+    {
+        radixsort_keySort(&arr[undef_cnt], tmp, node_cnt - undef_cnt);
+    }
+    radixsort_tieSort(arr, tmp, undef_cnt, cmp, arg, &cmp_cnt);
+    radixsort_tieSort(&arr[undef_cnt], tmp, node_cnt - undef_cnt, cmp, arg, &cmp_cnt);
+
+    // Relink the nodes in sorted order
+    for (size_t i = 0; i < node_cnt; i++)
+    {
+        arr[i].node->prev = (i == 0) ? NULL : arr[i - 1].node;
+        arr[i].node->next = (i + 1 == node_cnt) ? NULL : arr[i + 1].node;
+    }
+    *head = arr[0].node;
+    free(arr);
+    FT_NM_PROBE2(list_sort, node_cnt, cmp_cnt);
+    return LL_SUCCESS;
+}
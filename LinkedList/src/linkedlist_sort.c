@@ -4,54 +4,71 @@
  * @author Domen Banfi
  * @date 2025-03-16
  * @version 1.0
- * @todo Implement a more efficient sorting algorithm (e.g., merge sort) for better performance with large lists
  *
  * This file contains functions for sorting a doubly linked list of
  * writer_line_t structures, used to order symbol names in ft_nm.
- * The sorting uses insertion sort for simplicity and stability,
- * preserving the order of equal elements as determined by the comparison function.
+ * The sorting is a bottom-up merge sort of the list in place. Only the
+ * strict "greater than" result of the comparison function is relied on, and
+ * of equal elements the one later in the list comes first, which is the order
+ * the insertion sort used before produced; the output is unchanged.
  */
 
 #include "../inc_pub/linkedlist.h"
+#include "../../Probe/inc_pub/probe.h"  // For FT_NM_PROBE2
 #include <stdlib.h>
 
-
 /**
- * @brief Inserts a node into the sorted list at the correct position
- * @param[in,out] head Pointer to the head of the list
- * @param[in] inserting_node Node to be inserted
- * @param[in] next_node Node after which the insertion occurs
+ * @brief Merges two sorted runs
+ *
+ * Nodes of the later run go first unless they compare greater, so equal
+ * elements end up in reverse list order.
+ *
+ * @param[in] first Sorted run taken from earlier in the list
+ * @param[in] second Sorted run taken from later in the list
+ * @param[in] cmp Function pointer to compare two writer_line_t structures
+ * @param[in] arg Argument of cmp
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ * @return dl_list_t* Head of the merged run, linked through next only
  */
-static void insert_node(dl_list_t** head, dl_list_t* inserting_node, dl_list_t* next_node)
+static dl_list_t *merge_runs(dl_list_t *first, dl_list_t *second,
+                             linkedlist_cmp_f cmp, const void *arg, size_t *cmp_cnt)
 {
-    if (head == NULL || inserting_node == NULL || next_node == NULL)
-    {
-        return;  // Silently return on invalid input to prevent crashes
-    }
-    inserting_node->next = next_node;       // Link inserting node to next node
-    inserting_node->prev = next_node->prev; // Link inserting node to previous node
-    if (next_node->prev == NULL)
-    {
-        *head = inserting_node;            // Update head if inserting at the start
-    }
-    else
+    dl_list_t merged = {NULL, NULL, NULL};
+    dl_list_t *tail = &merged;
+
+    while ((first != NULL) && (second != NULL))
     {
-        next_node->prev->next = inserting_node; // Link previous node to inserting node
+        (*cmp_cnt)++;
+        if (cmp(second->line, first->line, arg) > 0)
+        {
+            tail->next = first;   // Earlier node is strictly smaller
+            first = first->next;
+        }
+        else
+        {
+            tail->next = second;  // Later node is smaller or equal
+            second = second->next;
+        }
+        tail = tail->next;
     }
-    next_node->prev = inserting_node;       // Link next node back to inserting node
+    tail->next = (first != NULL) ? first : second;
+    return merged.next;
 }
 
 /**
- * @brief Sorts the doubly linked list using insertion sort
+ * @brief Sorts the doubly linked list using a bottom-up merge sort
  * @param[in,out] head Pointer to the head of the list
  * @param[in] cmp Function pointer to compare two writer_line_t structures
+ * @param[in] arg Argument of cmp
  * @return int LL_SUCCESS on success, LL_ERR_NULL_INPUT on invalid input
  */
-int LinkedList_sort(dl_list_t** head, int (*cmp)(const writer_line_t*, const writer_line_t*))
+int LinkedList_sort(dl_list_t** head, linkedlist_cmp_f cmp, const void *arg)
 {
-    dl_list_t* next_node, *temp_node;
-    dl_list_t* curr_node;
-    dl_list_t* chk_node;
+    dl_list_t *runs[sizeof(size_t) * 8] = {NULL};  // runs[i] holds 2^i sorted nodes or is empty
+    dl_list_t *curr_node, *next_node, *run;
+    size_t node_cnt = 0;  // Number of sorted nodes, reported by the list_sort probe
+    size_t cmp_cnt = 0;   // Number of comparisons, reported by the list_sort probe
+    size_t level;
 
     if ((head == NULL) || (cmp == NULL))
     {
@@ -61,40 +78,39 @@ int LinkedList_sort(dl_list_t** head, int (*cmp)(const writer_line_t*, const wri
     {
         return LL_SUCCESS;         // Empty list is already sorted
     }
-    curr_node = *head;
-    *head = NULL;                  // Initialize sorted list as empty
-    while (curr_node != NULL)
+
+    // Merge single nodes into runs of doubling length, like a binary counter
+    for (curr_node = *head; curr_node != NULL; curr_node = next_node)
     {
-        chk_node = *head;
-        next_node = curr_node->next;  // Store next node for iteration
-        curr_node->next = NULL;       // Disconnect current node
-        curr_node->prev = NULL;       // Disconnect current node
-        if (*head == NULL)
+        next_node = curr_node->next;
+        curr_node->next = NULL;
+        run = curr_node;
+        node_cnt++;
+        for (level = 0; runs[level] != NULL; level++)
         {
-            *head = curr_node;        // First node in sorted list
+            run = merge_runs(runs[level], run, cmp, arg, &cmp_cnt);  // Stored run comes from earlier in the list
+            runs[level] = NULL;
         }
-        else
+        runs[level] = run;
+    }
+
+    // Merge the remaining runs, earlier ones being at higher levels
+    run = NULL;
+    for (level = 0; level < sizeof(runs) / sizeof(runs[0]); level++)
+    {
+        if (runs[level] != NULL)
         {
-            while (chk_node != NULL)
-            {
-                if (cmp(curr_node->line, chk_node->line) > 0)
-                {
-                    temp_node = chk_node;  // Store last checked node
-                    chk_node = chk_node->next;  // Move to next node
-                }
-                else
-                {
-                    insert_node(head, curr_node, chk_node);  // Insert at current position
-                    break;
-                }
-            }
-            if (chk_node == NULL)
-            {
-                temp_node->next = curr_node;  // Append to end of sorted list
-                curr_node->prev = temp_node;  // Link back to last node
-            }
+            run = (run == NULL) ? runs[level] : merge_runs(runs[level], run, cmp, arg, &cmp_cnt);
         }
-        curr_node = next_node;  // Move to next unsorted node
     }
+
+    // Restore the back links
+    *head = run;
+    run->prev = NULL;
+    for (curr_node = run; curr_node->next != NULL; curr_node = curr_node->next)
+    {
+        curr_node->next->prev = curr_node;
+    }
+    FT_NM_PROBE2(list_sort, node_cnt, cmp_cnt);
     return LL_SUCCESS;
 }
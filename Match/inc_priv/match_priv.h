@@ -0,0 +1,193 @@
+/**
+ * @file match_priv.h
+ * @brief Private header for the symbol name patterns of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header defines the pattern set: the literals and the NFA its
+ * patterns are parsed into, and the tries and the DFA they are compiled
+ * into, each over its own byte classes. It is intended for internal use
+ * only by match module components.
+ */
+
+#ifndef _IG_MATCH_PRIV_H_
+#define _IG_MATCH_PRIV_H_
+
+#include "../inc_pub/match.h"
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint*_t
+
+#define MA_NONE             UINT32_MAX  /**< No state, or the end of a patch list */
+#define MA_NFA_STATES_MAX   65536u      /**< Most NFA states of a set */
+#define MA_DFA_CELLS_MAX    (1u << 22)  /**< Most DFA transitions, states times byte classes */
+#define MA_CLASS_NUM        256u        /**< Number of byte values */
+
+// NFA state types
+#define MA_NFA_SET          0u  /**< Reads a byte of its set, then goes to out */
+#define MA_NFA_SPLIT        1u  /**< Goes to out and out1 without reading */
+#define MA_NFA_EMPTY        2u  /**< Goes to out without reading */
+#define MA_NFA_ACCEPT       3u  /**< Pattern matched, whatever follows */
+#define MA_NFA_ACCEPT_END   4u  /**< Pattern matched if the name ends here */
+
+// Accepting flags of trie nodes and DFA states
+#define MA_ACCEPT_ANY       1u  /**< Name matches, whatever follows */
+#define MA_ACCEPT_END       2u  /**< Name matches if it ends here */
+
+// Literal kinds
+#define MA_LIT_SUBSTR       0u  /**< Found anywhere in the name */
+#define MA_LIT_PREFIX       1u  /**< Starts the name */
+#define MA_LIT_EXACT        2u  /**< Is the whole name */
+
+/**
+ * @brief Set of bytes read by an NFA state
+ */
+typedef struct ma_set_s
+{
+    uint64_t bits[MA_CLASS_NUM / 64];  /**< Bit b set if byte b is in the set */
+} ma_set_t;
+
+/**
+ * @brief NFA state
+ */
+typedef struct ma_nstate_s
+{
+    uint8_t type;  /**< MA_NFA_* type */
+    uint32_t out;  /**< Next state, or the next patch list entry while dangling */
+    uint32_t out1; /**< Second next state of a split */
+    uint32_t set;  /**< Index of the byte set of a MA_NFA_SET state */
+} ma_nstate_t;
+
+/**
+ * @brief Growable array of state indices
+ */
+typedef struct ma_list_s
+{
+    uint32_t *items;  /**< Indices */
+    size_t cnt;       /**< Number of indices */
+    size_t cap;       /**< Room for indices */
+} ma_list_t;
+
+/**
+ * @brief NFA of the patterns that are not literals
+ */
+typedef struct ma_nfa_s
+{
+    ma_nstate_t *states;   /**< States */
+    size_t state_cnt;      /**< Number of states */
+    size_t state_cap;      /**< Room for states */
+    ma_set_t *sets;        /**< Byte sets of the MA_NFA_SET states */
+    size_t set_cnt;        /**< Number of sets */
+    size_t set_cap;        /**< Room for sets */
+    ma_list_t anchored;    /**< Start of each branch matching from the first byte */
+    ma_list_t floating;    /**< Start of each branch matching anywhere in the name */
+} ma_nfa_t;
+
+/**
+ * @brief Literal pattern branch
+ */
+typedef struct ma_literal_s
+{
+    size_t off;    /**< Offset of its bytes in the literal pool */
+    size_t len;    /**< Number of bytes */
+    uint8_t kind;  /**< MA_LIT_* kind */
+} ma_literal_t;
+
+/**
+ * @brief Trie over the literals, as a table of transitions per byte class
+ */
+typedef struct ma_trie_s
+{
+    uint32_t *delta;   /**< Next node of each node and class */
+    uint8_t *accept;   /**< MA_ACCEPT_* flags of each node */
+    size_t node_cnt;   /**< Number of nodes, 0 if the trie is not used */
+    size_t node_cap;   /**< Room for nodes */
+} ma_trie_t;
+
+/**
+ * @brief DFA of the NFA, as a table of transitions per byte class
+ */
+typedef struct ma_dfa_s
+{
+    uint32_t *delta;   /**< Next state of each state and class; state 0 is dead */
+    uint8_t *accept;   /**< MA_ACCEPT_* flags of each state */
+    size_t state_cnt;  /**< Number of states, 0 if the DFA is not used */
+    uint32_t start;    /**< Start state */
+} ma_dfa_t;
+
+/**
+ * @brief Pattern set
+ */
+struct match_s
+{
+    ma_nfa_t nfa;                       /**< NFA of the other patterns, parsed as they are added */
+    ma_literal_t *lits;                 /**< Literal branches */
+    size_t lit_cnt;                     /**< Number of literal branches */
+    size_t lit_cap;                     /**< Room for literal branches */
+    char *pool;                         /**< Bytes of the literals */
+    size_t pool_len;                    /**< Bytes used in the pool */
+    size_t pool_cap;                    /**< Room in the pool */
+    char *bad;                          /**< Copy of the malformed pattern of a file, or NULL */
+    unsigned short compiled;            /**< Non-zero once Match_compile ran */
+    uint8_t lit_class[MA_CLASS_NUM];    /**< Class of each byte in the tries */
+    size_t lit_class_cnt;               /**< Number of classes in the tries */
+    ma_trie_t prefix;                   /**< Trie of the prefix and exact literals, node 1 being the root */
+    ma_trie_t substr;                   /**< Aho-Corasick automaton of the other literals */
+    uint8_t dfa_class[MA_CLASS_NUM];    /**< Class of each byte in the DFA */
+    size_t dfa_class_cnt;               /**< Number of classes in the DFA */
+    ma_dfa_t dfa;                       /**< DFA of the NFA */
+};
+
+/**
+ * @brief Parses a pattern into literals and NFA branches of a set
+ * @param[in,out] match Set to add to
+ * @param[in] pattern Pattern, with its "glob:" prefix if any
+ * @param[in] len Length of the pattern
+ * @return int MA_SUCCESS on success, MA_ERR_BAD_PATTERN if the pattern is malformed,
+ *             MA_ERR_TOO_COMPLEX if the NFA grows past its bound,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_Parse_pattern(match_t *match, const char *pattern, size_t len);
+
+/**
+ * @brief Adds an index to a list
+ * @param[in,out] list List to add to
+ * @param[in] item Index to add
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_List_push(ma_list_t *list, uint32_t item);
+
+/**
+ * @brief Builds the prefix trie and the Aho-Corasick automaton of the literals of a set
+ * @param[in,out] match Set to compile
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_Trie_build(match_t *match);
+
+/**
+ * @brief Tests a name against the literals of a set
+ * @param[in] match Compiled set
+ * @param[in] name Name
+ * @param[in] max_len Most bytes of the name read
+ * @return int Non-zero if a literal matches the name
+ */
+int Match_Trie_run(const match_t *match, const uint8_t *name, size_t max_len);
+
+/**
+ * @brief Builds the DFA of the NFA of a set by subset construction
+ * @param[in,out] match Set to compile
+ * @return int MA_SUCCESS on success, MA_ERR_TOO_COMPLEX if the DFA grows past its bound,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_Dfa_build(match_t *match);
+
+/**
+ * @brief Tests a name against the DFA of a set
+ * @param[in] match Compiled set
+ * @param[in] name Name
+ * @param[in] max_len Most bytes of the name read
+ * @return int Non-zero if a branch of the DFA matches the name
+ */
+int Match_Dfa_run(const match_t *match, const uint8_t *name, size_t max_len);
+
+#endif /* _IG_MATCH_PRIV_H_ */
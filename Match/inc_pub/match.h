@@ -0,0 +1,103 @@
+/**
+ * @file match.h
+ * @brief Public header for the symbol name patterns of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the name filter behind --match and --match-file.
+ * Patterns are POSIX extended regular expressions searched anywhere in the
+ * name, like grep -E, or shell globs matching the whole name when written
+ * "glob:PATTERN". Once every pattern is added, the set is compiled once:
+ * literal branches go into an Aho-Corasick automaton, prefix and exact
+ * ones into a trie walked from the first byte, and all others into one
+ * DFA, so a name is tested in a single pass over each, whatever the number
+ * of patterns.
+ *
+ * A compiled set is only read, so it can be tested from several threads.
+ */
+
+#ifndef _IG_MATCH_H_
+#define _IG_MATCH_H_
+
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Error codes for pattern operations
+ */
+enum Match_Error {
+    MA_SUCCESS = 0,             /**< Success */
+    MA_ERR_NULL_INPUT = -1,     /**< Invalid input (NULL pointer, or set already compiled) */
+    MA_ERR_MALLOC_FAIL = -2,    /**< Memory allocation failed */
+    MA_ERR_FILE_FAIL = -3,      /**< Pattern file could not be read (errno set) */
+    MA_ERR_BAD_PATTERN = -4,    /**< Malformed pattern */
+    MA_ERR_TOO_COMPLEX = -5     /**< Patterns need more automaton states than allowed */
+};
+
+/**
+ * @brief Set of name patterns
+ */
+typedef struct match_s match_t;
+
+/**
+ * @brief Creates an empty pattern set
+ * @param[out] match Created set
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT if match is NULL,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_create(match_t **match);
+
+/**
+ * @brief Adds a pattern to a set
+ *
+ * An extended regular expression is split at its top-level '|'; each
+ * branch may start with '^' and end with '$'. A branch without any other
+ * special character is kept as a literal. The empty pattern matches every
+ * name, like an empty grep pattern.
+ *
+ * @param[in,out] match Set to add to, not compiled yet
+ * @param[in] pattern Pattern, "glob:" followed by a glob or an extended regular expression
+ * @param[in] len Length of the pattern
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT on invalid input,
+ *             MA_ERR_BAD_PATTERN if the pattern is malformed, MA_ERR_TOO_COMPLEX if it is too large,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_patternAdd(match_t *match, const char *pattern, size_t len);
+
+/**
+ * @brief Adds the patterns of a file to a set, one per line
+ * @param[in,out] match Set to add to, not compiled yet
+ * @param[in] path Path of the file
+ * @param[out] bad_pattern First malformed pattern, valid until the set is freed; NULL if none
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT on invalid input,
+ *             MA_ERR_FILE_FAIL if the file cannot be read, MA_ERR_BAD_PATTERN or
+ *             MA_ERR_TOO_COMPLEX for the pattern set in bad_pattern,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_fileAdd(match_t *match, const char *path, const char **bad_pattern);
+
+/**
+ * @brief Compiles the patterns of a set; no pattern can be added afterwards
+ * @param[in,out] match Set to compile
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT on invalid input,
+ *             MA_ERR_TOO_COMPLEX if the DFA grows past its bound,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_compile(match_t *match);
+
+/**
+ * @brief Tests a name against a compiled set
+ * @param[in] match Compiled set
+ * @param[in] name Name, ending at its first null byte or at max_len
+ * @param[in] max_len Most bytes of the name read
+ * @return int Non-zero if a pattern matches the name, 0 otherwise
+ */
+int Match_name(const match_t *match, const char *name, size_t max_len);
+
+/**
+ * @brief Frees a pattern set
+ * @param[in,out] match Set to free; set to NULL
+ */
+void Match_free(match_t **match);
+
+#endif /* _IG_MATCH_H_ */
@@ -0,0 +1,209 @@
+/**
+ * @file match.c
+ * @brief Symbol name patterns of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the pattern set behind --match and --match-file:
+ * adding patterns from the command line or a file, compiling the set into
+ * its literal automata and its DFA, and testing a name against both.
+ */
+
+#include "../inc_priv/match_priv.h"
+#include "../../FileHandler/inc_pub/filehandler.h"  // For source_file_t, FileHandler_*
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For calloc, malloc, free
+#include <string.h>  // For memchr, memcpy
+
+/**
+ * @brief Creates an empty pattern set
+ * @param[out] match Created set
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT if match is NULL,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_create(match_t **match)
+{
+    if (match == NULL)
+    {
+        return MA_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    *match = calloc(1, sizeof(match_t));
+    if (*match == NULL)
+    {
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(match_t));
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Adds a pattern to a set
+ * @param[in,out] match Set to add to, not compiled yet
+ * @param[in] pattern Pattern, "glob:" followed by a glob or an extended regular expression
+ * @param[in] len Length of the pattern
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT on invalid input,
+ *             MA_ERR_BAD_PATTERN if the pattern is malformed, MA_ERR_TOO_COMPLEX if it is too large,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_patternAdd(match_t *match, const char *pattern, size_t len)
+{
+    if ((match == NULL) || (pattern == NULL) || match->compiled)
+    {
+        return MA_ERR_NULL_INPUT;  // Invalid input: NULL pointer or compiled set
+    }
+    if (memchr(pattern, '\0', len) != NULL)
+    {
+        return MA_ERR_BAD_PATTERN;  // A name never holds a null byte
+    }
+    return Match_Parse_pattern(match, pattern, len);
+}
+
+/**
+ * @brief Keeps a copy of the malformed pattern of a file
+ * @param[in,out] match Set
+ * @param[in] line Pattern
+ * @param[in] len Length of the pattern
+ * @param[out] bad_pattern Copy of the pattern
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int match_badKeep(match_t *match, const char *line, size_t len, const char **bad_pattern)
+{
+    free(match->bad);
+    match->bad = malloc(len + 1);
+    if (match->bad == NULL)
+    {
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, len + 1);
+    memcpy(match->bad, line, len);
+    match->bad[len] = '\0';
+    *bad_pattern = match->bad;
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Adds the patterns of a file to a set, one per line
+ *
+ * A final newline does not start an empty pattern; any other empty line
+ * is an empty pattern, matching every name.
+ *
+ * @param[in,out] match Set to add to, not compiled yet
+ * @param[in] path Path of the file
+ * @param[out] bad_pattern First malformed pattern, valid until the set is freed; NULL if none
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT on invalid input,
+ *             MA_ERR_FILE_FAIL if the file cannot be read, MA_ERR_BAD_PATTERN or
+ *             MA_ERR_TOO_COMPLEX for the pattern set in bad_pattern,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_fileAdd(match_t *match, const char *path, const char **bad_pattern)
+{
+    source_file_t file;
+    int ret = MA_SUCCESS;
+
+    if ((match == NULL) || (path == NULL) || (bad_pattern == NULL) || match->compiled)
+    {
+        return MA_ERR_NULL_INPUT;  // Invalid input: NULL pointer or compiled set
+    }
+    *bad_pattern = NULL;
+    FileHandler_structSetup(&file);
+    if (FileHandler_fileOpen(&file, path) != FH_SUCCESS)
+    {
+        return MA_ERR_FILE_FAIL;  // Failed to open the file
+    }
+    if ((file.size != 0) && ((file.size > SIZE_MAX) || (FileHandler_mapGet(&file, (size_t)file.size, 0) != FH_SUCCESS)))
+    {
+        FileHandler_fileClose(&file);
+        return MA_ERR_FILE_FAIL;  // Failed to map the file
+    }
+    if (file.size != 0)
+    {
+        const char *text = file.map;
+        size_t pos = 0;
+
+        while ((pos < file.map_len) && (ret == MA_SUCCESS))
+        {
+            const char *newline = memchr(text + pos, '\n', file.map_len - pos);
+            size_t len = (newline != NULL) ? (size_t)(newline - (text + pos)) : (file.map_len - pos);
+
+            ret = Match_patternAdd(match, text + pos, len);
+            if ((ret == MA_ERR_BAD_PATTERN) || (ret == MA_ERR_TOO_COMPLEX))
+            {
+                int keep = match_badKeep(match, text + pos, len, bad_pattern);
+                ret = (keep != MA_SUCCESS) ? keep : ret;
+            }
+            pos += len + 1;
+        }
+    }
+    FileHandler_fileClose(&file);
+    return ret;
+}
+
+/**
+ * @brief Compiles the patterns of a set; no pattern can be added afterwards
+ * @param[in,out] match Set to compile
+ * @return int MA_SUCCESS on success, MA_ERR_NULL_INPUT on invalid input,
+ *             MA_ERR_TOO_COMPLEX if the DFA grows past its bound,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_compile(match_t *match)
+{
+    int ret;
+
+    if ((match == NULL) || match->compiled)
+    {
+        return MA_ERR_NULL_INPUT;  // Invalid input: NULL pointer or compiled set
+    }
+    match->compiled = 1;
+    if ((ret = Match_Trie_build(match)) != MA_SUCCESS)
+    {
+        return ret;
+    }
+    return Match_Dfa_build(match);
+}
+
+/**
+ * @brief Tests a name against a compiled set
+ * @param[in] match Compiled set
+ * @param[in] name Name, ending at its first null byte or at max_len
+ * @param[in] max_len Most bytes of the name read
+ * @return int Non-zero if a pattern matches the name, 0 otherwise
+ */
+int Match_name(const match_t *match, const char *name, size_t max_len)
+{
+    if ((match == NULL) || (name == NULL) || !match->compiled)
+    {
+        return 0;
+    }
+    return Match_Trie_run(match, (const uint8_t *)name, max_len) ||
+           Match_Dfa_run(match, (const uint8_t *)name, max_len);
+}
+
+/**
+ * @brief Frees a pattern set
+ * @param[in,out] match Set to free; set to NULL
+ */
+void Match_free(match_t **match)
+{
+    if ((match == NULL) || (*match == NULL))
+    {
+        return;
+    }
+    free((*match)->nfa.states);
+    free((*match)->nfa.sets);
+    free((*match)->nfa.anchored.items);
+    free((*match)->nfa.floating.items);
+    free((*match)->lits);
+    free((*match)->pool);
+    free((*match)->bad);
+    free((*match)->prefix.delta);
+    free((*match)->prefix.accept);
+    free((*match)->substr.delta);
+    free((*match)->substr.accept);
+    free((*match)->dfa.delta);
+    free((*match)->dfa.accept);
+    free(*match);
+    *match = NULL;
+}
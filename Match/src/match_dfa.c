@@ -0,0 +1,444 @@
+/**
+ * @file match_dfa.c
+ * @brief DFA of the symbol name patterns of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the subset construction of the NFA of the patterns
+ * that are not literals. The bytes are first split into classes no byte set
+ * of the NFA tells apart, then each DFA state is the sorted list of the
+ * byte-reading and accepting NFA states reachable without reading. Branches
+ * matching anywhere in the name are restarted after each byte, so the DFA
+ * searches them in one pass. States that accept whatever follows get no
+ * transitions, as the run stops there.
+ */
+
+#include "../inc_priv/match_priv.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For malloc, calloc, realloc, free, qsort
+#include <string.h>  // For memcmp, memset
+
+#define MA_DFA_STATES_MIN   64u          /**< First capacity of the DFA */
+#define MA_HASH_SEED        2166136261u  /**< FNV-1a offset basis */
+#define MA_HASH_PRIME       16777619u    /**< FNV-1a prime */
+
+/**
+ * @brief Working state of the subset construction
+ */
+typedef struct ma_builder_s
+{
+    match_t *match;        /**< Set being compiled */
+    uint32_t *items;       /**< NFA states of every DFA state, one list after the other */
+    size_t item_cnt;       /**< Number of NFA states in items */
+    size_t item_cap;       /**< Room in items */
+    size_t *offs;          /**< Offset of the list of each DFA state in items, plus the end */
+    size_t dfa_cap;        /**< Room for DFA states */
+    uint32_t *table;       /**< Hash table of DFA states, MA_NONE if empty */
+    size_t table_cap;      /**< Number of buckets, a power of two */
+    uint32_t *mark;        /**< Pass that last reached each NFA state */
+    uint32_t pass;         /**< Current closure pass */
+    uint32_t *stack;       /**< NFA states left to visit in a closure */
+    uint8_t rep[MA_CLASS_NUM];  /**< One byte of each class */
+} ma_builder_t;
+
+/**
+ * @brief Splits the bytes into the classes no byte set of the NFA tells apart
+ * @param[in,out] match Set to compile
+ */
+static void ma_classesSplit(match_t *match)
+{
+    uint16_t split[MA_CLASS_NUM * 2];
+
+    memset(match->dfa_class, 0, sizeof(match->dfa_class));
+    match->dfa_class_cnt = 1;
+    for (size_t s = 0; s < match->nfa.set_cnt; s++)
+    {
+        const ma_set_t *set = &match->nfa.sets[s];
+        size_t cnt = 0;
+
+        memset(split, 0xff, sizeof(split));
+        for (unsigned int b = 0; b < MA_CLASS_NUM; b++)
+        {
+            unsigned int key = (unsigned int)match->dfa_class[b] * 2 + ((set->bits[b / 64] >> (b % 64)) & 1u);
+            if (split[key] == UINT16_MAX)
+            {
+                split[key] = (uint16_t)cnt++;
+            }
+            match->dfa_class[b] = (uint8_t)split[key];
+        }
+        match->dfa_class_cnt = cnt;
+    }
+}
+
+/**
+ * @brief Adds an NFA state and what it reaches without reading to the builder's list
+ * @param[in,out] b Builder; the list grows at the end of items
+ * @param[in] state NFA state
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_closureAdd(ma_builder_t *b, uint32_t state)
+{
+    const ma_nstate_t *states = b->match->nfa.states;
+    size_t top = 0;
+
+    if (b->mark[state] == b->pass)
+    {
+        return MA_SUCCESS;
+    }
+    b->mark[state] = b->pass;
+    b->stack[top++] = state;
+    while (top != 0)
+    {
+        const ma_nstate_t *nstate = &states[b->stack[--top]];
+        uint32_t next[2] = {nstate->out, (nstate->type == MA_NFA_SPLIT) ? nstate->out1 : MA_NONE};
+
+        if ((nstate->type == MA_NFA_SPLIT) || (nstate->type == MA_NFA_EMPTY))
+        {
+            for (size_t i = 0; i < 2; i++)
+            {
+                if ((next[i] != MA_NONE) && (b->mark[next[i]] != b->pass))
+                {
+                    b->mark[next[i]] = b->pass;
+                    b->stack[top++] = next[i];
+                }
+            }
+            continue;
+        }
+        if (b->item_cnt == b->item_cap)
+        {
+            size_t new_cap = b->item_cap * 2;
+            uint32_t *new_items = realloc(b->items, new_cap * sizeof(uint32_t));
+            if (new_items == NULL)
+            {
+                return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+            }
+            STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+            STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(uint32_t));
+            b->items = new_items;
+            b->item_cap = new_cap;
+        }
+        b->items[b->item_cnt++] = (uint32_t)(nstate - states);
+    }
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Orders NFA state indices
+ * @param[in] a First index
+ * @param[in] b Second index
+ * @return int Negative, zero or positive as a is below, equal to or above b
+ */
+static int ma_indexCmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Hashes a list of NFA states
+ * @param[in] items States
+ * @param[in] cnt Number of states
+ * @return uint32_t Hash
+ */
+static uint32_t ma_listHash(const uint32_t *items, size_t cnt)
+{
+    uint32_t hash = MA_HASH_SEED;
+
+    for (size_t i = 0; i < cnt; i++)
+    {
+        hash = (hash ^ items[i]) * MA_HASH_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Inserts a DFA state in the hash table
+ * @param[in,out] b Builder
+ * @param[in] dfa_state DFA state, its list already in items
+ */
+static void ma_tableInsert(ma_builder_t *b, uint32_t dfa_state)
+{
+    size_t off = b->offs[dfa_state];
+    size_t cnt = b->offs[dfa_state + 1] - off;
+    size_t slot = ma_listHash(b->items + off, cnt) & (b->table_cap - 1);
+
+    while (b->table[slot] != MA_NONE)
+    {
+        slot = (slot + 1) & (b->table_cap - 1);
+    }
+    b->table[slot] = dfa_state;
+}
+
+/**
+ * @brief Grows the DFA and the builder's arrays by one state
+ * @param[in,out] b Builder
+ * @return int MA_SUCCESS on success, MA_ERR_TOO_COMPLEX past the bound of the DFA,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_dfaGrow(ma_builder_t *b)
+{
+    ma_dfa_t *dfa = &b->match->dfa;
+    size_t class_cnt = b->match->dfa_class_cnt;
+    size_t new_cap = b->dfa_cap * 2;
+
+    if (((dfa->state_cnt + 1) * class_cnt) > MA_DFA_CELLS_MAX)
+    {
+        return MA_ERR_TOO_COMPLEX;
+    }
+    if (dfa->state_cnt < b->dfa_cap)
+    {
+        return MA_SUCCESS;
+    }
+    uint32_t *new_delta = realloc(dfa->delta, new_cap * class_cnt * sizeof(uint32_t));
+    if (new_delta == NULL)
+    {
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    dfa->delta = new_delta;
+    uint8_t *new_accept = realloc(dfa->accept, new_cap);
+    if (new_accept == NULL)
+    {
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    dfa->accept = new_accept;
+    size_t *new_offs = realloc(b->offs, (new_cap + 1) * sizeof(size_t));
+    if (new_offs == NULL)
+    {
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    b->offs = new_offs;
+    uint32_t *new_table = malloc(new_cap * 2 * sizeof(uint32_t));
+    if (new_table == NULL)
+    {
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 4);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * (class_cnt * sizeof(uint32_t) + 1 + sizeof(size_t) +
+                                                       2 * sizeof(uint32_t)));
+    free(b->table);
+    b->table = new_table;
+    b->table_cap = new_cap * 2;  // Load stays at one half at most
+    b->dfa_cap = new_cap;
+    memset(b->table, 0xff, b->table_cap * sizeof(uint32_t));
+    for (size_t i = 0; i < dfa->state_cnt; i++)
+    {
+        ma_tableInsert(b, (uint32_t)i);
+    }
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Finds or adds the DFA state of the list of NFA states at the end of items
+ *
+ * The list starts at offs[state_cnt]. If an equal state exists, the list
+ * is dropped.
+ *
+ * @param[in,out] b Builder
+ * @param[out] dfa_state DFA state of the list
+ * @return int MA_SUCCESS on success, MA_ERR_TOO_COMPLEX past the bound of the DFA,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_stateIntern(ma_builder_t *b, uint32_t *dfa_state)
+{
+    ma_dfa_t *dfa = &b->match->dfa;
+    size_t off = b->offs[dfa->state_cnt];
+    size_t cnt = b->item_cnt - off;
+    uint32_t *list = b->items + off;
+    size_t slot;
+    uint8_t accept = 0;
+    int ret;
+
+    qsort(list, cnt, sizeof(uint32_t), ma_indexCmp);
+    slot = ma_listHash(list, cnt) & (b->table_cap - 1);
+    while (b->table[slot] != MA_NONE)
+    {
+        uint32_t other = b->table[slot];
+        size_t other_cnt = b->offs[other + 1] - b->offs[other];
+
+        if ((other_cnt == cnt) && (memcmp(b->items + b->offs[other], list, cnt * sizeof(uint32_t)) == 0))
+        {
+            b->item_cnt = off;
+            *dfa_state = other;
+            return MA_SUCCESS;
+        }
+        slot = (slot + 1) & (b->table_cap - 1);
+    }
+    if ((ret = ma_dfaGrow(b)) != MA_SUCCESS)
+    {
+        return ret;
+    }
+    for (size_t i = 0; i < cnt; i++)
+    {
+        uint8_t type = b->match->nfa.states[list[i]].type;
+        accept |= (type == MA_NFA_ACCEPT) ? MA_ACCEPT_ANY : ((type == MA_NFA_ACCEPT_END) ? MA_ACCEPT_END : 0);
+    }
+    *dfa_state = (uint32_t)dfa->state_cnt;
+    dfa->accept[dfa->state_cnt] = accept;
+    memset(dfa->delta + dfa->state_cnt * b->match->dfa_class_cnt, 0, b->match->dfa_class_cnt * sizeof(uint32_t));
+    b->offs[++dfa->state_cnt] = b->item_cnt;
+    ma_tableInsert(b, *dfa_state);
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Adds the closures of the floating branch starts to the builder's list
+ * @param[in,out] b Builder
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_floatingAdd(ma_builder_t *b)
+{
+    const ma_list_t *floating = &b->match->nfa.floating;
+    int ret = MA_SUCCESS;
+
+    for (size_t i = 0; (i < floating->cnt) && (ret == MA_SUCCESS); i++)
+    {
+        ret = ma_closureAdd(b, floating->items[i]);
+    }
+    return ret;
+}
+
+/**
+ * @brief Runs the subset construction from the start state
+ * @param[in,out] b Builder, its arrays allocated
+ * @return int MA_SUCCESS on success, MA_ERR_TOO_COMPLEX past the bound of the DFA,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_subsetBuild(ma_builder_t *b)
+{
+    match_t *match = b->match;
+    ma_dfa_t *dfa = &match->dfa;
+    size_t class_cnt = match->dfa_class_cnt;
+    uint32_t dead;
+    int ret;
+
+    b->offs[0] = 0;
+    if ((ret = ma_stateIntern(b, &dead)) != MA_SUCCESS)  // Empty list: state 0
+    {
+        return ret;
+    }
+    b->pass++;
+    for (size_t i = 0; (i < match->nfa.anchored.cnt) && (ret == MA_SUCCESS); i++)
+    {
+        ret = ma_closureAdd(b, match->nfa.anchored.items[i]);
+    }
+    if ((ret != MA_SUCCESS) || ((ret = ma_floatingAdd(b)) != MA_SUCCESS) ||
+        ((ret = ma_stateIntern(b, &dfa->start)) != MA_SUCCESS))
+    {
+        return ret;
+    }
+    for (size_t state = 1; state < dfa->state_cnt; state++)
+    {
+        if (dfa->accept[state] & MA_ACCEPT_ANY)
+        {
+            continue;  // The run stops here
+        }
+        for (size_t c = 0; c < class_cnt; c++)
+        {
+            uint8_t byte = b->rep[c];
+            uint32_t next;
+
+            b->pass++;
+            for (size_t i = b->offs[state]; i < b->offs[state + 1]; i++)
+            {
+                const ma_nstate_t *nstate = &match->nfa.states[b->items[i]];
+
+                if ((nstate->type == MA_NFA_SET) &&
+                    ((match->nfa.sets[nstate->set].bits[byte / 64] >> (byte % 64)) & 1u) &&
+                    ((ret = ma_closureAdd(b, nstate->out)) != MA_SUCCESS))
+                {
+                    return ret;
+                }
+            }
+            if (((ret = ma_floatingAdd(b)) != MA_SUCCESS) || ((ret = ma_stateIntern(b, &next)) != MA_SUCCESS))
+            {
+                return ret;
+            }
+            dfa->delta[state * class_cnt + c] = next;
+        }
+    }
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Builds the DFA of the NFA of a set by subset construction
+ * @param[in,out] match Set to compile
+ * @return int MA_SUCCESS on success, MA_ERR_TOO_COMPLEX if the DFA grows past its bound,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_Dfa_build(match_t *match)
+{
+    ma_builder_t b;
+    int ret = MA_ERR_MALLOC_FAIL;
+
+    if ((match->nfa.anchored.cnt + match->nfa.floating.cnt) == 0)
+    {
+        return MA_SUCCESS;  // Literals only
+    }
+    memset(&b, 0, sizeof(b));
+    b.match = match;
+    ma_classesSplit(match);
+    for (int byte = MA_CLASS_NUM - 1; byte >= 0; byte--)
+    {
+        b.rep[match->dfa_class[byte]] = (uint8_t)byte;  // Lowest byte of each class
+    }
+    b.item_cap = match->nfa.state_cnt + MA_DFA_STATES_MIN;
+    b.dfa_cap = MA_DFA_STATES_MIN;
+    b.table_cap = MA_DFA_STATES_MIN * 2;
+    b.items = malloc(b.item_cap * sizeof(uint32_t));
+    b.offs = malloc((b.dfa_cap + 1) * sizeof(size_t));
+    b.table = malloc(b.table_cap * sizeof(uint32_t));
+    b.mark = calloc(match->nfa.state_cnt, sizeof(uint32_t));
+    b.stack = malloc(match->nfa.state_cnt * sizeof(uint32_t));
+    match->dfa.delta = malloc(b.dfa_cap * match->dfa_class_cnt * sizeof(uint32_t));
+    match->dfa.accept = malloc(b.dfa_cap);
+    if ((b.items != NULL) && (b.offs != NULL) && (b.table != NULL) && (b.mark != NULL) && (b.stack != NULL) &&
+        (match->dfa.delta != NULL) && (match->dfa.accept != NULL))
+    {
+        STATS_COUNT(STATS_COUNTER_MALLOC, 7);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (b.item_cap + b.table_cap + 2 * match->nfa.state_cnt) * sizeof(uint32_t) +
+                                                (b.dfa_cap + 1) * sizeof(size_t) +
+                                                b.dfa_cap * (match->dfa_class_cnt * sizeof(uint32_t) + 1));
+        memset(b.table, 0xff, b.table_cap * sizeof(uint32_t));
+        ret = ma_subsetBuild(&b);
+    }
+    free(b.items);
+    free(b.offs);
+    free(b.table);
+    free(b.mark);
+    free(b.stack);
+    return ret;
+}
+
+/**
+ * @brief Tests a name against the DFA of a set
+ * @param[in] match Compiled set
+ * @param[in] name Name
+ * @param[in] max_len Most bytes of the name read
+ * @return int Non-zero if a branch of the DFA matches the name
+ */
+int Match_Dfa_run(const match_t *match, const uint8_t *name, size_t max_len)
+{
+    const ma_dfa_t *dfa = &match->dfa;
+    size_t class_cnt = match->dfa_class_cnt;
+    uint32_t state = dfa->start;
+
+    if (dfa->state_cnt == 0)
+    {
+        return 0;
+    }
+    for (size_t i = 0; (i < max_len) && (name[i] != '\0'); i++)
+    {
+        if (dfa->accept[state] & MA_ACCEPT_ANY)
+        {
+            return 1;
+        }
+        state = dfa->delta[state * class_cnt + match->dfa_class[name[i]]];
+        if (state == 0)
+        {
+            return 0;
+        }
+    }
+    return dfa->accept[state] != 0;
+}
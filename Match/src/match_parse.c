@@ -0,0 +1,979 @@
+/**
+ * @file match_parse.c
+ * @brief Pattern parser of the symbol name patterns of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the parsing of --match patterns. A pattern is split
+ * into branches; a branch made of plain bytes only, maybe anchored, is kept
+ * as a literal for the tries, and any other branch is built into the NFA of
+ * the set with Thompson's construction. Bounded repetitions are expanded by
+ * parsing the repeated expression again for each copy.
+ */
+
+#include "../inc_priv/match_priv.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <ctype.h>   // For isalpha, isdigit, ...
+#include <stdlib.h>  // For realloc
+#include <string.h>  // For memset, strchr, strncmp
+
+#define MA_GLOB_PREFIX      "glob:"  /**< Prefix of glob patterns */
+#define MA_GLOB_PREFIX_LEN  5u       /**< Length of the glob prefix */
+#define MA_REPEAT_MAX       255u     /**< Largest bound of a {m,n} repetition */
+#define MA_REPEAT_INF       UINT32_MAX  /**< Upper bound of {m,} */
+#define MA_REGEX_META       ".[()*+?{^$"  /**< Bytes that end a literal regex branch */
+#define MA_ARRAY_MIN        16u      /**< First capacity of the growable arrays */
+
+/**
+ * @brief Parser state over one pattern
+ */
+typedef struct ma_parser_s
+{
+    match_t *match;       /**< Set the pattern is added to */
+    const char *text;     /**< Pattern text, without its prefix */
+    size_t pos;           /**< Offset of the next byte */
+    size_t end;           /**< Offset past the bytes parsed, moved in for the copies of a repetition */
+    unsigned short glob;  /**< Non-zero for a glob */
+    int ret;              /**< MA_SUCCESS, or the first error met */
+} ma_parser_t;
+
+/**
+ * @brief Part of the NFA with one entry and a list of exits still to be connected
+ */
+typedef struct ma_frag_s
+{
+    uint32_t start;  /**< Entry state */
+    uint32_t patch;  /**< First dangling exit, as state * 2 + slot, or MA_NONE */
+} ma_frag_t;
+
+/**
+ * @brief Class name of a bracket expression and the test of its bytes
+ */
+typedef struct ma_class_s
+{
+    const char *name;      /**< Name between "[:" and ":]" */
+    int (*test)(int c);    /**< ctype test of the class */
+} ma_class_t;
+
+static const ma_class_t g_ma_classes[] = {
+    {"alnum", isalnum}, {"alpha", isalpha}, {"blank", isblank}, {"cntrl", iscntrl},
+    {"digit", isdigit}, {"graph", isgraph}, {"lower", islower}, {"print", isprint},
+    {"punct", ispunct}, {"space", isspace}, {"upper", isupper}, {"xdigit", isxdigit}
+};
+
+/**
+ * @brief Adds an index to a list
+ * @param[in,out] list List to add to
+ * @param[in] item Index to add
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_List_push(ma_list_t *list, uint32_t item)
+{
+    if (list->cnt == list->cap)
+    {
+        size_t new_cap = (list->cap == 0) ? MA_ARRAY_MIN : (list->cap * 2);
+        uint32_t *new_items = realloc(list->items, new_cap * sizeof(uint32_t));
+        if (new_items == NULL)
+        {
+            return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(uint32_t));
+        list->items = new_items;
+        list->cap = new_cap;
+    }
+    list->items[list->cnt++] = item;
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Adds a state to the NFA
+ * @param[in,out] p Parser; its error is set on failure
+ * @param[in] type MA_NFA_* type
+ * @param[in] out Next state or patch list entry
+ * @param[in] out1 Second next state of a split
+ * @param[in] set Byte set of a MA_NFA_SET state
+ * @return uint32_t Index of the state, MA_NONE on failure
+ */
+static uint32_t ma_stateAdd(ma_parser_t *p, uint8_t type, uint32_t out, uint32_t out1, uint32_t set)
+{
+    ma_nfa_t *nfa = &p->match->nfa;
+
+    if (p->ret != MA_SUCCESS)
+    {
+        return MA_NONE;
+    }
+    if (nfa->state_cnt == MA_NFA_STATES_MAX)
+    {
+        p->ret = MA_ERR_TOO_COMPLEX;
+        return MA_NONE;
+    }
+    if (nfa->state_cnt == nfa->state_cap)
+    {
+        size_t new_cap = (nfa->state_cap == 0) ? MA_ARRAY_MIN : (nfa->state_cap * 2);
+        ma_nstate_t *new_states = realloc(nfa->states, new_cap * sizeof(ma_nstate_t));
+        if (new_states == NULL)
+        {
+            p->ret = MA_ERR_MALLOC_FAIL;  // Memory allocation error
+            return MA_NONE;
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(ma_nstate_t));
+        nfa->states = new_states;
+        nfa->state_cap = new_cap;
+    }
+    nfa->states[nfa->state_cnt] = (ma_nstate_t){type, out, out1, set};
+    return (uint32_t)nfa->state_cnt++;
+}
+
+/**
+ * @brief Adds a byte set to the NFA
+ * @param[in,out] p Parser; its error is set on failure
+ * @param[in] set Byte set
+ * @return uint32_t Index of the set, MA_NONE on failure
+ */
+static uint32_t ma_setAdd(ma_parser_t *p, const ma_set_t *set)
+{
+    ma_nfa_t *nfa = &p->match->nfa;
+
+    if (p->ret != MA_SUCCESS)
+    {
+        return MA_NONE;
+    }
+    if (nfa->set_cnt == nfa->set_cap)
+    {
+        size_t new_cap = (nfa->set_cap == 0) ? MA_ARRAY_MIN : (nfa->set_cap * 2);
+        ma_set_t *new_sets = realloc(nfa->sets, new_cap * sizeof(ma_set_t));
+        if (new_sets == NULL)
+        {
+            p->ret = MA_ERR_MALLOC_FAIL;  // Memory allocation error
+            return MA_NONE;
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(ma_set_t));
+        nfa->sets = new_sets;
+        nfa->set_cap = new_cap;
+    }
+    nfa->sets[nfa->set_cnt] = *set;
+    return (uint32_t)nfa->set_cnt++;
+}
+
+/**
+ * @brief Adds a byte to a byte set
+ * @param[in,out] set Byte set
+ * @param[in] byte Byte to add
+ */
+static void ma_setBit(ma_set_t *set, uint8_t byte)
+{
+    set->bits[byte / 64] |= (uint64_t)1 << (byte % 64);
+}
+
+/**
+ * @brief Connects every exit of a patch list to a state
+ * @param[in,out] nfa NFA
+ * @param[in] list Patch list
+ * @param[in] target State the exits go to
+ */
+static void ma_patch(ma_nfa_t *nfa, uint32_t list, uint32_t target)
+{
+    while (list != MA_NONE)
+    {
+        ma_nstate_t *state = &nfa->states[list >> 1];
+        uint32_t *slot = (list & 1u) ? &state->out1 : &state->out;
+        list = *slot;
+        *slot = target;
+    }
+}
+
+/**
+ * @brief Joins two patch lists
+ * @param[in,out] nfa NFA
+ * @param[in] first First list
+ * @param[in] second Second list
+ * @return uint32_t Joined list
+ */
+static uint32_t ma_append(ma_nfa_t *nfa, uint32_t first, uint32_t second)
+{
+    uint32_t list = first;
+
+    if (first == MA_NONE)
+    {
+        return second;
+    }
+    for (;;)
+    {
+        ma_nstate_t *state = &nfa->states[list >> 1];
+        uint32_t *slot = (list & 1u) ? &state->out1 : &state->out;
+        if (*slot == MA_NONE)
+        {
+            *slot = second;
+            return first;
+        }
+        list = *slot;
+    }
+}
+
+/**
+ * @brief Builds the fragment reading one byte of a set
+ * @param[in,out] p Parser
+ * @param[in] set Byte set
+ * @return ma_frag_t Fragment
+ */
+static ma_frag_t ma_fragSet(ma_parser_t *p, const ma_set_t *set)
+{
+    uint32_t state = ma_stateAdd(p, MA_NFA_SET, MA_NONE, MA_NONE, ma_setAdd(p, set));
+    return (ma_frag_t){state, (state != MA_NONE) ? (state << 1) : MA_NONE};
+}
+
+/**
+ * @brief Builds the fragment matching the empty string
+ * @param[in,out] p Parser
+ * @return ma_frag_t Fragment
+ */
+static ma_frag_t ma_fragEmpty(ma_parser_t *p)
+{
+    uint32_t state = ma_stateAdd(p, MA_NFA_EMPTY, MA_NONE, MA_NONE, 0);
+    return (ma_frag_t){state, (state != MA_NONE) ? (state << 1) : MA_NONE};
+}
+
+/**
+ * @brief Builds the fragment of a fragment followed by another
+ * @param[in,out] p Parser
+ * @param[in] first First fragment
+ * @param[in] second Second fragment
+ * @return ma_frag_t Fragment
+ */
+static ma_frag_t ma_fragConcat(ma_parser_t *p, ma_frag_t first, ma_frag_t second)
+{
+    if (p->ret != MA_SUCCESS)
+    {
+        return first;
+    }
+    ma_patch(&p->match->nfa, first.patch, second.start);
+    return (ma_frag_t){first.start, second.patch};
+}
+
+/**
+ * @brief Builds the fragment of one fragment or another
+ * @param[in,out] p Parser
+ * @param[in] first First fragment
+ * @param[in] second Second fragment
+ * @return ma_frag_t Fragment
+ */
+static ma_frag_t ma_fragAlt(ma_parser_t *p, ma_frag_t first, ma_frag_t second)
+{
+    uint32_t state = ma_stateAdd(p, MA_NFA_SPLIT, first.start, second.start, 0);
+
+    if (state == MA_NONE)
+    {
+        return first;
+    }
+    return (ma_frag_t){state, ma_append(&p->match->nfa, first.patch, second.patch)};
+}
+
+/**
+ * @brief Builds the fragment of a fragment repeated (*, + or ?)
+ * @param[in,out] p Parser
+ * @param[in] frag Repeated fragment
+ * @param[in] op '*' for any number, '+' for at least one, '?' for at most one
+ * @return ma_frag_t Fragment
+ */
+static ma_frag_t ma_fragRepeat(ma_parser_t *p, ma_frag_t frag, char op)
+{
+    uint32_t state = ma_stateAdd(p, MA_NFA_SPLIT, frag.start, MA_NONE, 0);
+
+    if (state == MA_NONE)
+    {
+        return frag;
+    }
+    if (op == '?')
+    {
+        return (ma_frag_t){state, ma_append(&p->match->nfa, frag.patch, (state << 1) | 1u)};
+    }
+    ma_patch(&p->match->nfa, frag.patch, state);  // Loop back after each repetition
+    return (ma_frag_t){(op == '*') ? state : frag.start, (state << 1) | 1u};
+}
+
+/**
+ * @brief Connects a parsed branch to its accepting state and records where it starts
+ * @param[in,out] p Parser
+ * @param[in] frag Branch
+ * @param[in] anchored Non-zero if the branch matches from the first byte only
+ * @param[in] whole Non-zero if the branch must end with the name
+ */
+static void ma_branchAdd(ma_parser_t *p, ma_frag_t frag, unsigned short anchored, unsigned short whole)
+{
+    uint32_t accept = ma_stateAdd(p, whole ? MA_NFA_ACCEPT_END : MA_NFA_ACCEPT, MA_NONE, MA_NONE, 0);
+    int ret;
+
+    if (accept == MA_NONE)
+    {
+        return;
+    }
+    ma_patch(&p->match->nfa, frag.patch, accept);
+    ret = Match_List_push(anchored ? &p->match->nfa.anchored : &p->match->nfa.floating, frag.start);
+    p->ret = (ret != MA_SUCCESS) ? ret : p->ret;
+}
+
+/**
+ * @brief Appends a byte to the literal pool
+ * @param[in,out] p Parser; its error is set on failure
+ * @param[in] byte Byte to append
+ */
+static void ma_poolAppend(ma_parser_t *p, char byte)
+{
+    match_t *match = p->match;
+
+    if (match->pool_len == match->pool_cap)
+    {
+        size_t new_cap = (match->pool_cap == 0) ? (MA_ARRAY_MIN * 16) : (match->pool_cap * 2);
+        char *new_pool = realloc(match->pool, new_cap);
+        if (new_pool == NULL)
+        {
+            p->ret = MA_ERR_MALLOC_FAIL;  // Memory allocation error
+            return;
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap);
+        match->pool = new_pool;
+        match->pool_cap = new_cap;
+    }
+    match->pool[match->pool_len++] = byte;
+}
+
+/**
+ * @brief Records the bytes appended to the pool since an offset as a literal
+ * @param[in,out] p Parser; its error is set on failure
+ * @param[in] off Offset of the first byte of the literal
+ * @param[in] kind MA_LIT_* kind
+ */
+static void ma_literalAdd(ma_parser_t *p, size_t off, uint8_t kind)
+{
+    match_t *match = p->match;
+
+    if (match->lit_cnt == match->lit_cap)
+    {
+        size_t new_cap = (match->lit_cap == 0) ? MA_ARRAY_MIN : (match->lit_cap * 2);
+        ma_literal_t *new_lits = realloc(match->lits, new_cap * sizeof(ma_literal_t));
+        if (new_lits == NULL)
+        {
+            p->ret = MA_ERR_MALLOC_FAIL;  // Memory allocation error
+            return;
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(ma_literal_t));
+        match->lits = new_lits;
+        match->lit_cap = new_cap;
+    }
+    match->lits[match->lit_cnt++] = (ma_literal_t){off, match->pool_len - off, kind};
+}
+
+/**
+ * @brief Parses a bracket expression into a byte set
+ *
+ * Supports ranges, negation ('^', or '!' in a glob) and the POSIX classes
+ * like [:alpha:]. In a glob a backslash escapes the next byte; in a regular
+ * expression it stands for itself, as in POSIX.
+ *
+ * @param[in,out] p Parser, past the opening '['
+ * @param[out] set Byte set
+ */
+static void ma_bracketParse(ma_parser_t *p, ma_set_t *set)
+{
+    unsigned short negate = 0;
+    unsigned short first = 1;
+
+    memset(set, 0, sizeof(*set));
+    if ((p->pos < p->end) && ((p->text[p->pos] == '^') || (p->glob && (p->text[p->pos] == '!'))))
+    {
+        negate = 1;
+        p->pos++;
+    }
+    for (;;)
+    {
+        uint8_t lo, hi;
+
+        if (p->pos >= p->end)
+        {
+            p->ret = MA_ERR_BAD_PATTERN;  // Unterminated bracket expression
+            return;
+        }
+        if ((p->text[p->pos] == ']') && !first)
+        {
+            p->pos++;
+            break;
+        }
+        first = 0;
+        if ((p->text[p->pos] == '[') && ((p->pos + 1) < p->end) && (p->text[p->pos + 1] == ':'))
+        {
+            size_t name = p->pos + 2;
+            size_t stop = name;
+            size_t i;
+
+            while (((stop + 1) < p->end) && !((p->text[stop] == ':') && (p->text[stop + 1] == ']')))
+            {
+                stop++;
+            }
+            for (i = 0; i < (sizeof(g_ma_classes) / sizeof(g_ma_classes[0])); i++)
+            {
+                if ((strlen(g_ma_classes[i].name) == (stop - name)) &&
+                    (strncmp(g_ma_classes[i].name, p->text + name, stop - name) == 0))
+                {
+                    break;
+                }
+            }
+            if (((stop + 1) >= p->end) || (i == (sizeof(g_ma_classes) / sizeof(g_ma_classes[0]))))
+            {
+                p->ret = MA_ERR_BAD_PATTERN;  // Unterminated or unknown class
+                return;
+            }
+            for (int c = 1; c < (int)MA_CLASS_NUM; c++)
+            {
+                if (g_ma_classes[i].test(c))
+                {
+                    ma_setBit(set, (uint8_t)c);
+                }
+            }
+            p->pos = stop + 2;
+            continue;
+        }
+        if (p->glob && (p->text[p->pos] == '\\') && ((p->pos + 1) < p->end))
+        {
+            p->pos++;
+        }
+        lo = (uint8_t)p->text[p->pos++];
+        hi = lo;
+        if (((p->pos + 1) < p->end) && (p->text[p->pos] == '-') && (p->text[p->pos + 1] != ']'))
+        {
+            p->pos++;
+            if (p->glob && (p->text[p->pos] == '\\') && ((p->pos + 1) < p->end))
+            {
+                p->pos++;
+            }
+            hi = (uint8_t)p->text[p->pos++];
+            if (hi < lo)
+            {
+                p->ret = MA_ERR_BAD_PATTERN;  // Reversed range
+                return;
+            }
+        }
+        for (unsigned int c = lo; c <= hi; c++)
+        {
+            ma_setBit(set, (uint8_t)c);
+        }
+    }
+    if (negate)
+    {
+        for (size_t i = 0; i < (MA_CLASS_NUM / 64); i++)
+        {
+            set->bits[i] = ~set->bits[i];
+        }
+    }
+    set->bits[0] &= ~(uint64_t)1;  // Names never hold a null byte
+}
+
+/**
+ * @brief Returns the set of every byte a name can hold
+ * @param[out] set Byte set
+ */
+static void ma_setAny(ma_set_t *set)
+{
+    memset(set, 0xff, sizeof(*set));
+    set->bits[0] &= ~(uint64_t)1;
+}
+
+/**
+ * @brief Returns the set of one byte
+ * @param[out] set Byte set
+ * @param[in] byte Byte
+ */
+static void ma_setByte(ma_set_t *set, uint8_t byte)
+{
+    memset(set, 0, sizeof(*set));
+    ma_setBit(set, byte);
+}
+
+static ma_frag_t ma_regexAlt(ma_parser_t *p, unsigned int depth);
+static ma_frag_t ma_regexRepeat(ma_parser_t *p, unsigned int depth);
+
+/**
+ * @brief Parses an atom of a regular expression
+ * @param[in,out] p Parser
+ * @param[in] depth Number of enclosing groups
+ * @return ma_frag_t Fragment of the atom
+ */
+static ma_frag_t ma_regexAtom(ma_parser_t *p, unsigned int depth)
+{
+    ma_frag_t frag = {MA_NONE, MA_NONE};
+    ma_set_t set;
+    char c = p->text[p->pos++];
+
+    if (c == '(')
+    {
+        frag = ma_regexAlt(p, depth + 1);
+        if ((p->ret == MA_SUCCESS) && ((p->pos >= p->end) || (p->text[p->pos] != ')')))
+        {
+            p->ret = MA_ERR_BAD_PATTERN;  // Unmatched '('
+        }
+        p->pos++;
+        return frag;
+    }
+    if (c == '[')
+    {
+        ma_bracketParse(p, &set);
+        return ma_fragSet(p, &set);
+    }
+    if (c == '.')
+    {
+        ma_setAny(&set);
+        return ma_fragSet(p, &set);
+    }
+    if ((c == '*') || (c == '+') || (c == '?') || (c == '{') || (c == '^') || (c == '$'))
+    {
+        p->ret = MA_ERR_BAD_PATTERN;  // Repetition of nothing, or anchor inside the branch
+        return frag;
+    }
+    if (c == '\\')
+    {
+        if (p->pos >= p->end)
+        {
+            p->ret = MA_ERR_BAD_PATTERN;  // Trailing backslash
+            return frag;
+        }
+        c = p->text[p->pos++];
+    }
+    ma_setByte(&set, (uint8_t)c);
+    return ma_fragSet(p, &set);
+}
+
+/**
+ * @brief Parses the decimal number of a repetition bound
+ * @param[in,out] p Parser
+ * @param[out] num Number parsed
+ * @return unsigned short Non-zero if a number was read
+ */
+static unsigned short ma_boundNumParse(ma_parser_t *p, uint32_t *num)
+{
+    size_t start = p->pos;
+
+    *num = 0;
+    while ((p->pos < p->end) && (p->text[p->pos] >= '0') && (p->text[p->pos] <= '9') && (*num <= MA_REPEAT_MAX))
+    {
+        *num = *num * 10 + (uint32_t)(p->text[p->pos++] - '0');
+    }
+    return (p->pos != start);
+}
+
+/**
+ * @brief Parses the expression of a repetition again, for one more copy of it
+ * @param[in,out] p Parser
+ * @param[in] depth Number of enclosing groups
+ * @param[in] start Offset of the repeated expression
+ * @param[in] stop Offset past the repeated expression
+ * @return ma_frag_t Fragment of the copy
+ */
+static ma_frag_t ma_regexCopy(ma_parser_t *p, unsigned int depth, size_t start, size_t stop)
+{
+    size_t pos = p->pos;
+    size_t end = p->end;
+    ma_frag_t frag;
+
+    p->pos = start;
+    p->end = stop;
+    frag = ma_regexRepeat(p, depth);
+    p->pos = pos;
+    p->end = end;
+    return frag;
+}
+
+/**
+ * @brief Builds the fragment of a {m,n} repetition out of copies of the expression
+ * @param[in,out] p Parser
+ * @param[in] depth Number of enclosing groups
+ * @param[in] frag First copy, already parsed
+ * @param[in] start Offset of the repeated expression
+ * @param[in] stop Offset of the '{' of the bound
+ * @param[in] min Least number of repetitions
+ * @param[in] max Most number of repetitions, or MA_REPEAT_INF
+ * @return ma_frag_t Fragment of the repetition
+ */
+static ma_frag_t ma_regexBound(ma_parser_t *p, unsigned int depth, ma_frag_t frag, size_t start, size_t stop,
+                               uint32_t min, uint32_t max)
+{
+    ma_frag_t out = {MA_NONE, MA_NONE};
+    unsigned short have = 0;
+
+    for (uint32_t k = 0; (k < min) && (p->ret == MA_SUCCESS); k++)
+    {
+        ma_frag_t copy = (k == 0) ? frag : ma_regexCopy(p, depth, start, stop);
+        out = have ? ma_fragConcat(p, out, copy) : copy;
+        have = 1;
+    }
+    if (max == MA_REPEAT_INF)
+    {
+        ma_frag_t copy = ma_fragRepeat(p, (min == 0) ? frag : ma_regexCopy(p, depth, start, stop), '*');
+        out = have ? ma_fragConcat(p, out, copy) : copy;
+        have = 1;
+    }
+    for (uint32_t k = min; (max != MA_REPEAT_INF) && (k < max) && (p->ret == MA_SUCCESS); k++)
+    {
+        ma_frag_t copy = ma_fragRepeat(p, (k == 0) ? frag : ma_regexCopy(p, depth, start, stop), '?');
+        out = have ? ma_fragConcat(p, out, copy) : copy;
+        have = 1;
+    }
+    return have ? out : ma_fragEmpty(p);  // {0} or {0,0} match the empty string
+}
+
+/**
+ * @brief Parses an atom of a regular expression and its repetitions
+ * @param[in,out] p Parser
+ * @param[in] depth Number of enclosing groups
+ * @return ma_frag_t Fragment
+ */
+static ma_frag_t ma_regexRepeat(ma_parser_t *p, unsigned int depth)
+{
+    size_t start = p->pos;
+    ma_frag_t frag = ma_regexAtom(p, depth);
+
+    while ((p->ret == MA_SUCCESS) && (p->pos < p->end))
+    {
+        char c = p->text[p->pos];
+        size_t stop = p->pos;
+        uint32_t min, max;
+
+        if ((c == '*') || (c == '+') || (c == '?'))
+        {
+            p->pos++;
+            frag = ma_fragRepeat(p, frag, c);
+            continue;
+        }
+        if (c != '{')
+        {
+            break;
+        }
+        p->pos++;
+        if (!ma_boundNumParse(p, &min))
+        {
+            min = 0;  // {,n}
+        }
+        max = min;
+        if ((p->pos < p->end) && (p->text[p->pos] == ','))
+        {
+            p->pos++;
+            if (!ma_boundNumParse(p, &max))
+            {
+                max = MA_REPEAT_INF;
+            }
+        }
+        if ((p->pos >= p->end) || (p->text[p->pos] != '}') || (min > MA_REPEAT_MAX) ||
+            ((max != MA_REPEAT_INF) && ((max > MA_REPEAT_MAX) || (max < min))))
+        {
+            p->ret = MA_ERR_BAD_PATTERN;  // Malformed or too large bound
+            break;
+        }
+        p->pos++;
+        frag = ma_regexBound(p, depth, frag, start, stop, min, max);
+    }
+    return frag;
+}
+
+/**
+ * @brief Parses a sequence of a regular expression, up to a '|', a ')' or the end
+ * @param[in,out] p Parser
+ * @param[in] depth Number of enclosing groups
+ * @param[out] whole Set if a top-level sequence ends with '$'; may be NULL inside groups
+ * @return ma_frag_t Fragment of the sequence
+ */
+static ma_frag_t ma_regexConcat(ma_parser_t *p, unsigned int depth, unsigned short *whole)
+{
+    ma_frag_t out = {MA_NONE, MA_NONE};
+    unsigned short have = 0;
+
+    while ((p->ret == MA_SUCCESS) && (p->pos < p->end) && (p->text[p->pos] != '|'))
+    {
+        char c = p->text[p->pos];
+        ma_frag_t frag;
+
+        if (c == ')')
+        {
+            if (depth == 0)
+            {
+                p->ret = MA_ERR_BAD_PATTERN;  // Unmatched ')'
+            }
+            break;
+        }
+        if ((c == '$') && (depth == 0) && (((p->pos + 1) == p->end) || (p->text[p->pos + 1] == '|')))
+        {
+            p->pos++;
+            *whole = 1;
+            break;
+        }
+        frag = ma_regexRepeat(p, depth);
+        out = have ? ma_fragConcat(p, out, frag) : frag;
+        have = 1;
+    }
+    return have ? out : ma_fragEmpty(p);
+}
+
+/**
+ * @brief Parses the alternatives inside a group
+ * @param[in,out] p Parser, past the '('
+ * @param[in] depth Number of enclosing groups, this one included
+ * @return ma_frag_t Fragment of the alternatives
+ */
+static ma_frag_t ma_regexAlt(ma_parser_t *p, unsigned int depth)
+{
+    ma_frag_t out = ma_regexConcat(p, depth, NULL);
+
+    while ((p->ret == MA_SUCCESS) && (p->pos < p->end) && (p->text[p->pos] == '|'))
+    {
+        p->pos++;
+        out = ma_fragAlt(p, out, ma_regexConcat(p, depth, NULL));
+    }
+    return out;
+}
+
+/**
+ * @brief Reads a branch of a regular expression as a literal, if it is one
+ *
+ * A literal branch holds no special byte but a leading '^' and a trailing
+ * '$', with backslashes escaping the next byte. A branch only anchored at
+ * its end is left to the DFA.
+ *
+ * @param[in,out] p Parser, at the start of the branch; moved past it if it is a literal
+ * @return unsigned short Non-zero if the branch was added as a literal
+ */
+static unsigned short ma_regexLiteral(ma_parser_t *p)
+{
+    size_t start = p->pos;
+    size_t off = p->match->pool_len;
+    unsigned short anchored = 0, whole = 0;
+
+    if ((p->pos < p->end) && (p->text[p->pos] == '^'))
+    {
+        anchored = 1;
+        p->pos++;
+    }
+    while ((p->ret == MA_SUCCESS) && (p->pos < p->end) && (p->text[p->pos] != '|'))
+    {
+        char c = p->text[p->pos];
+
+        if ((c == '$') && (((p->pos + 1) == p->end) || (p->text[p->pos + 1] == '|')))
+        {
+            p->pos++;
+            whole = 1;
+            break;
+        }
+        if ((c == '\\') && ((p->pos + 1) < p->end))
+        {
+            c = p->text[p->pos + 1];
+            p->pos++;
+        }
+        else if ((c == '\\') || (c == ')') || (strchr(MA_REGEX_META, c) != NULL))
+        {
+            whole = 0;
+            anchored = 0;
+            break;
+        }
+        ma_poolAppend(p, c);
+        p->pos++;
+    }
+    if ((p->pos < p->end) && (p->text[p->pos] != '|'))
+    {
+        p->pos = start;  // Special byte: parsed into the NFA
+        p->match->pool_len = off;
+        return 0;
+    }
+    if (whole && !anchored)
+    {
+        p->pos = start;  // Suffix: left to the DFA
+        p->match->pool_len = off;
+        return 0;
+    }
+    ma_literalAdd(p, off, whole ? MA_LIT_EXACT : (anchored ? MA_LIT_PREFIX : MA_LIT_SUBSTR));
+    return 1;
+}
+
+/**
+ * @brief Parses an extended regular expression, branch by branch
+ * @param[in,out] p Parser
+ */
+static void ma_regexParse(ma_parser_t *p)
+{
+    for (;;)
+    {
+        if (!ma_regexLiteral(p) && (p->ret == MA_SUCCESS))
+        {
+            unsigned short anchored = 0, whole = 0;
+            ma_frag_t frag;
+
+            if ((p->pos < p->end) && (p->text[p->pos] == '^'))
+            {
+                anchored = 1;
+                p->pos++;
+            }
+            frag = ma_regexConcat(p, 0, &whole);
+            if (p->ret == MA_SUCCESS)
+            {
+                ma_branchAdd(p, frag, anchored, whole);
+            }
+        }
+        if ((p->ret != MA_SUCCESS) || (p->pos >= p->end))
+        {
+            break;
+        }
+        p->pos++;  // Past the '|' ending the branch
+        if (p->pos == p->end)
+        {
+            ma_literalAdd(p, p->match->pool_len, MA_LIT_SUBSTR);  // Empty last branch
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Reads a glob as a literal, if its only wildcards are a leading and a trailing '*'
+ * @param[in,out] p Parser, at the start of the glob
+ * @return unsigned short Non-zero if the glob was added as a literal
+ */
+static unsigned short ma_globLiteral(ma_parser_t *p)
+{
+    size_t off = p->match->pool_len;
+    unsigned short lead = 0, trail = 0;
+
+    for (size_t pos = p->pos; (pos < p->end) && (p->ret == MA_SUCCESS); pos++)
+    {
+        char c = p->text[pos];
+
+        if ((c == '*') && (pos == p->pos))
+        {
+            lead = 1;
+            continue;
+        }
+        if ((c == '*') && ((pos + 1) == p->end))
+        {
+            trail = 1;
+            continue;
+        }
+        if ((c == '*') || (c == '?') || (c == '[') || ((c == '\\') && ((pos + 1) == p->end)))
+        {
+            p->match->pool_len = off;  // Wildcard: parsed into the NFA
+            return 0;
+        }
+        if (c == '\\')
+        {
+            c = p->text[++pos];
+        }
+        ma_poolAppend(p, c);
+    }
+    if (lead && !trail && (p->match->pool_len != off))
+    {
+        p->match->pool_len = off;  // Suffix: left to the DFA
+        return 0;
+    }
+    ma_literalAdd(p, off, lead ? MA_LIT_SUBSTR : (trail ? MA_LIT_PREFIX : MA_LIT_EXACT));
+    return 1;
+}
+
+/**
+ * @brief Parses a glob matching the whole name
+ * @param[in,out] p Parser
+ */
+static void ma_globParse(ma_parser_t *p)
+{
+    ma_frag_t out = {MA_NONE, MA_NONE};
+    unsigned short have = 0;
+
+    if (ma_globLiteral(p))
+    {
+        return;
+    }
+    while ((p->ret == MA_SUCCESS) && (p->pos < p->end))
+    {
+        char c = p->text[p->pos++];
+        ma_frag_t frag;
+        ma_set_t set;
+
+        if (c == '*')
+        {
+            ma_setAny(&set);
+            frag = ma_fragRepeat(p, ma_fragSet(p, &set), '*');
+        }
+        else if (c == '?')
+        {
+            ma_setAny(&set);
+            frag = ma_fragSet(p, &set);
+        }
+        else if (c == '[')
+        {
+            ma_bracketParse(p, &set);
+            frag = ma_fragSet(p, &set);
+        }
+        else
+        {
+            if (c == '\\')
+            {
+                if (p->pos >= p->end)
+                {
+                    p->ret = MA_ERR_BAD_PATTERN;  // Trailing backslash
+                    break;
+                }
+                c = p->text[p->pos++];
+            }
+            ma_setByte(&set, (uint8_t)c);
+            frag = ma_fragSet(p, &set);
+        }
+        out = have ? ma_fragConcat(p, out, frag) : frag;
+        have = 1;
+    }
+    if (p->ret == MA_SUCCESS)
+    {
+        ma_branchAdd(p, have ? out : ma_fragEmpty(p), 1, 1);
+    }
+}
+
+/**
+ * @brief Parses a pattern into literals and NFA branches of a set
+ *
+ * On failure the set is left as it was before the call.
+ *
+ * @param[in,out] match Set to add to
+ * @param[in] pattern Pattern, with its "glob:" prefix if any
+ * @param[in] len Length of the pattern
+ * @return int MA_SUCCESS on success, MA_ERR_BAD_PATTERN if the pattern is malformed,
+ *             MA_ERR_TOO_COMPLEX if the NFA grows past its bound,
+ *             MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_Parse_pattern(match_t *match, const char *pattern, size_t len)
+{
+    ma_parser_t p = {match, pattern, 0, len, 0, MA_SUCCESS};
+    size_t state_cnt = match->nfa.state_cnt;
+    size_t set_cnt = match->nfa.set_cnt;
+    size_t anchored_cnt = match->nfa.anchored.cnt;
+    size_t floating_cnt = match->nfa.floating.cnt;
+    size_t lit_cnt = match->lit_cnt;
+    size_t pool_len = match->pool_len;
+
+    if ((len >= MA_GLOB_PREFIX_LEN) && (strncmp(pattern, MA_GLOB_PREFIX, MA_GLOB_PREFIX_LEN) == 0))
+    {
+        p.text += MA_GLOB_PREFIX_LEN;
+        p.end -= MA_GLOB_PREFIX_LEN;
+        p.glob = 1;
+        ma_globParse(&p);
+    }
+    else
+    {
+        ma_regexParse(&p);
+    }
+    if (p.ret != MA_SUCCESS)
+    {
+        match->nfa.state_cnt = state_cnt;  // Drop what the pattern added
+        match->nfa.set_cnt = set_cnt;
+        match->nfa.anchored.cnt = anchored_cnt;
+        match->nfa.floating.cnt = floating_cnt;
+        match->lit_cnt = lit_cnt;
+        match->pool_len = pool_len;
+    }
+    return p.ret;
+}
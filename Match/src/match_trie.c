@@ -0,0 +1,257 @@
+/**
+ * @file match_trie.c
+ * @brief Literal automata of the symbol name patterns of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the automata of the literal branches. Prefix and exact
+ * literals go into a trie walked from the first byte of the name, which
+ * stops at the first byte no literal continues with. Literals found
+ * anywhere go into an Aho-Corasick automaton whose failure links are folded
+ * into a full transition table, so each byte of the name costs one lookup.
+ * Both tables are indexed by byte class: each byte used in a literal has
+ * its own class and all other bytes share class 0. Patterns hold no null
+ * byte, so there are at most 256 classes.
+ */
+
+#include "../inc_priv/match_priv.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For malloc, realloc, free
+#include <string.h>  // For memset
+
+#define MA_TRIE_NODES_MIN  64u  /**< First capacity of a trie */
+
+/**
+ * @brief Adds a node without transitions to a trie
+ * @param[in,out] trie Trie
+ * @param[in] class_cnt Number of byte classes
+ * @param[out] node Index of the node
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_nodeAdd(ma_trie_t *trie, size_t class_cnt, uint32_t *node)
+{
+    if (trie->node_cnt == trie->node_cap)
+    {
+        size_t new_cap = (trie->node_cap == 0) ? MA_TRIE_NODES_MIN : (trie->node_cap * 2);
+        uint32_t *new_delta = realloc(trie->delta, new_cap * class_cnt * sizeof(uint32_t));
+        if (new_delta == NULL)
+        {
+            return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        trie->delta = new_delta;
+        uint8_t *new_accept = realloc(trie->accept, new_cap);
+        if (new_accept == NULL)
+        {
+            return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * (class_cnt * sizeof(uint32_t) + 1));
+        trie->accept = new_accept;
+        trie->node_cap = new_cap;
+    }
+    memset(trie->delta + trie->node_cnt * class_cnt, 0, class_cnt * sizeof(uint32_t));
+    trie->accept[trie->node_cnt] = 0;
+    *node = (uint32_t)trie->node_cnt++;
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Adds a literal to a trie
+ * @param[in,out] match Set holding the literal and the byte classes
+ * @param[in,out] trie Trie
+ * @param[in] root Root node of the trie
+ * @param[in] lit Literal
+ * @param[in] flag MA_ACCEPT_* flag of the node ending the literal
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_trieInsert(const match_t *match, ma_trie_t *trie, uint32_t root, const ma_literal_t *lit, uint8_t flag)
+{
+    size_t class_cnt = match->lit_class_cnt;
+    uint32_t node = root;
+
+    for (size_t i = 0; i < lit->len; i++)
+    {
+        size_t cell = node * class_cnt + match->lit_class[(uint8_t)match->pool[lit->off + i]];
+        uint32_t next = trie->delta[cell];
+
+        if (next == 0)
+        {
+            int ret = ma_nodeAdd(trie, class_cnt, &next);
+            if (ret != MA_SUCCESS)
+            {
+                return ret;
+            }
+            trie->delta[cell] = next;
+        }
+        node = next;
+    }
+    trie->accept[node] |= flag;
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Folds the failure links of an Aho-Corasick trie into its transitions
+ *
+ * Nodes are visited breadth first, so the failure node of each node is
+ * complete before the node itself. A missing transition takes the one of
+ * the failure node, and a node accepts if its failure node does.
+ *
+ * @param[in,out] trie Trie rooted at node 0
+ * @param[in] class_cnt Number of byte classes
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int ma_failFold(ma_trie_t *trie, size_t class_cnt)
+{
+    uint32_t *fail = malloc(trie->node_cnt * sizeof(uint32_t));
+    uint32_t *queue = malloc(trie->node_cnt * sizeof(uint32_t));
+    size_t head = 0, tail = 0;
+
+    if ((fail == NULL) || (queue == NULL))
+    {
+        free(fail);
+        free(queue);
+        return MA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, 2 * trie->node_cnt * sizeof(uint32_t));
+    for (size_t c = 0; c < class_cnt; c++)
+    {
+        uint32_t child = trie->delta[c];
+        if (child != 0)
+        {
+            fail[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+    while (head < tail)
+    {
+        uint32_t node = queue[head++];
+        uint32_t *row = trie->delta + node * class_cnt;
+        const uint32_t *fail_row = trie->delta + fail[node] * class_cnt;
+
+        for (size_t c = 0; c < class_cnt; c++)
+        {
+            if (row[c] != 0)
+            {
+                fail[row[c]] = fail_row[c];
+                trie->accept[row[c]] |= trie->accept[fail_row[c]];
+                queue[tail++] = row[c];
+            }
+            else
+            {
+                row[c] = fail_row[c];
+            }
+        }
+    }
+    free(fail);
+    free(queue);
+    return MA_SUCCESS;
+}
+
+/**
+ * @brief Builds the prefix trie and the Aho-Corasick automaton of the literals of a set
+ * @param[in,out] match Set to compile
+ * @return int MA_SUCCESS on success, MA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Match_Trie_build(match_t *match)
+{
+    unsigned short has_prefix = 0, has_substr = 0;
+    uint32_t node;
+    int ret;
+
+    memset(match->lit_class, 0, sizeof(match->lit_class));
+    match->lit_class_cnt = 1;
+    for (size_t i = 0; i < match->pool_len; i++)
+    {
+        uint8_t byte = (uint8_t)match->pool[i];
+        if (match->lit_class[byte] == 0)
+        {
+            match->lit_class[byte] = (uint8_t)match->lit_class_cnt++;
+        }
+    }
+    for (size_t i = 0; i < match->lit_cnt; i++)
+    {
+        has_substr |= (match->lits[i].kind == MA_LIT_SUBSTR);
+        has_prefix |= (match->lits[i].kind != MA_LIT_SUBSTR);
+    }
+    if (has_prefix)
+    {
+        if (((ret = ma_nodeAdd(&match->prefix, match->lit_class_cnt, &node)) != MA_SUCCESS) ||  // Dead node
+            ((ret = ma_nodeAdd(&match->prefix, match->lit_class_cnt, &node)) != MA_SUCCESS))    // Root
+        {
+            return ret;
+        }
+    }
+    if (has_substr && ((ret = ma_nodeAdd(&match->substr, match->lit_class_cnt, &node)) != MA_SUCCESS))
+    {
+        return ret;
+    }
+    for (size_t i = 0; i < match->lit_cnt; i++)
+    {
+        const ma_literal_t *lit = &match->lits[i];
+
+        if (lit->kind == MA_LIT_SUBSTR)
+        {
+            ret = ma_trieInsert(match, &match->substr, 0, lit, MA_ACCEPT_ANY);
+        }
+        else
+        {
+            ret = ma_trieInsert(match, &match->prefix, 1, lit,
+                                (lit->kind == MA_LIT_PREFIX) ? MA_ACCEPT_ANY : MA_ACCEPT_END);
+        }
+        if (ret != MA_SUCCESS)
+        {
+            return ret;
+        }
+    }
+    return has_substr ? ma_failFold(&match->substr, match->lit_class_cnt) : MA_SUCCESS;
+}
+
+/**
+ * @brief Tests a name against the literals of a set
+ * @param[in] match Compiled set
+ * @param[in] name Name
+ * @param[in] max_len Most bytes of the name read
+ * @return int Non-zero if a literal matches the name
+ */
+int Match_Trie_run(const match_t *match, const uint8_t *name, size_t max_len)
+{
+    const ma_trie_t *trie = &match->prefix;
+    size_t class_cnt = match->lit_class_cnt;
+
+    if (trie->node_cnt != 0)
+    {
+        uint32_t node = 1;
+        size_t i = 0;
+
+        while ((node != 0) && !(trie->accept[node] & MA_ACCEPT_ANY) && (i < max_len) && (name[i] != '\0'))
+        {
+            node = trie->delta[node * class_cnt + match->lit_class[name[i++]]];
+        }
+        if ((node != 0) && ((trie->accept[node] & MA_ACCEPT_ANY) ||
+                            ((trie->accept[node] & MA_ACCEPT_END) && ((i == max_len) || (name[i] == '\0')))))
+        {
+            return 1;
+        }
+    }
+    trie = &match->substr;
+    if (trie->node_cnt != 0)
+    {
+        uint32_t node = 0;
+
+        if (trie->accept[0])
+        {
+            return 1;  // Empty literal
+        }
+        for (size_t i = 0; (i < max_len) && (name[i] != '\0'); i++)
+        {
+            node = trie->delta[node * class_cnt + match->lit_class[name[i]]];
+            if (trie->accept[node])
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
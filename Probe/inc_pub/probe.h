@@ -0,0 +1,95 @@
+/**
+ * @file probe.h
+ * @brief Header-only static tracepoints (USDT) for ft_nm hot paths
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header provides the FT_NM_PROBE* macros used to place static
+ * tracepoints in ft_nm. When built with FT_NM_PROBES defined (make PROBES=1),
+ * every probe is a single nop plus a .note.stapsdt entry that perf, bpftrace
+ * and systemtap can attach to under the provider "ft_nm", for example
+ * "bpftrace -e 'usdt:./nm.out:ft_nm:map_get { @[arg1] = count(); }'".
+ * Without FT_NM_PROBES the macros only evaluate their arguments as void
+ * and compile to nothing.
+ *
+ * @section probes Probes
+ * - map_get(offset, length): FileHandler_mapGet before mapping
+ * - symtable_parse(symbol_count): once the symbol table is located
+ * - list_sort(n, comparisons): at the end of LinkedList_sort
+ * - symtab_sort(n, comparisons): at the end of SymTab_sort
+ * - line_flush(value, result): after Writer_linePrint wrote a full line
+ */
+
+#ifndef _IG_PROBE_H_
+#define _IG_PROBE_H_
+
+#ifdef FT_NM_PROBES
+
+#include <stdint.h>  // For uint64_t
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define FT_NM_PROBE_HAVE_SDT 1
+#endif
+#endif
+
+#ifdef FT_NM_PROBE_HAVE_SDT
+
+#include <sys/sdt.h>  // For DTRACE_PROBE*
+
+#define FT_NM_PROBE0(name)          DTRACE_PROBE(ft_nm, name)
+#define FT_NM_PROBE1(name, a1)      DTRACE_PROBE1(ft_nm, name, (uint64_t)(a1))
+#define FT_NM_PROBE2(name, a1, a2)  DTRACE_PROBE2(ft_nm, name, (uint64_t)(a1), (uint64_t)(a2))
+
+#else /* !FT_NM_PROBE_HAVE_SDT */
+
+/**
+ * @brief Emits the probe site nop and its .note.stapsdt descriptor (systemtap v3 format)
+ * @param name Probe name
+ * @param args Argument description string, e.g. "8@%[ft_nm_a1]"
+ */
+#define FT_NM_PROBE_ASM(name, args)                                             \
+    "990: nop\n"                                                                \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                               \
+    ".balign 4\n"                                                               \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                          \
+    "991: .asciz \"stapsdt\"\n"                                                 \
+    "992: .balign 4\n"                                                          \
+    "993: .8byte 990b\n"                                                        \
+    ".8byte _.stapsdt.base\n"                                                   \
+    ".8byte 0\n"                                                                \
+    ".asciz \"ft_nm\"\n"                                                        \
+    ".asciz \"" #name "\"\n"                                                    \
+    ".asciz \"" args "\"\n"                                                     \
+    "994: .balign 4\n"                                                          \
+    ".popsection\n"                                                             \
+    ".ifndef _.stapsdt.base\n"                                                  \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"     \
+    ".weak _.stapsdt.base\n"                                                    \
+    ".hidden _.stapsdt.base\n"                                                  \
+    "_.stapsdt.base: .space 1\n"                                                \
+    ".size _.stapsdt.base, 1\n"                                                 \
+    ".popsection\n"                                                             \
+    ".endif\n"
+
+#define FT_NM_PROBE0(name) \
+    __asm__ __volatile__ (FT_NM_PROBE_ASM(name, ""))
+#define FT_NM_PROBE1(name, a1) \
+    __asm__ __volatile__ (FT_NM_PROBE_ASM(name, "8@%[ft_nm_a1]") \
+                          :: [ft_nm_a1] "nor" ((uint64_t)(a1)))
+#define FT_NM_PROBE2(name, a1, a2) \
+    __asm__ __volatile__ (FT_NM_PROBE_ASM(name, "8@%[ft_nm_a1] 8@%[ft_nm_a2]") \
+                          :: [ft_nm_a1] "nor" ((uint64_t)(a1)), [ft_nm_a2] "nor" ((uint64_t)(a2)))
+
+#endif /* FT_NM_PROBE_HAVE_SDT */
+
+#else /* !FT_NM_PROBES */
+
+#define FT_NM_PROBE0(name)          do { } while (0)
+#define FT_NM_PROBE1(name, a1)      do { (void)(a1); } while (0)
+#define FT_NM_PROBE2(name, a1, a2)  do { (void)(a1); (void)(a2); } while (0)
+
+#endif /* FT_NM_PROBES */
+
+#endif /* _IG_PROBE_H_ */
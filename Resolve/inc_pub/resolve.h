@@ -0,0 +1,66 @@
+/**
+ * @file resolve.h
+ * @brief Public header for the cross-object symbol resolution report in ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interface used by the --resolve option. The global
+ * symbols of every input are added to one index keyed by interned name; once
+ * all inputs are read, the report lists for each undefined reference the
+ * object that defines it, or that it is unresolved, followed by the names with
+ * more than one strong definition.
+ */
+
+#ifndef _IG_RESOLVE_H_
+#define _IG_RESOLVE_H_
+
+#include "../../LinkedList/inc_pub/linkedlist.h"  // For dl_list_t
+#include "../../Writer/inc_pub/writer.h"          // For writer_ctx_t
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint32_t
+
+/**
+ * @brief Error codes for resolve operations
+ */
+enum Resolve_Error {
+    RS_SUCCESS = 0,           /**< Success */
+    RS_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    RS_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    RS_ERR_WRITE_FAIL = -3    /**< Writing the report failed */
+};
+
+/**
+ * @brief Adds the global symbols of one input to the index
+ *
+ * Symbol names are interned (see intern.h), so the lines and the string
+ * table of the input may be released once the call returns. Inputs must be
+ * added in the order they are to be reported; the symbols of an input are
+ * reported in symbol table order, the list being walked from its tail.
+ *
+ * @param[in] file_idx Index of the input, used to name it in the report
+ * @param[in] head Head of the unsorted symbol list of the input
+ * @param[in] writer Writer context with the string table of the input loaded
+ * @return int RS_SUCCESS on success, RS_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Resolve_fileAdd(uint32_t file_idx, const dl_list_t *head, const writer_ctx_t *writer);
+
+/**
+ * @brief Prints the resolution report to stdout
+ *
+ * Each undefined reference is printed as "file: U name -> provider", with
+ * "w" for weak references and "unresolved" when no input defines the name;
+ * each name defined strongly more than once is printed as
+ * "name: multiple definition: file file ...".
+ *
+ * @param[in] file_names Names of the inputs, indexed by file_idx
+ * @return int RS_SUCCESS on success, RS_ERR_WRITE_FAIL on write failure
+ */
+int Resolve_reportPrint(char *const *file_names);
+
+/**
+ * @brief Frees the index
+ */
+void Resolve_free(void);
+
+#endif /* _IG_RESOLVE_H_ */
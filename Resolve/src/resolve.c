@@ -0,0 +1,465 @@
+/**
+ * @file resolve.c
+ * @brief Cross-object symbol resolution report of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the index behind the --resolve option. Defined global
+ * names are kept in an array in first-seen order and found through an open
+ * addressing table keyed by the interned name pointer, so a lookup hashes a
+ * pointer rather than a string. Undefined references are kept in input order
+ * and resolved against the index once every input has been added, in one
+ * pass, so the work grows linearly with the number of symbols.
+ */
+
+#include "../inc_pub/resolve.h"
+#include "../../Writer/inc_pub/writer.h"
+#include "../../Writer/inc_pub/writer_flagprint.h"
+#include "../../Intern/inc_pub/intern.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <stdlib.h>  // For malloc, realloc, calloc, free
+#include <string.h>  // For strlen, memcpy
+#include <unistd.h>  // For write, STDOUT_FILENO
+
+#define RS_SLOTS_MIN     1024u                   /**< Initial slots of the index (power of two) */
+#define RS_ARRAY_MIN     256u                    /**< Initial capacity of the growable arrays */
+#define RS_NONE          UINT32_MAX              /**< Empty slot, or end of a duplicate chain */
+#define RS_PTR_MUL       0x9e3779b97f4a7c15ull   /**< Multiplier spreading name pointers over the slots */
+#define RS_OUT_SIZE      (64u * 1024u)           /**< Size of the report output buffer */
+
+/**
+ * @brief Rank of a definition; a higher rank provides the symbol
+ */
+typedef enum
+{
+    RS_RANK_NONE   = 0U,  /**< Not defined */
+    RS_RANK_COMMON = 1U,  /**< Common symbol (SHN_COMMON) */
+    RS_RANK_WEAK   = 2U,  /**< Weak definition */
+    RS_RANK_STRONG = 3U   /**< Global or GNU unique definition */
+} resolve_rank_e;
+
+/**
+ * @brief Defined global name
+ */
+typedef struct resolve_sym_s
+{
+    const char *name;     /**< Interned name */
+    uint32_t def_file;    /**< Input providing the name */
+    uint32_t rank;        /**< Rank of the providing definition (resolve_rank_e) */
+    uint32_t dup_head;    /**< First further strong definition, or RS_NONE */
+    uint32_t dup_tail;    /**< Last further strong definition, or RS_NONE */
+} resolve_sym_t;
+
+/**
+ * @brief Further strong definition of a name
+ */
+typedef struct resolve_dup_s
+{
+    uint32_t file;  /**< Defining input */
+    uint32_t next;  /**< Next further definition, or RS_NONE */
+} resolve_dup_t;
+
+/**
+ * @brief Undefined reference
+ */
+typedef struct resolve_ref_s
+{
+    const char *name;  /**< Interned name */
+    uint32_t file;     /**< Referencing input */
+    uint32_t weak;     /**< Non-zero for a weak reference */
+} resolve_ref_t;
+
+/**
+ * @brief Growable array
+ */
+typedef struct resolve_array_s
+{
+    void *data;   /**< Elements */
+    size_t len;   /**< Number of elements */
+    size_t cap;   /**< Allocated elements */
+} resolve_array_t;
+
+/**
+ * @brief Report output buffer
+ */
+typedef struct resolve_out_s
+{
+    char buf[RS_OUT_SIZE];  /**< Pending bytes */
+    size_t len;             /**< Number of pending bytes */
+    int failed;             /**< Non-zero once a write failed */
+} resolve_out_t;
+
+static resolve_array_t g_resolve_syms = {NULL, 0, 0};  /* Defined names in first-seen order */
+static resolve_array_t g_resolve_dups = {NULL, 0, 0};  /* Further strong definitions */
+static resolve_array_t g_resolve_refs = {NULL, 0, 0};  /* Undefined references in input order */
+static uint32_t *g_resolve_slots = NULL;                /* Open addressing table of indices into the names */
+static size_t g_resolve_slot_num = 0;                   /* Number of slots (power of two) */
+
+/**
+ * @brief Makes room for one more element in a growable array
+ * @param[in,out] array Array to grow
+ * @param[in] elem_size Size of one element
+ * @return void* Slot of the new element, or NULL on failure
+ */
+static void *resolve_arrayPush(resolve_array_t *array, size_t elem_size)
+{
+    if (array->len == array->cap)
+    {
+        size_t new_cap = (array->cap == 0) ? RS_ARRAY_MIN : array->cap * 2;
+        void *new_data;
+
+        if (new_cap > RS_NONE)
+        {
+            return NULL;  // Indices are 32-bit
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * elem_size);
+        new_data = realloc(array->data, new_cap * elem_size);
+        if (new_data == NULL)
+        {
+            return NULL;  // Memory allocation error
+        }
+        array->data = new_data;
+        array->cap = new_cap;
+    }
+    return (char *)array->data + (array->len++ * elem_size);
+}
+
+/**
+ * @brief Returns the first slot to probe for a name
+ * @param[in] name Interned name
+ * @param[in] slot_num Number of slots (power of two)
+ * @return size_t Slot index
+ */
+static size_t resolve_slotGet(const char *name, size_t slot_num)
+{
+    return (size_t)(((uint64_t)(uintptr_t)name * RS_PTR_MUL) >> 32) & (slot_num - 1);
+}
+
+/**
+ * @brief Doubles the slots once the table is half full
+ * @return int RS_SUCCESS on success, RS_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int resolve_slotsGrow(void)
+{
+    const resolve_sym_t *syms = g_resolve_syms.data;
+    size_t new_num = (g_resolve_slot_num == 0) ? RS_SLOTS_MIN : g_resolve_slot_num * 2;
+    uint32_t *new_slots;
+
+    if ((g_resolve_slots != NULL) && ((g_resolve_syms.len + 1) * 2 <= g_resolve_slot_num))
+    {
+        return RS_SUCCESS;  // Still less than half full
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_num * sizeof(uint32_t));
+    new_slots = malloc(new_num * sizeof(uint32_t));
+    if (new_slots == NULL)
+    {
+        return RS_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    memset(new_slots, 0xff, new_num * sizeof(uint32_t));  // Every slot RS_NONE
+    for (size_t i = 0; i < g_resolve_syms.len; i++)
+    {
+        size_t slot = resolve_slotGet(syms[i].name, new_num);
+        while (new_slots[slot] != RS_NONE)
+        {
+            slot = (slot + 1) & (new_num - 1);
+        }
+        new_slots[slot] = (uint32_t)i;
+    }
+    free(g_resolve_slots);
+    g_resolve_slots = new_slots;
+    g_resolve_slot_num = new_num;
+    return RS_SUCCESS;
+}
+
+/**
+ * @brief Finds a defined name in the index
+ * @param[in] name Interned name
+ * @return resolve_sym_t* Entry, or NULL if no input defines the name
+ */
+static resolve_sym_t *resolve_symFind(const char *name)
+{
+    resolve_sym_t *syms = g_resolve_syms.data;
+    size_t slot;
+
+    if (g_resolve_slots == NULL)
+    {
+        return NULL;
+    }
+    for (slot = resolve_slotGet(name, g_resolve_slot_num); g_resolve_slots[slot] != RS_NONE;
+         slot = (slot + 1) & (g_resolve_slot_num - 1))
+    {
+        if (syms[g_resolve_slots[slot]].name == name)
+        {
+            return &syms[g_resolve_slots[slot]];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Records a definition of a name
+ * @param[in] name Interned name
+ * @param[in] file Defining input
+ * @param[in] rank Rank of the definition
+ * @return int RS_SUCCESS on success, RS_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int resolve_defAdd(const char *name, uint32_t file, resolve_rank_e rank)
+{
+    resolve_sym_t *sym = resolve_symFind(name);
+    resolve_dup_t *dup;
+    size_t slot;
+
+    if (sym == NULL)
+    {
+        // First definition: add the name
+        if (resolve_slotsGrow() != RS_SUCCESS)
+        {
+            return RS_ERR_MALLOC_FAIL;
+        }
+        sym = resolve_arrayPush(&g_resolve_syms, sizeof(resolve_sym_t));
+        if (sym == NULL)
+        {
+            return RS_ERR_MALLOC_FAIL;
+        }
+        sym->name = name;
+        sym->def_file = file;
+        sym->rank = rank;
+        sym->dup_head = RS_NONE;
+        sym->dup_tail = RS_NONE;
+        for (slot = resolve_slotGet(name, g_resolve_slot_num); g_resolve_slots[slot] != RS_NONE;
+             slot = (slot + 1) & (g_resolve_slot_num - 1))
+        {
+            ;
+        }
+        g_resolve_slots[slot] = (uint32_t)(g_resolve_syms.len - 1);
+    }
+    else if ((rank == RS_RANK_STRONG) && (sym->rank == RS_RANK_STRONG))
+    {
+        // Another strong definition: a duplicate
+        uint32_t sym_idx = (uint32_t)(sym - (resolve_sym_t *)g_resolve_syms.data);
+        dup = resolve_arrayPush(&g_resolve_dups, sizeof(resolve_dup_t));
+        if (dup == NULL)
+        {
+            return RS_ERR_MALLOC_FAIL;
+        }
+        sym = &((resolve_sym_t *)g_resolve_syms.data)[sym_idx];
+        dup->file = file;
+        dup->next = RS_NONE;
+        if (sym->dup_tail == RS_NONE)
+        {
+            sym->dup_head = (uint32_t)(g_resolve_dups.len - 1);
+        }
+        else
+        {
+            ((resolve_dup_t *)g_resolve_dups.data)[sym->dup_tail].next = (uint32_t)(g_resolve_dups.len - 1);
+        }
+        sym->dup_tail = (uint32_t)(g_resolve_dups.len - 1);
+    }
+    else if (rank > sym->rank)
+    {
+        // Stronger definition provides the name instead
+        sym->def_file = file;
+        sym->rank = rank;
+    }
+    return RS_SUCCESS;
+}
+
+/**
+ * @brief Adds the global symbols of one input to the index
+ * @param[in] file_idx Index of the input, used to name it in the report
+ * @param[in] head Head of the unsorted symbol list of the input
+ * @param[in] writer Writer context with the string table of the input loaded
+ * @return int RS_SUCCESS on success, RS_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Resolve_fileAdd(uint32_t file_idx, const dl_list_t *head, const writer_ctx_t *writer)
+{
+    const dl_list_t *node = head;
+
+    while ((node != NULL) && (node->next != NULL))
+    {
+        node = node->next;  // Unsorted list holds the symbol table backwards
+    }
+    for (; node != NULL; node = node->prev)
+    {
+        const writer_line_t *line = node->line;
+        const char *name;
+        resolve_ref_t *ref;
+        resolve_rank_e rank;
+
+        if (line->bind == WRITER_FLAGPRINT_BIND_LOCAL)
+        {
+            continue;  // Not visible to other inputs
+        }
+        name = Writer_lineNameGet(writer, line);
+        name = (name == NULL) ? NULL : Intern_string(name, strlen(name));
+        if (name == NULL)
+        {
+            return RS_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        if (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED)
+        {
+            ref = resolve_arrayPush(&g_resolve_refs, sizeof(resolve_ref_t));
+            if (ref == NULL)
+            {
+                return RS_ERR_MALLOC_FAIL;
+            }
+            ref->name = name;
+            ref->file = file_idx;
+            ref->weak = (line->bind == WRITER_FLAGPRINT_BIND_WEAK);
+            continue;
+        }
+        if (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_COMMON)
+        {
+            rank = RS_RANK_COMMON;
+        }
+        else if (line->bind == WRITER_FLAGPRINT_BIND_WEAK)
+        {
+            rank = RS_RANK_WEAK;
+        }
+        else
+        {
+            rank = RS_RANK_STRONG;
+        }
+        if (resolve_defAdd(name, file_idx, rank) != RS_SUCCESS)
+        {
+            return RS_ERR_MALLOC_FAIL;
+        }
+    }
+    return RS_SUCCESS;
+}
+
+/**
+ * @brief Writes the pending report bytes to stdout
+ * @param[in,out] out Output buffer
+ */
+static void resolve_outFlush(resolve_out_t *out)
+{
+    size_t done = 0;
+
+    while ((done < out->len) && !out->failed)
+    {
+        ssize_t ret;
+
+        STATS_COUNT(STATS_COUNTER_WRITE, 1);
+        ret = write(STDOUT_FILENO, out->buf + done, out->len - done);
+        if (ret <= 0)
+        {
+            out->failed = 1;
+        }
+        else
+        {
+            done += (size_t)ret;
+        }
+    }
+    out->len = 0;
+}
+
+/**
+ * @brief Appends a string to the report
+ * @param[in,out] out Output buffer
+ * @param[in] str Null-terminated string
+ */
+static void resolve_outStr(resolve_out_t *out, const char *str)
+{
+    size_t len = strlen(str);
+
+    while (len != 0)
+    {
+        size_t chunk = RS_OUT_SIZE - out->len;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        memcpy(out->buf + out->len, str, chunk);
+        out->len += chunk;
+        str += chunk;
+        len -= chunk;
+        if (out->len == RS_OUT_SIZE)
+        {
+            resolve_outFlush(out);
+        }
+    }
+}
+
+/**
+ * @brief Prints the resolution report to stdout
+ * @param[in] file_names Names of the inputs, indexed by file_idx
+ * @return int RS_SUCCESS on success, RS_ERR_NULL_INPUT on invalid input,
+ *             RS_ERR_MALLOC_FAIL on memory allocation failure, RS_ERR_WRITE_FAIL on write failure
+ */
+int Resolve_reportPrint(char *const *file_names)
+{
+    const resolve_ref_t *refs = g_resolve_refs.data;
+    const resolve_sym_t *syms = g_resolve_syms.data;
+    const resolve_dup_t *dups = g_resolve_dups.data;
+    resolve_out_t *out;
+    int failed;
+
+    if (file_names == NULL)
+    {
+        return RS_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(resolve_out_t));
+    out = malloc(sizeof(resolve_out_t));
+    if (out == NULL)
+    {
+        return RS_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    out->len = 0;
+    out->failed = 0;
+
+    // Provider of every undefined reference, in input order
+    for (size_t i = 0; i < g_resolve_refs.len; i++)
+    {
+        const resolve_sym_t *sym = resolve_symFind(refs[i].name);
+
+        resolve_outStr(out, file_names[refs[i].file]);
+        resolve_outStr(out, refs[i].weak ? ": w " : ": U ");
+        resolve_outStr(out, refs[i].name);
+        resolve_outStr(out, " -> ");
+        resolve_outStr(out, (sym != NULL) ? file_names[sym->def_file] : "unresolved");
+        resolve_outStr(out, "\n");
+    }
+
+    // Names defined strongly more than once, in first-seen order
+    for (size_t i = 0; i < g_resolve_syms.len; i++)
+    {
+        if (syms[i].dup_head == RS_NONE)
+        {
+            continue;
+        }
+        resolve_outStr(out, syms[i].name);
+        resolve_outStr(out, ": multiple definition: ");
+        resolve_outStr(out, file_names[syms[i].def_file]);
+        for (uint32_t dup = syms[i].dup_head; dup != RS_NONE; dup = dups[dup].next)
+        {
+            resolve_outStr(out, " ");
+            resolve_outStr(out, file_names[dups[dup].file]);
+        }
+        resolve_outStr(out, "\n");
+    }
+    resolve_outFlush(out);
+    failed = out->failed;
+    free(out);
+    return failed ? RS_ERR_WRITE_FAIL : RS_SUCCESS;
+}
+
+/**
+ * @brief Frees the index
+ */
+void Resolve_free(void)
+{
+    free(g_resolve_syms.data);
+    free(g_resolve_dups.data);
+    free(g_resolve_refs.data);
+    free(g_resolve_slots);
+    g_resolve_syms = (resolve_array_t){NULL, 0, 0};
+    g_resolve_dups = (resolve_array_t){NULL, 0, 0};
+    g_resolve_refs = (resolve_array_t){NULL, 0, 0};
+    g_resolve_slots = NULL;
+    g_resolve_slot_num = 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file scan.h
+ * @brief Public header for the -R recursive directory scan of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the directory walker used by the -R option. The tree
+ * below a directory is read by a pool of threads; every regular file has its
+ * first bytes read with pread and is kept only if it starts with an ELF
+ * identification, so other files are never mapped or reported. The kept paths
+ * are returned sorted, so the listing does not depend on thread timing or on
+ * the order of directory entries.
+ */
+
+#ifndef _IG_SCAN_H_
+#define _IG_SCAN_H_
+
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Error codes for scan operations
+ */
+enum Scan_Error {
+    SC_SUCCESS = 0,           /**< Success */
+    SC_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    SC_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    SC_ERR_OPEN_FAIL = -3     /**< The root directory could not be opened, errno is set */
+};
+
+/**
+ * @brief Paths found by a scan
+ */
+typedef struct scan_list_s
+{
+    char **paths;     /**< Paths of the ELF files, sorted byte-wise */
+    size_t path_num;  /**< Number of paths */
+    size_t path_cap;  /**< Capacity of paths */
+} scan_list_t;
+
+/**
+ * @brief Adds the ELF files found below a directory to a list
+ *
+ * Symbolic links are not followed and subdirectories that cannot be read are
+ * skipped. The paths added by one call are sorted among themselves and
+ * appended after the paths already in the list.
+ *
+ * @param[in] root Directory to scan
+ * @param[in,out] list List to add to, zero-initialized before the first call
+ * @return int SC_SUCCESS on success, SC_ERR_NULL_INPUT on invalid input,
+ *             SC_ERR_OPEN_FAIL if root cannot be opened, SC_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Scan_run(const char *root, scan_list_t *list);
+
+/**
+ * @brief Frees the paths of a list
+ * @param[in,out] list List to free
+ */
+void Scan_free(scan_list_t *list);
+
+#endif /* _IG_SCAN_H_ */
@@ -0,0 +1,387 @@
+/**
+ * @file scan.c
+ * @brief Parallel directory walker of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the -R scan. Directories still to be read are kept on a
+ * shared stack; each worker pops one, reads its entries, pushes the
+ * subdirectories it finds and sniffs the regular files. A file is sniffed by
+ * reading its first SCAN_SNIFF_LEN bytes with pread through a descriptor
+ * opened relative to the directory, so no file is mapped or stat-ed twice and
+ * non-ELF files cost one open and one read. The walk ends once the stack is
+ * empty and no worker is reading a directory that could refill it.
+ */
+
+#include "../inc_pub/scan.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <dirent.h>    // For opendir, readdir, closedir, dirfd
+#include <fcntl.h>     // For openat, fstatat, AT_SYMLINK_NOFOLLOW
+#include <pthread.h>   // For pthread_create, pthread_mutex_t, pthread_cond_t
+#include <stddef.h>    // For offsetof
+#include <stdlib.h>    // For malloc, realloc, free, qsort
+#include <string.h>    // For strlen, strcmp, memcpy
+#include <sys/stat.h>  // For struct stat, S_ISDIR, S_ISREG
+#include <unistd.h>    // For pread, close, sysconf
+
+#define SCAN_SNIFF_LEN      16u  /**< Bytes read from each file, the ELF identification */
+#define SCAN_THREADS_MAX    8u   /**< Most walker threads */
+#define SCAN_LIST_CAP_MIN   64u  /**< First capacity of the path list */
+
+#define SCAN_ELF_CLASS_IDX  4u   /**< Offset of the class byte (EI_CLASS) */
+#define SCAN_ELF_DATA_IDX   5u   /**< Offset of the data encoding byte (EI_DATA) */
+
+/**
+ * @brief Directory waiting to be read
+ */
+typedef struct scan_dir_s
+{
+    struct scan_dir_s *next;  /**< Next directory on the stack */
+    char path[];              /**< Path of the directory */
+} scan_dir_t;
+
+/**
+ * @brief Walk state shared by the workers
+ */
+typedef struct scan_s
+{
+    pthread_mutex_t lock;  /**< Guards every field below */
+    pthread_cond_t cond;   /**< Signalled when a directory is pushed or the walk ends */
+    scan_dir_t *stack;     /**< Directories waiting to be read */
+    size_t busy;           /**< Number of workers reading a directory */
+    int failed;            /**< Non-zero once an allocation failed, stopping the walk */
+    scan_list_t *list;     /**< List receiving the paths */
+} scan_t;
+
+/**
+ * @brief Joins a directory path and an entry name
+ * @param[in] dir Directory path
+ * @param[in] name Entry name
+ * @param[in] extra Bytes reserved in front of the path
+ * @return char* Allocation of extra bytes followed by the joined path, or NULL on failure
+ */
+static char *scan_pathJoin(const char *dir, const char *name, size_t extra)
+{
+    size_t dir_len = strlen(dir);
+    size_t name_len = strlen(name);
+    size_t sep = ((dir_len != 0) && (dir[dir_len - 1] != '/')) ? 1 : 0;  // No doubled slash after a root given as "dir/"
+    char *buf = malloc(extra + dir_len + sep + name_len + 1);
+    char *path;
+
+    if (buf == NULL)
+    {
+        return NULL;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, extra + dir_len + sep + name_len + 1);
+    path = buf + extra;
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    memcpy(path + dir_len + sep, name, name_len + 1);
+    return buf;
+}
+
+/**
+ * @brief Pushes a directory on the stack
+ * @param[in,out] scan Walk state
+ * @param[in] dir Directory path
+ * @param[in] name Entry name within dir, or NULL to push dir itself
+ * @return int SC_SUCCESS on success, SC_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int scan_dirPush(scan_t *scan, const char *dir, const char *name)
+{
+    scan_dir_t *entry;
+
+    if (name != NULL)
+    {
+        entry = (scan_dir_t *)scan_pathJoin(dir, name, offsetof(scan_dir_t, path));
+    }
+    else
+    {
+        entry = malloc(offsetof(scan_dir_t, path) + strlen(dir) + 1);
+        if (entry != NULL)
+        {
+            STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+            STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, offsetof(scan_dir_t, path) + strlen(dir) + 1);
+            memcpy(entry->path, dir, strlen(dir) + 1);
+        }
+    }
+    if (entry == NULL)
+    {
+        return SC_ERR_MALLOC_FAIL;
+    }
+    pthread_mutex_lock(&scan->lock);
+    entry->next = scan->stack;
+    scan->stack = entry;
+    pthread_cond_signal(&scan->cond);
+    pthread_mutex_unlock(&scan->lock);
+    return SC_SUCCESS;
+}
+
+/**
+ * @brief Adds a path to the list
+ * @param[in,out] scan Walk state
+ * @param[in] path Path to add, owned by the list on success
+ * @return int SC_SUCCESS on success, SC_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int scan_pathAdd(scan_t *scan, char *path)
+{
+    scan_list_t *list = scan->list;
+    int ret = SC_SUCCESS;
+
+    pthread_mutex_lock(&scan->lock);
+    if (list->path_num == list->path_cap)
+    {
+        size_t new_cap = (list->path_cap == 0) ? SCAN_LIST_CAP_MIN : list->path_cap * 2;
+        char **new_paths = realloc(list->paths, new_cap * sizeof(char *));
+        if (new_paths != NULL)
+        {
+            STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+            STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * sizeof(char *));
+            list->paths = new_paths;
+            list->path_cap = new_cap;
+        }
+        else
+        {
+            ret = SC_ERR_MALLOC_FAIL;
+        }
+    }
+    if (ret == SC_SUCCESS)
+    {
+        list->paths[list->path_num++] = path;
+    }
+    pthread_mutex_unlock(&scan->lock);
+    return ret;
+}
+
+/**
+ * @brief Checks whether a file starts with an ELF identification
+ * @param[in] dir_fd Descriptor of the directory holding the file
+ * @param[in] name Name of the file within the directory
+ * @return int Non-zero if the file is an ELF file of a known class and data encoding
+ */
+static int scan_fileSniff(int dir_fd, const char *name)
+{
+    unsigned char ident[SCAN_SNIFF_LEN];
+    ssize_t len;
+    int fd = openat(dir_fd, name, O_RDONLY | O_NOFOLLOW | O_NOCTTY | O_CLOEXEC | O_NONBLOCK);  // A FIFO must not block the walk
+
+    if (fd < 0)
+    {
+        return 0;
+    }
+    len = pread(fd, ident, SCAN_SNIFF_LEN, 0);
+    close(fd);
+    return (len == (ssize_t)SCAN_SNIFF_LEN) &&
+           (ident[0] == 0x7f) && (ident[1] == 'E') && (ident[2] == 'L') && (ident[3] == 'F') &&
+           ((ident[SCAN_ELF_CLASS_IDX] == 1) || (ident[SCAN_ELF_CLASS_IDX] == 2)) &&
+           ((ident[SCAN_ELF_DATA_IDX] == 1) || (ident[SCAN_ELF_DATA_IDX] == 2));
+}
+
+/**
+ * @brief Reads one directory, pushing its subdirectories and adding its ELF files
+ * @param[in,out] scan Walk state
+ * @param[in] path Directory path
+ * @return int SC_SUCCESS on success or if the directory cannot be read, SC_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int scan_dirRead(scan_t *scan, const char *path)
+{
+    DIR *dir = opendir(path);
+    struct dirent *entry;
+    int ret = SC_SUCCESS;
+
+    if (dir == NULL)
+    {
+        return SC_SUCCESS;  // Unreadable subdirectories are skipped
+    }
+    while ((ret == SC_SUCCESS) && ((entry = readdir(dir)) != NULL))
+    {
+        unsigned char type = entry->d_type;
+        struct stat st;
+
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0))
+        {
+            continue;
+        }
+        if (type == DT_UNKNOWN)  // File systems without d_type
+        {
+            if (fstatat(dirfd(dir), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            {
+                continue;
+            }
+            type = S_ISDIR(st.st_mode) ? DT_DIR : (S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN);
+        }
+        if (type == DT_DIR)
+        {
+            ret = scan_dirPush(scan, path, entry->d_name);
+        }
+        else if ((type == DT_REG) && scan_fileSniff(dirfd(dir), entry->d_name))
+        {
+            char *file = scan_pathJoin(path, entry->d_name, 0);
+            ret = (file != NULL) ? scan_pathAdd(scan, file) : SC_ERR_MALLOC_FAIL;
+            if (ret != SC_SUCCESS)
+            {
+                free(file);
+            }
+        }
+    }
+    closedir(dir);
+    return ret;
+}
+
+/**
+ * @brief Worker reading directories until the walk ends
+ * @param[in,out] arg Walk state
+ * @return void* Always NULL
+ */
+static void *scan_worker(void *arg)
+{
+    scan_t *scan = arg;
+    scan_dir_t *dir;
+
+    pthread_mutex_lock(&scan->lock);
+    for (;;)
+    {
+        while ((scan->stack == NULL) && (scan->busy != 0) && (scan->failed == 0))
+        {
+            pthread_cond_wait(&scan->cond, &scan->lock);  // Another worker may still push directories
+        }
+        if ((scan->stack == NULL) || (scan->failed != 0))
+        {
+            break;
+        }
+        dir = scan->stack;
+        scan->stack = dir->next;
+        scan->busy++;
+        pthread_mutex_unlock(&scan->lock);
+
+        if (scan_dirRead(scan, dir->path) != SC_SUCCESS)
+        {
+            pthread_mutex_lock(&scan->lock);
+            scan->failed = 1;
+            pthread_mutex_unlock(&scan->lock);
+        }
+        free(dir);
+
+        pthread_mutex_lock(&scan->lock);
+        scan->busy--;
+        if (((scan->busy == 0) && (scan->stack == NULL)) || (scan->failed != 0))
+        {
+            pthread_cond_broadcast(&scan->cond);  // Wake the waiting workers so they can leave
+        }
+    }
+    pthread_mutex_unlock(&scan->lock);
+    return NULL;
+}
+
+/**
+ * @brief Compares two paths for qsort
+ * @param[in] a Pointer to the first path
+ * @param[in] b Pointer to the second path
+ * @return int Byte-wise comparison of the paths
+ */
+static int scan_pathCmp(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * @brief Adds the ELF files found below a directory to a list
+ * @param[in] root Directory to scan
+ * @param[in,out] list List to add to, zero-initialized before the first call
+ * @return int SC_SUCCESS on success, SC_ERR_NULL_INPUT on invalid input,
+ *             SC_ERR_OPEN_FAIL if root cannot be opened, SC_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Scan_run(const char *root, scan_list_t *list)
+{
+    pthread_t threads[SCAN_THREADS_MAX];
+    unsigned short started[SCAN_THREADS_MAX] = {0};
+    size_t thread_cnt;
+    size_t first = (list != NULL) ? list->path_num : 0;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    scan_t scan;
+    DIR *dir;
+    int ret;
+
+    if ((root == NULL) || (list == NULL))
+    {
+        return SC_ERR_NULL_INPUT;
+    }
+    dir = opendir(root);  // Only the root is reported when it cannot be read
+    if (dir == NULL)
+    {
+        return SC_ERR_OPEN_FAIL;
+    }
+    closedir(dir);
+
+    scan.stack = NULL;
+    scan.busy = 0;
+    scan.failed = 0;
+    scan.list = list;
+    if ((pthread_mutex_init(&scan.lock, NULL) != 0) || (pthread_cond_init(&scan.cond, NULL) != 0))
+    {
+        return SC_ERR_MALLOC_FAIL;
+    }
+    ret = scan_dirPush(&scan, root, NULL);
+
+    // One worker per online CPU, the first one being this thread
+    thread_cnt = (cpus > 1) ? (size_t)cpus : 1;
+    thread_cnt = (thread_cnt > SCAN_THREADS_MAX) ? SCAN_THREADS_MAX : thread_cnt;
+    for (size_t i = 1; (ret == SC_SUCCESS) && (i < thread_cnt); i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, scan_worker, &scan) == 0);
+    }
+    if (ret == SC_SUCCESS)
+    {
+        scan_worker(&scan);
+    }
+    for (size_t i = 1; i < thread_cnt; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    // Directories left by a failed walk
+    while (scan.stack != NULL)
+    {
+        scan_dir_t *next = scan.stack->next;
+        free(scan.stack);
+        scan.stack = next;
+    }
+    pthread_cond_destroy(&scan.cond);
+    pthread_mutex_destroy(&scan.lock);
+    if ((ret == SC_SUCCESS) && (scan.failed != 0))
+    {
+        ret = SC_ERR_MALLOC_FAIL;
+    }
+
+    // Paths arrive in thread order; sorting makes the listing reproducible
+    if (list->path_num > first)
+    {
+        qsort(list->paths + first, list->path_num - first, sizeof(char *), scan_pathCmp);
+    }
+    return ret;
+}
+
+/**
+ * @brief Frees the paths of a list
+ * @param[in,out] list List to free
+ */
+void Scan_free(scan_list_t *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < list->path_num; i++)
+    {
+        free(list->paths[i]);
+    }
+    free(list->paths);
+    list->paths = NULL;
+    list->path_num = 0;
+    list->path_cap = 0;
+}
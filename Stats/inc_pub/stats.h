@@ -0,0 +1,113 @@
+/**
+ * @file stats.h
+ * @brief Public header for stage timing and resource counters in ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interface used by ft_nm to measure time spent in
+ * each pipeline stage and to count system resources (mappings, writes and
+ * allocations) per file and in aggregate. Stage hooks also emit begin/end
+ * events to the trace module when tracing is enabled. Collection is off by
+ * default; when disabled every hook reduces to a single flag test.
+ */
+
+#ifndef _IG_STATS_H_
+#define _IG_STATS_H_
+
+#include <stdint.h>  // For uint64_t
+
+/**
+ * @brief Pipeline stages measured by the stats module
+ */
+typedef enum
+{
+    STATS_STAGE_OPEN = 0,           /**< Opening the file */
+    STATS_STAGE_MAP_IDENT,          /**< Mapping the ELF identification bytes */
+    STATS_STAGE_MAP_HEADER,         /**< Mapping the full ELF header */
+    STATS_STAGE_HEADER_PARSE,       /**< Parsing ELF identification and header */
+    STATS_STAGE_MAP_SECTHEAD,       /**< Mapping the section header table */
+    STATS_STAGE_SECT_PARSE,         /**< Parsing the section header table */
+    STATS_STAGE_MAP_SHSTRTAB,       /**< Mapping the section name string table */
+    STATS_STAGE_SECT_NAME_RESOLVE,  /**< Resolving section names */
+    STATS_STAGE_MAP_SYMTAB,         /**< Mapping the symbol table */
+    STATS_STAGE_SYMTAB_PARSE,       /**< Parsing the symbol table */
+    STATS_STAGE_MAP_STRTAB,         /**< Mapping the symbol name string table */
+    STATS_STAGE_SYM_NAME_RESOLVE,   /**< Resolving symbol names */
+    STATS_STAGE_CLOSE,              /**< Unmapping and closing the file */
+    STATS_STAGE_SYMBOL_LIST,        /**< Building the symbol list (symbol_list_create) */
+    STATS_STAGE_SORT,               /**< Sorting the symbol list */
+    STATS_STAGE_PRINT,              /**< Printing the symbol list */
+    STATS_STAGE_DEMANGLE,           /**< Demangling symbol names ahead of printing (-C) */
+    STATS_STAGE_NUM                 /**< Number of stages */
+} stats_stage_e;
+
+/**
+ * @brief Resource counters maintained by the stats module
+ */
+typedef enum
+{
+    STATS_COUNTER_MMAP = 0,         /**< Number of mmap calls */
+    STATS_COUNTER_WRITE,            /**< Number of write calls */
+    STATS_COUNTER_MALLOC,           /**< Number of malloc calls */
+    STATS_COUNTER_MALLOC_BYTES,     /**< Number of bytes requested from malloc */
+    STATS_COUNTER_SYM_SEEN,         /**< Number of symbol table entries examined */
+    STATS_COUNTER_SYM_FILTERED,     /**< Number of symbol table entries not printed */
+    STATS_COUNTER_INTERN_HIT,       /**< Number of names found in the intern table (--resolve, --diff) */
+    STATS_COUNTER_INTERN_BYTES,     /**< Number of bytes of names added to the intern table (--resolve, --diff) */
+    STATS_COUNTER_NUM               /**< Number of counters */
+} stats_counter_e;
+
+extern unsigned short g_stats_enabled; /**< Non-zero when stats collection is enabled */
+
+/**
+ * @brief Adds a value to a counter when stats collection is enabled
+ * @param counter Counter to update (stats_counter_e)
+ * @param n Value to add
+ */
+#define STATS_COUNT(counter, n) \
+    do { if (g_stats_enabled) { Stats_counterAdd((counter), (n)); } } while (0)
+
+/**
+ * @brief Enables stats collection and reporting
+ */
+void Stats_enable(void);
+
+/**
+ * @brief Adds a value to a counter of the current file
+ * @param[in] counter Counter to update
+ * @param[in] n Value to add
+ */
+void Stats_counterAdd(stats_counter_e counter, uint64_t n);
+
+/**
+ * @brief Marks the beginning of a stage
+ * @param[in] stage Stage that begins
+ * @return uint64_t Monotonic timestamp in nanoseconds, or 0 if stats and tracing are disabled
+ */
+uint64_t Stats_stageBegin(stats_stage_e stage);
+
+/**
+ * @brief Marks the end of a stage and accumulates its duration
+ * @param[in] stage Stage that ended
+ * @param[in] start Timestamp returned by the matching Stats_stageBegin call
+ */
+void Stats_stageEnd(stats_stage_e stage, uint64_t start);
+
+/**
+ * @brief Resets the per-file timers and counters
+ */
+void Stats_fileBegin(void);
+
+/**
+ * @brief Prints the per-file report to stderr and adds it to the aggregate
+ * @param[in] file_name Name of the processed file
+ */
+void Stats_fileEnd(const char *file_name);
+
+/**
+ * @brief Prints the aggregate report over all processed files to stderr
+ */
+void Stats_totalPrint(void);
+
+#endif /* _IG_STATS_H_ */
@@ -0,0 +1,252 @@
+/**
+ * @file stats.c
+ * @brief Stage timing and resource counters for ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains functions for measuring the time spent in each ft_nm
+ * pipeline stage and for counting mappings, writes, allocations and symbols.
+ * Reports are printed to stderr per file and in aggregate.
+ */
+
+#include "../inc_pub/stats.h"
+#include "../../Trace/inc_pub/trace.h"  // For Trace_eventRecord, Trace_nowGet
+#include <unistd.h>  // For write, STDERR_FILENO
+
+/**
+ * @brief Report macros
+ */
+#define STATS_PREFIX        "ft_nm: stats: "  /**< Prefix of every report header */
+#define STATS_TOTAL_NAME    "total"           /**< Name used for the aggregate report */
+#define STATS_LABEL_WIDTH   24u               /**< Column width of the value labels */
+#define STATS_LINE_MAX      256u              /**< Maximum length of one report line */
+#define STATS_NSEC_PER_USEC 1000u             /**< Nanoseconds per microsecond */
+#define STATS_TRACE_CATEGORY "stage"          /**< Trace category of stage events */
+
+/**
+ * @brief Display names of the stages, indexed by stats_stage_e
+ */
+static const char *const g_stage_names[STATS_STAGE_NUM] = {
+    "open", "map ident", "map header", "header parse", "map section headers",
+    "section parse", "map section strtab", "section name resolve", "map symtab",
+    "symtab parse", "map strtab", "symbol name resolve", "close",
+    "symbol_list_create", "sort", "print", "demangle"
+};
+
+/**
+ * @brief Display names of the counters, indexed by stats_counter_e
+ */
+static const char *const g_counter_names[STATS_COUNTER_NUM] = {
+    "mmap calls", "write calls", "malloc calls", "malloc bytes",
+    "symbols seen", "symbols filtered", "intern hits", "intern bytes"
+};
+
+/**
+ * @brief Accumulated measurements of one report
+ */
+typedef struct stats_record_s
+{
+    uint64_t stage_ns[STATS_STAGE_NUM];      /**< Time spent per stage in nanoseconds */
+    uint64_t counter[STATS_COUNTER_NUM];     /**< Counter values */
+    uint64_t file_num;                       /**< Number of files accumulated */
+} stats_record_t;
+
+unsigned short g_stats_enabled = 0u;  /* Global flag for enabling/disabling stats collection */
+static stats_record_t g_file_stats;   /* Measurements of the file being processed */
+static stats_record_t g_total_stats;  /* Measurements accumulated over all files */
+
+/**
+ * @brief Appends a string to a line buffer
+ * @param[in,out] buf Line buffer
+ * @param[in,out] len Current length of the buffer content
+ * @param[in] str Null-terminated string to append
+ */
+static void stats_strAppend(char *buf, size_t *len, const char *str)
+{
+    while ((*str != '\0') && (*len < STATS_LINE_MAX))
+    {
+        buf[(*len)++] = *str++;
+    }
+}
+
+/**
+ * @brief Appends an unsigned decimal number to a line buffer
+ * @param[in,out] buf Line buffer
+ * @param[in,out] len Current length of the buffer content
+ * @param[in] num Number to append
+ * @param[in] min_digits Minimum number of digits, padded with zeros
+ */
+static void stats_numAppend(char *buf, size_t *len, uint64_t num, unsigned int min_digits)
+{
+    char digits[21];
+    unsigned int cnt = 0;
+
+    do {
+        digits[cnt++] = '0' + (num % 10u);
+        num /= 10u;
+    } while ((num != 0) || (cnt < min_digits));
+    while ((cnt != 0) && (*len < STATS_LINE_MAX))
+    {
+        buf[(*len)++] = digits[--cnt];
+    }
+}
+
+/**
+ * @brief Appends a label padded to the label column width
+ * @param[in,out] buf Line buffer
+ * @param[in,out] len Current length of the buffer content
+ * @param[in] label Label to append
+ */
+static void stats_labelAppend(char *buf, size_t *len, const char *label)
+{
+    size_t start = *len;
+
+    stats_strAppend(buf, len, "  ");
+    stats_strAppend(buf, len, label);
+    while ((*len - start < STATS_LABEL_WIDTH) && (*len < STATS_LINE_MAX))
+    {
+        buf[(*len)++] = ' ';
+    }
+}
+
+/**
+ * @brief Prints one report to stderr
+ * @param[in] record Measurements to print
+ * @param[in] name Name of the file, or STATS_TOTAL_NAME for the aggregate
+ */
+static void stats_recordPrint(const stats_record_t *record, const char *name)
+{
+    char line[STATS_LINE_MAX + 1];
+    size_t len = 0;
+
+    stats_strAppend(line, &len, STATS_PREFIX);
+    stats_strAppend(line, &len, name);
+    if (record == &g_total_stats)
+    {
+        stats_strAppend(line, &len, " (");
+        stats_numAppend(line, &len, record->file_num, 1u);
+        stats_strAppend(line, &len, " files)");
+    }
+    line[len++] = '\n';
+    write(STDERR_FILENO, line, len);
+    for (unsigned int i = 0; i < STATS_STAGE_NUM; i++)
+    {
+        len = 0;
+        stats_labelAppend(line, &len, g_stage_names[i]);
+        stats_numAppend(line, &len, record->stage_ns[i] / STATS_NSEC_PER_USEC, 1u);
+        stats_strAppend(line, &len, ".");
+        stats_numAppend(line, &len, record->stage_ns[i] % STATS_NSEC_PER_USEC, 3u);
+        stats_strAppend(line, &len, " us\n");
+        write(STDERR_FILENO, line, len);
+    }
+    for (unsigned int i = 0; i < STATS_COUNTER_NUM; i++)
+    {
+        len = 0;
+        stats_labelAppend(line, &len, g_counter_names[i]);
+        stats_numAppend(line, &len, record->counter[i], 1u);
+        stats_strAppend(line, &len, "\n");
+        write(STDERR_FILENO, line, len);
+    }
+}
+
+/**
+ * @brief Enables stats collection and reporting
+ */
+void Stats_enable(void)
+{
+    g_stats_enabled = 1u;  // Set stats flag to enabled
+}
+
+/**
+ * @brief Adds a value to a counter of the current file
+ * @param[in] counter Counter to update
+ * @param[in] n Value to add
+ */
+void Stats_counterAdd(stats_counter_e counter, uint64_t n)
+{
+    if (counter < STATS_COUNTER_NUM)
+    {
+        __atomic_fetch_add(&g_file_stats.counter[counter], n, __ATOMIC_RELAXED);  // Also counted by demangling threads
+    }
+}
+
+/**
+ * @brief Marks the beginning of a stage
+ * @param[in] stage Stage that begins
+ * @return uint64_t Monotonic timestamp in nanoseconds, or 0 if stats and tracing are disabled
+ */
+uint64_t Stats_stageBegin(stats_stage_e stage)
+{
+    uint64_t now;
+
+    if ((!g_stats_enabled && !g_trace_enabled) || (stage >= STATS_STAGE_NUM))
+    {
+        return (0);  // Do not touch the clock when disabled
+    }
+    now = Trace_nowGet();
+    Trace_eventRecord(g_stage_names[stage], STATS_TRACE_CATEGORY, TRACE_PHASE_BEGIN, now);
+    return (now);
+}
+
+/**
+ * @brief Marks the end of a stage and accumulates its duration
+ * @param[in] stage Stage that ended
+ * @param[in] start Timestamp returned by the matching Stats_stageBegin call
+ */
+void Stats_stageEnd(stats_stage_e stage, uint64_t start)
+{
+    uint64_t now;
+
+    if ((!g_stats_enabled && !g_trace_enabled) || (stage >= STATS_STAGE_NUM))
+    {
+        return;
+    }
+    now = Trace_nowGet();
+    Trace_eventRecord(g_stage_names[stage], STATS_TRACE_CATEGORY, TRACE_PHASE_END, now);
+    __atomic_fetch_add(&g_file_stats.stage_ns[stage], now - start, __ATOMIC_RELAXED);  // Stages may overlap across threads
+}
+
+/**
+ * @brief Resets the per-file timers and counters
+ */
+void Stats_fileBegin(void)
+{
+    stats_record_t empty = {0};
+
+    g_file_stats = empty;
+}
+
+/**
+ * @brief Prints the per-file report to stderr and adds it to the aggregate
+ * @param[in] file_name Name of the processed file
+ */
+void Stats_fileEnd(const char *file_name)
+{
+    if (!g_stats_enabled)
+    {
+        return;
+    }
+    stats_recordPrint(&g_file_stats, file_name);
+    for (unsigned int i = 0; i < STATS_STAGE_NUM; i++)
+    {
+        g_total_stats.stage_ns[i] += g_file_stats.stage_ns[i];
+    }
+    for (unsigned int i = 0; i < STATS_COUNTER_NUM; i++)
+    {
+        g_total_stats.counter[i] += g_file_stats.counter[i];
+    }
+    g_total_stats.file_num++;
+}
+
+/**
+ * @brief Prints the aggregate report over all processed files to stderr
+ */
+void Stats_totalPrint(void)
+{
+    if (!g_stats_enabled)
+    {
+        return;
+    }
+    stats_recordPrint(&g_total_stats, STATS_TOTAL_NAME);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file symtab.h
+ * @brief Public header for the structure-of-arrays symbol table of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the symbol table used to list a file. Every field of
+ * the kept symbols lives in an array of its own, all carved from a single
+ * allocation, and names stay offsets into the mapped string table. Sorting
+ * builds a permutation of symbol indices instead of moving records, and
+ * lines are only put together as writer_line_t when they are printed.
+ */
+
+#ifndef _IG_SYMTAB_H_
+#define _IG_SYMTAB_H_
+
+#include "../../Writer/inc_pub/writer.h"  // For writer_line_t
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint64_t, uint32_t, uint8_t
+
+/**
+ * @brief Error codes for symbol table operations
+ */
+enum SymTab_Error {
+    ST_SUCCESS = 0,           /**< Success */
+    ST_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    ST_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    ST_ERR_FULL = -3          /**< Table holds as many symbols as it was created for */
+};
+
+/**
+ * @brief Keys supported by SymTab_sort
+ */
+typedef enum
+{
+    SYMTAB_KEY_NAME  = 0,  /**< Sort by name */
+    SYMTAB_KEY_VALUE = 1,  /**< Sort by symbol value, undefined symbols first */
+    SYMTAB_KEY_SIZE  = 2   /**< Sort by symbol size, undefined symbols first */
+} symtab_key_e;
+
+/**
+ * @brief Symbol table kept as one array per field
+ */
+typedef struct symtab_s
+{
+    uint64_t *value;          /**< Symbol values */
+    uint64_t *size;           /**< Symbol sizes */
+    uint32_t *name_off;       /**< Name offsets in the string table */
+    uint32_t *sect_head_idx;  /**< Section header indices, extended indices resolved */
+    uint8_t *attr;            /**< Binding in the low nibble, type in the high nibble */
+    const char **display;     /**< Names printed with -C, or NULL to demangle them when printed */
+    size_t *order;            /**< Symbol indices in sorted order, or NULL before SymTab_sort */
+    size_t len;               /**< Number of symbols */
+    size_t cap;               /**< Number of symbols the arrays hold */
+    const char *strtab;       /**< Mapped string table the names point into */
+    size_t strtab_len;        /**< Length of the string table */
+} symtab_t;
+
+/**
+ * @brief Allocates the arrays of an empty symbol table
+ * @param[out] tab Table to set up
+ * @param[in] cap Most symbols the table will hold
+ * @param[in] strtab Mapped string table; must stay mapped while the table is used
+ * @param[in] strtab_len Length of the string table
+ * @return int ST_SUCCESS on success, ST_ERR_NULL_INPUT if tab is NULL,
+ *             ST_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int SymTab_create(symtab_t *tab, size_t cap, const char *strtab, size_t strtab_len);
+
+/**
+ * @brief Appends a symbol to the table
+ * @param[in,out] tab Table to append to
+ * @param[in] line Symbol to append; its name must be name_off in the string table
+ * @return int ST_SUCCESS on success, ST_ERR_NULL_INPUT on invalid input,
+ *             ST_ERR_FULL if the table is full
+ */
+int SymTab_push(symtab_t *tab, const writer_line_t *line);
+
+/**
+ * @brief Returns the name of a symbol
+ * @param[in] tab Symbol table
+ * @param[in] idx Index of the symbol
+ * @return const char* View into the string table
+ */
+const char *SymTab_nameGet(const symtab_t *tab, size_t idx);
+
+/**
+ * @brief Puts together the line printed for a symbol
+ * @param[in] tab Symbol table
+ * @param[in] idx Index of the symbol
+ * @param[out] line Line to fill; its name points into the string table
+ */
+void SymTab_lineGet(const symtab_t *tab, size_t idx, writer_line_t *line);
+
+/**
+ * @brief Sorts the table into tab->order
+ *
+ * The result and the order of equal symbols are those LinkedList_sort and
+ * LinkedList_radixSort give for a list built by pushing the symbols to the
+ * front in table order, so both paths print the same listing.
+ *
+ * @param[in,out] tab Table to sort
+ * @param[in] key Sort key
+ * @param[in] cmp Name comparison function; returns <0, 0, or >0
+ * @return int ST_SUCCESS on success, ST_ERR_NULL_INPUT on invalid input,
+ *             ST_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int SymTab_sort(symtab_t *tab, symtab_key_e key, int (*cmp)(const char*, const char*));
+
+/**
+ * @brief Frees the arrays of a symbol table
+ * @param[in,out] tab Table to free; left empty
+ */
+void SymTab_free(symtab_t *tab);
+
+#endif /* _IG_SYMTAB_H_ */
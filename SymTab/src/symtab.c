@@ -0,0 +1,133 @@
+/**
+ * @file symtab.c
+ * @brief Structure-of-arrays symbol table of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the storage of the symbol table. The arrays are laid
+ * out in one block, widest first so each stays aligned, which makes a kept
+ * symbol cost 25 bytes instead of a malloc'd writer_line_t plus a list node.
+ */
+
+#include "../inc_pub/symtab.h"
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For malloc, free
+
+#define SYMTAB_ATTR_TYPE_SHIFT  4u     /**< Position of the type in attr */
+#define SYMTAB_ATTR_BIND_MASK   0x0fu  /**< Bits of the binding in attr */
+
+/**
+ * @brief Bytes of one symbol across all arrays
+ */
+#define SYMTAB_SYMBOL_BYTES     (2u * sizeof(uint64_t) + 2u * sizeof(uint32_t) + sizeof(uint8_t))
+
+/**
+ * @brief Allocates the arrays of an empty symbol table
+ * @param[out] tab Table to set up
+ * @param[in] cap Most symbols the table will hold
+ * @param[in] strtab Mapped string table; must stay mapped while the table is used
+ * @param[in] strtab_len Length of the string table
+ * @return int ST_SUCCESS on success, ST_ERR_NULL_INPUT if tab is NULL,
+ *             ST_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int SymTab_create(symtab_t *tab, size_t cap, const char *strtab, size_t strtab_len)
+{
+    if (tab == NULL)
+    {
+        return ST_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    *tab = (symtab_t){0};
+    if (cap != 0)
+    {
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, cap * SYMTAB_SYMBOL_BYTES);
+        tab->value = malloc(cap * SYMTAB_SYMBOL_BYTES);
+        if (tab->value == NULL)
+        {
+            return ST_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        tab->size = &tab->value[cap];
+        tab->name_off = (uint32_t *)&tab->size[cap];
+        tab->sect_head_idx = &tab->name_off[cap];
+        tab->attr = (uint8_t *)&tab->sect_head_idx[cap];
+    }
+    tab->cap = cap;
+    tab->strtab = strtab;
+    tab->strtab_len = strtab_len;
+    return ST_SUCCESS;
+}
+
+/**
+ * @brief Appends a symbol to the table
+ * @param[in,out] tab Table to append to
+ * @param[in] line Symbol to append; its name must be name_off in the string table
+ * @return int ST_SUCCESS on success, ST_ERR_NULL_INPUT on invalid input,
+ *             ST_ERR_FULL if the table is full
+ */
+int SymTab_push(symtab_t *tab, const writer_line_t *line)
+{
+    size_t idx;
+
+    if ((tab == NULL) || (line == NULL))
+    {
+        return ST_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (tab->len == tab->cap)
+    {
+        return ST_ERR_FULL;
+    }
+    idx = tab->len++;
+    tab->value[idx] = line->value;
+    tab->size[idx] = line->size;
+    tab->name_off[idx] = line->name_off;
+    tab->sect_head_idx[idx] = line->sect_head_idx;
+    tab->attr[idx] = (uint8_t)(((unsigned int)line->type << SYMTAB_ATTR_TYPE_SHIFT) |
+                               ((unsigned int)line->bind & SYMTAB_ATTR_BIND_MASK));
+    return ST_SUCCESS;
+}
+
+/**
+ * @brief Returns the name of a symbol
+ * @param[in] tab Symbol table
+ * @param[in] idx Index of the symbol
+ * @return const char* View into the string table
+ */
+const char *SymTab_nameGet(const symtab_t *tab, size_t idx)
+{
+    return &tab->strtab[tab->name_off[idx]];  // Offsets were checked when the symbol was kept
+}
+
+/**
+ * @brief Puts together the line printed for a symbol
+ * @param[in] tab Symbol table
+ * @param[in] idx Index of the symbol
+ * @param[out] line Line to fill; its name points into the string table
+ */
+void SymTab_lineGet(const symtab_t *tab, size_t idx, writer_line_t *line)
+{
+    line->bind = (writer_flagprint_bind_e)(tab->attr[idx] & SYMTAB_ATTR_BIND_MASK);
+    line->type = (writer_flagprint_type_e)(tab->attr[idx] >> SYMTAB_ATTR_TYPE_SHIFT);
+    line->sect_head_idx = tab->sect_head_idx[idx];
+    line->name_off = tab->name_off[idx];
+    line->name = SymTab_nameGet(tab, idx);
+    line->value = tab->value[idx];
+    line->size = tab->size[idx];
+    line->demangled = (tab->display != NULL) ? tab->display[idx] : NULL;
+}
+
+/**
+ * @brief Frees the arrays of a symbol table
+ * @param[in,out] tab Table to free; left empty
+ */
+void SymTab_free(symtab_t *tab)
+{
+    if (tab == NULL)
+    {
+        return;
+    }
+    free(tab->value);
+    free(tab->display);
+    free(tab->order);
+    *tab = (symtab_t){0};
+}
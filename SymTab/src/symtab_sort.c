@@ -0,0 +1,387 @@
+/**
+ * @file symtab_sort.c
+ * @brief Sorting of the structure-of-arrays symbol table for ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the name, value and size sorts of the symbol table. They
+ * order an array of symbol indices and leave the symbol arrays untouched.
+ * Both start from the order of a list built by pushing symbols to the front,
+ * that is the table reversed, and make the same merges and comparisons as
+ * LinkedList_sort and LinkedList_radixSort, so equal and incomparable names
+ * end up exactly where the list sorts put them.
+ */
+
+#include "../inc_pub/symtab.h"
+#include "../../Probe/inc_pub/probe.h"  // For FT_NM_PROBE2
+#include "../../Stats/inc_pub/stats.h"  // For STATS_COUNT
+#include <stdlib.h>  // For malloc, free
+
+/**
+ * @brief Radix macros
+ */
+#define SYMTAB_RADIX_BITS          8u                        /**< Bits per radix digit */
+#define SYMTAB_RADIX_BUCKETS       (1u << SYMTAB_RADIX_BITS) /**< Buckets per digit */
+#define SYMTAB_RADIX_DIGITS        (64u / SYMTAB_RADIX_BITS) /**< Digits in a 64-bit key */
+#define SYMTAB_RADIX_INSERTION_MAX 16u                       /**< Runs up to this length use insertion sort */
+
+/**
+ * @brief Name comparison function type
+ */
+typedef int (*symtab_cmp_t)(const char*, const char*);
+
+/**
+ * @brief Sort element: key and the symbol it belongs to
+ */
+typedef struct symtab_pair_s
+{
+    uint64_t key;  /**< Sort key (symbol value or size) */
+    size_t idx;    /**< Symbol index */
+} symtab_pair_t;
+
+/**
+ * @brief Merges two adjacent sorted runs of symbol indices
+ *
+ * Indices of the later run go first unless their name compares greater, like
+ * the run merge of LinkedList_sort.
+ *
+ * @param[in] tab Symbol table
+ * @param[in,out] order Index array holding both runs
+ * @param[in,out] tmp Scratch space of at least end - start indices
+ * @param[in] start Position of the first run
+ * @param[in] mid Position of the second run
+ * @param[in] end Position past the second run
+ * @param[in] cmp Name comparison function
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ */
+static void symtab_runMerge(const symtab_t *tab, size_t *order, size_t *tmp, size_t start, size_t mid, size_t end,
+                            symtab_cmp_t cmp, size_t *cmp_cnt)
+{
+    size_t first = start, second = mid, out = 0;
+
+    while ((first < mid) && (second < end))
+    {
+        (*cmp_cnt)++;
+        if (cmp(SymTab_nameGet(tab, order[second]), SymTab_nameGet(tab, order[first])) > 0)
+        {
+            tmp[out++] = order[first++];   // Earlier symbol is strictly smaller
+        }
+        else
+        {
+            tmp[out++] = order[second++];  // Later symbol is smaller or equal
+        }
+    }
+    while (first < mid)
+    {
+        tmp[out++] = order[first++];
+    }
+    while (second < end)
+    {
+        tmp[out++] = order[second++];
+    }
+    for (size_t i = 0; i < out; i++)
+    {
+        order[start + i] = tmp[i];
+    }
+}
+
+/**
+ * @brief Sorts symbol indices by name with the bottom-up merges of LinkedList_sort
+ * @param[in] tab Symbol table
+ * @param[in,out] order Indices to sort
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] cmp Name comparison function
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ */
+static void symtab_nameSort(const symtab_t *tab, size_t *order, size_t *tmp, symtab_cmp_t cmp, size_t *cmp_cnt)
+{
+    size_t run_start[sizeof(size_t) * 8];  // Pending runs, longest first, each twice the next one at least
+    size_t run_cnt = 0;
+    size_t start, end;
+
+    // Merge single indices into runs of doubling length, like a binary counter
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        start = i;
+        while ((run_cnt != 0) && ((start - run_start[run_cnt - 1]) == (i + 1 - start)))
+        {
+            run_cnt--;
+            symtab_runMerge(tab, order, tmp, run_start[run_cnt], start, i + 1, cmp, cmp_cnt);
+            start = run_start[run_cnt];
+        }
+        run_start[run_cnt++] = start;
+    }
+
+    // Merge the remaining runs, the shortest and latest first
+    end = tab->len;
+    start = (run_cnt != 0) ? run_start[--run_cnt] : 0;
+    while (run_cnt != 0)
+    {
+        run_cnt--;
+        symtab_runMerge(tab, order, tmp, run_start[run_cnt], start, end, cmp, cmp_cnt);
+        start = run_start[run_cnt];
+    }
+}
+
+/**
+ * @brief Sorts pairs by key with an LSD radix sort
+ * @param[in,out] arr Pairs to sort; holds the result on return
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] n Number of pairs
+ */
+static void symtab_keySort(symtab_pair_t *arr, symtab_pair_t *tmp, size_t n)
+{
+    size_t count[SYMTAB_RADIX_DIGITS][SYMTAB_RADIX_BUCKETS] = {{0}};
+    symtab_pair_t *src = arr, *dst = tmp, *swap;
+    size_t pos, cnt;
+
+    // Build the histograms of all digits in one pass
+    for (size_t i = 0; i < n; i++)
+    {
+        for (unsigned int d = 0; d < SYMTAB_RADIX_DIGITS; d++)
+        {
+            count[d][(arr[i].key >> (d * SYMTAB_RADIX_BITS)) & (SYMTAB_RADIX_BUCKETS - 1)]++;
+        }
+    }
+    for (unsigned int d = 0; d < SYMTAB_RADIX_DIGITS; d++)
+    {
+        // Skip digits that are the same for every key
+        if (count[d][(arr[0].key >> (d * SYMTAB_RADIX_BITS)) & (SYMTAB_RADIX_BUCKETS - 1)] == n)
+        {
+            continue;
+        }
+        // Turn counts into bucket start offsets
+        pos = 0;
+        for (unsigned int b = 0; b < SYMTAB_RADIX_BUCKETS; b++)
+        {
+            cnt = count[d][b];
+            count[d][b] = pos;
+            pos += cnt;
+        }
+        // Scatter stably into the buckets
+        for (size_t i = 0; i < n; i++)
+        {
+            dst[count[d][(src[i].key >> (d * SYMTAB_RADIX_BITS)) & (SYMTAB_RADIX_BUCKETS - 1)]++] = src[i];
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != arr)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            arr[i] = src[i];  // Odd number of passes, move result back
+        }
+    }
+}
+
+/**
+ * @brief Sorts a run of pairs stably by name
+ * @param[in] tab Symbol table
+ * @param[in,out] arr Pairs to sort
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] n Number of pairs
+ * @param[in] cmp Name comparison function
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ */
+static void symtab_runSort(const symtab_t *tab, symtab_pair_t *arr, symtab_pair_t *tmp, size_t n,
+                           symtab_cmp_t cmp, size_t *cmp_cnt)
+{
+    symtab_pair_t curr;
+    size_t left, right, mid, out;
+    size_t j;
+
+    if (n <= SYMTAB_RADIX_INSERTION_MAX)
+    {
+        for (size_t i = 1; i < n; i++)
+        {
+            curr = arr[i];
+            for (j = i; j > 0; j--)
+            {
+                (*cmp_cnt)++;
+                if (cmp(SymTab_nameGet(tab, curr.idx), SymTab_nameGet(tab, arr[j - 1].idx)) >= 0)
+                {
+                    break;  // Equal elements keep their order
+                }
+                arr[j] = arr[j - 1];
+            }
+            arr[j] = curr;
+        }
+        return;
+    }
+    mid = n / 2;
+    symtab_runSort(tab, arr, tmp, mid, cmp, cmp_cnt);
+    symtab_runSort(tab, &arr[mid], &tmp[mid], n - mid, cmp, cmp_cnt);
+    left = 0;
+    right = mid;
+    out = 0;
+    while ((left < mid) && (right < n))
+    {
+        (*cmp_cnt)++;
+        if (cmp(SymTab_nameGet(tab, arr[right].idx), SymTab_nameGet(tab, arr[left].idx)) < 0)
+        {
+            tmp[out++] = arr[right++];
+        }
+        else
+        {
+            tmp[out++] = arr[left++];  // Ties taken from the left keep their order
+        }
+    }
+    while (left < mid)
+    {
+        tmp[out++] = arr[left++];
+    }
+    while (right < n)
+    {
+        tmp[out++] = arr[right++];
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        arr[i] = tmp[i];
+    }
+}
+
+/**
+ * @brief Sorts each run of equal keys in a key-sorted range by name
+ * @param[in] tab Symbol table
+ * @param[in,out] arr Key-sorted pairs
+ * @param[in,out] tmp Scratch space of the same length
+ * @param[in] n Number of pairs
+ * @param[in] cmp Name comparison function
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ */
+static void symtab_tieSort(const symtab_t *tab, symtab_pair_t *arr, symtab_pair_t *tmp, size_t n,
+                           symtab_cmp_t cmp, size_t *cmp_cnt)
+{
+    size_t start = 0;
+
+    for (size_t i = 1; i <= n; i++)
+    {
+        if ((i == n) || (arr[i].key != arr[start].key))
+        {
+            if (i - start > 1)
+            {
+                symtab_runSort(tab, &arr[start], &tmp[start], i - start, cmp, cmp_cnt);
+            }
+            start = i;
+        }
+    }
+}
+
+/**
+ * @brief Sorts symbol indices by value or size, undefined symbols first
+ * @param[in] tab Symbol table
+ * @param[in,out] order Indices to sort
+ * @param[in] key Sort key (SYMTAB_KEY_VALUE or SYMTAB_KEY_SIZE)
+ * @param[in] cmp Name comparison function ordering equal keys
+ * @param[in,out] cmp_cnt Number of comparisons, incremented
+ * @return int ST_SUCCESS on success, ST_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int symtab_keyOrder(const symtab_t *tab, size_t *order, symtab_key_e key, symtab_cmp_t cmp, size_t *cmp_cnt)
+{
+    symtab_pair_t *arr, *tmp;
+    size_t undef_cnt = 0, def_pos;
+
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, 2 * tab->len * sizeof(symtab_pair_t));
+    arr = malloc(2 * tab->len * sizeof(symtab_pair_t));
+    if (arr == NULL)
+    {
+        return ST_ERR_MALLOC_FAIL;  // Memory allocation failure
+    }
+    tmp = &arr[tab->len];
+
+    // Undefined symbols go first, the rest follows in the starting order
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        undef_cnt += (tab->sect_head_idx[order[i]] == WRITER_FLAGPRINT_SHIDX_UNDEFINED);
+    }
+    def_pos = undef_cnt;
+    undef_cnt = 0;
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        size_t idx = order[i];
+        if (tab->sect_head_idx[idx] == WRITER_FLAGPRINT_SHIDX_UNDEFINED)
+        {
+            arr[undef_cnt].key = 0;
+            arr[undef_cnt++].idx = idx;
+        }
+        else
+        {
+            arr[def_pos].key = (key == SYMTAB_KEY_SIZE) ? tab->size[idx] : tab->value[idx];
+            arr[def_pos++].idx = idx;
+        }
+    }
+    if (tab->len - undef_cnt > 1)
+    {
+        symtab_keySort(&arr[undef_cnt], tmp, tab->len - undef_cnt);
+    }
+    symtab_tieSort(tab, arr, tmp, undef_cnt, cmp, cmp_cnt);
+    symtab_tieSort(tab, &arr[undef_cnt], tmp, tab->len - undef_cnt, cmp, cmp_cnt);
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        order[i] = arr[i].idx;
+    }
+    free(arr);
+    return ST_SUCCESS;
+}
+
+/**
+ * @brief Sorts the table into tab->order
+ * @param[in,out] tab Table to sort
+ * @param[in] key Sort key
+ * @param[in] cmp Name comparison function; returns <0, 0, or >0
+ * @return int ST_SUCCESS on success, ST_ERR_NULL_INPUT on invalid input,
+ *             ST_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int SymTab_sort(symtab_t *tab, symtab_key_e key, int (*cmp)(const char*, const char*))
+{
+    size_t *tmp;
+    size_t cmp_cnt = 0;
+    int ret = ST_SUCCESS;
+
+    if ((tab == NULL) || (cmp == NULL))
+    {
+        return ST_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (tab->order == NULL)
+    {
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (tab->len + 1) * sizeof(size_t));
+        tab->order = malloc((tab->len + 1) * sizeof(size_t));
+        if (tab->order == NULL)
+        {
+            return ST_ERR_MALLOC_FAIL;  // Memory allocation failure
+        }
+    }
+
+    // Start from the order of a list built front to back: the table reversed
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        tab->order[i] = tab->len - 1 - i;
+    }
+    if (tab->len < 2)
+    {
+        return ST_SUCCESS;  // Nothing to sort
+    }
+    if (key == SYMTAB_KEY_NAME)
+    {
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, tab->len * sizeof(size_t));
+        tmp = malloc(tab->len * sizeof(size_t));
+        if (tmp == NULL)
+        {
+            return ST_ERR_MALLOC_FAIL;  // Memory allocation failure
+        }
+        symtab_nameSort(tab, tab->order, tmp, cmp, &cmp_cnt);
+        free(tmp);
+    }
+    else
+    {
+        ret = symtab_keyOrder(tab, tab->order, key, cmp, &cmp_cnt);
+    }
+    FT_NM_PROBE2(symtab_sort, tab->len, cmp_cnt);
+    return ret;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file trace.h
+ * @brief Public header for Chrome trace event export in ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the interface for recording begin/end events of files
+ * and pipeline stages. Events are buffered in a per-thread ring without locks,
+ * written to the trace file when a ring fills and at exit, in Chrome trace
+ * JSON format, loadable in Perfetto or chrome://tracing.
+ */
+
+#ifndef _IG_TRACE_H_
+#define _IG_TRACE_H_
+
+#include <stdint.h>  // For uint64_t
+
+/**
+ * @brief Error codes for trace operations
+ */
+enum Trace_Error {
+    TR_SUCCESS = 0,           /**< Success */
+    TR_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    TR_ERR_OPEN_FAIL = -2,    /**< Output file could not be opened */
+    TR_ERR_WRITE_FAIL = -3    /**< Output file could not be written */
+};
+
+/**
+ * @brief Event phases, matching the Chrome trace "ph" field
+ */
+typedef enum
+{
+    TRACE_PHASE_BEGIN = 'B',  /**< Duration begin event */
+    TRACE_PHASE_END   = 'E'   /**< Duration end event */
+} trace_phase_e;
+
+extern unsigned short g_trace_enabled; /**< Non-zero when tracing is enabled */
+
+/**
+ * @brief Enables tracing and opens the output file
+ * @param[in] path Path of the Chrome trace JSON file to create
+ * @return int TR_SUCCESS on success, TR_ERR_NULL_INPUT if path is NULL,
+ *             TR_ERR_OPEN_FAIL if the file cannot be created
+ */
+int Trace_enable(const char *path);
+
+/**
+ * @brief Returns the current monotonic time used for event timestamps
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t Trace_nowGet(void);
+
+/**
+ * @brief Records an event in the ring of the calling thread
+ * @param[in] name Event name; must stay valid until Trace_flush
+ * @param[in] category Event category; must stay valid until Trace_flush
+ * @param[in] phase TRACE_PHASE_BEGIN or TRACE_PHASE_END
+ * @param[in] ts Timestamp in nanoseconds from Trace_nowGet
+ */
+void Trace_eventRecord(const char *name, const char *category, trace_phase_e phase, uint64_t ts);
+
+/**
+ * @brief Records a begin event at the current time
+ * @param[in] name Event name; must stay valid until Trace_flush
+ * @param[in] category Event category; must stay valid until Trace_flush
+ */
+void Trace_begin(const char *name, const char *category);
+
+/**
+ * @brief Records an end event at the current time
+ * @param[in] name Event name; must stay valid until Trace_flush
+ * @param[in] category Event category; must stay valid until Trace_flush
+ */
+void Trace_end(const char *name, const char *category);
+
+/**
+ * @brief Writes all buffered events to the output file and disables tracing
+ * @return int TR_SUCCESS on success or if tracing is disabled,
+ *             TR_ERR_WRITE_FAIL if the file cannot be written
+ */
+int Trace_flush(void);
+
+#endif /* _IG_TRACE_H_ */
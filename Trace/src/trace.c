@@ -0,0 +1,548 @@
+/**
+ * @file trace.c
+ * @brief Chrome trace event export for ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains functions for recording begin/end events into per-thread
+ * ring buffers and writing them as Chrome trace JSON. Rings are owned by their
+ * thread and registered in a global list with a compare-and-swap push, so
+ * recording never takes a lock. A ring starts small and doubles up to its
+ * capacity; once full, its events are written to the trace file and it is
+ * emptied, so runs of any length are recorded whole. Only if that write
+ * fails are whole spans dropped, so every begin event written has its end
+ * event. The rest of the output is written at exit.
+ */
+
+#include "../inc_pub/trace.h"
+#include <fcntl.h>      // For open, O_WRONLY, O_CREAT, O_TRUNC
+#include <pthread.h>    // For pthread_mutex_lock, pthread_mutex_unlock
+#include <stdatomic.h>  // For atomic_compare_exchange_weak, atomic_fetch_add
+#include <stdlib.h>     // For malloc, realloc, free, atexit
+#include <time.h>       // For clock_gettime, CLOCK_MONOTONIC
+#include <unistd.h>     // For write, close, getpid
+
+/**
+ * @brief Trace macros
+ */
+#define TRACE_RING_INITIAL  256u        /**< Events of a new thread ring */
+#define TRACE_RING_CAPACITY (1u << 16)  /**< Most events of a thread ring, 2 MiB; then written to the file */
+#define TRACE_OUT_BUF_SIZE  65536u      /**< Size of the output write buffer */
+#define TRACE_NSEC_PER_USEC 1000u       /**< Nanoseconds per microsecond */
+#define TRACE_NSEC_PER_SEC  1000000000u /**< Nanoseconds per second */
+#define TRACE_FILE_MODE     0644        /**< Permissions of the created trace file */
+
+#define TRACE_JSON_HEAD     "{\"traceEvents\":[\n"
+#define TRACE_JSON_TAIL     "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":\""
+
+/**
+ * @brief One recorded event
+ */
+typedef struct trace_event_s
+{
+    const char *name;      /**< Event name */
+    const char *category;  /**< Event category */
+    uint64_t ts;           /**< Timestamp in nanoseconds */
+    char phase;            /**< Chrome trace phase character */
+} trace_event_t;
+
+/**
+ * @brief Event ring owned by one thread
+ */
+typedef struct trace_ring_s
+{
+    trace_event_t *events;      /**< Event storage */
+    size_t cap;                 /**< Room for events, doubled up to TRACE_RING_CAPACITY */
+    size_t count;               /**< Number of events recorded */
+    size_t open;                /**< Spans begun and not ended yet, whose end events need room */
+    size_t skip;                /**< Spans being dropped: the current one and those nested in it */
+    uint64_t dropped;           /**< Number of events dropped */
+    unsigned int tid;           /**< Thread id reported in the trace */
+    struct trace_ring_s *next;  /**< Next registered ring */
+} trace_ring_t;
+
+/**
+ * @brief Buffered writer for the output file
+ */
+typedef struct trace_out_s
+{
+    int fd;                          /**< Output file descriptor */
+    size_t len;                      /**< Bytes pending in buf */
+    int failed;                      /**< Non-zero once a write has failed */
+    char buf[TRACE_OUT_BUF_SIZE];    /**< Pending output */
+} trace_out_t;
+
+unsigned short g_trace_enabled = 0u;                 /* Global flag for enabling/disabling tracing */
+static int g_trace_fd = -1;                          /* Output file descriptor */
+static uint64_t g_trace_start = 0;                   /* Timestamp all events are relative to */
+static _Atomic(trace_ring_t *) g_ring_list = NULL;   /* Registered rings of all threads */
+static atomic_uint g_tid_next = 1;                   /* Next thread id to hand out */
+static _Thread_local trace_ring_t *t_ring = NULL;    /* Ring of the calling thread */
+static pthread_mutex_t g_trace_lock = PTHREAD_MUTEX_INITIALIZER;  /* Serializes writes to the output file */
+static int g_trace_sep = 0;                          /* Non-zero once an event is written, next one is separated */
+static int g_trace_failed = 0;                       /* Non-zero once a write to the output file has failed */
+
+/**
+ * @brief Returns the current monotonic time used for event timestamps
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t Trace_nowGet(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * TRACE_NSEC_PER_SEC + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * @brief Writes the pending output buffer to the file
+ * @param[in,out] out Output writer
+ */
+static void trace_outFlush(trace_out_t *out)
+{
+    size_t done = 0;
+    ssize_t ret_val;
+
+    while ((done < out->len) && !out->failed)
+    {
+        ret_val = write(out->fd, out->buf + done, out->len - done);
+        if (ret_val <= 0)
+        {
+            out->failed = 1;  // Give up on write error
+        }
+        else
+        {
+            done += (size_t)ret_val;
+        }
+    }
+    out->len = 0;
+}
+
+/**
+ * @brief Appends bytes to the output buffer
+ * @param[in,out] out Output writer
+ * @param[in] str Bytes to append
+ * @param[in] len Number of bytes
+ */
+static void trace_outAppend(trace_out_t *out, const char *str, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (out->len == TRACE_OUT_BUF_SIZE)
+        {
+            trace_outFlush(out);
+        }
+        out->buf[out->len++] = str[i];
+    }
+}
+
+/**
+ * @brief Appends a null-terminated string to the output buffer
+ * @param[in,out] out Output writer
+ * @param[in] str String to append
+ */
+static void trace_outStr(trace_out_t *out, const char *str)
+{
+    size_t len = 0;
+
+    while (str[len] != '\0')
+    {
+        len++;
+    }
+    trace_outAppend(out, str, len);
+}
+
+/**
+ * @brief Appends a string as JSON string content, escaping as needed
+ * @param[in,out] out Output writer
+ * @param[in] str String to append
+ */
+static void trace_outJsonStr(trace_out_t *out, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+    char esc[6] = {'\\', 'u', '0', '0', 0, 0};
+
+    for (; *str != '\0'; str++)
+    {
+        unsigned char c = (unsigned char)*str;
+        if ((c == '"') || (c == '\\'))
+        {
+            trace_outAppend(out, "\\", 1);
+            trace_outAppend(out, str, 1);
+        }
+        else if (c < 0x20)
+        {
+            esc[4] = hex[c >> 4];
+            esc[5] = hex[c & 0xf];
+            trace_outAppend(out, esc, sizeof(esc));
+        }
+        else
+        {
+            trace_outAppend(out, str, 1);
+        }
+    }
+}
+
+/**
+ * @brief Appends an unsigned decimal number to the output buffer
+ * @param[in,out] out Output writer
+ * @param[in] num Number to append
+ * @param[in] min_digits Minimum number of digits, padded with zeros
+ */
+static void trace_outNum(trace_out_t *out, uint64_t num, unsigned int min_digits)
+{
+    char digits[21];
+    unsigned int cnt = 0;
+
+    do {
+        digits[cnt++] = '0' + (num % 10u);
+        num /= 10u;
+    } while ((num != 0) || (cnt < min_digits));
+    while (cnt != 0)
+    {
+        trace_outAppend(out, &digits[--cnt], 1);
+    }
+}
+
+/**
+ * @brief Appends the events of a ring to the output buffer
+ *
+ * Must be called with g_trace_lock held.
+ *
+ * @param[in,out] out Output writer
+ * @param[in] ring Ring whose events are appended
+ * @param[in] pid Process id reported in the trace
+ */
+static void trace_outEvents(trace_out_t *out, const trace_ring_t *ring, uint64_t pid)
+{
+    for (size_t i = 0; i < ring->count; i++)
+    {
+        const trace_event_t *event = &ring->events[i];
+        uint64_t rel = (event->ts > g_trace_start) ? (event->ts - g_trace_start) : 0;
+        char phase = event->phase;
+
+        if (g_trace_sep)
+        {
+            trace_outStr(out, ",\n");
+        }
+        g_trace_sep = 1;
+        trace_outStr(out, "{\"name\":\"");
+        trace_outJsonStr(out, event->name);
+        trace_outStr(out, "\",\"cat\":\"");
+        trace_outJsonStr(out, event->category);
+        trace_outStr(out, "\",\"ph\":\"");
+        trace_outAppend(out, &phase, 1);
+        trace_outStr(out, "\",\"ts\":");
+        trace_outNum(out, rel / TRACE_NSEC_PER_USEC, 1u);
+        trace_outStr(out, ".");
+        trace_outNum(out, rel % TRACE_NSEC_PER_USEC, 3u);
+        trace_outStr(out, ",\"pid\":");
+        trace_outNum(out, pid, 1u);
+        trace_outStr(out, ",\"tid\":");
+        trace_outNum(out, ring->tid, 1u);
+        trace_outStr(out, "}");
+    }
+}
+
+/**
+ * @brief Writes the events of a full ring to the output file and empties it
+ *
+ * Recording stays lock-free until a ring fills; only its write to the file
+ * is serialized with the other threads and Trace_flush.
+ *
+ * @param[in,out] ring Ring of the calling thread
+ * @return int Non-zero if the ring was emptied, 0 if its events could not be written
+ */
+static int trace_ringSpill(trace_ring_t *ring)
+{
+    trace_out_t *out;
+    int ret;
+
+    out = malloc(sizeof(trace_out_t));
+    if (out == NULL)
+    {
+        return (0);  // Tracing is best effort, keep the ring full
+    }
+    pthread_mutex_lock(&g_trace_lock);
+    out->fd = g_trace_fd;
+    out->len = 0;
+    out->failed = g_trace_failed;
+    trace_outEvents(out, ring, (uint64_t)getpid());
+    trace_outFlush(out);
+    g_trace_failed = out->failed;
+    pthread_mutex_unlock(&g_trace_lock);
+    ret = !out->failed;
+    free(out);
+    if (ret)
+    {
+        ring->count = 0;  // Events are in the file, end events of open spans follow
+    }
+    return (ret);
+}
+
+/**
+ * @brief Returns the ring of the calling thread, creating and registering it on first use
+ * @return trace_ring_t* Ring of the calling thread, or NULL on allocation failure
+ */
+static trace_ring_t *trace_ringGet(void)
+{
+    trace_ring_t *ring;
+
+    if (t_ring != NULL)
+    {
+        return (t_ring);
+    }
+    ring = malloc(sizeof(trace_ring_t));
+    if (ring == NULL)
+    {
+        return (NULL);
+    }
+    ring->events = malloc(TRACE_RING_INITIAL * sizeof(trace_event_t));
+    if (ring->events == NULL)
+    {
+        free(ring);
+        return (NULL);
+    }
+    ring->cap = TRACE_RING_INITIAL;
+    ring->count = 0;
+    ring->open = 0;
+    ring->skip = 0;
+    ring->dropped = 0;
+    ring->tid = atomic_fetch_add(&g_tid_next, 1u);
+    ring->next = atomic_load(&g_ring_list);
+    while (!atomic_compare_exchange_weak(&g_ring_list, &ring->next, ring))
+    {
+        ;  // ring->next was reloaded with the current list head, retry
+    }
+    t_ring = ring;
+    return (ring);
+}
+
+/**
+ * @brief Makes room in a ring for a number of events
+ * @param[in,out] ring Ring of the calling thread
+ * @param[in] need Number of events the ring must hold
+ * @return int Non-zero if the ring holds need events, 0 if it is full
+ */
+static int trace_ringReserve(trace_ring_t *ring, size_t need)
+{
+    size_t new_cap = ring->cap;
+    trace_event_t *new_events;
+
+    if (need <= ring->cap)
+    {
+        return (1);
+    }
+    while ((new_cap < need) && (new_cap < TRACE_RING_CAPACITY))
+    {
+        new_cap *= 2;
+    }
+    if (new_cap < need)
+    {
+        return (0);  // At capacity
+    }
+    new_events = realloc(ring->events, new_cap * sizeof(trace_event_t));
+    if (new_events == NULL)
+    {
+        return (0);  // Tracing is best effort, treat as full
+    }
+    ring->events = new_events;
+    ring->cap = new_cap;
+    return (1);
+}
+
+/**
+ * @brief Flushes the trace at process exit
+ */
+static void trace_atExit(void)
+{
+    Trace_flush();
+}
+
+/**
+ * @brief Enables tracing and opens the output file
+ * @param[in] path Path of the Chrome trace JSON file to create
+ * @return int TR_SUCCESS on success, TR_ERR_NULL_INPUT if path is NULL,
+ *             TR_ERR_OPEN_FAIL if the file cannot be created
+ */
+int Trace_enable(const char *path)
+{
+    if (path == NULL)
+    {
+        return TR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (g_trace_fd != -1)
+    {
+        close(g_trace_fd);  // A later --trace replaces an earlier one
+    }
+    g_trace_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, TRACE_FILE_MODE);
+    if (g_trace_fd == -1)
+    {
+        return TR_ERR_OPEN_FAIL;  // Failed to create file
+    }
+    g_trace_sep = 0;
+    g_trace_failed = (write(g_trace_fd, TRACE_JSON_HEAD, sizeof(TRACE_JSON_HEAD) - 1)
+                      != (ssize_t)(sizeof(TRACE_JSON_HEAD) - 1));  // Spilled rings follow the head
+    if (!g_trace_enabled)
+    {
+        g_trace_start = Trace_nowGet();
+        atexit(trace_atExit);  // Make sure early exits still produce a trace
+    }
+    g_trace_enabled = 1u;
+    return TR_SUCCESS;
+}
+
+/**
+ * @brief Records an event in the ring of the calling thread
+ *
+ * A begin event is only kept if the ring has room for it, its end event and
+ * the end events of every span still open. A ring without that room is
+ * written to the file first; if it cannot be, the whole span is dropped,
+ * along with the spans nested in it.
+ *
+ * @param[in] name Event name; must stay valid until Trace_flush
+ * @param[in] category Event category; must stay valid until Trace_flush
+ * @param[in] phase TRACE_PHASE_BEGIN or TRACE_PHASE_END
+ * @param[in] ts Timestamp in nanoseconds from Trace_nowGet
+ */
+void Trace_eventRecord(const char *name, const char *category, trace_phase_e phase, uint64_t ts)
+{
+    trace_ring_t *ring;
+    trace_event_t *event;
+
+    if (!g_trace_enabled)
+    {
+        return;
+    }
+    ring = trace_ringGet();
+    if (ring == NULL)
+    {
+        return;  // Tracing is best effort, drop the event
+    }
+    if (ring->skip != 0)
+    {
+        if (phase == TRACE_PHASE_BEGIN)
+        {
+            ring->skip++;  // Nested in a dropped span
+        }
+        else
+        {
+            ring->skip--;
+        }
+        ring->dropped++;
+        return;
+    }
+    if (phase == TRACE_PHASE_BEGIN)
+    {
+        if (!trace_ringReserve(ring, ring->count + ring->open + 2)
+            && (!trace_ringSpill(ring) || !trace_ringReserve(ring, ring->open + 2)))
+        {
+            ring->skip = 1;  // Drop this span and its end event
+            ring->dropped++;
+            return;
+        }
+        ring->open++;
+    }
+    else if (ring->open != 0)
+    {
+        ring->open--;  // Room was reserved with the begin event
+    }
+    else if (!trace_ringReserve(ring, ring->count + 1)
+             && (!trace_ringSpill(ring) || !trace_ringReserve(ring, 1)))
+    {
+        ring->dropped++;
+        return;
+    }
+    event = &ring->events[ring->count];
+    event->name = name;
+    event->category = category;
+    event->ts = ts;
+    event->phase = (char)phase;
+    ring->count++;
+}
+
+/**
+ * @brief Records a begin event at the current time
+ * @param[in] name Event name; must stay valid until Trace_flush
+ * @param[in] category Event category; must stay valid until Trace_flush
+ */
+void Trace_begin(const char *name, const char *category)
+{
+    if (g_trace_enabled)
+    {
+        Trace_eventRecord(name, category, TRACE_PHASE_BEGIN, Trace_nowGet());
+    }
+}
+
+/**
+ * @brief Records an end event at the current time
+ * @param[in] name Event name; must stay valid until Trace_flush
+ * @param[in] category Event category; must stay valid until Trace_flush
+ */
+void Trace_end(const char *name, const char *category)
+{
+    if (g_trace_enabled)
+    {
+        Trace_eventRecord(name, category, TRACE_PHASE_END, Trace_nowGet());
+    }
+}
+
+/**
+ * @brief Writes all buffered events to the output file and disables tracing
+ * @return int TR_SUCCESS on success or if tracing is disabled,
+ *             TR_ERR_WRITE_FAIL if the file cannot be written
+ */
+int Trace_flush(void)
+{
+    trace_out_t *out;
+    trace_ring_t *ring, *next;
+    uint64_t dropped = 0;
+    uint64_t pid;
+    int ret = TR_SUCCESS;
+
+    if (!g_trace_enabled)
+    {
+        return TR_SUCCESS;  // Nothing recorded
+    }
+    g_trace_enabled = 0u;
+    out = malloc(sizeof(trace_out_t));
+    if (out == NULL)
+    {
+        close(g_trace_fd);
+        g_trace_fd = -1;
+        return TR_ERR_WRITE_FAIL;
+    }
+    pthread_mutex_lock(&g_trace_lock);
+    out->fd = g_trace_fd;
+    out->len = 0;
+    out->failed = g_trace_failed;
+    pid = (uint64_t)getpid();
+    for (ring = atomic_exchange(&g_ring_list, NULL); ring != NULL; ring = next)
+    {
+        dropped += ring->dropped;
+        trace_outEvents(out, ring, pid);
+        next = ring->next;
+        free(ring->events);
+        free(ring);
+    }
+    t_ring = NULL;
+    trace_outStr(out, TRACE_JSON_TAIL);
+    trace_outNum(out, dropped, 1u);
+    trace_outStr(out, "\"}}\n");
+    trace_outFlush(out);
+    if (out->failed)
+    {
+        ret = TR_ERR_WRITE_FAIL;
+    }
+    if (close(g_trace_fd) != 0)
+    {
+        ret = TR_ERR_WRITE_FAIL;
+    }
+    g_trace_fd = -1;
+    g_trace_sep = 0;
+    g_trace_failed = 0;
+    pthread_mutex_unlock(&g_trace_lock);
+    free(out);
+    return ret;
+}
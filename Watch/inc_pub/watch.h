@@ -0,0 +1,58 @@
+/**
+ * @file watch.h
+ * @brief Public header for the --watch mode of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the file watcher used by the --watch option. The
+ * directories holding the target files, and target directories themselves,
+ * are watched with inotify; once a burst of changes settles, every changed
+ * file is handed to a callback, once, so only it is parsed and listed again.
+ */
+
+#ifndef _IG_WATCH_H_
+#define _IG_WATCH_H_
+
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Error codes for watch operations
+ */
+enum Watch_Error {
+    WA_SUCCESS = 0,           /**< Success */
+    WA_ERR_NULL_INPUT = -1,   /**< Invalid input (NULL pointer) */
+    WA_ERR_MALLOC_FAIL = -2,  /**< Memory allocation failed */
+    WA_ERR_WATCH_FAIL = -3    /**< inotify could not be set up, or nothing is left to watch */
+};
+
+/**
+ * @brief Callback listing one changed file
+ * @param[in] path Path of the changed file
+ * @param[in] arg Argument given to Watch_run
+ */
+typedef void (*watch_list_f)(const char *path, void *arg);
+
+/**
+ * @brief Watches the targets and lists the files that change, until nothing is left to watch
+ *
+ * A target file is watched through the directory that holds it, so it is
+ * still seen after a build replaces it; a target directory reports changes
+ * of any file directly in it, from the event alone, without scanning it.
+ * Changes are collected until none arrives for debounce_ms milliseconds; a
+ * target file whose inode, size and modification time did not change since it
+ * was last listed is skipped.
+ * If the kernel drops events, every target is looked at again: target files
+ * are queued and skipped the same way, target directories are listed whole.
+ *
+ * @param[in] paths Target files and directories
+ * @param[in] path_num Number of paths
+ * @param[in] debounce_ms Quiet time closing a burst of changes
+ * @param[in] list Callback listing a changed file
+ * @param[in] arg Argument passed to list
+ * @return int WA_ERR_WATCH_FAIL once no watch is left or inotify fails,
+ *             WA_ERR_NULL_INPUT on invalid input, WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Watch_run(char *const *paths, size_t path_num, unsigned int debounce_ms, watch_list_f list, void *arg);
+
+#endif /* _IG_WATCH_H_ */
@@ -0,0 +1,558 @@
+/**
+ * @file watch.c
+ * @brief inotify file watcher of ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the --watch loop. Target files are watched through their
+ * directory for files closed after writing or moved into place, which covers
+ * linkers writing in place as well as tools renaming a temporary file over
+ * the output. Events name the changed entry, so a watched directory is only
+ * scanned when the kernel event queue overflows and events were lost. Changed
+ * paths are queued without duplicates, found through a hash set of the queue,
+ * and listed once the directory has been quiet for the debounce time.
+ */
+
+#include "../inc_pub/watch.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <dirent.h>       // For opendir, readdir, closedir
+#include <errno.h>        // For errno, EINTR, ENOENT
+#include <poll.h>         // For poll
+#include <stdint.h>       // For SIZE_MAX, uint64_t
+#include <stdlib.h>       // For malloc, calloc, realloc, free
+#include <string.h>       // For strlen, strnlen, strcmp, memcpy, strrchr
+#include <sys/inotify.h>  // For inotify_init1, inotify_add_watch
+#include <sys/stat.h>     // For stat
+#include <unistd.h>       // For read, close
+
+#define WA_EVENT_MASK   (IN_CLOSE_WRITE | IN_MOVED_TO)          /**< Events marking a file as changed */
+#define WA_EVENT_BUF    (16u * (sizeof(struct inotify_event) + 256u))  /**< Size of the event read buffer */
+#define WA_CURRENT_DIR  "."                                      /**< Directory of a target without one */
+#define WA_PENDING_MIN  16u                                      /**< First capacity of the pending queue */
+#define WA_FNV_OFFSET   14695981039346656037ull                  /**< FNV-1a offset basis */
+#define WA_FNV_PRIME    1099511628211ull                         /**< FNV-1a prime */
+#define WA_NO_FILE      SIZE_MAX                                 /**< File index of a path that is no target file */
+
+/**
+ * @brief Watched directory
+ */
+typedef struct watch_dir_s
+{
+    int wd;            /**< inotify watch descriptor, -1 once removed */
+    char *path;        /**< Path of the directory */
+    int whole;         /**< Non-zero if the directory is a target, so every file in it is listed */
+} watch_dir_t;
+
+/**
+ * @brief Target file, watched through its directory
+ */
+typedef struct watch_file_s
+{
+    const char *path;   /**< Path as given */
+    const char *base;   /**< Name of the file within its directory */
+    size_t dir_idx;     /**< Index of its directory */
+    struct stat last;   /**< State when it was last listed */
+    int last_valid;     /**< Non-zero if last holds a state */
+} watch_file_t;
+
+/**
+ * @brief Changed path waiting for the burst to settle
+ */
+typedef struct watch_pending_s
+{
+    char *path;        /**< Path to list */
+    uint64_t hash;     /**< Hash of the path */
+    size_t file_idx;   /**< Index of the target file, WA_NO_FILE if none */
+} watch_pending_t;
+
+/**
+ * @brief Watcher state
+ */
+typedef struct watch_s
+{
+    int fd;                    /**< inotify descriptor */
+    watch_dir_t *dirs;         /**< Watched directories */
+    size_t dir_num;            /**< Number of directories */
+    watch_file_t *files;       /**< Target files */
+    size_t file_num;           /**< Number of target files */
+    watch_pending_t *pending;  /**< Changed paths waiting for the burst to settle */
+    size_t pending_num;        /**< Number of pending paths */
+    size_t pending_cap;        /**< Allocated pending paths */
+    size_t *slots;             /**< Hash set of the pending paths: index + 1, 0 if empty */
+    size_t slot_num;           /**< Number of slots, a power of two, twice pending_cap */
+} watch_t;
+
+/**
+ * @brief Copies at most the first len bytes of a string
+ * @param[in] str String to copy
+ * @param[in] len Number of bytes, room for at least len bytes and a null byte is allocated
+ * @return char* Null-terminated copy, or NULL on failure
+ */
+static char *watch_strDup(const char *str, size_t len)
+{
+    size_t str_len = strnlen(str, len);
+    char *copy;
+
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, len + 1);
+    copy = malloc(len + 1);
+    if (copy != NULL)
+    {
+        memcpy(copy, str, str_len);
+        copy[str_len] = '\0';
+    }
+    return copy;
+}
+
+/**
+ * @brief Watches a directory, or finds it among the watched ones
+ * @param[in,out] watch Watcher state
+ * @param[in] path Path of the directory, taken over by the watcher
+ * @param[in] whole Non-zero if the directory is a target
+ * @param[out] dir_idx Index of the directory
+ * @return int WA_SUCCESS on success, WA_ERR_WATCH_FAIL if it cannot be watched,
+ *             WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_dirAdd(watch_t *watch, char *path, int whole, size_t *dir_idx)
+{
+    watch_dir_t *new_dirs;
+    int wd = inotify_add_watch(watch->fd, path, WA_EVENT_MASK);
+
+    if (wd < 0)
+    {
+        free(path);
+        return WA_ERR_WATCH_FAIL;
+    }
+    for (size_t i = 0; i < watch->dir_num; i++)
+    {
+        if (watch->dirs[i].wd == wd)
+        {
+            watch->dirs[i].whole |= whole;  // Same directory reached through another path
+            *dir_idx = i;
+            free(path);
+            return WA_SUCCESS;
+        }
+    }
+    new_dirs = realloc(watch->dirs, (watch->dir_num + 1) * sizeof(watch_dir_t));
+    if (new_dirs == NULL)
+    {
+        free(path);
+        return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    watch->dirs = new_dirs;
+    watch->dirs[watch->dir_num] = (watch_dir_t){wd, path, whole};
+    *dir_idx = watch->dir_num++;
+    return WA_SUCCESS;
+}
+
+/**
+ * @brief Hashes a string with FNV-1a
+ * @param[in] str String to hash
+ * @return uint64_t Hash of the string
+ */
+static uint64_t watch_hash(const char *str)
+{
+    uint64_t hash = WA_FNV_OFFSET;
+
+    for (; *str != '\0'; str++)
+    {
+        hash ^= (unsigned char)*str;
+        hash *= WA_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds the slot of a path in the hash set of the pending paths
+ * @param[in] watch Watcher state, with a hash set allocated
+ * @param[in] path Path to find
+ * @param[in] hash Hash of the path
+ * @return size_t Slot holding the path, or the empty slot where it belongs
+ */
+static size_t watch_slotFind(const watch_t *watch, const char *path, uint64_t hash)
+{
+    size_t slot = (size_t)hash & (watch->slot_num - 1);
+
+    while (watch->slots[slot] != 0)
+    {
+        const watch_pending_t *entry = &watch->pending[watch->slots[slot] - 1];
+
+        if ((entry->hash == hash) && (strcmp(entry->path, path) == 0))
+        {
+            break;
+        }
+        slot = (slot + 1) & (watch->slot_num - 1);  // Linear probing
+    }
+    return slot;
+}
+
+/**
+ * @brief Doubles the pending queue and rebuilds its hash set
+ * @param[in,out] watch Watcher state
+ * @return int WA_SUCCESS on success, WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_pendingGrow(watch_t *watch)
+{
+    size_t new_cap = (watch->pending_cap == 0) ? WA_PENDING_MIN : watch->pending_cap * 2;
+    watch_pending_t *new_pending;
+    size_t *new_slots;
+
+    new_pending = realloc(watch->pending, new_cap * sizeof(watch_pending_t));
+    if (new_pending == NULL)
+    {
+        return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    watch->pending = new_pending;
+    new_slots = calloc(new_cap * 2, sizeof(size_t));  // At most half full
+    if (new_slots == NULL)
+    {
+        return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap * (sizeof(watch_pending_t) + 2 * sizeof(size_t)));
+    free(watch->slots);
+    watch->slots = new_slots;
+    watch->slot_num = new_cap * 2;
+    watch->pending_cap = new_cap;
+    for (size_t i = 0; i < watch->pending_num; i++)
+    {
+        watch->slots[watch_slotFind(watch, watch->pending[i].path, watch->pending[i].hash)] = i + 1;
+    }
+    return WA_SUCCESS;
+}
+
+/**
+ * @brief Queues a changed path unless it is already queued
+ * @param[in,out] watch Watcher state
+ * @param[in] dir Directory of the path, or NULL if path is complete
+ * @param[in] name Path, or name within dir
+ * @param[in] file_idx Index of the target file named by the path, WA_NO_FILE if unknown
+ * @return int WA_SUCCESS on success, WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_pendingAdd(watch_t *watch, const char *dir, const char *name, size_t file_idx)
+{
+    size_t dir_len = (dir != NULL) ? strlen(dir) : 0;
+    size_t name_len = strlen(name);
+    uint64_t hash;
+    size_t slot;
+    char *path;
+
+    path = (dir != NULL) ? watch_strDup(dir, dir_len + 1 + name_len) : watch_strDup(name, name_len);
+    if (path == NULL)
+    {
+        return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    if (dir != NULL)
+    {
+        path[dir_len] = '/';
+        memcpy(path + dir_len + 1, name, name_len + 1);
+    }
+    if ((watch->pending_num == watch->pending_cap) && (watch_pendingGrow(watch) != WA_SUCCESS))
+    {
+        free(path);
+        return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    hash = watch_hash(path);
+    slot = watch_slotFind(watch, path, hash);
+    if (watch->slots[slot] != 0)
+    {
+        watch_pending_t *entry = &watch->pending[watch->slots[slot] - 1];
+
+        if (entry->file_idx == WA_NO_FILE)
+        {
+            entry->file_idx = file_idx;  // Queued through its directory first
+        }
+        free(path);
+        return WA_SUCCESS;  // Already queued in this burst
+    }
+    watch->pending[watch->pending_num] = (watch_pending_t){path, hash, file_idx};
+    watch->slots[slot] = ++watch->pending_num;
+    return WA_SUCCESS;
+}
+
+/**
+ * @brief Lists the queued paths once a burst has settled
+ * @param[in,out] watch Watcher state
+ * @param[in] list Callback listing a changed file
+ * @param[in] arg Argument passed to list
+ */
+static void watch_pendingFlush(watch_t *watch, watch_list_f list, void *arg)
+{
+    for (size_t i = 0; i < watch->pending_num; i++)
+    {
+        size_t file_idx = watch->pending[i].file_idx;
+        watch_file_t *file = (file_idx != WA_NO_FILE) ? &watch->files[file_idx] : NULL;
+        struct stat now;
+
+        if ((file != NULL) && (stat(file->path, &now) == 0))
+        {
+            // Skip a target rewritten with the same content state
+            if (file->last_valid && (now.st_ino == file->last.st_ino) && (now.st_dev == file->last.st_dev) &&
+                (now.st_size == file->last.st_size) && (now.st_mtim.tv_sec == file->last.st_mtim.tv_sec) &&
+                (now.st_mtim.tv_nsec == file->last.st_mtim.tv_nsec))
+            {
+                free(watch->pending[i].path);
+                continue;
+            }
+            file->last = now;
+            file->last_valid = 1;
+        }
+        list(watch->pending[i].path, arg);
+        free(watch->pending[i].path);
+    }
+    if (watch->pending_num != 0)
+    {
+        memset(watch->slots, 0, watch->slot_num * sizeof(size_t));
+    }
+    watch->pending_num = 0;
+}
+
+/**
+ * @brief Queues every file of a target directory
+ * @param[in,out] watch Watcher state
+ * @param[in] dir Watched directory
+ * @return int WA_SUCCESS on success, or if the directory cannot be read,
+ *             WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_dirRescan(watch_t *watch, const watch_dir_t *dir)
+{
+    DIR *stream = opendir(dir->path);
+    struct dirent *entry;
+    int ret = WA_SUCCESS;
+
+    if (stream == NULL)
+    {
+        return WA_SUCCESS;  // Gone: its IN_IGNORED event follows
+    }
+    while ((ret == WA_SUCCESS) && ((entry = readdir(stream)) != NULL))
+    {
+        if ((entry->d_type == DT_REG) || (entry->d_type == DT_UNKNOWN))
+        {
+            ret = watch_pendingAdd(watch, dir->path, entry->d_name, WA_NO_FILE);
+        }
+    }
+    closedir(stream);
+    return ret;
+}
+
+/**
+ * @brief Queues every target after the event queue overflowed
+ *
+ * The lost events cannot be told apart, so every target file is queued and
+ * skipped by watch_pendingFlush if its state did not change, and every file
+ * of a target directory is listed again.
+ *
+ * @param[in,out] watch Watcher state
+ * @return int WA_SUCCESS on success, WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_rescan(watch_t *watch)
+{
+    int ret = WA_SUCCESS;
+
+    for (size_t i = 0; (i < watch->dir_num) && (ret == WA_SUCCESS); i++)
+    {
+        if ((watch->dirs[i].wd >= 0) && watch->dirs[i].whole)
+        {
+            ret = watch_dirRescan(watch, &watch->dirs[i]);
+        }
+    }
+    for (size_t i = 0; (i < watch->file_num) && (ret == WA_SUCCESS); i++)
+    {
+        ret = watch_pendingAdd(watch, NULL, watch->files[i].path, i);
+    }
+    return ret;
+}
+
+/**
+ * @brief Queues the paths named by a batch of inotify events
+ * @param[in,out] watch Watcher state
+ * @param[in] buf Events read from the inotify descriptor
+ * @param[in] len Number of bytes read
+ * @return int WA_SUCCESS on success, WA_ERR_WATCH_FAIL once no directory is left,
+ *             WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_eventsRead(watch_t *watch, const char *buf, size_t len)
+{
+    size_t off = 0;
+    int ret = WA_SUCCESS;
+
+    while ((off + sizeof(struct inotify_event) <= len) && (ret == WA_SUCCESS))
+    {
+        const struct inotify_event *event = (const struct inotify_event *)(buf + off);
+
+        off += sizeof(struct inotify_event) + event->len;
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+            ret = watch_rescan(watch);  // Events were dropped: look at everything
+            continue;
+        }
+        for (size_t i = 0; (i < watch->dir_num) && (ret == WA_SUCCESS); i++)
+        {
+            if (watch->dirs[i].wd != event->wd)
+            {
+                continue;
+            }
+            if (event->mask & IN_IGNORED)
+            {
+                watch->dirs[i].wd = -1;  // Directory removed or unmounted
+            }
+            else if ((event->len != 0) && (event->mask & WA_EVENT_MASK))
+            {
+                if (watch->dirs[i].whole)
+                {
+                    ret = watch_pendingAdd(watch, watch->dirs[i].path, event->name, WA_NO_FILE);
+                }
+                for (size_t j = 0; (j < watch->file_num) && (ret == WA_SUCCESS); j++)
+                {
+                    if ((watch->files[j].dir_idx == i) && (strcmp(watch->files[j].base, event->name) == 0))
+                    {
+                        ret = watch_pendingAdd(watch, NULL, watch->files[j].path, j);
+                    }
+                }
+            }
+        }
+    }
+    if (ret == WA_SUCCESS)
+    {
+        ret = WA_ERR_WATCH_FAIL;
+        for (size_t i = 0; i < watch->dir_num; i++)
+        {
+            if (watch->dirs[i].wd >= 0)
+            {
+                ret = WA_SUCCESS;  // Something is still watched
+            }
+        }
+        if (ret == WA_ERR_WATCH_FAIL)
+        {
+            errno = ENOENT;  // Every watched directory is gone
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Sets up the watches of every target
+ * @param[in,out] watch Watcher state
+ * @param[in] paths Target files and directories
+ * @param[in] path_num Number of paths
+ * @return int WA_SUCCESS if anything is watched, WA_ERR_WATCH_FAIL otherwise,
+ *             WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int watch_setup(watch_t *watch, char *const *paths, size_t path_num)
+{
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, path_num * sizeof(watch_file_t));
+    watch->files = malloc(path_num * sizeof(watch_file_t));
+    if (watch->files == NULL)
+    {
+        return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    for (size_t i = 0; i < path_num; i++)
+    {
+        struct stat st;
+        int is_dir = (stat(paths[i], &st) == 0) && S_ISDIR(st.st_mode);
+        const char *slash = strrchr(paths[i], '/');
+        watch_file_t *file = &watch->files[watch->file_num];
+        char *dir_path;
+        size_t dir_idx;
+        int ret;
+
+        if (is_dir)
+        {
+            dir_path = watch_strDup(paths[i], strlen(paths[i]));
+        }
+        else if (slash == NULL)
+        {
+            dir_path = watch_strDup(WA_CURRENT_DIR, strlen(WA_CURRENT_DIR));
+        }
+        else
+        {
+            dir_path = watch_strDup(paths[i], (slash == paths[i]) ? 1 : (size_t)(slash - paths[i]));  // Keep "/" for the root
+        }
+        if (dir_path == NULL)
+        {
+            return WA_ERR_MALLOC_FAIL;  // Memory allocation error
+        }
+        ret = watch_dirAdd(watch, dir_path, is_dir, &dir_idx);
+        if (ret == WA_ERR_MALLOC_FAIL)
+        {
+            return ret;
+        }
+        if ((ret != WA_SUCCESS) || is_dir)
+        {
+            continue;  // Directory cannot be watched, or is watched as a whole
+        }
+        file->path = paths[i];
+        file->base = (slash == NULL) ? paths[i] : slash + 1;
+        file->dir_idx = dir_idx;
+        file->last_valid = (stat(paths[i], &file->last) == 0);
+        watch->file_num++;
+    }
+    return (watch->dir_num != 0) ? WA_SUCCESS : WA_ERR_WATCH_FAIL;
+}
+
+/**
+ * @brief Watches the targets and lists the files that change, until nothing is left to watch
+ * @param[in] paths Target files and directories
+ * @param[in] path_num Number of paths
+ * @param[in] debounce_ms Quiet time closing a burst of changes
+ * @param[in] list Callback listing a changed file
+ * @param[in] arg Argument passed to list
+ * @return int WA_ERR_WATCH_FAIL once no watch is left or inotify fails,
+ *             WA_ERR_NULL_INPUT on invalid input, WA_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Watch_run(char *const *paths, size_t path_num, unsigned int debounce_ms, watch_list_f list, void *arg)
+{
+    watch_t watch = {0};
+    char buf[WA_EVENT_BUF] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int ret;
+
+    if ((paths == NULL) || (list == NULL) || (path_num == 0))
+    {
+        return WA_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    watch.fd = inotify_init1(IN_CLOEXEC);
+    if (watch.fd < 0)
+    {
+        return WA_ERR_WATCH_FAIL;
+    }
+    ret = watch_setup(&watch, paths, path_num);
+    while (ret == WA_SUCCESS)
+    {
+        struct pollfd pfd = {watch.fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, (watch.pending_num != 0) ? (int)debounce_ms : -1);
+
+        if (ready == 0)
+        {
+            watch_pendingFlush(&watch, list, arg);  // Burst settled
+        }
+        else if (ready < 0)
+        {
+            ret = (errno == EINTR) ? WA_SUCCESS : WA_ERR_WATCH_FAIL;
+        }
+        else
+        {
+            ssize_t len = read(watch.fd, buf, sizeof(buf));
+            if (len < 0)
+            {
+                ret = (errno == EINTR) ? WA_SUCCESS : WA_ERR_WATCH_FAIL;
+            }
+            else
+            {
+                ret = watch_eventsRead(&watch, buf, (size_t)len);
+            }
+        }
+    }
+    watch_pendingFlush(&watch, list, arg);  // List what changed before the last directory went away
+    for (size_t i = 0; i < watch.dir_num; i++)
+    {
+        free(watch.dirs[i].path);
+    }
+    free(watch.dirs);
+    free(watch.files);
+    free(watch.pending);
+    free(watch.slots);
+    close(watch.fd);
+    return ret;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file writer_ctx_priv.h
+ * @brief Private header for the writer context of the ft_nm writer module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header defines the writer context, which holds everything the writer
+ * module used to keep in globals: the section table and string table of the
+ * file being printed, its bit width, the size and debug options, the output
+ * buffer, the demangler contexts, the binary block being written, the
+ * output counters and the source location lookup of -l. It is intended for internal use only by writer module
+ * components.
+ */
+
+#ifndef _IG_WRITER_CTX_PRIV_
+#define _IG_WRITER_CTX_PRIV_
+
+#include "../inc_pub/writer.h"
+#include "../../Demangle/inc_pub/demangle.h"  // For demangle_ctx_t
+#include "writer_out_priv.h"
+#include <stdint.h>  // For uint*_t
+
+#define WRITER_DEMANGLE_THREADS_MAX   8u     /**< Most threads demangling a batch */
+
+/**
+ * @brief Growable byte buffer of a binary block
+ */
+typedef struct writer_binary_buf_s
+{
+    uint8_t *data;    /**< Buffer storage */
+    size_t len;       /**< Bytes used */
+    size_t cap;       /**< Bytes allocated */
+} writer_binary_buf_t;
+
+/**
+ * @brief State of the binary block being written
+ */
+typedef struct writer_binary_out_s
+{
+    const char *path;               /**< Input file path */
+    uint64_t record_count;          /**< Records appended so far */
+    writer_binary_buf_t records;    /**< Encoded records */
+    writer_binary_buf_t names;      /**< Name blob */
+    unsigned short active;          /**< Non-zero between begin and end */
+    int error;                      /**< First error of a line, returned by end instead of writing the block */
+} writer_binary_out_t;
+
+/**
+ * @brief Writer context
+ */
+struct writer_ctx_s
+{
+    const elfparser_secthead_entry_t *sects;  /**< Section header table of the file, or NULL */
+    uint32_t sect_cnt;                      /**< Number of sections of sects */
+    const char *strtab;                     /**< String table of the file, or NULL */
+    size_t strtab_len;                      /**< Length of strtab */
+    writer_bit_t bit_len;                   /**< Bit width of the file */
+    writer_size_e size_mode;                /**< Symbol size printing mode */
+    unsigned short debug_print;             /**< Non-zero to flag symbols of debug sections 'N' */
+    writer_out_t out;                       /**< Output buffer */
+    demangle_ctx_t *demangle[WRITER_DEMANGLE_THREADS_MAX]; /**< Demangler contexts, [0] also used for lazy demangling */
+    size_t demangle_cnt;                    /**< Number of demangler contexts, 0 when demangling is disabled */
+    writer_binary_out_t binary;             /**< Binary block being written */
+    uint64_t line_cnt;                      /**< Text lines printed */
+    writer_source_get_f source_get;         /**< Finds the source location printed after a line (-l), or NULL */
+    const void *source_arg;                 /**< Argument of source_get */
+};
+
+#endif /* _IG_WRITER_CTX_PRIV_ */
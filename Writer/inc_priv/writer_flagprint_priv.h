@@ -14,6 +14,7 @@
 #define _IG_WRITER_FLAGPRINT_PRIV_
 
 #include "../inc_pub/writer_flagprint.h"
+#include "writer_out_priv.h"
 
 #define FLAGPRINT_FLAG_ABSOLUTE             "A" /**< Flag for absolute symbols (reserved section index) */
 #define FLAGPRINT_FLAG_BSS_GLOBAL           "B" /**< Flag for global BSS section symbols (.bss) */
@@ -54,7 +55,9 @@
 #define FLAGPRINT_SH_NAME_DEBUG_ARR_LEN 1 /**< Length of FLAGPRINT_SH_NAME_DEBUG_ARR */
 
 /**
- * @brief Prints a symbol flag to stdout
+ * @brief Prints a symbol flag
+ * @param[in] ctx Writer context
+ * @param[in,out] out Output buffer
  * @param[in] bind Symbol binding type
  * @param[in] symbol_shidx Section header index for the symbol
  * @param[in] type Symbol type
@@ -62,6 +65,6 @@
  *             WR_ERR_WRITE_FAIL on complete write failure or index out of bounds,
  *             WR_ERR_WRITE_PARTIAL on partial write
  */
-int Writer_FlagPrint_print(writer_flagprint_bind_e bind, uint16_t symbol_shidx, writer_flagprint_type_e type);
+int Writer_FlagPrint_print(const writer_ctx_t *ctx, writer_out_t *out, writer_flagprint_bind_e bind, uint32_t symbol_shidx, writer_flagprint_type_e type);
 
 #endif /* _IG_WRITER_FLAGPRINT_PRIV_ */
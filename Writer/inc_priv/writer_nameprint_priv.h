@@ -13,11 +13,14 @@
 #ifndef _IG_WRITER_NAMEPRINT_PRIV_
 #define _IG_WRITER_NAMEPRINT_PRIV_
 
+#include "writer_out_priv.h"
+
 /**
  * @brief Prints a symbol name to stdout
+ * @param[in,out] out Output buffer
  * @param[in] name Null-terminated string containing the symbol name
  * @return int WR_SUCCESS on success, or error code (e.g., WR_ERR_WRITE_FAIL) on write failure
  */
-int Writer_NamePrint_print(char* name);
+int Writer_NamePrint_print(writer_out_t *out, const char* name);
 
 #endif /* _IG_WRITER_NAMEPRINT_PRIV_ */
@@ -0,0 +1,63 @@
+/**
+ * @file writer_out_priv.h
+ * @brief Private header for the output buffers of the ft_nm writer module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the buffers the text writer components format into.
+ * The buffer of a writer context is written out when it is full or by
+ * Writer_flush; chunk
+ * buffers grow instead, so a range of lines can be formatted on a worker
+ * thread and written out later in order. It is intended for internal use
+ * only by writer module components.
+ */
+
+#ifndef _IG_WRITER_OUT_PRIV_
+#define _IG_WRITER_OUT_PRIV_
+
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint64_t
+
+/**
+ * @brief Size of the buffer of a writer context in bytes
+ */
+#define WRITER_OUT_BUF_SIZE  65536u
+
+/**
+ * @brief Output buffer
+ */
+typedef struct writer_out_s
+{
+    char *buf;         /**< Buffered bytes */
+    size_t len;        /**< Number of buffered bytes */
+    size_t cap;        /**< Capacity of buf */
+    int fd;            /**< File descriptor the buffer is written to when full, or -1 to grow it */
+    uint64_t written;  /**< Bytes written to fd so far */
+} writer_out_t;
+
+/**
+ * @brief Appends bytes to an output buffer
+ *
+ * A buffer with a file descriptor is written out first if the bytes do not
+ * fit, and data larger than it is written directly; a buffer without one
+ * grows.
+ *
+ * @param[in,out] out Output buffer
+ * @param[in] data Bytes to append
+ * @param[in] len Number of bytes
+ * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
+ *             WR_ERR_WRITE_PARTIAL on partial write, WR_ERR_MALLOC_FAIL if a buffer
+ *             without file descriptor cannot grow
+ */
+int Writer_Out_write(writer_out_t *out, const void *data, size_t len);
+
+/**
+ * @brief Writes out the bytes held in an output buffer with a file descriptor
+ * @param[in,out] out Output buffer; emptied
+ * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
+ *             WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_Out_flush(writer_out_t *out);
+
+#endif /* _IG_WRITER_OUT_PRIV_ */
@@ -15,15 +15,17 @@
 
 #include <inttypes.h>
 #include "../inc_pub/writer.h"
+#include "writer_out_priv.h"
 
 /**
  * @brief Prints a symbol value to stdout in hexadecimal format
+ * @param[in,out] out Output buffer
  * @param[in] value 64-bit value to print
  * @param[in] is_undefined Flag indicating if the value is undefined
  * @param[in] bit_len Bit length (e.g., WRITER_BIT_32 or WRITER_BIT_64)
  * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
  *             WR_ERR_WRITE_PARTIAL on partial write, or WR_ERR_NULL_INPUT on invalid input
  */
-int Writer_ValuePrint_print(uint64_t value, uint8_t is_undefined, writer_bit_t bit_len);
+int Writer_ValuePrint_print(writer_out_t *out, uint64_t value, uint8_t is_undefined, writer_bit_t bit_len);
 
 #endif /* _IG_WRITER_VALUEPRINT_PRIV_ */
\ No newline at end of file
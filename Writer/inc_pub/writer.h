@@ -6,15 +6,18 @@
  * @version 1.0
  *
  * This header provides the public interface for the ft_nm writer module, which
- * handles printing symbol information to stdout. It includes error codes, data
- * structures for symbol lines, bit length specifications, and the primary printing
- * function.
+ * handles printing symbol information to a file descriptor. It includes error
+ * codes, data structures for symbol lines, bit length specifications, the
+ * writer context, and the primary printing function. All state lives in the
+ * writer context, so separate contexts can print on separate threads.
  */
 
 #ifndef _IG_WRITER_H_
 #define _IG_WRITER_H_
 
 #include "writer_flagprint.h"  // For writer_flagprint_bind_e, writer_flagprint_type_e
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint64_t
 
 /**
  * @brief Error codes for writer operations
@@ -23,7 +26,10 @@ enum Writer_Error {
     WR_SUCCESS = 0,          /**< Success */
     WR_ERR_NULL_INPUT = -1,  /**< Invalid input (NULL pointer) */
     WR_ERR_WRITE_FAIL = -2,  /**< Write operation failed completely */
-    WR_ERR_WRITE_PARTIAL = -3 /**< Write operation completed partially */
+    WR_ERR_WRITE_PARTIAL = -3, /**< Write operation completed partially */
+    WR_ERR_MALLOC_FAIL = -4,  /**< Memory allocation failed */
+    WR_ERR_BAD_FORMAT = -5,   /**< Input data is malformed */
+    WR_ERR_OVERFLOW = -6      /**< Output does not fit the fields of its format */
 };
 
 /**
@@ -33,9 +39,12 @@ typedef struct writre_line_s
 {
     writer_flagprint_bind_e bind;    /**< Symbol binding type (e.g., WRITER_FLAGPRINT_BIND_WEAK) */
     writer_flagprint_type_e type;    /**< Symbol type (e.g., WRITER_FLAGPRINT_TYPE_OBJECT) */
-    uint16_t sect_head_idx;          /**< Section header index for the symbol */
-    char *name;                      /**< Pointer to the symbol name (null-terminated) */
+    uint32_t sect_head_idx;          /**< Section header index for the symbol, extended indices resolved */
+    uint32_t name_off;               /**< Offset of the name in the loaded string table (st_name) */
+    const char *name;                /**< Pointer to the symbol name (null-terminated), or NULL to resolve name_off lazily */
     uint64_t value;                  /**< Symbol value (32-bit or 64-bit) */
+    uint64_t size;                   /**< Symbol size (st_size) */
+    const char *demangled;           /**< Name printed with -C, or NULL to demangle it when printed */
 } writer_line_t;
 
 /**
@@ -48,12 +57,191 @@ typedef enum
 } writer_bit_t;
 
 /**
- * @brief Prints a symbol line to stdout
+ * @brief Enumeration of symbol size printing modes
+ */
+typedef enum
+{
+    WRITER_SIZE_NONE     = 0U, /**< Sizes are not printed */
+    WRITER_SIZE_COLUMN   = 1U, /**< Size column after the value of sized defined symbols (-S) */
+    WRITER_SIZE_AS_VALUE = 2U  /**< Size printed in place of the value (--size-sort without -S) */
+} writer_size_e;
+
+/**
+ * @brief Output counters of a writer context
+ */
+typedef struct writer_counters_s
+{
+    uint64_t line_cnt;  /**< Text lines printed */
+    uint64_t byte_cnt;  /**< Bytes written to the file descriptor */
+} writer_counters_t;
+
+/**
+ * @brief Source location printed after a symbol line (-l)
+ *
+ * The path printed is made of the parts that are not NULL, joined with '/'.
+ */
+typedef struct writer_source_s
+{
+    const char *comp_dir;  /**< Compilation directory, or NULL */
+    const char *dir;       /**< Directory of the file, or NULL */
+    const char *file;      /**< File name */
+    uint32_t line;         /**< Line number */
+} writer_source_t;
+
+/**
+ * @brief Finds the source location of a symbol line
+ * @param[in] line Symbol line
+ * @param[out] source Source location of the line
+ * @param[in] arg Argument given to Writer_sourceSet
+ * @return int Non-zero if the line has a source location, 0 otherwise
+ */
+typedef int (*writer_source_get_f)(const writer_line_t *line, writer_source_t *source, const void *arg);
+
+/**
+ * @brief Creates a writer context
+ *
+ * The context starts with no file loaded, 64-bit values, sizes not printed,
+ * debug flags and demangling disabled, and an empty output buffer.
+ *
+ * @param[out] ctx Created context
+ * @param[in] fd File descriptor the output goes to
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL,
+ *             WR_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Writer_ctxCreate(writer_ctx_t **ctx, int fd);
+
+/**
+ * @brief Frees a writer context and its demangler contexts
+ *
+ * Output still held in the buffer is dropped; call Writer_flush first.
+ *
+ * @param[in,out] ctx Context to free; set to NULL
+ */
+void Writer_ctxFree(writer_ctx_t **ctx);
+
+/**
+ * @brief Sets the bit width values are printed with
+ * @param[in,out] ctx Writer context
+ * @param[in] bit_len Bit width of the file (WRITER_VALUEPRINT_32BIT or WRITER_VALUEPRINT_64BIT)
+ */
+void Writer_bitLenSet(writer_ctx_t *ctx, writer_bit_t bit_len);
+
+/**
+ * @brief Selects how symbol sizes are printed by Writer_linePrint
+ * @param[in,out] ctx Writer context
+ * @param[in] mode Size printing mode
+ */
+void Writer_sizeModeSet(writer_ctx_t *ctx, writer_size_e mode);
+
+/**
+ * @brief Sets the function finding the source location printed after each line (-l)
+ *
+ * Lines with a source location are printed with a tab, the path and
+ * ":line" after the name. The function is called from the formatting
+ * threads of Writer_rangePrint and must only read shared data.
+ *
+ * @param[in,out] ctx Writer context
+ * @param[in] source_get Function finding the location of a line, or NULL to print none
+ * @param[in] arg Argument of source_get
+ */
+void Writer_sourceSet(writer_ctx_t *ctx, writer_source_get_f source_get, const void *arg);
+
+/**
+ * @brief Returns the output counters of a writer context
+ * @param[in] ctx Writer context
+ * @param[out] counters Lines printed and bytes written so far
+ */
+void Writer_countersGet(const writer_ctx_t *ctx, writer_counters_t *counters);
+
+/**
+ * @brief Returns the name of a symbol line
+ *
+ * Lines with a NULL name are resolved from name_off against the string table
+ * loaded with Writer_NamePrint_strTableLoad; the result is a view into it.
+ *
+ * @param[in] ctx Writer context
+ * @param[in] line Pointer to the writer_line_t structure
+ * @return const char* Null-terminated symbol name, or NULL if ctx or line is NULL
+ *                     or name_off lies outside the loaded string table
+ */
+const char *Writer_lineNameGet(const writer_ctx_t *ctx, const writer_line_t *line);
+
+/**
+ * @brief Returns the name printed for a symbol line
+ *
+ * With demangling enabled (Writer_NamePrint_demangleEnable) this is the
+ * demangled name, taken from line->demangled when it was demangled ahead,
+ * or the name itself if it is not a C++ name; otherwise it is the name
+ * returned by Writer_lineNameGet.
+ *
+ * @param[in,out] ctx Writer context; its demangler demangles the name if needed
+ * @param[in] line Pointer to the writer_line_t structure
+ * @return const char* Null-terminated name, or NULL if ctx or line is NULL or
+ *                     its name cannot be resolved
+ */
+const char *Writer_lineDisplayNameGet(writer_ctx_t *ctx, const writer_line_t *line);
+
+/**
+ * @brief Prints a symbol line
+ *
+ * The line is formatted into the buffer of the context, which is only
+ * written out when it is full or by Writer_flush; write errors are reported
+ * by the call that writes the buffer out.
+ *
+ * @param[in,out] ctx Writer context
  * @param[in] line Pointer to the writer_line_t structure containing symbol data
- * @param[in] bit_len Bit length for value formatting (WRITER_VALUEPRINT_32BIT or WRITER_VALUEPRINT_64BIT)
  * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input,
  *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
  */
-int Writer_linePrint(const writer_line_t *line, writer_bit_t bit_len);
+int Writer_linePrint(writer_ctx_t *ctx, const writer_line_t *line);
+
+/**
+ * @brief Reads the symbol line at a position of a range printed by Writer_rangePrint
+ * @param[in] pos Position in the range, from 0
+ * @param[out] line Line at that position
+ * @param[in] arg Argument given to Writer_rangePrint
+ */
+typedef void (*writer_line_get_f)(size_t pos, writer_line_t *line, const void *arg);
+
+/**
+ * @brief Most threads formatting a range in Writer_rangePrint
+ */
+#define WRITER_RANGE_THREADS_MAX  64u
+
+/**
+ * @brief Prints an ordered range of symbol lines
+ *
+ * With more than one thread, the range is cut into chunks of consecutive
+ * positions; each thread formats a chunk into its own buffer, and the
+ * buffers are appended to the buffer of the context in position order, so the output
+ * is the same as printing the lines one by one. line_get is called from
+ * several threads at once and must only read shared data; with demangling
+ * enabled, it must set the demangled name of every line, since the writer's
+ * own demangler context is not shared. A chunk whose buffer cannot grow is
+ * printed on the calling thread instead.
+ *
+ * @param[in,out] ctx Writer context
+ * @param[in] line_cnt Number of lines of the range
+ * @param[in] line_get Reads the line at a position of the range
+ * @param[in] arg Argument of line_get
+ * @param[in] thread_cnt Number of formatting threads, at most WRITER_RANGE_THREADS_MAX; 0 uses one
+ *            thread per online CPU for large ranges and a single thread otherwise
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_rangePrint(writer_ctx_t *ctx, size_t line_cnt, writer_line_get_f line_get, const void *arg,
+                      size_t thread_cnt);
+
+/**
+ * @brief Writes out the symbol lines held in the buffer of a writer context
+ *
+ * Called once the lines of a file are printed, before anything else is
+ * written to the file descriptor of the context.
+ *
+ * @param[in,out] ctx Writer context
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_flush(writer_ctx_t *ctx);
 
 #endif /* _IG_WRITER_H_ */
@@ -0,0 +1,179 @@
+/**
+ * @file writer_binary.h
+ * @brief Public header for the ft_nm binary output format and its reader
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header defines the versioned binary record stream written by
+ * ft_nm --format=binary, the writer functions that produce it and a small
+ * reader for downstream tools. All integers are little-endian.
+ *
+ * @section layout Stream layout
+ * The stream is a sequence of per-file blocks. Each block is:
+ * - a header of header_size bytes (WRITER_BINARY_HEADER_SIZE in version 1)
+ * - path_len bytes of the input file path, not null-terminated
+ * - record_count records of record_size bytes each
+ * - name_blob_len bytes of null-terminated symbol names
+ *
+ * Readers must step over headers and records using header_size and
+ * record_size, so later versions can append fields without breaking them.
+ *
+ * @section header Header (version 1)
+ * | offset | size | field                                    |
+ * |--------|------|------------------------------------------|
+ * | 0      | 4    | magic "FTNM"                             |
+ * | 4      | 2    | version                                  |
+ * | 6      | 2    | header_size                              |
+ * | 8      | 2    | record_size                              |
+ * | 10     | 1    | bit width of the input (32 or 64)        |
+ * | 11     | 1    | reserved                                 |
+ * | 12     | 4    | path_len                                 |
+ * | 16     | 8    | record_count                             |
+ * | 24     | 8    | name_blob_len                            |
+ *
+ * @section record Record (version 1)
+ * | offset | size | field                                    |
+ * |--------|------|------------------------------------------|
+ * | 0      | 8    | value                                    |
+ * | 8      | 4    | name offset in the name blob             |
+ * | 12     | 4    | section header index                     |
+ * | 16     | 1    | bind (writer_flagprint_bind_e)           |
+ * | 17     | 1    | type (writer_flagprint_type_e)           |
+ * | 18     | 1    | flag character as printed in text mode   |
+ * | 19     | 5    | reserved                                 |
+ *
+ * A reserved section index (SHN_ABS, SHN_COMMON) is written with
+ * WRITER_FLAGPRINT_SHIDX_RESERVED set, apart from real sections numbered
+ * 0xff00 and up.
+ */
+
+#ifndef _IG_WRITER_BINARY_H_
+#define _IG_WRITER_BINARY_H_
+
+#include "writer.h"    // For writer_line_t, writer_bit_t
+#include <stddef.h>    // For size_t
+#include <stdint.h>    // For uint*_t
+
+#define WRITER_BINARY_MAGIC         "FTNM" /**< Magic bytes at the start of every block */
+#define WRITER_BINARY_MAGIC_LEN     4u     /**< Length of WRITER_BINARY_MAGIC */
+#define WRITER_BINARY_VERSION       1u     /**< Version written by this implementation */
+#define WRITER_BINARY_HEADER_SIZE   32u    /**< Size of a version 1 header */
+#define WRITER_BINARY_RECORD_SIZE   24u    /**< Size of a version 1 record */
+
+/**
+ * @brief Decoded block header
+ */
+typedef struct writer_binary_header_s
+{
+    uint16_t version;        /**< Format version */
+    uint16_t header_size;    /**< Size of the encoded header */
+    uint16_t record_size;    /**< Size of one encoded record */
+    uint8_t bit_width;       /**< Bit width of the input file (32 or 64) */
+    uint32_t path_len;       /**< Length of the input file path */
+    uint64_t record_count;   /**< Number of records */
+    uint64_t name_blob_len;  /**< Length of the name blob */
+} writer_binary_header_t;
+
+/**
+ * @brief Decoded symbol record
+ */
+typedef struct writer_binary_record_s
+{
+    uint64_t value;          /**< Symbol value */
+    uint32_t name_off;       /**< Offset of the name in the name blob */
+    uint32_t sect_head_idx;  /**< Section header index */
+    uint8_t bind;            /**< Symbol binding (writer_flagprint_bind_e) */
+    uint8_t type;            /**< Symbol type (writer_flagprint_type_e) */
+    char flag;               /**< Flag character as printed in text mode */
+} writer_binary_record_t;
+
+/**
+ * @brief One block located by the reader
+ */
+typedef struct writer_binary_block_s
+{
+    writer_binary_header_t header;  /**< Decoded header */
+    const char *path;               /**< Input file path, path_len bytes, not null-terminated */
+    const uint8_t *records;         /**< First encoded record */
+    const char *name_blob;          /**< Name blob */
+} writer_binary_block_t;
+
+/**
+ * @brief Reader state over an in-memory stream
+ */
+typedef struct writer_binary_reader_s
+{
+    const uint8_t *buf;  /**< Stream start */
+    size_t len;          /**< Stream length */
+    size_t pos;          /**< Offset of the next block */
+} writer_binary_reader_t;
+
+/**
+ * @brief Starts a binary block for one input file
+ *
+ * The header records the bit width set with Writer_bitLenSet when the block
+ * is ended.
+ *
+ * @param[in,out] ctx Writer context
+ * @param[in] path Path of the input file
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx or path is NULL
+ */
+int Writer_BinaryPrint_begin(writer_ctx_t *ctx, const char *path);
+
+/**
+ * @brief Appends one symbol line to the current binary block
+ *
+ * A failed line leaves the block as it was and is remembered: later lines
+ * are ignored and Writer_BinaryPrint_end returns the error without writing
+ * the block, so a stream is never written with records missing.
+ *
+ * @param[in,out] ctx Writer context
+ * @param[in] line Pointer to the writer_line_t structure containing symbol data
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input or if
+ *             no block was started, WR_ERR_MALLOC_FAIL on allocation failure,
+ *             WR_ERR_OVERFLOW if the name blob would pass 4 GiB,
+ *             WR_ERR_WRITE_FAIL if the flag cannot be determined
+ */
+int Writer_BinaryPrint_line(writer_ctx_t *ctx, const writer_line_t *line);
+
+/**
+ * @brief Writes the current binary block to the file descriptor of the context and releases its buffers
+ * @param[in,out] ctx Writer context
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL or no block was started,
+ *             the first error of Writer_BinaryPrint_line if a line failed (nothing is written),
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_BinaryPrint_end(writer_ctx_t *ctx);
+
+/**
+ * @brief Initializes a reader over an in-memory binary stream
+ * @param[out] reader Reader to initialize
+ * @param[in] buf Stream data
+ * @param[in] len Stream length
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if reader or buf is NULL
+ */
+int Writer_BinaryRead_init(writer_binary_reader_t *reader, const void *buf, size_t len);
+
+/**
+ * @brief Locates and validates the next block of the stream
+ * @param[in,out] reader Reader state; advanced past the block on success
+ * @param[out] block Located block
+ * @return int 1 if a block was read, 0 at end of stream, WR_ERR_NULL_INPUT on
+ *             invalid input, WR_ERR_BAD_FORMAT if the stream is malformed
+ */
+int Writer_BinaryRead_blockNext(writer_binary_reader_t *reader, writer_binary_block_t *block);
+
+/**
+ * @brief Decodes one record of a block
+ * @param[in] block Block returned by Writer_BinaryRead_blockNext
+ * @param[in] idx Record index, below header.record_count
+ * @param[out] record Decoded record
+ * @param[out] name Optional; set to the record's null-terminated name
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input or index,
+ *             WR_ERR_BAD_FORMAT if the name offset is out of bounds
+ */
+int Writer_BinaryRead_recordGet(const writer_binary_block_t *block, uint64_t idx,
+                                writer_binary_record_t *record, const char **name);
+
+#endif /* _IG_WRITER_BINARY_H_ */
@@ -12,7 +12,7 @@
  * data and debug output.
  *
  * @section dependencies Dependencies
- * - elfparser_secthead.h: For elfparser_secthead_t structure
+ * - elfparser_secthead.h: For elfparser_secthead_entry_t structure
  * - elfparser_symtable.h: For ELFPARSER_SYMTABLE_* constants
  *
  * @section enums Enumerations
@@ -26,9 +26,17 @@
 #ifndef _IG_WRITER_FLAGPRINT_
 #define _IG_WRITER_FLAGPRINT_
 
-#include "../../ElfParser/inc_pub/elfparser_secthead.h" // For elfparser_secthead_t
+#include "../../ElfParser/inc_pub/elfparser_secthead.h" // For elfparser_secthead_entry_t
 #include "../../ElfParser/inc_pub/elfparser_symtable.h"  // For ELFPARSER_SYMTABLE_* constants
 
+/**
+ * @brief Writer context, created with Writer_ctxCreate (writer.h)
+ *
+ * Holds the tables of the file being printed, the print options and the
+ * output buffer; every writer function works on the context it is given.
+ */
+typedef struct writer_ctx_s writer_ctx_t;
+
 /**
  * @brief Enumeration of symbol binding types for flag printing
  * @enum writer_flagprint_bind_e
@@ -59,30 +67,73 @@ typedef enum
     WRITER_FLAGPRINT_TYPE_GNU     = ELFPARSER_SYMTABLE_TYPE_GNU_IFUNC  /**< GNU indirect function symbol type (STT_GNU_IFUNC) */
 } writer_flagprint_type_e;
 
-/* Special Section Index Values (st_shndx) */
-#define WRITER_FLAGPRINT_SHIDX_UNDEFINED  0u      /**< Undefined section index (SHN_UNDEF) */
-#define WRITER_FLAGPRINT_SHIDX_ABSOLUTE   0xfff1u /**< Absolute value section index (SHN_ABS) */
-#define WRITER_FLAGPRINT_SHIDX_COMMON     0xfff2u /**< Common symbol section index (SHN_COMMON) */
+/* Special Section Index Values (st_shndx); a line moves the reserved ones past every section index */
+#define WRITER_FLAGPRINT_SHIDX_UNDEFINED  0u           /**< Undefined section index (SHN_UNDEF) */
+#define WRITER_FLAGPRINT_SHIDX_LORESERVE  0xff00u      /**< First reserved index of st_shndx (SHN_LORESERVE) */
+#define WRITER_FLAGPRINT_SHIDX_RESERVED   0xffff0000u  /**< Bits set in the reserved index of a line */
+#define WRITER_FLAGPRINT_SHIDX_ABSOLUTE   0xfffffff1u  /**< Absolute value section index of a line (SHN_ABS) */
+#define WRITER_FLAGPRINT_SHIDX_COMMON     0xfffffff2u  /**< Common symbol section index of a line (SHN_COMMON) */
+#define WRITER_FLAGPRINT_SHIDX_XINDEX     0xffffu      /**< Index held in the extended index table (SHN_XINDEX) */
 
 /**
  * @brief Loads section header data for flag printing
- * @param[in] sect_head Pointer to the section header structure from libelfparser
+ * @param[in,out] ctx Writer context
+ * @param[in] sects Section headers of the file, with names resolved; kept until unloaded
+ * @param[in] sect_cnt Number of sections
+ */
+void Writer_FlagPrint_sectionHeadLoad(writer_ctx_t *ctx, const elfparser_secthead_entry_t *sects, uint32_t sect_cnt);
+
+/**
+ * @brief Unloads section header data from a writer context
+ * @param[in,out] ctx Writer context
  */
-void Writer_FlagPrint_sectionHeadLoad(const elfparser_secthead_t *sect_head);
+void Writer_FlagPrint_sectionHeadUnload(writer_ctx_t *ctx);
 
 /**
- * @brief Unloads section header data, resetting internal state
+ * @brief Determines the flag character of a symbol
+ *
+ * The section headers of the symbol's file must be loaded in the context
+ * with Writer_FlagPrint_sectionHeadLoad.
+ *
+ * @param[in] ctx Writer context
+ * @param[in] bind Symbol binding type
+ * @param[in] symbol_shidx Section header index for the symbol
+ * @param[in] type Symbol type
+ * @param[out] flag Flag character of the symbol
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if section table or flag is NULL,
+ *             WR_ERR_WRITE_FAIL if index is out of bounds
+ */
+int Writer_FlagPrint_flagGet(const writer_ctx_t *ctx, writer_flagprint_bind_e bind, uint32_t symbol_shidx, writer_flagprint_type_e type, char *flag);
+
+/**
+ * @brief Determines the flag character of a symbol against the given section headers
+ *
+ * Unlike Writer_FlagPrint_flagGet, no writer context is needed; debug
+ * section symbols get the flag of an unknown section.
+ *
+ * @param[in] sects Section headers of the symbol's file
+ * @param[in] sect_cnt Number of sections
+ * @param[in] bind Symbol binding type
+ * @param[in] symbol_shidx Section header index for the symbol
+ * @param[in] type Symbol type
+ * @param[out] flag Flag character of the symbol
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if sects or flag is NULL,
+ *             WR_ERR_WRITE_FAIL if index is out of bounds
  */
-void Writer_FlagPrint_sectionHeadUnload(void);
+int Writer_FlagPrint_flagFind(const elfparser_secthead_entry_t *sects, uint32_t sect_cnt,
+                              writer_flagprint_bind_e bind, uint32_t symbol_shidx, writer_flagprint_type_e type,
+                              char *flag);
 
 /**
  * @brief Enables printing of debug symbols
+ * @param[in,out] ctx Writer context
  */
-void Writer_FlagPrint_enableDebug(void);
+void Writer_FlagPrint_enableDebug(writer_ctx_t *ctx);
 
 /**
  * @brief Disables printing of debug symbols
+ * @param[in,out] ctx Writer context
  */
-void Writer_FlagPrint_disableDebug(void);
+void Writer_FlagPrint_disableDebug(writer_ctx_t *ctx);
 
 #endif /* _IG_WRITER_FLAGPRINT_ */
\ No newline at end of file
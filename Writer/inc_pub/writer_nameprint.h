@@ -0,0 +1,76 @@
+/**
+ * @file writer_nameprint.h
+ * @brief Public header for symbol name resolution in the ft_nm writer module
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This header declares the functions that load the symbol string table used
+ * to resolve symbol names lazily. Symbol lines carry the raw st_name offset and
+ * are turned into a name only when the sort key or the writer needs it. It also
+ * declares the C++ demangling (-C) of printed names, which can be done ahead
+ * of the writer on several threads.
+ */
+
+#ifndef _IG_WRITER_NAMEPRINT_
+#define _IG_WRITER_NAMEPRINT_
+
+#include "writer.h"  // For writer_line_t
+#include <stddef.h>  // For size_t
+
+/**
+ * @brief Loads the symbol string table used to resolve symbol names
+ * @param[in,out] ctx Writer context
+ * @param[in] strtab Mapped string table; must stay mapped until unloaded
+ * @param[in] strtab_len Length of the string table, strtab[strtab_len - 1] must be '\0'
+ */
+void Writer_NamePrint_strTableLoad(writer_ctx_t *ctx, const char *strtab, size_t strtab_len);
+
+/**
+ * @brief Unloads the symbol string table, releasing the names demangled for it
+ * @param[in,out] ctx Writer context
+ */
+void Writer_NamePrint_strTableUnload(writer_ctx_t *ctx);
+
+/**
+ * @brief Enables demangling of the printed symbol names
+ * @param[in,out] ctx Writer context
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL,
+ *             WR_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Writer_NamePrint_demangleEnable(writer_ctx_t *ctx);
+
+/**
+ * @brief Demangles the names of symbol lines ahead of printing
+ *
+ * Large batches are split across up to eight threads, one per online CPU,
+ * each with its own demangler context and memo cache. Results are stored in
+ * line->demangled and stay valid until the string table is unloaded. Does
+ * nothing when demangling is not enabled.
+ *
+ * @param[in,out] ctx Writer context; demangler contexts are added for the threads
+ * @param[in,out] lines Symbol lines to demangle
+ * @param[in] line_cnt Number of lines
+ */
+void Writer_NamePrint_demangleAhead(writer_ctx_t *ctx, writer_line_t *const *lines, size_t line_cnt);
+
+/**
+ * @brief Demangles an array of symbol names in place ahead of printing
+ *
+ * Works like Writer_NamePrint_demangleAhead for symbols that are not held as
+ * lines: each name is replaced by its demangled form, or kept if it is not a
+ * C++ name. Results stay valid until the string table is unloaded.
+ *
+ * @param[in,out] ctx Writer context; demangler contexts are added for the threads
+ * @param[in,out] names Names to demangle
+ * @param[in] name_cnt Number of names
+ */
+void Writer_NamePrint_demangleNames(writer_ctx_t *ctx, const char **names, size_t name_cnt);
+
+/**
+ * @brief Frees the demangler contexts, disabling demangling
+ * @param[in,out] ctx Writer context
+ */
+void Writer_NamePrint_demangleFree(writer_ctx_t *ctx);
+
+#endif /* _IG_WRITER_NAMEPRINT_ */
@@ -7,13 +7,24 @@
  *
  * This file contains basic functions for printing symbol information
  * in ft_nm, formatting and outputting symbol values, flags, and names
- * to stdout with appropriate spacing and newlines.
+ * to the buffer of a writer context with appropriate spacing and newlines,
+ * and the functions creating and configuring writer contexts. Large ranges
+ * of lines are formatted in chunks on several threads, each chunk into its
+ * own buffer, and the chunks are appended to the context buffer in order.
  */
 
 #include "../inc_pub/writer.h"
 #include "../inc_priv/writer_valueprint_priv.h"
 #include "../inc_priv/writer_flagprint_priv.h"
 #include "../inc_priv/writer_nameprint_priv.h"
+#include "../inc_priv/writer_out_priv.h"
+#include "../inc_priv/writer_ctx_priv.h"
+#include "../inc_pub/writer_nameprint.h"
+#include "../../Stats/inc_pub/stats.h"
+#include "../../Probe/inc_pub/probe.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 /**
@@ -23,60 +34,405 @@
 #define SPACE_LEN 1    /**< Length of space string */
 #define NL_STR "\n"    /**< Newline string */
 #define NL_LEN 1       /**< Length of newline string */
+#define TAB_STR "\t"   /**< Tab string, before the source location */
+#define TAB_LEN 1      /**< Length of tab string */
+#define LINE_DIGITS_MAX 10u  /**< Most decimal digits of a line number */
 
+#define WRITER_RANGE_CHUNK         16384u  /**< Lines formatted by one thread in one round */
+#define WRITER_RANGE_PARALLEL_MIN  65536u  /**< Fewest lines formatted on several threads when the thread count is not set */
+#define WRITER_RANGE_AUTO_MAX      8u      /**< Most threads picked when the thread count is not set */
 
+/**
+ * @brief Chunk of a range formatted by one thread
+ */
+typedef struct writer_range_job_s
+{
+    writer_ctx_t *ctx;           /**< Writer context of the range */
+    writer_line_get_f line_get;  /**< Reads the line at a position of the range */
+    const void *arg;             /**< Argument of line_get */
+    size_t first;                /**< First position of the chunk */
+    size_t end;                  /**< Position past the last one of the chunk */
+    writer_out_t out;            /**< Buffer of the chunk, kept across rounds */
+    int ret;                     /**< Result of the formatting */
+} writer_range_job_t;
 
 /**
- * @brief Prints a symbol line to stdout
+ * @brief Creates a writer context
+ * @param[out] ctx Created context
+ * @param[in] fd File descriptor the output goes to
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL,
+ *             WR_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Writer_ctxCreate(writer_ctx_t **ctx, int fd)
+{
+    writer_ctx_t *new_ctx;
+
+    if (ctx == NULL)
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(writer_ctx_t) + WRITER_OUT_BUF_SIZE);
+    new_ctx = malloc(sizeof(writer_ctx_t));
+    if (new_ctx == NULL)
+    {
+        return WR_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    memset(new_ctx, 0, sizeof(writer_ctx_t));
+    new_ctx->out.buf = malloc(WRITER_OUT_BUF_SIZE);
+    if (new_ctx->out.buf == NULL)
+    {
+        free(new_ctx);
+        return WR_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    new_ctx->out.cap = WRITER_OUT_BUF_SIZE;
+    new_ctx->out.fd = fd;
+    new_ctx->bit_len = WRITER_VALUEPRINT_64BIT;
+    new_ctx->size_mode = WRITER_SIZE_NONE;
+    *ctx = new_ctx;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Frees a writer context and its demangler contexts
+ * @param[in,out] ctx Context to free; set to NULL
+ */
+void Writer_ctxFree(writer_ctx_t **ctx)
+{
+    if ((ctx == NULL) || (*ctx == NULL))
+    {
+        return;
+    }
+    Writer_NamePrint_demangleFree(*ctx);
+    free((*ctx)->binary.records.data);
+    free((*ctx)->binary.names.data);
+    free((*ctx)->out.buf);
+    free(*ctx);
+    *ctx = NULL;
+}
+
+/**
+ * @brief Sets the bit width values are printed with
+ * @param[in,out] ctx Writer context
+ * @param[in] bit_len Bit width of the file
+ */
+void Writer_bitLenSet(writer_ctx_t *ctx, writer_bit_t bit_len)
+{
+    ctx->bit_len = bit_len;  // Set bit width of the context
+}
+
+/**
+ * @brief Selects how symbol sizes are printed by Writer_linePrint
+ * @param[in,out] ctx Writer context
+ * @param[in] mode Size printing mode
+ */
+void Writer_sizeModeSet(writer_ctx_t *ctx, writer_size_e mode)
+{
+    ctx->size_mode = mode;  // Set size printing mode of the context
+}
+
+/**
+ * @brief Sets the function finding the source location printed after each line (-l)
+ * @param[in,out] ctx Writer context
+ * @param[in] source_get Function finding the location of a line, or NULL to print none
+ * @param[in] arg Argument of source_get
+ */
+void Writer_sourceSet(writer_ctx_t *ctx, writer_source_get_f source_get, const void *arg)
+{
+    ctx->source_get = source_get;  // Set source location lookup of the context
+    ctx->source_arg = arg;         // Set its argument
+}
+
+/**
+ * @brief Returns the output counters of a writer context
+ * @param[in] ctx Writer context
+ * @param[out] counters Lines printed and bytes written so far
+ */
+void Writer_countersGet(const writer_ctx_t *ctx, writer_counters_t *counters)
+{
+    counters->line_cnt = ctx->line_cnt;
+    counters->byte_cnt = ctx->out.written;
+}
+
+/**
+ * @brief Formats the source location of a symbol line as "\tpath:line"
+ * @param[in,out] out Output buffer
+ * @param[in] source Source location
+ * @return int WR_SUCCESS on success, or error code on write failure
+ */
+static int writer_sourceFormat(writer_out_t *out, const writer_source_t *source)
+{
+    const char *parts[3] = {source->comp_dir, source->dir, source->file};
+    char digits[LINE_DIGITS_MAX + 1];
+    size_t pos = sizeof(digits);
+    uint32_t line = source->line;
+    int ret_val = Writer_Out_write(out, TAB_STR, TAB_LEN);
+    unsigned short first = 1;
+
+    for (size_t i = 0; (i < (sizeof(parts) / sizeof(parts[0]))) && (ret_val == WR_SUCCESS); i++)
+    {
+        if (parts[i] == NULL)
+        {
+            continue;
+        }
+        if (!first)
+        {
+            ret_val = Writer_Out_write(out, "/", 1);  // Separate the parts of the path
+        }
+        if (ret_val == WR_SUCCESS)
+        {
+            ret_val = Writer_Out_write(out, parts[i], strlen(parts[i]));
+        }
+        first = 0;
+    }
+    do
+    {
+        digits[--pos] = (char)('0' + (line % 10));
+        line /= 10;
+    } while (line != 0);
+    digits[--pos] = ':';
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_write(out, &digits[pos], sizeof(digits) - pos);
+    }
+    return ret_val;
+}
+
+/**
+ * @brief Formats the size column of a symbol line (-S)
+ *
+ * The column is left out for undefined symbols and symbols without a size,
+ * as binutils nm does.
+ *
+ * @param[in] ctx Writer context
+ * @param[in,out] out Output buffer
+ * @param[in] line Pointer to the writer_line_t structure containing symbol data
+ * @param[in] is_undefined Non-zero if the symbol is undefined
+ * @return int WR_SUCCESS on success or if no column is printed,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+static int writer_sizeColumnFormat(const writer_ctx_t *ctx, writer_out_t *out, const writer_line_t *line,
+                                   uint8_t is_undefined)
+{
+    int ret_val;
+
+    if ((ctx->size_mode != WRITER_SIZE_COLUMN) || is_undefined || (line->size == 0))
+    {
+        return WR_SUCCESS;  // No size column for this line
+    }
+    ret_val = Writer_ValuePrint_print(out, line->size, 0, ctx->bit_len);  // Print symbol size
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_write(out, SPACE_STR, SPACE_LEN);  // Add space after size
+    }
+    return ret_val;
+}
+
+/**
+ * @brief Formats a symbol line into an output buffer
+ * @param[in,out] ctx Writer context; only read unless the name is demangled lazily
+ * @param[in,out] out Output buffer
  * @param[in] line Pointer to the writer_line_t structure containing symbol data
- * @param[in] bit_len Bit length for value formatting (e.g., WRITER_BIT_32 or WRITER_BIT_64)
  * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input,
  *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write,
  *             or error code from subsidiary print functions
  */
-int Writer_linePrint(const writer_line_t *line, writer_bit_t bit_len)
+static int writer_lineFormat(writer_ctx_t *ctx, writer_out_t *out, const writer_line_t *line)
 {
     int ret_val;
+    uint8_t is_undefined;
+    writer_source_t source;
 
     if (line == NULL)
     {
         return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
     }
-    ret_val = Writer_ValuePrint_print(line->value, (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED), bit_len);  // Print symbol value
+    is_undefined = (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED);
+    ret_val = Writer_ValuePrint_print(out, (ctx->size_mode == WRITER_SIZE_AS_VALUE) ? line->size : line->value,
+                                      is_undefined, ctx->bit_len);  // Print symbol value
     if (ret_val == WR_SUCCESS)
     {
-        ret_val = write(STDOUT_FILENO, SPACE_STR, SPACE_LEN);  // Add space after value
-        if (ret_val != SPACE_LEN)
-        {
-            return (ret_val < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
-        }
-        ret_val = WR_SUCCESS;  // Reset to success if write succeeds
+        ret_val = Writer_Out_write(out, SPACE_STR, SPACE_LEN);  // Add space after value
     }
     if (ret_val == WR_SUCCESS)
     {
-        ret_val = Writer_FlagPrint_print(line->bind, line->sect_head_idx, line->type);  // Print symbol flags
+        ret_val = writer_sizeColumnFormat(ctx, out, line, is_undefined);  // Print symbol size (-S)
     }
     if (ret_val == WR_SUCCESS)
     {
-        ret_val = write(STDOUT_FILENO, SPACE_STR, SPACE_LEN);  // Add space after flags
-        if (ret_val != SPACE_LEN)
-        {
-            return (ret_val < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
-        }
-        ret_val = WR_SUCCESS;  // Reset to success if write succeeds
+        ret_val = Writer_FlagPrint_print(ctx, out, line->bind, line->sect_head_idx, line->type);  // Print symbol flags
+    }
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_write(out, SPACE_STR, SPACE_LEN);  // Add space after flags
     }
     if (ret_val == WR_SUCCESS)
     {
-        ret_val = Writer_NamePrint_print(line->name);  // Print symbol name
+        ret_val = Writer_NamePrint_print(out, Writer_lineDisplayNameGet(ctx, line));  // Print symbol name, demangled with -C
     }  
+    if ((ret_val == WR_SUCCESS) && (ctx->source_get != NULL) && ctx->source_get(line, &source, ctx->source_arg))
+    {
+        ret_val = writer_sourceFormat(out, &source);  // Print source location with -l
+    }
     if (ret_val == WR_SUCCESS)
     {
-        ret_val = write(STDOUT_FILENO, NL_STR, NL_LEN);  // Add newline at end
-        if (ret_val != NL_LEN)
+        ret_val = Writer_Out_write(out, NL_STR, NL_LEN);  // Add newline at end
+    }
+    FT_NM_PROBE2(line_flush, line->value, ret_val);
+    return ret_val;  // Return final result
+}
+
+/**
+ * @brief Prints a symbol line
+ * @param[in,out] ctx Writer context
+ * @param[in] line Pointer to the writer_line_t structure containing symbol data
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write,
+ *             or error code from subsidiary print functions
+ */
+int Writer_linePrint(writer_ctx_t *ctx, const writer_line_t *line)
+{
+    if (ctx == NULL)
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    ctx->line_cnt++;
+    return writer_lineFormat(ctx, &ctx->out, line);
+}
+
+/**
+ * @brief Formats the lines of a chunk into its buffer
+ * @param[in,out] arg Pointer to the writer_range_job_t of the chunk
+ * @return void* NULL
+ */
+static void *writer_rangeJob(void *arg)
+{
+    writer_range_job_t *job = arg;
+    writer_line_t line;
+
+    job->out.len = 0;
+    job->ret = WR_SUCCESS;
+    for (size_t pos = job->first; (pos < job->end) && (job->ret == WR_SUCCESS); pos++)
+    {
+        job->line_get(pos, &line, job->arg);
+        job->ret = writer_lineFormat(job->ctx, &job->out, &line);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Prints a range of symbol lines on one thread
+ * @param[in,out] ctx Writer context
+ * @param[in] first First position of the range
+ * @param[in] end Position past the last one of the range
+ * @param[in] line_get Reads the line at a position of the range
+ * @param[in] arg Argument of line_get
+ * @return int WR_SUCCESS on success, or the error of the first line that failed
+ */
+static int writer_rangeSerialPrint(writer_ctx_t *ctx, size_t first, size_t end, writer_line_get_f line_get,
+                                   const void *arg)
+{
+    writer_line_t line;
+    int ret_val = WR_SUCCESS;
+
+    for (size_t pos = first; pos < end; pos++)
+    {
+        line_get(pos, &line, arg);
+        if (ret_val == WR_SUCCESS)
         {
-            return (ret_val < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
+            ret_val = writer_lineFormat(ctx, &ctx->out, &line);
+        }
+        else
+        {
+            writer_lineFormat(ctx, &ctx->out, &line);  // Keep printing, like separate Writer_linePrint calls
         }
-        ret_val = WR_SUCCESS;  // Reset to success if write succeeds
     }
-    return ret_val;  // Return final result
+    return ret_val;
+}
+
+/**
+ * @brief Prints an ordered range of symbol lines
+ * @param[in,out] ctx Writer context
+ * @param[in] line_cnt Number of lines of the range
+ * @param[in] line_get Reads the line at a position of the range
+ * @param[in] arg Argument of line_get
+ * @param[in] thread_cnt Number of formatting threads, 0 to pick them from the number of lines
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_rangePrint(writer_ctx_t *ctx, size_t line_cnt, writer_line_get_f line_get, const void *arg,
+                      size_t thread_cnt)
+{
+    writer_range_job_t jobs[WRITER_RANGE_THREADS_MAX];
+    pthread_t threads[WRITER_RANGE_THREADS_MAX];
+    unsigned short started[WRITER_RANGE_THREADS_MAX] = {0};
+    size_t round_len;
+    int ret_val = WR_SUCCESS;
+    int job_ret;
+
+    if ((ctx == NULL) || (line_get == NULL))
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    ctx->line_cnt += line_cnt;
+
+    // One thread per online CPU for large ranges, unless the count is set
+    if (thread_cnt == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_cnt = ((line_cnt >= WRITER_RANGE_PARALLEL_MIN) && (cpus > 1)) ? (size_t)cpus : 1;
+        thread_cnt = (thread_cnt > WRITER_RANGE_AUTO_MAX) ? WRITER_RANGE_AUTO_MAX : thread_cnt;
+    }
+    thread_cnt = (thread_cnt > WRITER_RANGE_THREADS_MAX) ? WRITER_RANGE_THREADS_MAX : thread_cnt;
+    if ((thread_cnt <= 1) || (line_cnt <= WRITER_RANGE_CHUNK))
+    {
+        return writer_rangeSerialPrint(ctx, 0, line_cnt, line_get, arg);
+    }
+
+    // Format one chunk per thread, then append the chunks in order, a round at a time
+    for (size_t i = 0; i < thread_cnt; i++)
+    {
+        jobs[i] = (writer_range_job_t){ctx, line_get, arg, 0, 0, {NULL, 0, 0, -1, 0}, WR_SUCCESS};
+    }
+    round_len = thread_cnt * WRITER_RANGE_CHUNK;
+    for (size_t round = 0; round < line_cnt; round += round_len)
+    {
+        for (size_t i = 0; i < thread_cnt; i++)
+        {
+            size_t first = round + i * WRITER_RANGE_CHUNK;
+            jobs[i].first = (first < line_cnt) ? first : line_cnt;
+            jobs[i].end = ((line_cnt - jobs[i].first) > WRITER_RANGE_CHUNK) ? (jobs[i].first + WRITER_RANGE_CHUNK) : line_cnt;
+        }
+        for (size_t i = 1; (i < thread_cnt) && (jobs[i].first < jobs[i].end); i++)
+        {
+            started[i] = (pthread_create(&threads[i], NULL, writer_rangeJob, &jobs[i]) == 0);
+        }
+        writer_rangeJob(&jobs[0]);
+        for (size_t i = 0; (i < thread_cnt) && (jobs[i].first < jobs[i].end); i++)
+        {
+            if (started[i])
+            {
+                pthread_join(threads[i], NULL);
+                started[i] = 0;
+            }
+            else if (i != 0)
+            {
+                writer_rangeJob(&jobs[i]);  // Thread could not be started
+            }
+            if (jobs[i].ret == WR_SUCCESS)
+            {
+                job_ret = Writer_Out_write(&ctx->out, jobs[i].out.buf, jobs[i].out.len);
+            }
+            else
+            {
+                job_ret = writer_rangeSerialPrint(ctx, jobs[i].first, jobs[i].end, line_get, arg);  // Chunk buffer could not grow
+            }
+            ret_val = (ret_val == WR_SUCCESS) ? job_ret : ret_val;
+        }
+    }
+    for (size_t i = 0; i < thread_cnt; i++)
+    {
+        free(jobs[i].out.buf);
+    }
+    return ret_val;
 }
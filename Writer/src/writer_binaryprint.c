@@ -0,0 +1,250 @@
+/**
+ * @file writer_binaryprint.c
+ * @brief Binary symbol record output for ft_nm
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains functions for writing symbol lines as the fixed-width
+ * binary record stream described in writer_binary.h. Records and names are
+ * collected in memory per input file, in the writer context, and written
+ * through the context buffer with a few large writes.
+ */
+
+#include "../inc_pub/writer_binary.h"
+#include "../inc_priv/writer_flagprint_priv.h"
+#include "../inc_priv/writer_ctx_priv.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Buffer macros
+ */
+#define BINARY_BUF_INIT_SIZE 65536u  /**< Initial capacity of the record and name buffers */
+#define BINARY_BIT_WIDTH_32  32u     /**< Encoded bit width of 32-bit inputs */
+#define BINARY_BIT_WIDTH_64  64u     /**< Encoded bit width of 64-bit inputs */
+
+/**
+ * @brief Stores a 16-bit value in little-endian order
+ * @param[out] dst Destination bytes
+ * @param[in] val Value to store
+ */
+static void binary_u16Put(uint8_t *dst, uint16_t val)
+{
+    dst[0] = (uint8_t)val;
+    dst[1] = (uint8_t)(val >> 8);
+}
+
+/**
+ * @brief Stores a 32-bit value in little-endian order
+ * @param[out] dst Destination bytes
+ * @param[in] val Value to store
+ */
+static void binary_u32Put(uint8_t *dst, uint32_t val)
+{
+    for (unsigned int i = 0; i < sizeof(val); i++)
+    {
+        dst[i] = (uint8_t)(val >> (8u * i));
+    }
+}
+
+/**
+ * @brief Stores a 64-bit value in little-endian order
+ * @param[out] dst Destination bytes
+ * @param[in] val Value to store
+ */
+static void binary_u64Put(uint8_t *dst, uint64_t val)
+{
+    for (unsigned int i = 0; i < sizeof(val); i++)
+    {
+        dst[i] = (uint8_t)(val >> (8u * i));
+    }
+}
+
+/**
+ * @brief Reserves space at the end of a buffer, growing it as needed
+ * @param[in,out] buf Buffer to grow
+ * @param[in] len Number of bytes to reserve
+ * @return uint8_t* Start of the reserved space, or NULL on allocation failure
+ */
+static uint8_t *binary_bufReserve(writer_binary_buf_t *buf, size_t len)
+{
+    uint8_t *new_data;
+    size_t new_cap;
+
+    if (buf->len + len > buf->cap)
+    {
+        new_cap = (buf->cap == 0) ? BINARY_BUF_INIT_SIZE : buf->cap;
+        while (new_cap < buf->len + len)
+        {
+            new_cap *= 2;
+        }
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap);
+        new_data = realloc(buf->data, new_cap);
+        if (new_data == NULL)
+        {
+            return NULL;  // Allocation failure
+        }
+        buf->data = new_data;
+        buf->cap = new_cap;
+    }
+    buf->len += len;
+    return &buf->data[buf->len - len];
+}
+
+/**
+ * @brief Releases the buffers of the current block
+ * @param[in,out] block Binary block of a writer context
+ */
+static void binary_blockReset(writer_binary_out_t *block)
+{
+    free(block->records.data);
+    free(block->names.data);
+    memset(block, 0, sizeof(*block));
+}
+
+/**
+ * @brief Starts a binary block for one input file
+ * @param[in,out] ctx Writer context; its bit width is written in the header
+ * @param[in] path Path of the input file
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx or path is NULL
+ */
+int Writer_BinaryPrint_begin(writer_ctx_t *ctx, const char *path)
+{
+    if ((ctx == NULL) || (path == NULL))
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    binary_blockReset(&ctx->binary);  // Drop any block that was never ended
+    ctx->binary.path = path;
+    ctx->binary.active = 1u;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Appends one symbol line to the current binary block
+ *
+ * The record is reserved before the name, and given back if the name
+ * cannot be stored, so a failed line leaves the block unchanged. The first
+ * error is kept for Writer_BinaryPrint_end.
+ *
+ * @param[in,out] ctx Writer context
+ * @param[in] line Pointer to the writer_line_t structure containing symbol data
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input or if
+ *             no block was started, WR_ERR_MALLOC_FAIL on allocation failure,
+ *             WR_ERR_OVERFLOW if the name blob would pass 4 GiB,
+ *             WR_ERR_WRITE_FAIL if the flag cannot be determined
+ */
+int Writer_BinaryPrint_line(writer_ctx_t *ctx, const writer_line_t *line)
+{
+    const char *name = Writer_lineNameGet(ctx, line);
+    writer_binary_out_t *block;
+    uint8_t *record;
+    uint8_t *name_dst;
+    size_t name_len;
+    uint32_t name_off;
+    char flag;
+    int ret_val;
+
+    if ((name == NULL) || (!ctx->binary.active))
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input or no block started
+    }
+    block = &ctx->binary;
+    if (block->error != WR_SUCCESS)
+    {
+        return block->error;  // The block already failed
+    }
+    ret_val = Writer_FlagPrint_flagGet(ctx, line->bind, line->sect_head_idx, line->type, &flag);
+    if (ret_val != WR_SUCCESS)
+    {
+        block->error = ret_val;
+        return ret_val;  // Propagate flag lookup error
+    }
+    name_len = strlen(name) + 1;
+    if (block->names.len > UINT32_MAX)
+    {
+        block->error = WR_ERR_OVERFLOW;
+        return WR_ERR_OVERFLOW;  // Name offset does not fit its 32-bit field
+    }
+    name_off = (uint32_t)block->names.len;
+    record = binary_bufReserve(&block->records, WRITER_BINARY_RECORD_SIZE);
+    if (record == NULL)
+    {
+        block->error = WR_ERR_MALLOC_FAIL;
+        return WR_ERR_MALLOC_FAIL;  // Allocation failure
+    }
+    name_dst = binary_bufReserve(&block->names, name_len);
+    if (name_dst == NULL)
+    {
+        block->records.len -= WRITER_BINARY_RECORD_SIZE;  // Give the record back
+        block->error = WR_ERR_MALLOC_FAIL;
+        return WR_ERR_MALLOC_FAIL;  // Allocation failure
+    }
+    memcpy(name_dst, name, name_len);
+    memset(record, 0, WRITER_BINARY_RECORD_SIZE);
+    binary_u64Put(&record[0], line->value);
+    binary_u32Put(&record[8], name_off);
+    binary_u32Put(&record[12], line->sect_head_idx);
+    record[16] = (uint8_t)line->bind;
+    record[17] = (uint8_t)line->type;
+    record[18] = (uint8_t)flag;
+    block->record_count++;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Writes the current binary block out and releases its buffers
+ * @param[in,out] ctx Writer context
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL or no block was started,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_BinaryPrint_end(writer_ctx_t *ctx)
+{
+    uint8_t header[WRITER_BINARY_HEADER_SIZE] = {0};
+    writer_binary_out_t *block;
+    size_t path_len;
+    int ret_val;
+
+    if ((ctx == NULL) || (!ctx->binary.active))
+    {
+        return WR_ERR_NULL_INPUT;  // No block started
+    }
+    block = &ctx->binary;
+    if (block->error != WR_SUCCESS)
+    {
+        ret_val = block->error;
+        binary_blockReset(block);
+        return ret_val;  // A line failed; the block is not written
+    }
+    path_len = strlen(block->path);
+    memcpy(&header[0], WRITER_BINARY_MAGIC, WRITER_BINARY_MAGIC_LEN);
+    binary_u16Put(&header[4], WRITER_BINARY_VERSION);
+    binary_u16Put(&header[6], WRITER_BINARY_HEADER_SIZE);
+    binary_u16Put(&header[8], WRITER_BINARY_RECORD_SIZE);
+    header[10] = (ctx->bit_len == WRITER_VALUEPRINT_32BIT) ? BINARY_BIT_WIDTH_32 : BINARY_BIT_WIDTH_64;
+    binary_u32Put(&header[12], (uint32_t)path_len);
+    binary_u64Put(&header[16], block->record_count);
+    binary_u64Put(&header[24], block->names.len);
+    ret_val = Writer_Out_write(&ctx->out, header, sizeof(header));
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_write(&ctx->out, block->path, path_len);
+    }
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_write(&ctx->out, block->records.data, block->records.len);
+    }
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_write(&ctx->out, block->names.data, block->names.len);
+    }
+    if (ret_val == WR_SUCCESS)
+    {
+        ret_val = Writer_Out_flush(&ctx->out);  // The block goes out whole, as before
+    }
+    binary_blockReset(block);
+    return ret_val;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file writer_binaryread.c
+ * @brief Reader for the ft_nm binary output format
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains functions for downstream tools to walk the binary
+ * record stream written by ft_nm --format=binary, as described in
+ * writer_binary.h. The reader works on a buffer in memory and never copies.
+ */
+
+#include "../inc_pub/writer_binary.h"
+#include <string.h>
+
+/**
+ * @brief Loads a 16-bit little-endian value
+ * @param[in] src Source bytes
+ * @return uint16_t Decoded value
+ */
+static uint16_t binaryread_u16Get(const uint8_t *src)
+{
+    return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+/**
+ * @brief Loads a 32-bit little-endian value
+ * @param[in] src Source bytes
+ * @return uint32_t Decoded value
+ */
+static uint32_t binaryread_u32Get(const uint8_t *src)
+{
+    uint32_t val = 0;
+
+    for (unsigned int i = sizeof(val); i != 0; i--)
+    {
+        val = (val << 8) | src[i - 1];
+    }
+    return val;
+}
+
+/**
+ * @brief Loads a 64-bit little-endian value
+ * @param[in] src Source bytes
+ * @return uint64_t Decoded value
+ */
+static uint64_t binaryread_u64Get(const uint8_t *src)
+{
+    uint64_t val = 0;
+
+    for (unsigned int i = sizeof(val); i != 0; i--)
+    {
+        val = (val << 8) | src[i - 1];
+    }
+    return val;
+}
+
+/**
+ * @brief Initializes a reader over an in-memory binary stream
+ * @param[out] reader Reader to initialize
+ * @param[in] buf Stream data
+ * @param[in] len Stream length
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if reader or buf is NULL
+ */
+int Writer_BinaryRead_init(writer_binary_reader_t *reader, const void *buf, size_t len)
+{
+    if ((reader == NULL) || (buf == NULL))
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    reader->buf = buf;
+    reader->len = len;
+    reader->pos = 0;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Locates and validates the next block of the stream
+ * @param[in,out] reader Reader state; advanced past the block on success
+ * @param[out] block Located block
+ * @return int 1 if a block was read, 0 at end of stream, WR_ERR_NULL_INPUT on
+ *             invalid input, WR_ERR_BAD_FORMAT if the stream is malformed
+ */
+int Writer_BinaryRead_blockNext(writer_binary_reader_t *reader, writer_binary_block_t *block)
+{
+    const uint8_t *src;
+    size_t left;
+    uint64_t body_len;
+
+    if ((reader == NULL) || (block == NULL))
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (reader->pos == reader->len)
+    {
+        return 0;  // End of stream
+    }
+    src = reader->buf + reader->pos;
+    left = reader->len - reader->pos;
+    if ((left < WRITER_BINARY_HEADER_SIZE) ||
+        (memcmp(src, WRITER_BINARY_MAGIC, WRITER_BINARY_MAGIC_LEN) != 0))
+    {
+        return WR_ERR_BAD_FORMAT;  // Truncated header or bad magic
+    }
+    block->header.version = binaryread_u16Get(&src[4]);
+    block->header.header_size = binaryread_u16Get(&src[6]);
+    block->header.record_size = binaryread_u16Get(&src[8]);
+    block->header.bit_width = src[10];
+    block->header.path_len = binaryread_u32Get(&src[12]);
+    block->header.record_count = binaryread_u64Get(&src[16]);
+    block->header.name_blob_len = binaryread_u64Get(&src[24]);
+    if ((block->header.header_size < WRITER_BINARY_HEADER_SIZE) ||
+        (block->header.record_size < WRITER_BINARY_RECORD_SIZE) ||
+        (block->header.header_size > left))
+    {
+        return WR_ERR_BAD_FORMAT;  // Fields smaller than version 1 or truncated
+    }
+    left -= block->header.header_size;
+    if ((block->header.record_count > (left / block->header.record_size)) ||
+        (block->header.name_blob_len > left) || (block->header.path_len > left))
+    {
+        return WR_ERR_BAD_FORMAT;  // Body cannot fit in the stream
+    }
+    body_len = (uint64_t)block->header.path_len
+             + block->header.record_count * block->header.record_size
+             + block->header.name_blob_len;
+    if (body_len > left)
+    {
+        return WR_ERR_BAD_FORMAT;  // Truncated body
+    }
+    if ((block->header.name_blob_len != 0) &&
+        (src[block->header.header_size + body_len - 1] != '\0'))
+    {
+        return WR_ERR_BAD_FORMAT;  // Last name is not terminated
+    }
+    block->path = (const char *)src + block->header.header_size;
+    block->records = (const uint8_t *)block->path + block->header.path_len;
+    block->name_blob = (const char *)block->records + block->header.record_count * block->header.record_size;
+    reader->pos += block->header.header_size + body_len;
+    return 1;
+}
+
+/**
+ * @brief Decodes one record of a block
+ * @param[in] block Block returned by Writer_BinaryRead_blockNext
+ * @param[in] idx Record index, below header.record_count
+ * @param[out] record Decoded record
+ * @param[out] name Optional; set to the record's null-terminated name
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT on invalid input or index,
+ *             WR_ERR_BAD_FORMAT if the name offset is out of bounds
+ */
+int Writer_BinaryRead_recordGet(const writer_binary_block_t *block, uint64_t idx,
+                                writer_binary_record_t *record, const char **name)
+{
+    const uint8_t *src;
+
+    if ((block == NULL) || (record == NULL) || (idx >= block->header.record_count))
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input or index
+    }
+    src = block->records + idx * block->header.record_size;
+    record->value = binaryread_u64Get(&src[0]);
+    record->name_off = binaryread_u32Get(&src[8]);
+    record->sect_head_idx = binaryread_u32Get(&src[12]);
+    record->bind = src[16];
+    record->type = src[17];
+    record->flag = (char)src[18];
+    if (record->name_off >= block->header.name_blob_len)
+    {
+        return WR_ERR_BAD_FORMAT;  // Name outside the blob
+    }
+    if (name != NULL)
+    {
+        *name = &block->name_blob[record->name_off];
+    }
+    return WR_SUCCESS;
+}
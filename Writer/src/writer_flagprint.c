@@ -7,13 +7,15 @@
  *
  * This file contains functions for printing symbol flags to stdout
  * in the ft_nm writer module, based on binding, section index, and type.
- * It supports section header table lookups and debug flag toggling.
+ * It supports section header table lookups and debug flag toggling, both
+ * kept in the writer context.
  */
 
 #include "../inc_pub/writer_flagprint.h"
 #include "../inc_priv/writer_flagprint_priv.h" 
+#include "../inc_priv/writer_out_priv.h"
+#include "../inc_priv/writer_ctx_priv.h"
 #include "../inc_pub/writer.h"
-#include <unistd.h>
 #include <string.h>
 
 /**
@@ -26,9 +28,6 @@
 
 #define SECTION_PRINT NO_PRINT
 
-const elfparser_secthead_t *g_sect_head_table = NULL; /* Global pointer to the section header table */
-unsigned short debug_print = NO_PRINT; /* Global flag for enabling/disabling debug output */
-
 /**
  * @brief Compares two strings up to a maximum length
  * @param[in] s1 First string
@@ -66,52 +65,63 @@ static int flagprint_strNCmp(const char *s1, const char *s2, size_t n)
 
 /**
  * @brief Loads the section header table for flag printing
- * @param[in] sect_head Pointer to the section header table
+ * @param[in,out] ctx Writer context
+ * @param[in] sects Section headers of the file, with names resolved
+ * @param[in] sect_cnt Number of sections
  */
-void Writer_FlagPrint_sectionHeadLoad(const elfparser_secthead_t *sect_head)
+void Writer_FlagPrint_sectionHeadLoad(writer_ctx_t *ctx, const elfparser_secthead_entry_t *sects, uint32_t sect_cnt)
 {
-    g_sect_head_table = sect_head;  // Set global section header table
+    ctx->sects = sects;        // Set section header table of the context
+    ctx->sect_cnt = sect_cnt;
 }
 
 /**
  * @brief Clears the section header table
+ * @param[in,out] ctx Writer context
  */
-void Writer_FlagPrint_sectionHeadUnload(void)
+void Writer_FlagPrint_sectionHeadUnload(writer_ctx_t *ctx)
 {
-    g_sect_head_table = NULL;  // Clear global section header table
+    ctx->sects = NULL;  // Clear section header table of the context
+    ctx->sect_cnt = 0;
 }
 
 /**
  * @brief Enables debug flag printing
+ * @param[in,out] ctx Writer context
  */
-void Writer_FlagPrint_enableDebug(void)
+void Writer_FlagPrint_enableDebug(writer_ctx_t *ctx)
 {
-    debug_print = PRINT;  // Set debug flag to enabled
+    ctx->debug_print = PRINT;  // Set debug flag to enabled
 }
 
 /**
  * @brief Disables debug flag printing
+ * @param[in,out] ctx Writer context
  */
-void Writer_FlagPrint_disableDebug(void)
+void Writer_FlagPrint_disableDebug(writer_ctx_t *ctx)
 {
-    debug_print = NO_PRINT;  // Set debug flag to disabled
+    ctx->debug_print = NO_PRINT;  // Set debug flag to disabled
 }
 
 /**
- * @brief Prints a symbol flag to stdout
+ * @brief Determines the flag character of a symbol against the given section headers
+ * @param[in] sects Section headers of the symbol's file
+ * @param[in] sect_cnt Number of sections
+ * @param[in] debug_print PRINT to flag symbols of debug sections, NO_PRINT otherwise
  * @param[in] bind Symbol binding type (e.g., WRITER_FLAGPRINT_BIND_WEAK)
  * @param[in] symbol_shidx Section header index for the symbol
  * @param[in] type Symbol type (e.g., WRITER_FLAGPRINT_TYPE_GNU)
- * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if section table is NULL,
- *             WR_ERR_WRITE_FAIL on complete write failure or index out of bounds,
- *             WR_ERR_WRITE_PARTIAL on partial write
+ * @param[out] flag Flag character of the symbol
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if sects or flag is NULL,
+ *             WR_ERR_WRITE_FAIL if index is out of bounds
  */
-int Writer_FlagPrint_print(writer_flagprint_bind_e bind, uint16_t symbol_shidx, writer_flagprint_type_e type)
+static int flagprint_flagFind(const elfparser_secthead_entry_t *sects, uint32_t sect_cnt, unsigned short debug_print,
+                              writer_flagprint_bind_e bind, uint32_t symbol_shidx, writer_flagprint_type_e type,
+                              char *flag)
 {
-    const char *flag_str;  // Flag string to print
-    int ret_val;           // Return value from write
+    const char *flag_str;  // Selected flag string
 
-    if (g_sect_head_table == NULL)
+    if ((sects == NULL) || (flag == NULL))
     {
         return WR_ERR_NULL_INPUT;  // Section table not loaded
     }
@@ -143,69 +153,132 @@ int Writer_FlagPrint_print(writer_flagprint_bind_e bind, uint16_t symbol_shidx,
     }
     else
     {
-        if (symbol_shidx >= g_sect_head_table->table_len)
+        if (symbol_shidx >= sect_cnt)
         {
             return WR_ERR_WRITE_FAIL;  // Index out of bounds, repurposed as write-related error
         }
         for (uint8_t i = 0; i < FLAGPRINT_SH_NAME_DATA_ARR_LEN; i++)
         {
-            if (flagprint_strNCmp(g_sect_head_table->table[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_DATA_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
+            if (flagprint_strNCmp(sects[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_DATA_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
             {
                 flag_str = (bind == WRITER_FLAGPRINT_BIND_LOCAL) ? FLAGPRINT_FLAG_DATA_LOCAL : FLAGPRINT_FLAG_DATA_GLOBAL;
-                goto print_flag;
+                goto flag_found;
             }
         }
         for (uint8_t i = 0; i < FLAGPRINT_SH_NAME_RODATA_ARR_LEN; i++)
         {
-            if (flagprint_strNCmp(g_sect_head_table->table[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_RODATA_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
+            if (flagprint_strNCmp(sects[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_RODATA_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
             {
                 flag_str = (bind == WRITER_FLAGPRINT_BIND_LOCAL) ? FLAGPRINT_FLAG_RODATA_LOCAL : FLAGPRINT_FLAG_RODATA_GLOBAL;
-                goto print_flag;
+                goto flag_found;
             }
         }
         for (uint8_t i = 0; i < FLAGPRINT_SH_NAME_CODE_ARR_LEN; i++)
         {
-            if (flagprint_strNCmp(g_sect_head_table->table[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_CODE_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
+            if (flagprint_strNCmp(sects[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_CODE_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
             {
                 flag_str = (bind == WRITER_FLAGPRINT_BIND_LOCAL) ? FLAGPRINT_FLAG_CODE_LOCAL : FLAGPRINT_FLAG_CODE_GLOBAL;
-                goto print_flag;
+                goto flag_found;
             }
         }
         for (uint8_t i = 0; i < FLAGPRINT_SH_NAME_BSS_ARR_LEN; i++)
         {
-            if (flagprint_strNCmp(g_sect_head_table->table[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_BSS_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
+            if (flagprint_strNCmp(sects[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_BSS_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
             {
                 flag_str = (bind == WRITER_FLAGPRINT_BIND_LOCAL) ? FLAGPRINT_FLAG_BSS_LOCAL : FLAGPRINT_FLAG_BSS_GLOBAL;
-                goto print_flag;
+                goto flag_found;
             }
         }
         if (debug_print == PRINT)
         {
             for (uint8_t i = 0; i < FLAGPRINT_SH_NAME_DEBUG_ARR_LEN; i++)
             {
-                if (flagprint_strNCmp(g_sect_head_table->table[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_DEBUG_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
+                if (flagprint_strNCmp(sects[symbol_shidx].sh_name, FLAGPRINT_SH_NAME_DEBUG_ARR[i], SIZE_MAX) == FLAGPRINT_STRNCMP_EQUAL)
                 {
                     flag_str = FLAGPRINT_FLAG_DEBUG;
-                    goto print_flag;
+                    goto flag_found;
                 }
             }
         }
         flag_str = FLAGPRINT_FLAG_UNKNOW;  // Default to unknown
     }
 
-print_flag:
-    ret_val = write(STDOUT_FILENO, flag_str, FLAGPRINT_FLAG_LEN);  // Print selected flag
-    if (ret_val != FLAGPRINT_FLAG_LEN)
+flag_found:
+    *flag = flag_str[0];
+    return WR_SUCCESS;  // Success
+}
+
+/**
+ * @brief Determines the flag character of a symbol
+ * @param[in] ctx Writer context
+ * @param[in] bind Symbol binding type (e.g., WRITER_FLAGPRINT_BIND_WEAK)
+ * @param[in] symbol_shidx Section header index for the symbol
+ * @param[in] type Symbol type (e.g., WRITER_FLAGPRINT_TYPE_GNU)
+ * @param[out] flag Flag character of the symbol
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx, section table or flag is NULL,
+ *             WR_ERR_WRITE_FAIL if index is out of bounds
+ */
+int Writer_FlagPrint_flagGet(const writer_ctx_t *ctx, writer_flagprint_bind_e bind, uint32_t symbol_shidx,
+                             writer_flagprint_type_e type, char *flag)
+{
+    if (ctx == NULL)
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    return flagprint_flagFind(ctx->sects, ctx->sect_cnt, ctx->debug_print, bind, symbol_shidx, type, flag);
+}
+
+/**
+ * @brief Determines the flag character of a symbol against the given section headers
+ * @param[in] sects Section headers of the symbol's file
+ * @param[in] sect_cnt Number of sections
+ * @param[in] bind Symbol binding type (e.g., WRITER_FLAGPRINT_BIND_WEAK)
+ * @param[in] symbol_shidx Section header index for the symbol
+ * @param[in] type Symbol type (e.g., WRITER_FLAGPRINT_TYPE_GNU)
+ * @param[out] flag Flag character of the symbol
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if sects or flag is NULL,
+ *             WR_ERR_WRITE_FAIL if index is out of bounds
+ */
+int Writer_FlagPrint_flagFind(const elfparser_secthead_entry_t *sects, uint32_t sect_cnt,
+                              writer_flagprint_bind_e bind, uint32_t symbol_shidx, writer_flagprint_type_e type,
+                              char *flag)
+{
+    return flagprint_flagFind(sects, sect_cnt, NO_PRINT, bind, symbol_shidx, type, flag);
+}
+
+/**
+ * @brief Prints a symbol flag
+ * @param[in] ctx Writer context
+ * @param[in,out] out Output buffer
+ * @param[in] bind Symbol binding type (e.g., WRITER_FLAGPRINT_BIND_WEAK)
+ * @param[in] symbol_shidx Section header index for the symbol
+ * @param[in] type Symbol type (e.g., WRITER_FLAGPRINT_TYPE_GNU)
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if section table is NULL,
+ *             WR_ERR_WRITE_FAIL on complete write failure or index out of bounds,
+ *             WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_FlagPrint_print(const writer_ctx_t *ctx, writer_out_t *out, writer_flagprint_bind_e bind, uint32_t symbol_shidx, writer_flagprint_type_e type)
+{
+    char flag_str[FLAGPRINT_FLAG_LEN];  // Flag to print
+    int ret_val;                        // Return value from write
+
+    ret_val = Writer_FlagPrint_flagGet(ctx, bind, symbol_shidx, type, flag_str);
+    if (ret_val != WR_SUCCESS)
+    {
+        return ret_val;  // Propagate lookup error
+    }
+    ret_val = Writer_Out_write(out, flag_str, FLAGPRINT_FLAG_LEN);  // Print selected flag
+    if (ret_val != WR_SUCCESS)
     {
-        return (ret_val < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
+        return ret_val;  // Fail or partial write
     }
-    if (SECTION_PRINT == PRINT && symbol_shidx < g_sect_head_table->table_len)  // Debug print if enabled
+    if (SECTION_PRINT == PRINT && symbol_shidx < ctx->sect_cnt)  // Debug print if enabled
     {
-        size_t name_len = strlen(g_sect_head_table->table[symbol_shidx].sh_name);
-        ret_val = write(STDOUT_FILENO, g_sect_head_table->table[symbol_shidx].sh_name, name_len);
-        if (ret_val != (int)name_len)
+        ret_val = Writer_Out_write(out, ctx->sects[symbol_shidx].sh_name,
+                                   strlen(ctx->sects[symbol_shidx].sh_name));
+        if (ret_val != WR_SUCCESS)
         {
-            return (ret_val < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
+            return ret_val;  // Fail or partial write
         }
     }
     return WR_SUCCESS;  // Success
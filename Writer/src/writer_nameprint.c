@@ -5,22 +5,301 @@
  * @date 2025-03-16
  * @version 1.0
  *
- * This file contains a function for printing symbol names to stdout
- * in the ft_nm writer module.
+ * This file contains functions for resolving symbol names against the
+ * string table loaded in the writer context and printing them in the ft_nm
+ * writer module. With -C, names are demangled through the demangle module.
+ * Batches are demangled ahead of the writer on worker threads, each owning
+ * one demangler context of the writer context; the demangler contexts are
+ * kept across files, so their memo caches carry the names and prefixes
+ * shared by the objects of a run.
  */
 
 #include "../inc_priv/writer_valueprint_priv.h"
+#include "../inc_pub/writer_nameprint.h"
+#include "../inc_priv/writer_out_priv.h"
+#include "../inc_priv/writer_ctx_priv.h"
+#include "../../Demangle/inc_pub/demangle.h"
+#include <pthread.h>
 #include <unistd.h>
 
+#define WRITER_DEMANGLE_PARALLEL_MIN  4096u  /**< Fewest names demangled on several threads */
+
+/**
+ * @brief Slice of a batch demangled by one thread
+ */
+typedef struct writer_demangle_job_s
+{
+    const writer_ctx_t *writer;   /**< Writer context the names are resolved in */
+    demangle_ctx_t *ctx;          /**< Demangler context of the thread */
+    writer_line_t *const *lines;  /**< First line of the slice, or NULL for a slice of names */
+    const char **names;           /**< First name of the slice, when lines is NULL */
+    size_t line_cnt;              /**< Number of lines or names in the slice */
+} writer_demangle_job_t;
+
+/**
+ * @brief Loads the symbol string table used to resolve symbol names
+ * @param[in,out] ctx Writer context
+ * @param[in] strtab Mapped string table; must stay mapped until unloaded
+ * @param[in] strtab_len Length of the string table, strtab[strtab_len - 1] must be '\0'
+ */
+void Writer_NamePrint_strTableLoad(writer_ctx_t *ctx, const char *strtab, size_t strtab_len)
+{
+    ctx->strtab = strtab;          // Set string table of the context
+    ctx->strtab_len = strtab_len;  // Set string table length
+}
+
+/**
+ * @brief Unloads the symbol string table, releasing the names demangled for it
+ * @param[in,out] ctx Writer context
+ */
+void Writer_NamePrint_strTableUnload(writer_ctx_t *ctx)
+{
+    ctx->strtab = NULL;   // Clear string table of the context
+    ctx->strtab_len = 0;  // Clear string table length
+    for (size_t i = 0; i < ctx->demangle_cnt; i++)
+    {
+        Demangle_ctxReset(ctx->demangle[i]);  // Release names not held in the memo caches
+    }
+}
+
+/**
+ * @brief Enables demangling of the printed symbol names
+ * @param[in,out] ctx Writer context
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL,
+ *             WR_ERR_MALLOC_FAIL on memory allocation failure
+ */
+int Writer_NamePrint_demangleEnable(writer_ctx_t *ctx)
+{
+    if (ctx == NULL)
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    if (ctx->demangle_cnt != 0)
+    {
+        return WR_SUCCESS;  // Already enabled
+    }
+    if (Demangle_ctxCreate(&ctx->demangle[0]) != DM_SUCCESS)
+    {
+        return WR_ERR_MALLOC_FAIL;  // Memory allocation error
+    }
+    ctx->demangle_cnt = 1;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Frees the demangler contexts, disabling demangling
+ * @param[in,out] ctx Writer context
+ */
+void Writer_NamePrint_demangleFree(writer_ctx_t *ctx)
+{
+    for (size_t i = 0; i < ctx->demangle_cnt; i++)
+    {
+        Demangle_ctxFree(&ctx->demangle[i]);
+    }
+    ctx->demangle_cnt = 0;
+}
+
+/**
+ * @brief Demangles a symbol name
+ *
+ * A versioned name is split at its first '@': the part before it is
+ * demangled and the "@" or "@@" version is appended unchanged, like nm -C.
+ *
+ * @param[in] ctx Demangler context
+ * @param[in] name Symbol name, or NULL
+ * @return const char* Demangled name, the name itself if it is not demangled,
+ *                     or NULL if name is NULL
+ */
+static const char *nameprint_demangle(demangle_ctx_t *ctx, const char *name)
+{
+    const char *demangled;
+    size_t len = 0;  // Length of the name up to its version
+
+    if (name == NULL)
+    {
+        return NULL;  // Invalid input: NULL pointer
+    }
+    while ((name[len] != '\0') && (name[len] != '@'))
+    {
+        len++;
+    }
+    if (Demangle_namePart(ctx, name, len, &demangled) == DM_SUCCESS)
+    {
+        return demangled;
+    }
+    return name;  // Not a C++ name, or not understood: printed as it is, like nm -C
+}
+
+/**
+ * @brief Demangles one slice of a batch
+ * @param[in,out] arg Pointer to the writer_demangle_job_t of the slice
+ * @return void* NULL
+ */
+static void *nameprint_demangleJob(void *arg)
+{
+    const writer_demangle_job_t *job = arg;
+
+    for (size_t i = 0; i < job->line_cnt; i++)
+    {
+        if (job->lines != NULL)
+        {
+            job->lines[i]->demangled = nameprint_demangle(job->ctx, Writer_lineNameGet(job->writer, job->lines[i]));
+        }
+        else
+        {
+            job->names[i] = nameprint_demangle(job->ctx, job->names[i]);
+        }
+    }
+    return NULL;
+}
+
 /**
- * @brief Prints a symbol name to stdout
+ * @brief Demangles a batch of symbol lines or names, split across threads
+ * @param[in,out] ctx Writer context; demangler contexts are added for the threads
+ * @param[in,out] lines Symbol lines to demangle, or NULL to demangle names
+ * @param[in,out] names Names to demangle in place, when lines is NULL
+ * @param[in] line_cnt Number of lines or names
+ */
+static void nameprint_demangleBatch(writer_ctx_t *ctx, writer_line_t *const *lines, const char **names, size_t line_cnt)
+{
+    writer_demangle_job_t jobs[WRITER_DEMANGLE_THREADS_MAX];
+    pthread_t threads[WRITER_DEMANGLE_THREADS_MAX];
+    unsigned short started[WRITER_DEMANGLE_THREADS_MAX] = {0};
+    size_t thread_cnt = 1;
+    size_t slice;
+
+    if ((ctx == NULL) || (ctx->demangle_cnt == 0) || ((lines == NULL) && (names == NULL)) || (line_cnt == 0))
+    {
+        return;
+    }
+
+    // One thread per online CPU for large batches, each with its own context
+    if (line_cnt >= WRITER_DEMANGLE_PARALLEL_MIN)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_cnt = (cpus > 1) ? (size_t)cpus : 1;
+        thread_cnt = (thread_cnt > WRITER_DEMANGLE_THREADS_MAX) ? WRITER_DEMANGLE_THREADS_MAX : thread_cnt;
+    }
+    while ((ctx->demangle_cnt < thread_cnt) && (Demangle_ctxCreate(&ctx->demangle[ctx->demangle_cnt]) == DM_SUCCESS))
+    {
+        ctx->demangle_cnt++;
+    }
+    thread_cnt = (thread_cnt > ctx->demangle_cnt) ? ctx->demangle_cnt : thread_cnt;
+
+    // Split the batch into contiguous slices, the first one demangled by this thread
+    slice = (line_cnt + thread_cnt - 1) / thread_cnt;
+    for (size_t i = 0; i < thread_cnt; i++)
+    {
+        size_t first = i * slice;
+        jobs[i].writer = ctx;
+        jobs[i].ctx = ctx->demangle[i];
+        jobs[i].lines = (lines != NULL) ? &lines[first] : NULL;
+        jobs[i].names = (lines == NULL) ? &names[first] : NULL;
+        jobs[i].line_cnt = (first >= line_cnt) ? 0 : (((line_cnt - first) < slice) ? (line_cnt - first) : slice);
+    }
+    for (size_t i = 1; i < thread_cnt; i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, nameprint_demangleJob, &jobs[i]) == 0);
+    }
+    nameprint_demangleJob(&jobs[0]);
+    for (size_t i = 1; i < thread_cnt; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            nameprint_demangleJob(&jobs[i]);  // Thread could not be started
+        }
+    }
+}
+
+/**
+ * @brief Demangles the names of symbol lines ahead of printing
+ * @param[in,out] ctx Writer context
+ * @param[in,out] lines Symbol lines to demangle
+ * @param[in] line_cnt Number of lines
+ */
+void Writer_NamePrint_demangleAhead(writer_ctx_t *ctx, writer_line_t *const *lines, size_t line_cnt)
+{
+    if (lines != NULL)
+    {
+        nameprint_demangleBatch(ctx, lines, NULL, line_cnt);
+    }
+}
+
+/**
+ * @brief Demangles an array of symbol names in place ahead of printing
+ * @param[in,out] ctx Writer context
+ * @param[in,out] names Names to demangle
+ * @param[in] name_cnt Number of names
+ */
+void Writer_NamePrint_demangleNames(writer_ctx_t *ctx, const char **names, size_t name_cnt)
+{
+    if (names != NULL)
+    {
+        nameprint_demangleBatch(ctx, NULL, names, name_cnt);
+    }
+}
+
+/**
+ * @brief Returns the name of a symbol line, resolving name_off if needed
+ * @param[in] ctx Writer context
+ * @param[in] line Pointer to the writer_line_t structure
+ * @return const char* Null-terminated symbol name, or NULL if ctx or line is NULL
+ *                     or name_off lies outside the loaded string table
+ */
+const char *Writer_lineNameGet(const writer_ctx_t *ctx, const writer_line_t *line)
+{
+    if ((ctx == NULL) || (line == NULL))
+    {
+        return NULL;  // Invalid input: NULL pointer
+    }
+    if (line->name != NULL)
+    {
+        return line->name;  // Name already resolved
+    }
+    if ((ctx->strtab == NULL) || (line->name_off >= ctx->strtab_len))
+    {
+        return NULL;  // No table loaded or offset out of bounds
+    }
+    return &ctx->strtab[line->name_off];  // View into the string table
+}
+
+/**
+ * @brief Returns the name printed for a symbol line
+ * @param[in,out] ctx Writer context
+ * @param[in] line Pointer to the writer_line_t structure
+ * @return const char* Null-terminated name, or NULL if ctx or line is NULL or
+ *                     its name cannot be resolved
+ */
+const char *Writer_lineDisplayNameGet(writer_ctx_t *ctx, const writer_line_t *line)
+{
+    if ((ctx == NULL) || (line == NULL))
+    {
+        return NULL;  // Invalid input: NULL pointer
+    }
+    if (line->demangled != NULL)
+    {
+        return line->demangled;  // Demangled ahead
+    }
+    if (ctx->demangle_cnt == 0)
+    {
+        return Writer_lineNameGet(ctx, line);  // Demangling disabled
+    }
+    return nameprint_demangle(ctx->demangle[0], Writer_lineNameGet(ctx, line));
+}
+
+/**
+ * @brief Prints a symbol name
+ * @param[in,out] out Output buffer
  * @param[in] name Null-terminated string containing the symbol name
  * @return int WR_SUCCESS on success, or error code on write failure
  */
-int Writer_NamePrint_print(char* name)
+int Writer_NamePrint_print(writer_out_t *out, const char* name)
 {
     size_t len = 0;  // Length of the name string
-    int ret_val; // Return value from write
 
     if (name == NULL)
     {
@@ -30,10 +309,5 @@ int Writer_NamePrint_print(char* name)
     {
         len++;
     }  
-    ret_val = write(STDOUT_FILENO, name, len);  // Write name to stdout
-    if (ret_val != (int)len)
-    {
-        return (ret_val < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
-    }
-    return WR_SUCCESS;  // Success
+    return Writer_Out_write(out, name, len);  // Append name to the output buffer
 }
\ No newline at end of file
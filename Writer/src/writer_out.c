@@ -0,0 +1,145 @@
+/**
+ * @file writer_out.c
+ * @brief Output buffers of the ft_nm writer
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the buffers the text writer formats symbol lines into.
+ * Fields are appended to the buffer of the writer context instead of being
+ * written one write call each, and the buffer goes out in one write call when
+ * it is full or flushed. Chunk buffers, formatted on worker threads, grow
+ * instead and are appended to the context buffer in order.
+ */
+
+#include "../inc_pub/writer.h"
+#include "../inc_priv/writer_out_priv.h"
+#include "../inc_priv/writer_ctx_priv.h"
+#include "../../Stats/inc_pub/stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Writes bytes to the file descriptor of an output buffer, retrying short writes
+ * @param[in,out] out Output buffer; its written count is updated
+ * @param[in] data Bytes to write
+ * @param[in] len Number of bytes
+ * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
+ *             WR_ERR_WRITE_PARTIAL on partial write
+ */
+static int out_write(writer_out_t *out, const char *data, size_t len)
+{
+    size_t done = 0;
+    ssize_t ret_val;
+
+    while (done < len)
+    {
+        STATS_COUNT(STATS_COUNTER_WRITE, 1);
+        ret_val = write(out->fd, data + done, len - done);
+        if (ret_val <= 0)
+        {
+            return ((done == 0) ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
+        }
+        done += (size_t)ret_val;
+        out->written += (uint64_t)ret_val;
+    }
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Grows an output buffer without file descriptor to hold more bytes
+ * @param[in,out] out Output buffer
+ * @param[in] len Number of bytes to add
+ * @return int WR_SUCCESS on success, WR_ERR_MALLOC_FAIL on memory allocation failure
+ */
+static int out_grow(writer_out_t *out, size_t len)
+{
+    size_t cap = (out->cap != 0) ? out->cap : WRITER_OUT_BUF_SIZE;
+    char *buf;
+
+    while ((cap - out->len) < len)
+    {
+        cap *= 2;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, cap);
+    buf = realloc(out->buf, cap);
+    if (buf == NULL)
+    {
+        return WR_ERR_MALLOC_FAIL;
+    }
+    out->buf = buf;
+    out->cap = cap;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Appends bytes to an output buffer
+ * @param[in,out] out Output buffer
+ * @param[in] data Bytes to append
+ * @param[in] len Number of bytes
+ * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
+ *             WR_ERR_WRITE_PARTIAL on partial write, WR_ERR_MALLOC_FAIL if a buffer
+ *             without file descriptor cannot grow
+ */
+int Writer_Out_write(writer_out_t *out, const void *data, size_t len)
+{
+    int ret_val;
+
+    if (len > (out->cap - out->len))
+    {
+        if (out->fd < 0)
+        {
+            ret_val = out_grow(out, len);  // Chunk buffer
+        }
+        else
+        {
+            ret_val = Writer_Out_flush(out);  // Make room
+            if ((ret_val == WR_SUCCESS) && (len > out->cap))
+            {
+                return out_write(out, data, len);  // Too large to buffer
+            }
+        }
+        if (ret_val != WR_SUCCESS)
+        {
+            return ret_val;
+        }
+    }
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+    return WR_SUCCESS;
+}
+
+/**
+ * @brief Writes out the bytes held in an output buffer with a file descriptor
+ * @param[in,out] out Output buffer; emptied
+ * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
+ *             WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_Out_flush(writer_out_t *out)
+{
+    size_t len = out->len;
+
+    out->len = 0;  // Dropped on failure, like an unbuffered write
+    if ((len == 0) || (out->fd < 0))
+    {
+        return WR_SUCCESS;
+    }
+    return out_write(out, out->buf, len);
+}
+
+/**
+ * @brief Writes out the symbol lines held in the buffer of a writer context
+ * @param[in,out] ctx Writer context
+ * @return int WR_SUCCESS on success, WR_ERR_NULL_INPUT if ctx is NULL,
+ *             WR_ERR_WRITE_FAIL on complete write failure, WR_ERR_WRITE_PARTIAL on partial write
+ */
+int Writer_flush(writer_ctx_t *ctx)
+{
+    if (ctx == NULL)
+    {
+        return WR_ERR_NULL_INPUT;  // Invalid input: NULL pointer
+    }
+    return Writer_Out_flush(&ctx->out);
+}
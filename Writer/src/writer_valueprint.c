@@ -11,7 +11,7 @@
  */
 
 #include "../inc_priv/writer_valueprint_priv.h"
-#include <unistd.h>
+#include "../inc_priv/writer_out_priv.h"
 
 /**
  * @brief Print macros
@@ -68,31 +68,26 @@ static int8_t valueprint_ulltoa_hex(uint64_t num, char** ret_str, writer_bit_t b
 
 /**
  * @brief Prints a symbol value to stdout in hexadecimal format
+ * @param[in,out] out Output buffer
  * @param[in] value 64-bit value to print
  * @param[in] is_undefined Flag indicating if the value is undefined
  * @param[in] bit_len Bit length (WRITER_VALUEPRINT_32BIT or WRITER_VALUEPRINT_64BIT)
  * @return int WR_SUCCESS on success, WR_ERR_WRITE_FAIL on complete write failure,
  *             WR_ERR_WRITE_PARTIAL on partial write, or WR_ERR_NULL_INPUT from helper
  */
-int Writer_ValuePrint_print(uint64_t value, uint8_t is_undefined, writer_bit_t bit_len)
+int Writer_ValuePrint_print(writer_out_t *out, uint64_t value, uint8_t is_undefined, writer_bit_t bit_len)
 {
     char num_val[((bit_len == WRITER_VALUEPRINT_32BIT) ? (MAX_LEN_32) : (MAX_LEN_64)) + 1];  // Buffer for hex string
     char *num_val_p = num_val;  // Pointer to buffer
     int8_t num_len;             // Length of converted hex string
-    int temp;                   // Temporary return value from write
-    int expected_len;           // Expected length for write check
+    int temp;                   // Temporary return value from the buffer
+    int expected_len;           // Length of the printed value
     
     if (is_undefined)
     {
         expected_len = (bit_len == WRITER_VALUEPRINT_32BIT) ? LEN_TO_PRINT_32 : LEN_TO_PRINT_64;
-        temp = write(STDOUT_FILENO, 
-                     ((bit_len == WRITER_VALUEPRINT_32BIT) ? (UNDEF_VALUE_32) : (UNDEF_VALUE_64)), 
-                     expected_len);  // Print undefined value
-        if (temp != expected_len)
-        {
-            return (temp < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
-        }
-        return WR_SUCCESS;  // Success
+        return Writer_Out_write(out, ((bit_len == WRITER_VALUEPRINT_32BIT) ? (UNDEF_VALUE_32) : (UNDEF_VALUE_64)),
+                                expected_len);  // Print undefined value
     }
     num_len = valueprint_ulltoa_hex(value, &num_val_p, bit_len);  // Convert value to hex
     if (num_len == WR_ERR_NULL_INPUT)
@@ -100,17 +95,11 @@ int Writer_ValuePrint_print(uint64_t value, uint8_t is_undefined, writer_bit_t b
         return num_len;  // Propagate null input error
     }
     expected_len = (bit_len == WRITER_VALUEPRINT_32BIT) ? LEN_TO_PRINT_32 : LEN_TO_PRINT_64;
-    temp = write(STDOUT_FILENO, 
-                 ((bit_len == WRITER_VALUEPRINT_32BIT) ? (ZEROS_32) : (ZEROS_64)), 
-                 expected_len - num_len);  // Print leading zeros
-    if (temp != (expected_len - num_len))
+    temp = Writer_Out_write(out, ((bit_len == WRITER_VALUEPRINT_32BIT) ? (ZEROS_32) : (ZEROS_64)),
+                            expected_len - num_len);  // Print leading zeros
+    if (temp != WR_SUCCESS)
     {
-        return (temp < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
+        return temp;  // Fail or partial write
     }
-    temp = write(STDOUT_FILENO, num_val_p, num_len);  // Print hex value
-    if (temp != num_len)
-    {
-        return (temp < 0 ? WR_ERR_WRITE_FAIL : WR_ERR_WRITE_PARTIAL);  // Fail or partial write
-    }
-    return WR_SUCCESS;  // Success
+    return Writer_Out_write(out, num_val_p, num_len);  // Print hex value
 }
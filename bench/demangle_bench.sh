@@ -0,0 +1,39 @@
+#!/bin/sh
+# Demangler throughput over the symbols of libstdc++: the names of the shared
+# library and, when installed, of the static archive, whose local clones
+# (.constprop, .isra) the shared library does not export.
+#
+# usage: demangle_bench.sh BENCH [LIBRARY...]
+# NAMES_NM picks the nm that lists the libraries (default: nm).
+
+BENCH=$1
+shift
+NAMES_NM=${NAMES_NM:-nm}
+CXX=${CXX:-g++}
+NAMES=${TMPDIR:-/tmp}/ftnm_demangle_names.$$
+
+trap 'rm -f "$NAMES"' EXIT
+
+if [ $# -eq 0 ]
+then
+    for lib in libstdc++.so libstdc++.a
+    do
+        path=$("$CXX" -print-file-name="$lib" 2>/dev/null)
+        [ -f "$path" ] && set -- "$@" "$path"
+    done
+fi
+if [ $# -eq 0 ]
+then
+    echo "demangle_bench: no libstdc++ found; pass libraries to list" >&2
+    exit 1
+fi
+
+for lib in "$@"
+do
+    case $lib in
+        *.so*) "$NAMES_NM" -D "$lib" ;;
+        *)     "$NAMES_NM" "$lib" ;;
+    esac 2>/dev/null
+done | awk '{ print $NF }' | sed -n 's/@.*//; /^_Z/p' | sort -u > "$NAMES"
+
+"$BENCH" "$NAMES" 5
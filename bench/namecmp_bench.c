@@ -0,0 +1,257 @@
+/**
+ * @file namecmp_bench.c
+ * @brief Benchmark of the name sort comparison
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains the benchmark run by namecmp_bench.sh: it sorts a list
+ * of names, one per line, with qsort and FtNm_nameCmp, then with a byte at a
+ * time comparison of the same rules, and prints the best round of each. The
+ * names are shuffled once with a fixed seed, so every round sorts the same
+ * input. Both comparisons are also run on every pair of neighbouring names
+ * of the input; a pair on which their signs differ fails the benchmark.
+ */
+
+#include "../FtNm/inc_pub/ftnm.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ROUNDS_DEFAULT  5u                      /**< Rounds when none are given */
+#define BENCH_SHUFFLE_SEED    0x9e3779b97f4a7c15ull  /**< Seed of the shuffle */
+
+/**
+ * @brief Reads a whole file into memory and splits it into lines
+ * @param[in] path Path of the file
+ * @param[out] names Start of each line, null-terminated in place
+ * @param[out] name_cnt Number of lines
+ * @param[out] bytes Number of name bytes
+ * @return char* Contents of the file, freed by the caller with names; NULL on failure
+ */
+static char *bench_namesRead(const char *path, char ***names, size_t *name_cnt, size_t *bytes)
+{
+    FILE *file = fopen(path, "rb");
+    char *buf = NULL;
+    size_t len = 0, cnt = 0;
+    long size;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        len = (size_t)size;
+        buf = malloc(len + 1);
+        if ((buf != NULL) && (fread(buf, 1, len, file) != len))
+        {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(file);
+    if (buf == NULL)
+    {
+        return NULL;
+    }
+    buf[len] = '\0';
+    for (size_t i = 0; i < len; i++)
+    {
+        cnt += (buf[i] == '\n');
+    }
+    *names = malloc((cnt + 1) * sizeof(char *));
+    if (*names == NULL)
+    {
+        free(buf);
+        return NULL;
+    }
+    *name_cnt = 0;
+    *bytes = 0;
+    for (char *line = buf; *line != '\0'; )
+    {
+        char *newline = strchr(line, '\n');
+        if (newline != NULL)
+        {
+            *newline = '\0';
+        }
+        if (*line != '\0')
+        {
+            (*names)[(*name_cnt)++] = line;
+            *bytes += strlen(line);
+        }
+        line = (newline != NULL) ? (newline + 1) : (line + strlen(line));
+    }
+    return buf;
+}
+
+/**
+ * @brief Shuffles names with a fixed seed
+ * @param[in,out] names Names to shuffle
+ * @param[in] name_cnt Number of names
+ */
+static void bench_shuffle(char **names, size_t name_cnt)
+{
+    uint64_t state = BENCH_SHUFFLE_SEED;
+
+    for (size_t i = name_cnt; i > 1; i--)
+    {
+        size_t j;
+        char *name;
+
+        state ^= state << 13;  // xorshift64
+        state ^= state >> 7;
+        state ^= state << 17;
+        j = (size_t)(state % i);
+        name = names[i - 1];
+        names[i - 1] = names[j];
+        names[j] = name;
+    }
+}
+
+/**
+ * @brief Compares two names a byte at a time, with the rules of FtNm_nameCmp
+ * @param[in] name1 First symbol name
+ * @param[in] name2 Second symbol name
+ * @return int Negative if name1 < name2, positive if name1 > name2, 0 if equal
+ */
+static int bench_byteCmp(const char *name1, const char *name2)
+{
+    char char1 = 0, char2 = 0;
+
+    while (*name1 != '\0')
+    {
+        if (*name1 == '_')
+        {
+            name1++;
+            continue;
+        }
+        if (*name2 == '_')
+        {
+            name2++;
+            continue;
+        }
+        char1 = ((*name1 >= 'a') && (*name1 <= 'z')) ? (char)(*name1 - ('a' - 'A')) : *name1;
+        char2 = ((*name2 >= 'a') && (*name2 <= 'z')) ? (char)(*name2 - ('a' - 'A')) : *name2;
+        if (char1 != char2)
+        {
+            break;
+        }
+        name1++;
+        name2++;
+    }
+    return (char1 - char2);
+}
+
+/**
+ * @brief qsort comparison of two names with FtNm_nameCmp
+ * @param[in] a First name
+ * @param[in] b Second name
+ * @return int Result of FtNm_nameCmp
+ */
+static int bench_sortLib(const void *a, const void *b)
+{
+    return (FtNm_nameCmp(*(char *const *)a, *(char *const *)b));
+}
+
+/**
+ * @brief qsort comparison of two names with the byte loop
+ * @param[in] a First name
+ * @param[in] b Second name
+ * @return int Result of bench_byteCmp
+ */
+static int bench_sortByte(const void *a, const void *b)
+{
+    return (bench_byteCmp(*(char *const *)a, *(char *const *)b));
+}
+
+/**
+ * @brief Returns a monotonic timestamp
+ * @return double Seconds
+ */
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * @brief Sorts a copy of the names with a comparison, keeping the best round
+ * @param[in] names Names to sort
+ * @param[in] name_cnt Number of names
+ * @param[out] work Array of name_cnt names sorted in place
+ * @param[in] cmp Comparison given to qsort
+ * @param[in] rounds Number of rounds
+ * @return double Seconds of the best round
+ */
+static double bench_sortTime(char *const *names, size_t name_cnt, char **work,
+                             int (*cmp)(const void *, const void *), unsigned int rounds)
+{
+    double best = 0.0;
+
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        double start;
+
+        memcpy(work, names, name_cnt * sizeof(char *));
+        start = bench_now();
+        qsort(work, name_cnt, sizeof(char *), cmp);
+        start = bench_now() - start;
+        best = ((r == 0) || (start < best)) ? start : best;
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int rounds = BENCH_ROUNDS_DEFAULT;
+    size_t name_cnt = 0, bytes = 0, differ = 0;
+    double lib, byte;
+    char **names = NULL, **work;
+    char *buf;
+
+    if ((argc != 2) && (argc != 3))
+    {
+        fprintf(stderr, "usage: %s NAMES [ROUNDS]\n", argv[0]);
+        return 2;
+    }
+    if ((argc == 3) && ((rounds = (unsigned int)strtoul(argv[2], NULL, 10)) == 0))
+    {
+        rounds = BENCH_ROUNDS_DEFAULT;
+    }
+    buf = bench_namesRead(argv[1], &names, &name_cnt, &bytes);
+    if (buf == NULL)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    work = malloc((name_cnt + 1) * sizeof(char *));
+    if (work == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        free(names);
+        free(buf);
+        return 2;
+    }
+    bench_shuffle(names, name_cnt);
+    for (size_t i = 1; i < name_cnt; i++)
+    {
+        int lib_ret = FtNm_nameCmp(names[i - 1], names[i]);
+        int byte_ret = bench_byteCmp(names[i - 1], names[i]);
+
+        differ += ((lib_ret < 0) != (byte_ret < 0)) || ((lib_ret > 0) != (byte_ret > 0));
+    }
+    lib = bench_sortTime(names, name_cnt, work, bench_sortLib, rounds);
+    byte = bench_sortTime(names, name_cnt, work, bench_sortByte, rounds);
+    printf("namecmp: %zu names, %zu bytes, %zu pairs differ\n", name_cnt, bytes, differ);
+    printf("namecmp: best of %u rounds FtNm_nameCmp %.3f ms, byte loop %.3f ms, %.2fx\n", rounds, lib * 1e3,
+           byte * 1e3, byte / lib);
+    free(work);
+    free(names);
+    free(buf);
+    return (differ != 0);
+}
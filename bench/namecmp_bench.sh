@@ -0,0 +1,51 @@
+#!/bin/sh
+# Name sort over 400k mangled names, the size of a large C++ symbol table.
+# The names of libstdc++ are repeated with the clone suffixes the compiler
+# appends (.constprop.N), so most neighbours in sorted order share a long
+# prefix, as the names of one class or template do. The benchmark is built
+# with the flags of the library, so its byte loop is the baseline the vector
+# variants of FtNm_nameCmp are measured against.
+#
+# usage: namecmp_bench.sh BENCH [LIBRARY...]
+# NAMES_NM picks the nm that lists the libraries (default: nm), COUNT the
+# number of names (default: 400000).
+
+BENCH=$1
+shift
+NAMES_NM=${NAMES_NM:-nm}
+CXX=${CXX:-g++}
+COUNT=${COUNT:-400000}
+NAMES=${TMPDIR:-/tmp}/ftnm_namecmp_names.$$
+
+trap 'rm -f "$NAMES"' EXIT
+
+if [ $# -eq 0 ]
+then
+    for lib in libstdc++.so libstdc++.a
+    do
+        path=$("$CXX" -print-file-name="$lib" 2>/dev/null)
+        [ -f "$path" ] && set -- "$@" "$path"
+    done
+fi
+if [ $# -eq 0 ]
+then
+    echo "namecmp_bench: no libstdc++ found; pass libraries to list" >&2
+    exit 1
+fi
+
+for lib in "$@"
+do
+    case $lib in
+        *.so*) "$NAMES_NM" -D "$lib" ;;
+        *)     "$NAMES_NM" "$lib" ;;
+    esac 2>/dev/null
+done | awk '{ print $NF }' | sed -n 's/@.*//; /^_Z/p' | sort -u |
+awk -v count="$COUNT" '{ name[NR] = $0 } END {
+    for (i = 0; (NR > 0) && (i < count); i++)
+    {
+        clone = int(i / NR)
+        printf "%s%s\n", name[i % NR + 1], (clone != 0) ? ".constprop." clone : ""
+    }
+}' > "$NAMES"
+
+"$BENCH" "$NAMES" 5
@@ -26,6 +26,20 @@ int Err_Print_BadAlloc(void);
  */
 int Err_Print_BadOption(const char* option);
 
+/**
+ * @brief Prints an error message for a command-line option given without its argument
+ * @param[in] option The option character
+ * @return int Always returns 1
+ */
+int Err_Print_MissingArgument(const char* option);
+
+/**
+ * @brief Prints an error message for an invalid long command-line option
+ * @param[in] option The invalid option string including its "--" prefix
+ * @return int Always returns 1
+ */
+int Err_Print_BadLongOption(const char* option);
+
 /**
  * @brief Prints an error message for an unrecognized file format
  * @param[in] file_name Name of the file with the bad format
@@ -40,4 +54,37 @@ int Err_Print_BadFormat(const char* file_name);
  */
 int Err_Print_Errno(const char* file_name);
 
+/**
+ * @brief Prints an error message for an option given the wrong number of files
+ * @param[in] option The option string including its "--" prefix
+ * @param[in] file_num Number of files the option requires (single digit)
+ * @return int Always returns 1
+ */
+int Err_Print_BadFileCount(const char* option, unsigned int file_num);
+
+/**
+ * @brief Prints an error message for an address that could not be parsed
+ * @param[in] addr The address text as given
+ * @return int Always returns 1
+ */
+int Err_Print_BadAddress(const char* addr);
+
+/**
+ * @brief Prints an error message for a name pattern that could not be compiled
+ * @param[in] pattern The pattern text as given
+ * @param[in] too_complex Non-zero if the pattern is valid but the automaton would be too large
+ * @return int Always returns 1
+ */
+int Err_Print_BadPattern(const char* pattern, unsigned short too_complex);
+
+/**
+ * @brief Prints an error message for an option argument outside its allowed range
+ * @param[in] option The option character
+ * @param[in] arg The argument text as given
+ * @param[in] min Smallest allowed value
+ * @param[in] max Largest allowed value
+ * @return int Always returns 1
+ */
+int Err_Print_BadRange(const char* option, const char* arg, unsigned int min, unsigned int max);
+
 #endif /* _IG_ERROR_H_ */
@@ -25,6 +25,17 @@
 #define UNKNOWN_FORMAT ": file format not recognized\n"
 #define BAD_ALLOC "Malloc failed\n"
 #define BAD_OPTION "invalid option -- "
+#define MISSING_ARGUMENT "option requires an argument -- "
+#define BAD_LONG_OPTION "unrecognized option "
+#define BAD_FILE_COUNT "option "
+#define BAD_FILE_COUNT_REQ " requires "
+#define BAD_FILE_COUNT_FILES " files\n"
+#define BAD_ADDRESS ": not a valid address\n"
+#define BAD_PATTERN ": invalid pattern\n"
+#define BIG_PATTERN ": patterns too complex\n"
+#define BAD_ARGUMENT "invalid argument "
+#define BAD_ARGUMENT_TO " to option -- "
+#define BAD_ARGUMENT_RANGE ": allowed range is "
 
 /**
  * @brief Calculates the length of a string
@@ -67,6 +78,23 @@ static void Print_File(int fd, const char* filename)
     // Note: Missing closing single quote in original code
 }
 
+/**
+ * @brief Prints an unsigned decimal number to a file descriptor
+ * @param[in] fd File descriptor to write to
+ * @param[in] num Number to print
+ */
+static void Print_Num(int fd, unsigned int num)
+{
+    char digits[10];        // Enough for any unsigned int
+    unsigned int cnt = 0U;  // Number of digits
+
+    do {
+        digits[sizeof(digits) - ++cnt] = (char)('0' + (num % 10U));
+        num /= 10U;
+    } while (num != 0U);
+    write(fd, &digits[sizeof(digits) - cnt], cnt);  // Write the digits, most significant first
+}
+
 /**
  * @brief Prints an error message for memory allocation failure
  * @return int Always returns 1
@@ -92,6 +120,36 @@ int Err_Print_BadOption(const char* option)
     return (1);                                        // Return error code
 }
 
+/**
+ * @brief Prints an error message for a command-line option given without its argument
+ * @param[in] option The option character
+ * @return int Always returns 1
+ */
+int Err_Print_MissingArgument(const char* option)
+{
+    Print_App(STDERR_FILENO);                          // Print app name to stderr
+    write(STDERR_FILENO, MISSING_ARGUMENT, ft_strlen(MISSING_ARGUMENT));  // Print "option requires an argument -- "
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, option, 1);                   // Print the option char
+    write(STDERR_FILENO, "'\n", 2);                    // Print closing quote and newline
+    return (1);                                        // Return error code
+}
+
+/**
+ * @brief Prints an error message for an invalid long command-line option
+ * @param[in] option The invalid option string including its "--" prefix
+ * @return int Always returns 1
+ */
+int Err_Print_BadLongOption(const char* option)
+{
+    Print_App(STDERR_FILENO);                          // Print app name to stderr
+    write(STDERR_FILENO, BAD_LONG_OPTION, ft_strlen(BAD_LONG_OPTION));  // Print "unrecognized option "
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, option, ft_strlen(option));   // Print the invalid option string
+    write(STDERR_FILENO, "'\n", 2);                    // Print closing quote and newline
+    return (1);                                        // Return error code
+}
+
 /**
  * @brief Prints an error message for an unrecognized file format
  * @param[in] file_name Name of the file with the bad format
@@ -117,3 +175,84 @@ int Err_Print_Errno(const char* file_name)
     perror("'");                     // Print errno message with quote prefix
     return (1);                      // Return error code
 }
+
+/**
+ * @brief Prints an error message for an option given the wrong number of files
+ * @param[in] option The option string including its "--" prefix
+ * @param[in] file_num Number of files the option requires (single digit)
+ * @return int Always returns 1
+ */
+int Err_Print_BadFileCount(const char* option, unsigned int file_num)
+{
+    char digit = (char)('0' + (file_num % 10));        // Required file count as a digit
+
+    Print_App(STDERR_FILENO);                          // Print app name to stderr
+    write(STDERR_FILENO, BAD_FILE_COUNT, ft_strlen(BAD_FILE_COUNT));  // Print "option "
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, option, ft_strlen(option));   // Print the option string
+    write(STDERR_FILENO, "'", 1);                      // Print closing single quote
+    write(STDERR_FILENO, BAD_FILE_COUNT_REQ, ft_strlen(BAD_FILE_COUNT_REQ));  // Print " requires "
+    write(STDERR_FILENO, &digit, 1);                   // Print the file count
+    write(STDERR_FILENO, BAD_FILE_COUNT_FILES, ft_strlen(BAD_FILE_COUNT_FILES));  // Print " files"
+    return (1);                                        // Return error code
+}
+
+/**
+ * @brief Prints an error message for an address that could not be parsed
+ * @param[in] addr The address text as given
+ * @return int Always returns 1
+ */
+int Err_Print_BadAddress(const char* addr)
+{
+    Print_App(STDERR_FILENO);                          // Print app name to stderr
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, addr, ft_strlen(addr));       // Print the address text
+    write(STDERR_FILENO, "'", 1);                      // Print closing single quote
+    write(STDERR_FILENO, BAD_ADDRESS, ft_strlen(BAD_ADDRESS));  // Print ": not a valid address"
+    return (1);                                        // Return error code
+}
+
+/**
+ * @brief Prints an error message for a name pattern that could not be compiled
+ * @param[in] pattern The pattern text as given
+ * @param[in] too_complex Non-zero if the pattern is valid but the automaton would be too large
+ * @return int Always returns 1
+ */
+int Err_Print_BadPattern(const char* pattern, unsigned short too_complex)
+{
+    const char *reason = (too_complex != 0) ? BIG_PATTERN : BAD_PATTERN;
+
+    Print_App(STDERR_FILENO);                          // Print app name to stderr
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, pattern, ft_strlen(pattern)); // Print the pattern text
+    write(STDERR_FILENO, "'", 1);                      // Print closing single quote
+    write(STDERR_FILENO, reason, ft_strlen(reason));   // Print the reason
+    return (1);                                        // Return error code
+}
+
+/**
+ * @brief Prints an error message for an option argument outside its allowed range
+ * @param[in] option The option character
+ * @param[in] arg The argument text as given
+ * @param[in] min Smallest allowed value
+ * @param[in] max Largest allowed value
+ * @return int Always returns 1
+ */
+int Err_Print_BadRange(const char* option, const char* arg, unsigned int min, unsigned int max)
+{
+    Print_App(STDERR_FILENO);                          // Print app name to stderr
+    write(STDERR_FILENO, BAD_ARGUMENT, ft_strlen(BAD_ARGUMENT));  // Print "invalid argument "
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, arg, ft_strlen(arg));         // Print the argument text
+    write(STDERR_FILENO, "'", 1);                      // Print closing single quote
+    write(STDERR_FILENO, BAD_ARGUMENT_TO, ft_strlen(BAD_ARGUMENT_TO));  // Print " to option -- "
+    write(STDERR_FILENO, "'", 1);                      // Print opening single quote
+    write(STDERR_FILENO, option, 1);                   // Print the option char
+    write(STDERR_FILENO, "'", 1);                      // Print closing single quote
+    write(STDERR_FILENO, BAD_ARGUMENT_RANGE, ft_strlen(BAD_ARGUMENT_RANGE));  // Print ": allowed range is "
+    Print_Num(STDERR_FILENO, min);                     // Print the smallest value
+    write(STDERR_FILENO, "..", 2);                     // Print the range separator
+    Print_Num(STDERR_FILENO, max);                     // Print the largest value
+    write(STDERR_FILENO, "\n", 1);                     // Print newline
+    return (1);                                        // Return error code
+}
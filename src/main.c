@@ -10,18 +10,35 @@
  * command-line options for filtering and sorting symbols.
  */
 
-#include "../ElfParser/inc_pub/elfparser_header.h"
 #include "../ElfParser/inc_pub/elfparser_secthead.h"
 #include "../ElfParser/inc_pub/elfparser_symtable.h"
 #include "../FileHandler/inc_pub/filehandler.h"
 #include "../LinkedList/inc_pub/linkedlist.h"
 #include "../Writer/inc_pub/writer.h"
 #include "../Writer/inc_pub/writer_flagprint.h"
+#include "../Writer/inc_pub/writer_nameprint.h"
+#include "../Writer/inc_pub/writer_binary.h"
+#include "../Stats/inc_pub/stats.h"
+#include "../Trace/inc_pub/trace.h"
+#include "../Probe/inc_pub/probe.h"
+#include "../Intern/inc_pub/intern.h"
+#include "../Resolve/inc_pub/resolve.h"
+#include "../Diff/inc_pub/diff.h"
+#include "../Watch/inc_pub/watch.h"
+#include "../SymTab/inc_pub/symtab.h"
+#include "../FtNm/inc_pub/ftnm_elf.h"
+#include "../Scan/inc_pub/scan.h"
+#include "../Addr/inc_pub/addr.h"
+#include "../DebugLine/inc_pub/debugline.h"
+#include "../Match/inc_pub/match.h"
 #include "../inc/error.h"
 
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
 
 // Boolean definitions
 #define FT_TRUE     1u
@@ -32,342 +49,1762 @@
 #define NORMAL_SORT     1u
 #define REVERSE_SORT    2u
 
+// Sorting key definitions
+#define SORT_KEY_NAME   0u
+#define SORT_KEY_VALUE  1u
+#define SORT_KEY_SIZE   2u
+
+// Symbol layout definitions
+#define LAYOUT_LIST     0u  /**< Linked list of writer_line_t (--resolve, --top) */
+#define LAYOUT_TABLE    1u  /**< Structure-of-arrays symbol table */
+#define LAYOUT_CHUNKED  2u  /**< Sorted runs of slices of the table merged from disk (--max-memory) */
+#define LAYOUT_STREAM   3u  /**< Entries printed as they are read, without sorting (-p) */
+#define LAYOUT_RANGE    4u  /**< Address index of the sized symbols (--start-address / --stop-address) */
+
+// Output format definitions
+#define FORMAT_TEXT     0u
+#define FORMAT_BINARY   1u
+
+// Long option definitions
+#define LONG_OPTION_PREFIX      "--"
+#define LONG_OPTION_PREFIX_LEN  2u
+#define LONG_OPTION_STATS       "--stats"
+#define LONG_OPTION_TRACE       "--trace="
+#define LONG_OPTION_TRACE_LEN   8u
+#define LONG_OPTION_NUMERIC     "--numeric-sort"
+#define LONG_OPTION_PRINT_SIZE  "--print-size"
+#define LONG_OPTION_SIZE_SORT   "--size-sort"
+#define LONG_OPTION_TOP         "--top="
+#define LONG_OPTION_TOP_LEN     6u
+#define LONG_OPTION_DEMANGLE    "--demangle"
+#define LONG_OPTION_RESOLVE     "--resolve"
+#define LONG_OPTION_DIFF        "--diff"
+#define LONG_OPTION_DYNAMIC     "--dynamic"
+#define LONG_OPTION_WATCH       "--watch"
+#define LONG_OPTION_MAX_MEMORY  "--max-memory="
+#define LONG_OPTION_MAX_MEMORY_LEN 13u
+#define LONG_OPTION_ADDR        "--addr"
+#define LONG_OPTION_START_ADDR  "--start-address="
+#define LONG_OPTION_START_ADDR_LEN 16u
+#define LONG_OPTION_STOP_ADDR   "--stop-address="
+#define LONG_OPTION_STOP_ADDR_LEN 15u
+#define LONG_OPTION_MATCH       "--match="
+#define LONG_OPTION_MATCH_LEN   8u
+#define LONG_OPTION_MATCH_FILE  "--match-file="
+#define LONG_OPTION_MATCH_FILE_LEN 13u
+#define LONG_OPTION_FORMAT      "--format="
+#define FORMAT_NAME_TEXT        "bsd"
+#define FORMAT_NAME_BINARY      "binary"
+
+// Short options taking an argument, in the same argument (-RDIR) or the next one (-R DIR)
+#define SHORT_OPTION_RECURSIVE  'R'  /**< Directory to scan */
+#define SHORT_OPTION_JOBS       'j'  /**< Number of threads formatting sorted output */
+#define SHORT_OPTIONS_WITH_ARG  "Rj"
+
+// Symbol table section names
+#define SYMTAB_NAME_STATIC      ".symtab"
+#define SYMTAB_NAME_DYNAMIC     ".dynsym"
+
+// Quiet time closing a burst of changes in --watch mode, in milliseconds
+#define WATCH_DEBOUNCE_MS       200u
+
+// Number of files compared by --diff
+#define DIFF_FILE_NUM           2u
+
+// Bytes --addr reads from stdin at a time
+#define ADDR_READ_SIZE          (64u * 1024u)
+// Most hex digits of an address
+#define ADDR_DIGITS_MAX         16u
+
+// Memory held per listed symbol (line, list node and their allocation headers), for --max-memory
+#define MAX_MEMORY_SYMBOL_COST  (sizeof(writer_line_t) + sizeof(dl_list_t) + 2u * sizeof(size_t))
+// Fewest symbols sorted in one --max-memory run
+#define MAX_MEMORY_CHUNK_MIN    1024u
+
+// Trace category of per-file events
+#define TRACE_CATEGORY_FILE     "file"
+
 // Return code definitions
 #define RET_OK 0u
 #define RET_FILE_ERR 1u
 #define RET_PARSE_ERR 2u
 
-// Forward declaration of line comparison function for sorting
-int lineCmp(const writer_line_t *line1, const writer_line_t *line2);
+/**
+ * @brief Symbol filter applied before symbols are materialized
+ */
+typedef struct symbol_filter_s
+{
+    ftnm_filter_t sym;              /**< Per-symbol filter (-g / -u / --size-sort / --match) */
+    size_t top;                     /**< Keep only the top largest symbols, 0 keeps all */
+} symbol_filter_t;
+
+/**
+ * @brief Options of a run, shared by every target file
+ */
+typedef struct symbol_run_s
+{
+    symbol_filter_t filter;     /**< Symbol filter */
+    unsigned short sort;        /**< Sorting mode (NO_SORT, NORMAL_SORT, REVERSE_SORT) */
+    unsigned short sort_key;    /**< Sorting key (SORT_KEY_NAME, SORT_KEY_VALUE, SORT_KEY_SIZE) */
+    unsigned short format;      /**< Output format (FORMAT_TEXT, FORMAT_BINARY) */
+    unsigned short demangle;    /**< Demangle names (-C) */
+    unsigned short resolve;     /**< Add symbols to the --resolve index instead of printing them */
+    const char *symtab_name;    /**< Name of the symbol table section to read */
+    size_t max_memory;          /**< Memory bound of the symbol list in bytes (--max-memory), 0 for none */
+    size_t jobs;                /**< Threads formatting sorted output (-j), 0 to pick them by output size */
+    writer_ctx_t *writer;       /**< Writer context the files are printed with */
+    unsigned short addr_range;  /**< List the sized symbols starting in [addr_start, addr_stop) */
+    uint64_t addr_start;        /**< First address listed (--start-address) */
+    uint64_t addr_stop;         /**< Address past the listed range (--stop-address) */
+    unsigned short lines;       /**< Print the source line of the defined symbols (-l) */
+} symbol_run_t;
+
+/**
+ * @brief One of the two files compared by --diff
+ */
+typedef struct symbol_diff_file_s
+{
+    const char *file_name;            /**< Path of the file */
+    const char *symtab_name;          /**< Name of the symbol table section to read */
+    source_file_t file;               /**< Opened file, holding its string table mapping */
+    ftnm_symslice_t slices;           /**< Symbol table, read a slice at a time */
+    ftnm_sects_t sects;               /**< Section headers */
+    writer_bit_t file_bit;            /**< File bit width */
+    unsigned int ret;                 /**< Result of FtNm_Elf_fileParse */
+    int err;                          /**< errno left by FtNm_Elf_fileParse */
+    dl_list_t *head;                  /**< Symbol list */
+    diff_side_t side;                 /**< Sorted symbols compared by the diff */
+} symbol_diff_file_t;
+
+/**
+ * @brief Entry of the bounded heap used to select the largest symbols (--top)
+ */
+typedef struct symbol_top_s
+{
+    writer_line_t *line;  /**< Selected symbol line */
+    size_t seq;           /**< Position of the symbol in the table, orders equal sizes */
+} symbol_top_t;
+
+/**
+ * @brief Sorted symbol arrays read by symbol_tableLineGet
+ */
+typedef struct symbol_range_s
+{
+    const symtab_t *tab;   /**< Symbol table */
+    unsigned short sort;   /**< Sorting mode (NO_SORT, NORMAL_SORT, REVERSE_SORT) */
+} symbol_range_t;
+
+/**
+ * @brief Positions of the address index read by symbol_addrLineGet
+ */
+typedef struct symbol_addr_range_s
+{
+    const addr_index_t *index;  /**< Sorted address index */
+    size_t first;               /**< Position of the first listed symbol */
+    size_t end;                 /**< Position past the last listed symbol */
+    unsigned short reverse;     /**< FT_TRUE to list from the highest address down (-r) */
+} symbol_addr_range_t;
+
+/**
+ * @brief Output settings passed to symbol_emitLine by the external sort
+ */
+typedef struct symbol_emit_s
+{
+    writer_ctx_t *writer;    /**< Writer context of the file */
+    unsigned short format;   /**< Output format (FORMAT_TEXT, FORMAT_BINARY) */
+} symbol_emit_t;
+
+// Forward declaration of line comparison function for sorting
+int lineCmp(const writer_line_t *line1, const writer_line_t *line2, const void *arg);
+
+/**
+ * @brief Maps a libftnm result to the return codes of ft_nm
+ * @param[in] ret FN_* result
+ * @return unsigned int RET_OK on success, RET_FILE_ERR for file errors (errno set),
+ *         RET_PARSE_ERR for malformed input or failed allocation
+ */
+static unsigned int symbol_retGet(int ret)
+{
+    if ((ret == FN_SUCCESS) || (ret == FN_FILTERED))
+    {
+        return (RET_OK);
+    }
+    return ((ret == FN_ERR_FILE_FAIL) ? RET_FILE_ERR : RET_PARSE_ERR);
+}
+
+/**
+ * @brief Maps a result of the binary writer to the return codes of ft_nm
+ * @param[in] ret WR_* result
+ * @return unsigned int RET_OK on success, RET_PARSE_ERR for failed allocation,
+ *         RET_FILE_ERR for failed writes or a block too large for the format (errno set)
+ */
+static unsigned int symbol_writerRetGet(int ret)
+{
+    if (ret == WR_SUCCESS)
+    {
+        return (RET_OK);
+    }
+    if (ret == WR_ERR_MALLOC_FAIL)
+    {
+        return (RET_PARSE_ERR);
+    }
+    if (ret == WR_ERR_OVERFLOW)
+    {
+        errno = EOVERFLOW;
+    }
+    return (RET_FILE_ERR);
+}
+
+/**
+ * @brief Ends the binary block of a file and merges its result into ret
+ *
+ * A failed line is remembered by the writer and returned here, so the lines
+ * of a block need no check of their own.
+ *
+ * @param[in,out] writer Writer context of the file
+ * @param[in] ret Result of listing the file so far
+ * @return unsigned int ret if it is an error, otherwise the result of ending the block
+ */
+static unsigned int symbol_binaryEnd(writer_ctx_t *writer, unsigned int ret)
+{
+    unsigned int end_ret = symbol_writerRetGet(Writer_BinaryPrint_end(writer));
+
+    return ((ret != RET_OK) ? ret : end_ret);
+}
+
+/**
+ * @brief Checks whether heap entry a is to be evicted before heap entry b
+ *
+ * Smaller symbols are evicted first; of equal sizes the one seen later in the
+ * table goes first, so the earliest symbols win ties at the --top boundary.
+ *
+ * @param[in] a First heap entry
+ * @param[in] b Second heap entry
+ * @return unsigned short FT_TRUE if a is below b in the heap order, FT_FALSE otherwise
+ */
+static unsigned short symbol_topLess(const symbol_top_t *a, const symbol_top_t *b)
+{
+    if (a->line->size != b->line->size)
+    {
+        return (a->line->size < b->line->size);
+    }
+    return (a->seq > b->seq);
+}
+
+/**
+ * @brief Orders heap entries by their position in the table (qsort comparator)
+ * @param[in] a First symbol_top_t
+ * @param[in] b Second symbol_top_t
+ * @return int Negative, zero or positive as a comes before, with or after b in the table
+ */
+static int symbol_topSeqCmp(const void *a, const void *b)
+{
+    size_t seq_a = ((const symbol_top_t *)a)->seq;
+    size_t seq_b = ((const symbol_top_t *)b)->seq;
+
+    return ((seq_a > seq_b) - (seq_a < seq_b));
+}
+
+/**
+ * @brief Restores the min-heap order from a position towards the root
+ * @param[in,out] heap Heap array
+ * @param[in] pos Position of the entry to move up
+ */
+static void symbol_topSiftUp(symbol_top_t *heap, size_t pos)
+{
+    symbol_top_t entry = heap[pos];
+
+    while (pos > 0)
+    {
+        size_t parent = (pos - 1) / 2;
+        if (symbol_topLess(&entry, &heap[parent]) == FT_FALSE)
+        {
+            break;
+        }
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+    heap[pos] = entry;
+}
+
+/**
+ * @brief Restores the min-heap order from the root towards the leaves
+ * @param[in,out] heap Heap array
+ * @param[in] len Number of entries in the heap
+ */
+static void symbol_topSiftDown(symbol_top_t *heap, size_t len)
+{
+    symbol_top_t entry = heap[0];
+    size_t pos = 0;
+
+    while ((2 * pos + 1) < len)
+    {
+        size_t child = 2 * pos + 1;
+        if (((child + 1) < len) && (symbol_topLess(&heap[child + 1], &heap[child]) == FT_TRUE))
+        {
+            child++;  // Take the smaller child
+        }
+        if (symbol_topLess(&heap[child], &entry) == FT_FALSE)
+        {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = entry;
+}
+
+/**
+ * @brief Replaces the name of a kept symbol line by its interned copy (--resolve, --diff)
+ *
+ * Only the modes whose lists of several files live together intern names, so
+ * the names outlive the file they came from. If the name cannot be interned
+ * the line keeps resolving it lazily from the string table of its file, and
+ * compares equal to an interned copy by content, not by pointer.
+ *
+ * @param[in] writer Writer context with the string table of the file loaded
+ * @param[in,out] line Symbol line added to the list
+ */
+static void symbol_nameIntern(const writer_ctx_t *writer, writer_line_t *line)
+{
+    const char *name;
+
+    if (Intern_isEnabled())
+    {
+        name = Writer_lineNameGet(writer, line);
+        if (name != NULL)
+        {
+            line->name = Intern_string(name, strlen(name));
+        }
+    }
+}
+
+/**
+ * @brief Creates a linked list of symbols from the symbol table
+ *
+ * The filter is applied to the raw table entry by FtNm_Elf_sliceEntryRead, so
+ * rejected symbols never get a writer_line_t allocated or a list node
+ * created. Names are not looked up
+ * here: lines keep the st_name offset, which is only checked against the
+ * string table length, and are resolved by Writer_lineNameGet on first use.
+ * With filter->top set, the largest symbols are kept in a bounded min-heap
+ * whose evicted lines are reused, so at most top lines are ever allocated and
+ * only they are added to the list. With --resolve and --diff, the names of the
+ * symbols added to the list are replaced by their copies in the global intern table.
+ *
+ * @param[in,out] head_p Pointer to head of linked list to populate
+ * @param[in,out] slices Symbol table to process, read a slice at a time
+ * @param[in] filter Symbol filter (-g / -u / --size-sort / --top) to apply
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @param[in] sym_first Index of the first symbol to process (1 skips the null symbol)
+ * @param[in] sym_end Index past the last symbol to process
+ * @param[in] writer Writer context with the string table of the file loaded, for --resolve and --diff
+ * @return unsigned int RET_OK on success, error code on failure
+ */
+unsigned int symbol_list_create(dl_list_t **head_p, ftnm_symslice_t *slices, 
+                              const symbol_filter_t *filter, const char *strtab, size_t strtab_len,
+                              size_t sym_first, size_t sym_end, const writer_ctx_t *writer)
+{
+    writer_line_t *new_line;
+    writer_line_t line;
+    int read_ret;
+    symbol_top_t *heap = NULL;
+    size_t heap_len = 0;
+    unsigned int ret = RET_OK;
+
+    // Allocate the --top heap, bounded by the table size
+    if (filter->top != 0)
+    {
+        size_t heap_cap = (filter->top < (sym_end - sym_first)) ? filter->top : (sym_end - sym_first);
+        STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+        STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, (heap_cap + 1) * sizeof(symbol_top_t));
+        heap = malloc((heap_cap + 1) * sizeof(symbol_top_t));
+        if (heap == NULL)
+        {
+            return(RET_PARSE_ERR);  // Memory allocation error
+        }
+    }
+
+    // Process each symbol of the range
+    for (size_t i = sym_first; i < sym_end; i++)
+    {
+        read_ret = FtNm_Elf_sliceEntryRead(slices, i, &filter->sym, strtab, strtab_len, &line);
+        ret = symbol_retGet(read_ret);
+        if (ret != RET_OK)
+        {
+            break;
+        }
+        if (read_ret == FN_FILTERED)
+        {
+            continue;
+        }
+
+        if ((heap != NULL) && (heap_len == filter->top))
+        {
+            // Heap is full: skip symbols not larger than the smallest kept one
+            if (line.size <= heap[0].line->size)
+            {
+                STATS_COUNT(STATS_COUNTER_SYM_FILTERED, 1);
+                continue;
+            }
+            new_line = heap[0].line;  // Reuse the evicted line
+        }
+        else
+        {
+            // Allocate memory for new symbol line
+            STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+            STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, sizeof(writer_line_t));
+            new_line = malloc(sizeof(writer_line_t));
+            if (new_line == NULL)
+            {
+                ret = RET_PARSE_ERR;  // Memory allocation error
+                break;
+            }
+        }
+        *new_line = line;
+
+        if (heap == NULL)
+        {
+            // Add to linked list
+            symbol_nameIntern(writer, new_line);
+            LinkedList_nodePushFront(head_p, new_line);
+        }
+        else if (heap_len == filter->top)
+        {
+            // Replace the smallest kept symbol
+            heap[0].seq = i;
+            symbol_topSiftDown(heap, heap_len);
+        }
+        else
+        {
+            // Add to the heap
+            heap[heap_len].line = new_line;
+            heap[heap_len].seq = i;
+            symbol_topSiftUp(heap, heap_len);
+            heap_len++;
+        }
+    }
+
+    // Move the kept symbols to the linked list in table order, which -p keeps; it frees them on cleanup
+    if (heap_len > 1)
+    {
+        qsort(heap, heap_len, sizeof(symbol_top_t), symbol_topSeqCmp);
+    }
+    for (size_t j = 0; j < heap_len; j++)
+    {
+        symbol_nameIntern(writer, heap[j].line);
+        LinkedList_nodePushFront(head_p, heap[j].line);
+    }
+    free(heap);
+    return (ret);
+}
+
+/**
+ * @brief Demangles the names of the listed symbols ahead of printing (-C)
+ *
+ * The lines are gathered in list order so the writer can split them across
+ * threads; if the array cannot be allocated, names are demangled as they are
+ * printed instead.
+ *
+ * @param[in,out] writer Writer context
+ * @param[in] head Head of the symbol list
+ */
+static void symbol_demangle(writer_ctx_t *writer, const dl_list_t *head)
+{
+    writer_line_t **lines;
+    size_t line_cnt = 0;
+
+    for (const dl_list_t *node = head; node != NULL; node = node->next)
+    {
+        line_cnt++;
+    }
+    if (line_cnt == 0)
+    {
+        return;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, line_cnt * sizeof(writer_line_t *));
+    lines = malloc(line_cnt * sizeof(writer_line_t *));
+    if (lines == NULL)
+    {
+        return;  // Demangled by the writer instead
+    }
+    line_cnt = 0;
+    for (const dl_list_t *node = head; node != NULL; node = node->next)
+    {
+        lines[line_cnt++] = node->line;
+    }
+    Writer_NamePrint_demangleAhead(writer, lines, line_cnt);
+    free(lines);
+}
+
+/**
+ * @brief Prints one symbol line in the selected output format
+ * @param[in,out] writer Writer context of the file
+ * @param[in] line Symbol line to print
+ * @param[in] format Output format (FORMAT_TEXT, FORMAT_BINARY)
+ */
+static void symbol_linePrint(writer_ctx_t *writer, const writer_line_t *line, unsigned short format)
+{
+    if (format == FORMAT_BINARY)
+    {
+        Writer_BinaryPrint_line(writer, line);
+    }
+    else
+    {
+        Writer_linePrint(writer, line);
+    }
+}
+
+/**
+ * @brief Prints symbols from the linked list
+ * @param[in,out] writer Writer context of the file
+ * @param[in] head Head of the symbol list
+ * @param[in] sort Sorting mode (NO_SORT, NORMAL_SORT, REVERSE_SORT)
+ * @param[in] format Output format (FORMAT_TEXT, FORMAT_BINARY)
+ * @param[in] file_name Name of the file, recorded in binary output
+ * @return unsigned int RET_OK on success, error code if the binary block could not be written
+ */
+unsigned int symbol_print(writer_ctx_t *writer, const dl_list_t *head, unsigned short sort,
+                          unsigned short format, const char *file_name)
+{
+    if ((format == FORMAT_BINARY) && (Writer_BinaryPrint_begin(writer, file_name) != WR_SUCCESS))
+    {
+        return (RET_PARSE_ERR);
+    }
+    if (sort == NORMAL_SORT)
+    {
+        // Print symbols in forward order
+        for (const dl_list_t *node = head; node != NULL; node = node->next)
+        {
+            symbol_linePrint(writer, node->line, format);
+        }
+    }
+    else if (head != NULL)
+    {
+        // Find last node for reverse printing
+        const dl_list_t *node = head;
+        for (; node->next != NULL; node = node->next)
+        {
+            ;
+        }
+        // Print symbols in reverse order
+        for (; node != NULL; node = node->prev)
+        {
+            symbol_linePrint(writer, node->line, format);
+        }
+    }
+    return ((format == FORMAT_BINARY) ? symbol_binaryEnd(writer, RET_OK) : RET_OK);
+}
+
+/**
+ * @brief Fills the symbol arrays of a file from its symbol table
+ *
+ * The arrays are sized for the whole table up front and the symbols kept by
+ * the filter are appended in table order.
+ *
+ * @param[out] tab Symbol table to create; freed by the caller with SymTab_free
+ * @param[in,out] slices Symbol table to process, read a slice at a time
+ * @param[in] filter Symbol filter (-g / -u / --size-sort) to apply
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @return unsigned int RET_OK on success, error code on failure
+ */
+static unsigned int symbol_table_create(symtab_t *tab, ftnm_symslice_t *slices, const symbol_filter_t *filter,
+                                        const char *strtab, size_t strtab_len)
+{
+    size_t sym_cnt = slices->sym_cnt;
+    writer_line_t line;
+    int read_ret;
+    unsigned int ret = RET_OK;
+
+    if (SymTab_create(tab, (sym_cnt > 1) ? (sym_cnt - 1) : 0, strtab, strtab_len) != ST_SUCCESS)
+    {
+        return (RET_PARSE_ERR);  // Memory allocation error
+    }
+    for (size_t i = 1; (i < sym_cnt) && (ret == RET_OK); i++)
+    {
+        read_ret = FtNm_Elf_sliceEntryRead(slices, i, &filter->sym, strtab, strtab_len, &line);
+        ret = symbol_retGet(read_ret);
+        if (read_ret == FN_SUCCESS)
+        {
+            SymTab_push(tab, &line);  // Sized for every entry but the null symbol
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Demangles the names of the symbol arrays ahead of printing (-C)
+ *
+ * If the name array cannot be allocated, names are demangled as they are
+ * printed instead.
+ *
+ * @param[in,out] writer Writer context
+ * @param[in,out] tab Symbol table; its display array is set
+ */
+static void symbol_tableDemangle(writer_ctx_t *writer, symtab_t *tab)
+{
+    const char **names;
+
+    if (tab->len == 0)
+    {
+        return;
+    }
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, tab->len * sizeof(const char *));
+    names = malloc(tab->len * sizeof(const char *));
+    if (names == NULL)
+    {
+        return;  // Demangled by the writer instead
+    }
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        names[i] = SymTab_nameGet(tab, i);
+    }
+    Writer_NamePrint_demangleNames(writer, names, tab->len);
+    tab->display = names;
+}
+
+/**
+ * @brief Reads the symbol at a position of the printed order of the symbol arrays
+ * @param[in] pos Position in the printed order
+ * @param[out] line Line of the symbol
+ * @param[in] arg Pointer to the symbol_range_t of the arrays
+ */
+static void symbol_tableLineGet(size_t pos, writer_line_t *line, const void *arg)
+{
+    const symbol_range_t *range = arg;
+    const symtab_t *tab = range->tab;
+    size_t idx = pos;
+
+    if ((range->sort != NO_SORT) && (tab->order != NULL))
+    {
+        idx = (range->sort == NORMAL_SORT) ? tab->order[pos] : tab->order[tab->len - 1 - pos];
+    }
+    SymTab_lineGet(tab, idx, line);
+}
+
+/**
+ * @brief Prints the symbols of the symbol arrays
+ *
+ * If the sort failed, symbols are printed in table order, which is also
+ * what symbol_print gives for an unsorted list. Text output is formatted
+ * by the writer on jobs threads.
+ *
+ * @param[in,out] writer Writer context of the file
+ * @param[in] tab Symbol table
+ * @param[in] sort Sorting mode (NO_SORT, NORMAL_SORT, REVERSE_SORT)
+ * @param[in] format Output format (FORMAT_TEXT, FORMAT_BINARY)
+ * @param[in] file_name Name of the file, recorded in binary output
+ * @param[in] jobs Formatting threads, 0 to pick them by output size
+ * @return unsigned int RET_OK on success, error code if the binary block could not be written
+ */
+static unsigned int symbol_tablePrint(writer_ctx_t *writer, const symtab_t *tab, unsigned short sort,
+                                      unsigned short format, const char *file_name, size_t jobs)
+{
+    symbol_range_t range = {tab, sort};
+    writer_line_t line;
+
+    if (format == FORMAT_TEXT)
+    {
+        Writer_rangePrint(writer, tab->len, symbol_tableLineGet, &range, jobs);
+        return (RET_OK);
+    }
+    if (Writer_BinaryPrint_begin(writer, file_name) != WR_SUCCESS)
+    {
+        return (RET_PARSE_ERR);
+    }
+    for (size_t i = 0; i < tab->len; i++)
+    {
+        symbol_tableLineGet(i, &line, &range);
+        Writer_BinaryPrint_line(writer, &line);
+    }
+    return (symbol_binaryEnd(writer, RET_OK));
+}
+
+/**
+ * @brief Lists the symbols of a file from the symbol arrays
+ * @param[in,out] slices Symbol table to process, read a slice at a time
+ * @param[in] run Options of the run
+ * @param[in] file_name Name of the file, recorded in binary output
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @return unsigned int RET_OK on success, error code on failure
+ */
+static unsigned int symbol_tableProcess(ftnm_symslice_t *slices, const symbol_run_t *run, const char *file_name,
+                                        const char *strtab, size_t strtab_len)
+{
+    symtab_t tab;
+    unsigned int ret;
+    uint64_t stage_start;
+
+    // Create symbol arrays
+    stage_start = Stats_stageBegin(STATS_STAGE_SYMBOL_LIST);
+    ret = symbol_table_create(&tab, slices, &run->filter, strtab, strtab_len);
+    Stats_stageEnd(STATS_STAGE_SYMBOL_LIST, stage_start);
+    if (ret == RET_OK)
+    {
+        // Sort symbols if required; on failure they are printed in table order
+        if (run->sort != NO_SORT)
+        {
+            stage_start = Stats_stageBegin(STATS_STAGE_SORT);
+            SymTab_sort(&tab, (run->sort_key == SORT_KEY_VALUE) ? SYMTAB_KEY_VALUE :
+                              (run->sort_key == SORT_KEY_SIZE) ? SYMTAB_KEY_SIZE : SYMTAB_KEY_NAME, FtNm_nameCmp);
+            Stats_stageEnd(STATS_STAGE_SORT, stage_start);
+        }
+        // Demangle names ahead of the writer
+        if ((run->demangle == FT_TRUE) && (run->format == FORMAT_TEXT))
+        {
+            stage_start = Stats_stageBegin(STATS_STAGE_DEMANGLE);
+            symbol_tableDemangle(run->writer, &tab);
+            Stats_stageEnd(STATS_STAGE_DEMANGLE, stage_start);
+        }
+        // Print symbols
+        stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+        ret = symbol_tablePrint(run->writer, &tab, run->sort, run->format, file_name,
+                                ((run->demangle == FT_TRUE) && (tab.display == NULL)) ? 1 : run->jobs);  // Names left to the writer's demangler
+        Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
+    }
+    SymTab_free(&tab);
+    return (ret);
+}
+
+/**
+ * @brief Prints one line merged by the external sort (--max-memory)
+ * @param[in] line Symbol line to print
+ * @param[in] arg Pointer to the symbol_emit_t of the file
+ */
+static void symbol_emitLine(const writer_line_t *line, void *arg)
+{
+    const symbol_emit_t *emit = arg;
+
+    symbol_linePrint(emit->writer, line, emit->format);
+}
+
+/**
+ * @brief Selects how the symbols of each file of a run are held
+ *
+ * --resolve and --top work on the linked list. An address range is listed
+ * from the address index. The table order (-p) needs no symbol held at all
+ * and is streamed a slice of the table at a time. With --max-memory, the
+ * name order is produced a slice at a time; the value and size orders need
+ * every symbol at once, so they use the symbol arrays like every other run.
+ *
+ * @param[in] run Options of the run
+ * @return unsigned short LAYOUT_LIST, LAYOUT_RANGE, LAYOUT_TABLE, LAYOUT_CHUNKED or LAYOUT_STREAM
+ */
+static unsigned short symbol_layoutGet(const symbol_run_t *run)
+{
+    if ((run->resolve == FT_TRUE) || (run->filter.top != 0))
+    {
+        return (LAYOUT_LIST);
+    }
+    if (run->addr_range == FT_TRUE)
+    {
+        return (LAYOUT_RANGE);
+    }
+    if (run->sort == NO_SORT)
+    {
+        return (LAYOUT_STREAM);
+    }
+    if ((run->max_memory != 0) && (run->sort_key == SORT_KEY_NAME))
+    {
+        return (LAYOUT_CHUNKED);
+    }
+    return (LAYOUT_TABLE);
+}
+
+/**
+ * @brief Prints the symbols of a file in table order as they are read (-p)
+ *
+ * The table is read from the file a slice at a time, and each entry goes
+ * through the filter straight into the writer; no line is allocated, so
+ * memory stays bounded by one slice whatever the number of symbols. With -C,
+ * names are demangled by the writer as they are printed. The slices are
+ * first read once to check every entry, so a malformed entry fails the file
+ * before any of its symbols is printed.
+ *
+ * @param[in,out] slices Symbol table left in the file by FtNm_Elf_fileParse
+ * @param[in] run Options of the run
+ * @param[in] file_name Name of the file, recorded in binary output
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @return unsigned int RET_OK on success, RET_PARSE_ERR for a malformed entry,
+ *         RET_FILE_ERR if the table could not be read (errno set)
+ */
+static unsigned int symbol_streamPrint(ftnm_symslice_t *slices, const symbol_run_t *run, const char *file_name,
+                                       const char *strtab, size_t strtab_len)
+{
+    writer_line_t line;
+    int read_ret;
+    unsigned int ret;
+    uint64_t stage_start;
+
+    ret = symbol_retGet(FtNm_Elf_sliceCheck(slices, &run->filter.sym, strtab_len));
+    if (ret != RET_OK)
+    {
+        return (ret);
+    }
+    stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+    if ((run->format == FORMAT_BINARY) && (Writer_BinaryPrint_begin(run->writer, file_name) != WR_SUCCESS))
+    {
+        ret = RET_PARSE_ERR;
+    }
+    for (size_t i = 1; (i < slices->sym_cnt) && (ret == RET_OK); i++)
+    {
+        read_ret = FtNm_Elf_sliceEntryRead(slices, i, &run->filter.sym, strtab, strtab_len, &line);
+        ret = symbol_retGet(read_ret);
+        if (read_ret == FN_SUCCESS)
+        {
+            symbol_linePrint(run->writer, &line, run->format);
+        }
+    }
+    if (run->format == FORMAT_BINARY)
+    {
+        ret = symbol_binaryEnd(run->writer, ret);
+    }
+    Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
+    return (ret);
+}
+
+/**
+ * @brief Lists the symbols of a file a slice of the table at a time (--max-memory)
+ *
+ * Each slice holds as many symbols as fit in the memory bound. Its entries
+ * are read from the file, become a sorted run on disk and are freed before
+ * the next slice is read; the runs are merged in name order while printing.
+ * The output is the same as listing the whole table at once.
+ *
+ * @param[in,out] slices Symbol table left in the file by FtNm_Elf_fileParse
+ * @param[in] run Options of the run
+ * @param[in] file_name Name of the file, recorded in binary output
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @return unsigned int RET_OK on success, RET_PARSE_ERR for a malformed table,
+ *         RET_FILE_ERR if the table could not be read or the runs could not be stored (errno set)
+ */
+static unsigned int symbol_chunkedPrint(ftnm_symslice_t *slices, const symbol_run_t *run, const char *file_name,
+                                        const char *strtab, size_t strtab_len)
+{
+    symbol_emit_t emit = {run->writer, run->format};
+    ll_extsort_t *sorter = NULL;
+    dl_list_t *head = NULL;
+    size_t chunk = run->max_memory / MAX_MEMORY_SYMBOL_COST;
+    size_t sym_cnt = slices->sym_cnt;
+    unsigned int ret = RET_OK;
+    uint64_t stage_start;
+
+    if (chunk < MAX_MEMORY_CHUNK_MIN)
+    {
+        chunk = MAX_MEMORY_CHUNK_MIN;
+    }
+    if (LinkedList_extSortCreate(&sorter, run->max_memory, (run->sort == REVERSE_SORT), lineCmp, run->writer)
+        != LL_SUCCESS)
+    {
+        return (RET_FILE_ERR);
+    }
+    if ((run->format == FORMAT_BINARY) && (Writer_BinaryPrint_begin(run->writer, file_name) != WR_SUCCESS))
+    {
+        ret = RET_PARSE_ERR;
+    }
+
+    // Build and store one slice of the table at a time
+    for (size_t first = 1; (first < sym_cnt) && (ret == RET_OK); )
+    {
+        size_t end = ((sym_cnt - first) > chunk) ? (first + chunk) : sym_cnt;
+
+        stage_start = Stats_stageBegin(STATS_STAGE_SYMBOL_LIST);
+        ret = symbol_retGet(FtNm_Elf_sliceRead(slices, first, end));
+        if (ret == RET_OK)
+        {
+            ret = symbol_list_create(&head, slices, &run->filter, strtab, strtab_len, first, end, run->writer);
+        }
+        Stats_stageEnd(STATS_STAGE_SYMBOL_LIST, stage_start);
+        if (ret == RET_OK)
+        {
+            stage_start = Stats_stageBegin(STATS_STAGE_SORT);
+            if (LinkedList_extSortRunAdd(sorter, &head) != LL_SUCCESS)
+            {
+                ret = RET_FILE_ERR;
+            }
+            Stats_stageEnd(STATS_STAGE_SORT, stage_start);
+        }
+        LinkedList_delete(&head, free);
+        first = end;
+    }
+
+    // Merge the sorted runs into the output
+    if (ret == RET_OK)
+    {
+        stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+        if (LinkedList_extSortMerge(sorter, symbol_emitLine, &emit) != LL_SUCCESS)
+        {
+            ret = RET_FILE_ERR;
+        }
+        Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
+    }
+    if (run->format == FORMAT_BINARY)
+    {
+        ret = symbol_binaryEnd(run->writer, ret);
+    }
+    LinkedList_extSortFree(&sorter);
+    return (ret);
+}
+
+/**
+ * @brief Parses an address given in hex, with or without a 0x prefix
+ * @param[in] str Text to parse
+ * @param[out] addr Parsed address
+ * @return unsigned short FT_TRUE on success, FT_FALSE if str is not an address
+ */
+static unsigned short symbol_addrParse(const char *str, uint64_t *addr)
+{
+    uint64_t num = 0;
+    size_t digits = 0;
+
+    if ((str[0] == '0') && ((str[1] == 'x') || (str[1] == 'X')))
+    {
+        str += 2;
+    }
+    for (; *str != '\0'; str++, digits++)
+    {
+        unsigned int digit;
+
+        if ((*str >= '0') && (*str <= '9'))
+        {
+            digit = (unsigned int)(*str - '0');
+        }
+        else if ((*str >= 'a') && (*str <= 'f'))
+        {
+            digit = (unsigned int)(*str - 'a' + 10);
+        }
+        else if ((*str >= 'A') && (*str <= 'F'))
+        {
+            digit = (unsigned int)(*str - 'A' + 10);
+        }
+        else
+        {
+            return (FT_FALSE);
+        }
+        num = (num << 4) | digit;
+    }
+    if ((digits == 0) || (digits > ADDR_DIGITS_MAX))
+    {
+        return (FT_FALSE);
+    }
+    *addr = num;
+    return (FT_TRUE);
+}
 
 /**
- * @brief Parses an ELF file and populates symbol table and section header structures
- * @param[in] file_name Path to the ELF file to parse
- * @param[out] elf_symbol_table Pointer to symbol table structure to populate
- * @param[out] elf_sect_head Pointer to section header structure to populate
- * @param[out] file_bit Pointer to store file bit width (32/64)
- * @return unsigned int RET_OK on success, RET_FILE_ERR for file errors, 
- *         RET_PARSE_ERR for parsing errors
+ * @brief Builds the address index of a file from its symbol table
+ *
+ * The filter (-g / -u) is applied to the raw entries first; of the kept
+ * symbols, the index holds the defined FUNC and OBJECT symbols with a size.
+ *
+ * @param[out] index Index to create; freed by the caller with Addr_indexFree
+ * @param[in,out] slices Symbol table to process, read a slice at a time
+ * @param[in] filter Symbol filter to apply
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @return unsigned int RET_OK on success, error code on failure
  */
-unsigned int parseFile(const char* file_name, elfparser_symtable_t *elf_symbol_table, 
-                      elfparser_secthead_t *elf_sect_head, writer_bit_t *file_bit)
+static unsigned int symbol_addrIndexCreate(addr_index_t *index, ftnm_symslice_t *slices,
+                                           const symbol_filter_t *filter, const char *strtab, size_t strtab_len)
 {
-    source_file_t file = {0};
-    elfparser_header_t elf_header = {0};
-    int32_t symtab_sect_index;
+    size_t sym_cnt = slices->sym_cnt;
+    writer_line_t line;
+    int read_ret;
     unsigned int ret = RET_OK;
+    uint64_t stage_start;
 
-    // Initialize file handler structure
-    FileHandler_structSetup(&file);
-    
-    // Attempt to open the file
-    ret = FileHandler_fileOpen(&file, file_name);
-    if (ret != RET_OK)
+    stage_start = Stats_stageBegin(STATS_STAGE_SYMBOL_LIST);
+    if (Addr_indexCreate(index, (sym_cnt > 1) ? (sym_cnt - 1) : 0) != AD_SUCCESS)
     {
-        return (RET_FILE_ERR);
+        ret = RET_PARSE_ERR;  // Memory allocation error
     }
-
-    // Get initial file mapping (16 bytes for ELF ident)
+    for (size_t i = 1; (i < sym_cnt) && (ret == RET_OK); i++)
+    {
+        read_ret = FtNm_Elf_sliceEntryRead(slices, i, &filter->sym, strtab, strtab_len, &line);
+        ret = symbol_retGet(read_ret);
+        if (read_ret == FN_SUCCESS)
+        {
+            Addr_indexAdd(index, &line);  // Sized for every entry but the null symbol
+        }
+    }
+    Stats_stageEnd(STATS_STAGE_SYMBOL_LIST, stage_start);
     if (ret == RET_OK)
     {
-        ret = FileHandler_mapGet(&file, 16, 0);
-        if (ret != RET_OK)
+        stage_start = Stats_stageBegin(STATS_STAGE_SORT);
+        if (Addr_indexSort(index) != AD_SUCCESS)
         {
-            ret = RET_FILE_ERR;
+            ret = RET_PARSE_ERR;  // Memory allocation error
         }
+        Stats_stageEnd(STATS_STAGE_SORT, stage_start);
     }
+    return (ret);
+}
+
+/**
+ * @brief Reads the symbol at a position of a listed address range
+ * @param[in] pos Position in the listing
+ * @param[out] line Line of the symbol
+ * @param[in] arg Pointer to the symbol_addr_range_t of the range
+ */
+static void symbol_addrLineGet(size_t pos, writer_line_t *line, const void *arg)
+{
+    const symbol_addr_range_t *range = arg;
+
+    *line = *Addr_lineGet(range->index, (range->reverse == FT_TRUE) ? (range->end - 1 - pos) : (range->first + pos));
+}
+
+/**
+ * @brief Lists the symbols of a file starting in an address range (--start-address / --stop-address)
+ *
+ * The range is cut from the address index, so the symbols listed are the
+ * sized FUNC and OBJECT ones, in address order, or from the highest address
+ * down with -r. With -C, names are demangled by the writer as they are printed.
+ *
+ * @param[in,out] slices Symbol table to process, read a slice at a time
+ * @param[in] run Options of the run
+ * @param[in] file_name Name of the file, recorded in binary output
+ * @param[in] strtab Mapped symbol string table
+ * @param[in] strtab_len Length of the symbol string table
+ * @return unsigned int RET_OK on success, error code on failure
+ */
+static unsigned int symbol_rangeProcess(ftnm_symslice_t *slices, const symbol_run_t *run, const char *file_name,
+                                        const char *strtab, size_t strtab_len)
+{
+    addr_index_t index;
+    symbol_addr_range_t range = {&index, 0, 0, (run->sort == REVERSE_SORT) ? FT_TRUE : FT_FALSE};
+    writer_line_t line;
+    unsigned int ret;
+    uint64_t stage_start;
 
-    // Parse ELF identification header
+    ret = symbol_addrIndexCreate(&index, slices, &run->filter, strtab, strtab_len);
     if (ret == RET_OK)
     {
-        ret = ElfParser_Header_identParse(&elf_header, file.map, file.map_len);
-        if (ret)
+        Addr_rangeGet(&index, run->addr_start, run->addr_stop, &range.first, &range.end);
+        stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+        if (run->format == FORMAT_TEXT)
+        {
+            Writer_rangePrint(run->writer, range.end - range.first, symbol_addrLineGet, &range,
+                              (run->demangle == FT_TRUE) ? 1 : run->jobs);  // Names left to the writer's demangler
+        }
+        else if (Writer_BinaryPrint_begin(run->writer, file_name) != WR_SUCCESS)
         {
             ret = RET_PARSE_ERR;
         }
         else
         {
-            // Set writer bit width based on ELF class (32-bit or 64-bit)
-            *file_bit = (elf_header.elf_ident.elf_class == ELFPARSER_HEADER_CLASS_32_BIT) 
-                       ? (WRITER_VALUEPRINT_32BIT) : (WRITER_VALUEPRINT_64BIT);
+            for (size_t i = 0; i < (range.end - range.first); i++)
+            {
+                symbol_addrLineGet(i, &line, &range);
+                Writer_BinaryPrint_line(run->writer, &line);
+            }
+            ret = symbol_binaryEnd(run->writer, ret);
         }
+        Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
     }
+    Addr_indexFree(&index);
+    return (ret);
+}
 
-    // Map full ELF header
-    if (ret == RET_OK)
+/**
+ * @brief Reads the whole of stdin into a null-terminated buffer (--addr)
+ * @param[out] buf_p Buffer read; freed by the caller
+ * @param[out] len_p Number of bytes read
+ * @return unsigned int RET_OK on success, RET_FILE_ERR if stdin could not be read (errno set),
+ *         RET_PARSE_ERR on memory allocation failure
+ */
+static unsigned int symbol_addrStdinRead(char **buf_p, size_t *len_p)
+{
+    char *buf = NULL;
+    size_t len = 0, cap = 0;
+    ssize_t ret;
+
+    do
     {
-        ret = FileHandler_mapGet(&file, ElfParser_Header_sizeGet(&elf_header), 0);
-        if (ret)
+        if ((cap - len) <= ADDR_READ_SIZE)
         {
-            ret = RET_FILE_ERR;
+            size_t new_cap = (cap == 0) ? (ADDR_READ_SIZE + 1) : (cap * 2);
+            char *new_buf = realloc(buf, new_cap);
+            if (new_buf == NULL)
+            {
+                free(buf);
+                return (RET_PARSE_ERR);  // Memory allocation error
+            }
+            STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+            STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, new_cap);
+            buf = new_buf;
+            cap = new_cap;
         }
+        ret = read(STDIN_FILENO, buf + len, cap - len - 1);
+        len += (ret > 0) ? (size_t)ret : 0;
+    } while ((ret > 0) || ((ret < 0) && (errno == EINTR)));
+    if (ret < 0)
+    {
+        free(buf);
+        return (RET_FILE_ERR);
     }
+    buf[len] = '\0';
+    *buf_p = buf;
+    *len_p = len;
+    return (RET_OK);
+}
 
-    // Parse complete ELF header
-    if (ret == RET_OK)
+/**
+ * @brief Looks up addresses in the symbols of a file (--addr)
+ *
+ * The first target is the file; the other targets are the addresses, in hex.
+ * Without them, whitespace-separated addresses are read from stdin. Each
+ * address is printed with the symbol covering it and the offset into it.
+ *
+ * @param[in] target_file Target arguments
+ * @param[in] target_num Number of target arguments
+ * @param[in] run Options of the run
+ * @return int 0 on success, non-zero if the file or an address could not be read or memory ran out
+ */
+static int symbol_addrLookup(char *const *target_file, size_t target_num, const symbol_run_t *run)
+{
+    ftnm_sects_t sects;
+    ftnm_symslice_t slices;
+    source_file_t file;
+    writer_bit_t file_bit;
+    addr_index_t index = {0};
+    char *input = NULL;
+    size_t input_len = 0;
+    uint64_t *addrs = NULL;
+    size_t *pos = NULL;
+    size_t addr_cap = target_num - 1, addr_cnt = 0;
+    int ret, out = EXIT_SUCCESS;
+    uint64_t stage_start;
+
+    // Gather the addresses first, so a bad stdin fails before the file is read
+    if (target_num == 1)
     {
-        ret = ElfParser_Header_parse(&elf_header, file.map, file.map_len);
-        if (ret)
+        ret = symbol_addrStdinRead(&input, &input_len);
+        if (ret != RET_OK)
         {
-            ret = RET_PARSE_ERR;
+            return ((ret == RET_FILE_ERR) ? Err_Print_Errno("stdin") : Err_Print_BadAlloc());
         }
+        addr_cap = input_len / 2 + 1;  // Tokens are separated by at least one byte
     }
-
-    // Map section header table
-    if (ret == RET_OK)
+    STATS_COUNT(STATS_COUNTER_MALLOC, 2);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, addr_cap * (sizeof(uint64_t) + sizeof(size_t)));
+    addrs = malloc(addr_cap * sizeof(uint64_t));
+    pos = malloc(addr_cap * sizeof(size_t));
+    if ((addrs == NULL) || (pos == NULL))
+    {
+        free(input);
+        free(addrs);
+        free(pos);
+        return (Err_Print_BadAlloc());
+    }
+    if (input == NULL)
     {
-        ret = FileHandler_mapGet(&file, 
-            (elf_header.elf_section_header_entry_num * elf_header.elf_section_header_entry_size),
-            elf_header.elf_section_header_off);
-        if (ret)
+        for (size_t i = 1; i < target_num; i++)
         {
-            ret = RET_FILE_ERR;
+            if (symbol_addrParse(target_file[i], &addrs[addr_cnt]) == FT_TRUE)
+            {
+                addr_cnt++;
+            }
+            else
+            {
+                out |= Err_Print_BadAddress(target_file[i]);
+            }
         }
     }
-
-    // Initialize section header structure
-    if (ret == RET_OK)
+    else
     {
-        ret = ElfParser_SectHead_structSetup(elf_sect_head, &elf_header);
-        if (ret)
+        for (char *tok = strtok(input, " \t\r\n"); tok != NULL; tok = strtok(NULL, " \t\r\n"))
         {
-            ret = RET_PARSE_ERR;
+            if (symbol_addrParse(tok, &addrs[addr_cnt]) == FT_TRUE)
+            {
+                addr_cnt++;
+            }
+            else
+            {
+                out |= Err_Print_BadAddress(tok);
+            }
         }
     }
 
-    // Parse section headers
-    if (ret == RET_OK)
+    // Index the file, resolve the whole batch and print it
+    Stats_fileBegin();
+    ret = symbol_retGet(FtNm_Elf_fileParse(target_file[0], &file, &sects, &file_bit, run->symtab_name, &slices));
+    if (ret == RET_FILE_ERR)
+    {
+        out |= Err_Print_Errno(target_file[0]);
+    }
+    else if (ret == RET_PARSE_ERR)
+    {
+        out |= Err_Print_BadFormat(target_file[0]);
+    }
+    else
     {
-        ret = ElfParser_SectHead_parse(elf_sect_head, file.map, file.map_len);
-        if (ret)
+        Writer_NamePrint_strTableLoad(run->writer, file.map, file.map_len);
+        ret = symbol_addrIndexCreate(&index, &slices, &run->filter, file.map, file.map_len);
+        if (ret != RET_OK)
         {
-            ret = RET_PARSE_ERR;
+            out |= Err_Print_BadFormat(target_file[0]);
+        }
+        else
+        {
+            stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+            ret = Addr_lookupBatch(&index, addrs, addr_cnt, pos);
+            if (ret == AD_SUCCESS)
+            {
+                ret = Addr_print(&index, addrs, pos, addr_cnt, run->writer, file_bit);
+            }
+            if (ret == AD_ERR_MALLOC_FAIL)
+            {
+                out |= Err_Print_BadAlloc();
+            }
+            Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
         }
+        Addr_indexFree(&index);
+        FtNm_Elf_sliceFree(&slices);
+        FtNm_Elf_sectsFree(&sects);
+        Writer_NamePrint_strTableUnload(run->writer);
+        stage_start = Stats_stageBegin(STATS_STAGE_CLOSE);
+        FileHandler_fileClose(&file);
+        Stats_stageEnd(STATS_STAGE_CLOSE, stage_start);
     }
+    Stats_fileEnd(target_file[0]);
+    free(input);
+    free(addrs);
+    free(pos);
+    return (out);
+}
 
-    // Map string table for section names
-    if (ret == RET_OK)
+/**
+ * @brief Parses one file compared by --diff
+ * @param[in,out] arg Pointer to the symbol_diff_file_t of the file
+ * @return void* NULL
+ */
+static void *symbol_diffParseJob(void *arg)
+{
+    symbol_diff_file_t *diff_file = arg;
+
+    diff_file->ret = symbol_retGet(FtNm_Elf_fileParse(diff_file->file_name, &diff_file->file, &diff_file->sects,
+                                                      &diff_file->file_bit, diff_file->symtab_name,
+                                                      &diff_file->slices));
+    diff_file->err = errno;
+    return NULL;
+}
+
+/**
+ * @brief Prints the symbols added, removed and changed between two files (--diff)
+ *
+ * Both files are parsed at the same time, the second one on its own thread.
+ * Their symbol lists are then built one after the other, since names and
+ * flags are resolved against the tables loaded in the writer; names are
+ * interned so both lists stay valid once the files are closed.
+ *
+ * @param[in] file_names Paths of the old and the new file
+ * @param[in] filter Symbol filter (-g / -u) to apply to both files
+ * @param[in] symtab_name Name of the symbol table section to compare
+ * @param[in,out] writer Writer context the tables of each file are loaded in
+ * @return int 0 on success, non-zero if a file could not be read or memory ran out
+ */
+static int symbol_diff(char *const *file_names, const symbol_filter_t *filter, const char *symtab_name,
+                       writer_ctx_t *writer)
+{
+    symbol_diff_file_t diff_files[DIFF_FILE_NUM];
+    pthread_t thread;
+    int threaded;
+    int out = EXIT_SUCCESS;
+    unsigned int ret;
+    uint64_t stage_start;
+
+    for (unsigned int i = 0; i < DIFF_FILE_NUM; i++)
     {
-        ret = FileHandler_mapGet(&file, 
-            (elf_sect_head->table)[elf_sect_head->string_table_idx].sh_size,
-            (elf_sect_head->table)[elf_sect_head->string_table_idx].sh_offset);
-        if (ret)
-        {
-            ret = RET_FILE_ERR;
-        }
+        diff_files[i] = (symbol_diff_file_t){0};
+        diff_files[i].file_name = file_names[i];
+        diff_files[i].symtab_name = symtab_name;
     }
 
-    // Resolve section names
-    if (ret == RET_OK)
+    // Parse both files in parallel, or one after the other if no thread can be started
+    threaded = (pthread_create(&thread, NULL, symbol_diffParseJob, &diff_files[1]) == 0);
+    symbol_diffParseJob(&diff_files[0]);
+    if (threaded)
     {
-        ret = ElfParser_SectHead_nameResolve(elf_sect_head, file.map, file.map_len);
-        if (ret)
-        {
-            ret = RET_PARSE_ERR;
-        }
+        pthread_join(thread, NULL);
+    }
+    else
+    {
+        symbol_diffParseJob(&diff_files[1]);
     }
 
-    // Find symbol table section
-    if (ret == RET_OK)
+    // Build and sort the symbols of each file while its tables are loaded
+    for (unsigned int i = 0; i < DIFF_FILE_NUM; i++)
     {
-        symtab_sect_index = ElfParser_SectHead_byNameFind(elf_sect_head, ".symtab", 0);
-        if (symtab_sect_index < 0)
+        symbol_diff_file_t *diff_file = &diff_files[i];
+
+        if (diff_file->ret == RET_FILE_ERR)
         {
-            ret = RET_PARSE_ERR;
+            errno = diff_file->err;
+            out |= Err_Print_Errno(diff_file->file_name);
+            continue;
+        }
+        if (diff_file->ret == RET_PARSE_ERR)
+        {
+            out |= Err_Print_BadFormat(diff_file->file_name);
+            continue;
+        }
+        Writer_FlagPrint_sectionHeadLoad(writer, diff_file->sects.table, diff_file->sects.table_len);
+        Writer_NamePrint_strTableLoad(writer, diff_file->file.map, diff_file->file.map_len);
+        stage_start = Stats_stageBegin(STATS_STAGE_SYMBOL_LIST);
+        ret = symbol_list_create(&diff_file->head, &diff_file->slices, filter, diff_file->file.map,
+                                 diff_file->file.map_len, 1, diff_file->slices.sym_cnt, writer);
+        Stats_stageEnd(STATS_STAGE_SYMBOL_LIST, stage_start);
+        if (ret != RET_OK)
+        {
+            out |= Err_Print_BadFormat(diff_file->file_name);
+        }
+        else
+        {
+            stage_start = Stats_stageBegin(STATS_STAGE_SORT);
+            if (Diff_sideBuild(&diff_file->side, writer, diff_file->head, diff_file->file_bit) != DF_SUCCESS)
+            {
+                out |= Err_Print_BadAlloc();
+            }
+            Stats_stageEnd(STATS_STAGE_SORT, stage_start);
         }
+        Writer_NamePrint_strTableUnload(writer);
+        Writer_FlagPrint_sectionHeadUnload(writer);
+        FtNm_Elf_sliceFree(&diff_file->slices);
+        FtNm_Elf_sectsFree(&diff_file->sects);
+        stage_start = Stats_stageBegin(STATS_STAGE_CLOSE);
+        FileHandler_fileClose(&diff_file->file);
+        Stats_stageEnd(STATS_STAGE_CLOSE, stage_start);
     }
 
-    // Map symbol table
-    if (ret == RET_OK)
+    // Merge both sides into the report
+    if (out == EXIT_SUCCESS)
     {
-        ret = FileHandler_mapGet(&file, 
-            elf_sect_head->table[symtab_sect_index].sh_size,
-            elf_sect_head->table[symtab_sect_index].sh_offset);
-        if (ret)
+        int diff_ret;
+
+        stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+        diff_ret = Diff_print(&diff_files[0].side, &diff_files[1].side, writer);
+        if (diff_ret == DF_ERR_MALLOC_FAIL)
         {
-            ret = RET_FILE_ERR;
+            out |= Err_Print_BadAlloc();
+        }
+        else if (diff_ret != DF_SUCCESS)
+        {
+            out |= Err_Print_Errno(LONG_OPTION_DIFF);  // The report could not be written (errno set)
         }
+        Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
     }
+    for (unsigned int i = 0; i < DIFF_FILE_NUM; i++)
+    {
+        Diff_sideFree(&diff_files[i].side);
+        LinkedList_delete(&diff_files[i].head, free);
+    }
+    return (out);
+}
 
-    // Initialize symbol table structure
-    if (ret == RET_OK)
+/**
+ * @brief Returns the line table key of a symbol line
+ * @param[in] line Symbol line
+ * @param[out] addr Address of the symbol and its section
+ * @return unsigned short FT_TRUE if the symbol is defined in a section, FT_FALSE otherwise
+ */
+static unsigned short symbol_lineKeyGet(const writer_line_t *line, debugline_addr_t *addr)
+{
+    if ((line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED) ||
+        (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_ABSOLUTE) ||
+        (line->sect_head_idx == WRITER_FLAGPRINT_SHIDX_COMMON))
     {
-        ret = ElfParser_SymTable_structSetup(elf_symbol_table, elf_sect_head, 
-                                           symtab_sect_index, &elf_header);
-        if (ret)
-        {
-            ret = RET_PARSE_ERR;
-        }
+        return (FT_FALSE);  // No code to take a line from
     }
+    addr->addr = line->value;
+    addr->sect = line->sect_head_idx;
+    return (FT_TRUE);
+}
 
-    // Parse symbol table
-    if (ret == RET_OK)
+/**
+ * @brief Finds the source location of a symbol line (-l), called by the writer
+ * @param[in] line Symbol line
+ * @param[out] source Source location of the line
+ * @param[in] arg Line table of the file (debugline_t)
+ * @return int Non-zero if the line has a source location, 0 otherwise
+ */
+static int symbol_sourceGet(const writer_line_t *line, writer_source_t *source, const void *arg)
+{
+    debugline_addr_t addr;
+
+    if (symbol_lineKeyGet(line, &addr) == FT_FALSE)
     {
-        ret = ElfParser_SymTable_parse(elf_symbol_table, file.map, file.map_len);
-        if (ret)
-        {
-            ret = RET_PARSE_ERR;
-        }
+        return (0);
     }
+    return (DebugLine_find(arg, &addr, source) == DL_SUCCESS);
+}
 
-    // Map string table for symbol names
-    if (ret == RET_OK)
+/**
+ * @brief Reads a symbol a relocation of the line table refers to (-l), called by the line table
+ * @param[in] sym Index of the symbol
+ * @param[out] value Value of the symbol
+ * @param[out] sect Section index of the symbol
+ * @param[in,out] arg Symbol table of the file (ftnm_symslice_t)
+ * @return int DL_SUCCESS if the symbol was read, DL_ERR_NOT_FOUND otherwise
+ */
+static int symbol_relocSymGet(size_t sym, uint64_t *value, uint32_t *sect, void *arg)
+{
+    return ((FtNm_Elf_sliceSymbolGet(arg, sym, value, sect) == FN_SUCCESS) ? DL_SUCCESS : DL_ERR_NOT_FOUND);
+}
+
+/**
+ * @brief Opens the line table of a file for -l and decodes the units the kept symbols fall in
+ *
+ * A file without a usable .debug_line is listed without lines, like nm -l.
+ *
+ * @param[out] debug_line Line table of the file, NULL if it has none
+ * @param[in] file Parsed file
+ * @param[in] sects Section headers of the file
+ * @param[in,out] slices Symbol table of the file, read a slice at a time
+ * @param[in] run Options of the run
+ * @param[in] file_name Path of the file
+ * @return int Bits to merge into the exit status, 0 on success
+ */
+static int symbol_linesLoad(debugline_t **debug_line, const source_file_t *file, const ftnm_sects_t *sects,
+                            ftnm_symslice_t *slices, const symbol_run_t *run, const char *file_name)
+{
+    debugline_addr_t *addrs;
+    size_t addr_cnt = 0;
+    int ret;
+
+    ret = DebugLine_open(debug_line, file, sects->table, sects->table_len, symbol_relocSymGet, slices);
+    if (ret == DL_ERR_MALLOC_FAIL)
     {
-        ret = FileHandler_mapGet(&file, 
-            (elf_sect_head->table)[elf_symbol_table->string_table_idx].sh_size,
-            (elf_sect_head->table)[elf_symbol_table->string_table_idx].sh_offset);
-        if (ret)
-        {
-            ret = RET_FILE_ERR;
-        }
+        return (Err_Print_BadAlloc());
+    }
+    if (ret != DL_SUCCESS)
+    {
+        return (RET_OK);  // No line table to read
     }
 
-    // Resolve symbol names
-    if (ret == RET_OK)
+    STATS_COUNT(STATS_COUNTER_MALLOC, 1);
+    STATS_COUNT(STATS_COUNTER_MALLOC_BYTES, slices->sym_cnt * sizeof(debugline_addr_t));
+    addrs = malloc((slices->sym_cnt + 1) * sizeof(debugline_addr_t));
+    if (addrs == NULL)
+    {
+        DebugLine_close(debug_line);
+        return (Err_Print_BadAlloc());
+    }
+    for (size_t i = 1; i < slices->sym_cnt; i++)
     {
-        ret = ElfParser_SymTable_nameResolve(elf_symbol_table, file.map, file.map_len);
-        if (ret)
+        writer_line_t line;
+        if ((FtNm_Elf_sliceEntryRead(slices, i, &run->filter.sym, file->map, file->map_len, &line) == FN_SUCCESS) &&
+            (symbol_lineKeyGet(&line, &addrs[addr_cnt]) == FT_TRUE))
         {
-            ret = RET_PARSE_ERR;
+            addr_cnt++;
         }
     }
-
-    // Clean up file resources
-    FileHandler_fileClose(&file);
-    return (ret);
+    ret = DebugLine_prepare(*debug_line, addrs, addr_cnt);
+    free(addrs);
+    if (ret != DL_SUCCESS)
+    {
+        DebugLine_close(debug_line);
+        return ((ret == DL_ERR_MALLOC_FAIL) ? Err_Print_BadAlloc() : Err_Print_BadFormat(file_name));
+    }
+    Writer_sourceSet(run->writer, symbol_sourceGet, *debug_line);
+    return (RET_OK);
 }
 
 /**
- * @brief Creates a linked list of symbols from the symbol table
- * @param[in,out] head_p Pointer to head of linked list to populate
- * @param[in] elf_symbol_table Symbol table to process
- * @param[in] global_only Flag to show only global symbols (FT_TRUE/FT_FALSE)
- * @param[in] undifined_only Flag to show only undefined symbols (FT_TRUE/FT_FALSE)
- * @return unsigned int RET_OK on success, error code on failure
+ * @brief Lists the symbols of one target file, or adds them to the --resolve index
+ * @param[in] file_name Path of the file
+ * @param[in] file_idx Index of the file among the targets
+ * @param[in] print_header FT_TRUE to print the file name before its symbols
+ * @param[in] run Options of the run
+ * @return int Bits to merge into the exit status, 0 on success
  */
-unsigned int symbol_list_create(dl_list_t **head_p, const elfparser_symtable_t elf_symbol_table, 
-                              unsigned short global_only, unsigned short undifined_only)
+static int symbol_fileProcess(const char *file_name, uint32_t file_idx, unsigned short print_header,
+                              const symbol_run_t *run)
 {
-    writer_line_t *new_line;
+    ftnm_sects_t sects;
+    ftnm_symslice_t slices;
+    dl_list_t *head = NULL;
+    debugline_t *debug_line = NULL;
+    source_file_t file;
+    writer_bit_t file_bit;
+    unsigned short layout = symbol_layoutGet(run);
+    int ret, sort_ret = LL_SUCCESS, out = EXIT_SUCCESS;
+    uint64_t stage_start;
+
+    Stats_fileBegin();
+    Trace_begin(file_name, TRACE_CATEGORY_FILE);
+    ret = symbol_retGet(FtNm_Elf_fileParse(file_name, &file, &sects, &file_bit, run->symtab_name, &slices));
+    out |= ret;
     
-    // Process each symbol in the table (skip first entry)
-    for (int i = 1; i < elf_symbol_table.table_len; i++)
+    // Handle parsing errors
+    if (ret == RET_FILE_ERR)
     {
-        // Skip section and file symbols
-        if (((elf_symbol_table.table)[i].sym_type == ELFPARSER_SYMTABLE_TYPE_SECT) || 
-            ((elf_symbol_table.table)[i].sym_type == ELFPARSER_SYMTABLE_TYPE_FILE))
+        out |= Err_Print_Errno(file_name);
+    }
+    else if (ret == RET_PARSE_ERR)
+    {
+        out |= Err_Print_BadFormat(file_name);
+    }
+    else
+    {
+        // Print file name header for multiple files
+        if ((print_header == FT_TRUE) && (run->format == FORMAT_TEXT) && (run->resolve == FT_FALSE))
         {
-            continue;
+            STATS_COUNT(STATS_COUNTER_WRITE, 3);
+            write(1, "\n", 1);
+            write(1, file_name, strlen(file_name));
+            write(1, ":\n", 2);
         }
+        
+        // Load section header information
+        Writer_FlagPrint_sectionHeadLoad(run->writer, sects.table, sects.table_len);
+        Writer_NamePrint_strTableLoad(run->writer, file.map, file.map_len);
+        Writer_bitLenSet(run->writer, file_bit);
 
-        // Allocate memory for new symbol line
-        new_line = malloc(sizeof(writer_line_t));
-        if (new_line == NULL)
+        // Decode the line table units covering the defined symbols, printed after each of them
+        if ((run->lines == FT_TRUE) && (run->format == FORMAT_TEXT) && (run->resolve == FT_FALSE))
         {
-            return(RET_PARSE_ERR);  // Memory allocation error
+            out |= symbol_linesLoad(&debug_line, &file, &sects, &slices, run, file_name);
         }
-
-        // Set symbol binding type
-        switch ((elf_symbol_table.table)[i].sym_bind)
+        
+        // List from the symbol arrays, or in bounded memory when the order allows it
+        if (layout == LAYOUT_STREAM)
         {
-            case (ELFPARSER_SYMTABLE_BIND_LOCAL):
-                new_line->bind = WRITER_FLAGPRINT_BIND_LOCAL;
-                break;
-            case (ELFPARSER_SYMTABLE_BIND_GLOBAL):
-                new_line->bind = WRITER_FLAGPRINT_BIND_GLOBAL;
-                break;
-            case (ELFPARSER_SYMTABLE_BIND_WEAK):
-                new_line->bind = WRITER_FLAGPRINT_BIND_WEAK;
-                break;
-            case (ELFPARSER_SYMTABLE_BIND_GNU_UNIQUE):
-                new_line->bind = WRITER_FLAGPRINT_BIND_GNU;
-                break;
-            default:
-                free(new_line);
-                return(RET_PARSE_ERR);
+            ret = symbol_streamPrint(&slices, run, file_name, file.map, file.map_len);
         }
-
-        // Skip non-global symbols if global_only flag is set
-        if ((global_only == FT_TRUE) && (new_line->bind == WRITER_FLAGPRINT_BIND_LOCAL)) // to be equal to nm v2.42 on linux
+        else if (layout == LAYOUT_TABLE)
         {
-            free(new_line);
-            continue;
+            ret = symbol_tableProcess(&slices, run, file_name, file.map, file.map_len);
+        }
+        else if (layout == LAYOUT_CHUNKED)
+        {
+            ret = symbol_chunkedPrint(&slices, run, file_name, file.map, file.map_len);
+        }
+        else if (layout == LAYOUT_RANGE)
+        {
+            ret = symbol_rangeProcess(&slices, run, file_name, file.map, file.map_len);
+        }
+        else
+        {
+            // Create symbol list
+            stage_start = Stats_stageBegin(STATS_STAGE_SYMBOL_LIST);
+            ret = symbol_list_create(&head, &slices, &run->filter, file.map, file.map_len, 1, slices.sym_cnt,
+                                     run->writer);
+            Stats_stageEnd(STATS_STAGE_SYMBOL_LIST, stage_start);
+        }
+        if ((ret == RET_OK) && (layout == LAYOUT_LIST))
+        {
+            // Sort symbols if required; --resolve reports in symbol table order and needs no sort
+            if ((run->sort != NO_SORT) && (run->resolve == FT_FALSE))
+            {
+                stage_start = Stats_stageBegin(STATS_STAGE_SORT);
+                if (run->sort_key == SORT_KEY_VALUE)
+                {
+                    sort_ret = LinkedList_radixSort(&head, LL_SORT_KEY_VALUE, lineCmp, run->writer);
+                }
+                else if (run->sort_key == SORT_KEY_SIZE)
+                {
+                    sort_ret = LinkedList_radixSort(&head, LL_SORT_KEY_SIZE, lineCmp, run->writer);
+                }
+                else
+                {
+                    sort_ret = LinkedList_sort(&head, lineCmp, run->writer);
+                }
+                Stats_stageEnd(STATS_STAGE_SORT, stage_start);
+            }
+            // An empty list needs no sort; a failed one is not listed out of order
+            if (sort_ret == LL_ERR_MALLOC_FAIL)
+            {
+                out |= Err_Print_BadAlloc();
+            }
+            // Add the symbols to the --resolve index instead of printing them
+            else if (run->resolve == FT_TRUE)
+            {
+                if (Resolve_fileAdd(file_idx, head, run->writer) != RS_SUCCESS)
+                {
+                    out |= Err_Print_BadAlloc();
+                }
+            }
+            else
+            {
+                // Demangle names ahead of the writer
+                if ((run->demangle == FT_TRUE) && (run->format == FORMAT_TEXT))
+                {
+                    stage_start = Stats_stageBegin(STATS_STAGE_DEMANGLE);
+                    symbol_demangle(run->writer, head);
+                    Stats_stageEnd(STATS_STAGE_DEMANGLE, stage_start);
+                }
+                // Print symbols
+                stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+                ret = symbol_print(run->writer, head, run->sort, run->format, file_name);
+                Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
+            }
+        }
+        Writer_flush(run->writer);  // Lines of the file go out before any error or the next header
+        if (ret == RET_PARSE_ERR)
+        {
+            out |= Err_Print_BadFormat(file_name);
         }
-
-        // Set symbol type
-        switch ((elf_symbol_table.table)[i].sym_type)
+        else if (ret != RET_OK)
         {
-            case (ELFPARSER_SYMTABLE_TYPE_NOTYPE):
-                new_line->type = WRITER_FLAGPRINT_TYPE_NOTYPE;
-                break;
-            case (ELFPARSER_SYMTABLE_TYPE_OBJECT):
-                new_line->type = WRITER_FLAGPRINT_TYPE_OBJECT;
-                break;
-            case (ELFPARSER_SYMTABLE_TYPE_FUNC):
-                new_line->type = WRITER_FLAGPRINT_TYPE_FUNC;
-                break;
-            case (ELFPARSER_SYMTABLE_TYPE_SECT):
-                new_line->type = WRITER_FLAGPRINT_TYPE_TLS;
-                break;
-            case (ELFPARSER_SYMTABLE_TYPE_GNU_IFUNC):
-                new_line->type = WRITER_FLAGPRINT_TYPE_GNU;
-                break;
-            default:
-                free(new_line);
-                return(RET_PARSE_ERR);
+            out |= Err_Print_Errno(file_name);
         }
+        
+        // Clean up resources
+        Writer_sourceSet(run->writer, NULL, NULL);
+        DebugLine_close(&debug_line);
+        LinkedList_delete(&head, free);
+        FtNm_Elf_sliceFree(&slices);
+        FtNm_Elf_sectsFree(&sects);
+        Writer_NamePrint_strTableUnload(run->writer);
+        Writer_FlagPrint_sectionHeadUnload(run->writer);
+        stage_start = Stats_stageBegin(STATS_STAGE_CLOSE);
+        FileHandler_fileClose(&file);
+        Stats_stageEnd(STATS_STAGE_CLOSE, stage_start);
+    }
+    Trace_end(file_name, TRACE_CATEGORY_FILE);
+    Stats_fileEnd(file_name);
+    return (out);
+}
 
-        // Set section header index
-        new_line->sect_head_idx = (elf_symbol_table.table)[i].sym_sect_idx;
+/**
+ * @brief Lists a file again after it changed (--watch)
+ * @param[in] path Path of the changed file
+ * @param[in] arg Pointer to the symbol_run_t of the run
+ */
+static void symbol_watchList(const char *path, void *arg)
+{
+    symbol_fileProcess(path, 0, FT_TRUE, arg);  // Errors are reported, and watching goes on
+}
 
-        // Skip defined symbols if undifined_only flag is set
-        if ((undifined_only == FT_TRUE) && 
-            (new_line->sect_head_idx != WRITER_FLAGPRINT_SHIDX_UNDEFINED))
-        {
-            free(new_line);
-            continue;
-        }
+/**
+ * @brief Parses a byte count with an optional K, M or G suffix (--max-memory)
+ * @param[in] str Text to parse
+ * @param[out] size Parsed number of bytes
+ * @return unsigned short FT_TRUE on success, FT_FALSE if str is not a non-zero size
+ */
+static unsigned short symbol_sizeParse(const char *str, size_t *size)
+{
+    size_t num = 0;
+    unsigned int shift = 0;
+
+    for (; (*str >= '0') && (*str <= '9') && (num <= (SIZE_MAX - 9) / 10); str++)
+    {
+        num = num * 10 + (size_t)(*str - '0');
+    }
+    switch (*str)
+    {
+        case 'K':
+        case 'k':
+            shift = 10;
+            str++;
+            break;
+        case 'M':
+        case 'm':
+            shift = 20;
+            str++;
+            break;
+        case 'G':
+        case 'g':
+            shift = 30;
+            str++;
+            break;
+        default:
+            break;
+    }
+    if ((*str != '\0') || (num == 0) || (num > (SIZE_MAX >> shift)))
+    {
+        return (FT_FALSE);
+    }
+    *size = num << shift;
+    return (FT_TRUE);
+}
 
-        // Set symbol name and value
-        new_line->name = (elf_symbol_table.table)[i].sym_name;
-        new_line->value = (elf_symbol_table.table)[i].sym_value;
+/**
+ * @brief Parses a thread count (-j)
+ * @param[in] str Text to parse
+ * @param[out] jobs Parsed number of threads
+ * @return unsigned short FT_TRUE on success, FT_FALSE if str is not a count from 1 to WRITER_RANGE_THREADS_MAX
+ */
+static unsigned short symbol_jobsParse(const char *str, size_t *jobs)
+{
+    size_t num = 0;
 
-        // Add to linked list
-        LinkedList_nodePushFront(head_p, new_line);
+    for (; (*str >= '0') && (*str <= '9') && (num <= WRITER_RANGE_THREADS_MAX); str++)
+    {
+        num = num * 10 + (size_t)(*str - '0');
     }
-    return (RET_OK);
+    if ((*str != '\0') || (num == 0) || (num > WRITER_RANGE_THREADS_MAX))
+    {
+        return (FT_FALSE);
+    }
+    *jobs = num;
+    return (FT_TRUE);
 }
 
 /**
- * @brief Prints symbols from the linked list
- * @param[in] head Head of the symbol list
- * @param[in] sort Sorting mode (NO_SORT, NORMAL_SORT, REVERSE_SORT)
- * @param[in] file_bit File bit width for printing
+ * @brief Adds a --match pattern, or the patterns of a --match-file, to the name filter
+ * @param[in,out] match Pattern set, created on first use
+ * @param[in] arg Pattern, or path of the pattern file
+ * @param[in] from_file FT_TRUE if arg is the path of a pattern file
+ * @return int 0 on success, 1 after printing an error
  */
-void symbol_print(const dl_list_t *head, unsigned short sort, writer_bit_t file_bit)
+static int symbol_matchAdd(match_t **match, const char *arg, unsigned short from_file)
 {
-    if (sort == NORMAL_SORT)
+    const char *bad = arg;
+    int ret;
+
+    if ((*match == NULL) && (Match_create(match) != MA_SUCCESS))
     {
-        // Print symbols in forward order
-        for (const dl_list_t *node = head; node != NULL; node = node->next)
-        {
-            Writer_linePrint(node->line, file_bit);
-        }
+        return (Err_Print_BadAlloc());
     }
-    else if (head != NULL)
+    if (from_file == FT_TRUE)
     {
-        // Find last node for reverse printing
-        const dl_list_t *node = head;
-        for (; node->next != NULL; node = node->next)
-        {
-            ;
-        }
-        // Print symbols in reverse order
-        for (; node != NULL; node = node->prev)
-        {
-            Writer_linePrint(node->line, file_bit);
-        }
+        ret = Match_fileAdd(*match, arg, &bad);
+    }
+    else
+    {
+        ret = Match_patternAdd(*match, arg, strlen(arg));
+    }
+    if (ret == MA_ERR_FILE_FAIL)
+    {
+        return (Err_Print_Errno(arg));
     }
+    if ((ret == MA_ERR_BAD_PATTERN) || (ret == MA_ERR_TOO_COMPLEX))
+    {
+        return (Err_Print_BadPattern(bad, (ret == MA_ERR_TOO_COMPLEX)));
+    }
+    return ((ret != MA_SUCCESS) ? Err_Print_BadAlloc() : 0);
+}
+
+/**
+ * @brief Returns the argument of the option taking one in a short option cluster
+ *
+ * The first option of the cluster that takes an argument (-R or -j) takes
+ * the rest of the cluster, or the next argument if it ends the cluster.
+ *
+ * @param[in] arg Short option cluster, like "-gR", "-Rdir" or "-j4"
+ * @param[in] next Argument following the cluster, or NULL if it is the last one
+ * @param[out] option Option taking the argument
+ * @return const char* Rest of the cluster after the option, next if the option ends
+ *                     the cluster, or NULL if no option of the cluster takes an argument
+ */
+static const char *symbol_optionArgGet(const char *arg, const char *next, char *option)
+{
+    const char *flag = strpbrk(arg + 1, SHORT_OPTIONS_WITH_ARG);
+
+    if (flag == NULL)
+    {
+        return (NULL);
+    }
+    *option = *flag;
+    return ((flag[1] != '\0') ? flag + 1 : next);
 }
 
 /**
@@ -378,37 +1815,172 @@ void symbol_print(const dl_list_t *head, unsigned short sort, writer_bit_t file_
  */
 int main (int argc, char **argv)
 { 
-    elfparser_secthead_t elf_sect_head = {0};
-    elfparser_symtable_t elf_symbol_table = {0};
-    dl_list_t *head = NULL;
-    writer_bit_t file_bit;
-
     // Initialize flags
-    unsigned short global_only = FT_FALSE;
-    unsigned short undifined_only = FT_FALSE;
+    symbol_filter_t filter = {{FT_FALSE, FT_FALSE, FT_FALSE, NULL}, 0};
     unsigned short sort = NORMAL_SORT;
+    unsigned short sort_key = SORT_KEY_NAME;
+    unsigned short format = FORMAT_TEXT;
+    unsigned short print_size = FT_FALSE;
+    unsigned short demangle = FT_FALSE;
+    unsigned short resolve = FT_FALSE;
+    unsigned short diff = FT_FALSE;
+    unsigned short watch = FT_FALSE;
+    unsigned short addr = FT_FALSE;     // Look up addresses instead of listing (--addr)
+    unsigned short addr_range = FT_FALSE;
+    unsigned short lines = FT_FALSE;
+    uint64_t addr_start = 0;            // Listed address range (--start-address / --stop-address)
+    uint64_t addr_stop = UINT64_MAX;
+    const char *symtab_name = SYMTAB_NAME_STATIC;
+    size_t max_memory = 0;
+    size_t jobs = 0;                    // Formatting threads (-j), 0 to pick them by output size
+    const char *jobs_arg;               // Argument text of -j
+    writer_ctx_t *writer = NULL;        // Writer context every file is printed with
+    const char *trace_path = NULL;      // Chrome trace output (--trace=FILE)
+    match_t *match = NULL;              // Name patterns (--match / --match-file), NULL keeps every name
 
-    int ret, out = EXIT_SUCCESS;
+    symbol_run_t run;
+    int out = EXIT_SUCCESS;
+    uint64_t stage_start;
 
     // Default target file
     char **target_file = NULL;
     size_t target_num = 0;
+    size_t scan_num = 0;                // Number of -R directories
+    scan_list_t scan = {NULL, 0, 0};    // ELF files found below them
 
     // Process command-line arguments for flags
     for (int i = 1; i < argc; i++)
     {
-        if (argv[i][0] == '-' && strlen(argv[i]) > 1)
+        if (strncmp(argv[i], LONG_OPTION_PREFIX, LONG_OPTION_PREFIX_LEN) == 0 && strlen(argv[i]) > LONG_OPTION_PREFIX_LEN)
+        {
+            if (strcmp(argv[i], LONG_OPTION_STATS) == 0)  // Print stage timing and counters
+            {
+                Stats_enable();
+            }
+            else if (strncmp(argv[i], LONG_OPTION_TRACE, LONG_OPTION_TRACE_LEN) == 0)  // Export Chrome trace events
+            {
+                trace_path = argv[i] + LONG_OPTION_TRACE_LEN;
+                if (Trace_enable(trace_path) != TR_SUCCESS)
+                {
+                    return (Err_Print_Errno(trace_path));
+                }
+            }
+            else if (strcmp(argv[i], LONG_OPTION_NUMERIC) == 0)  // Sort by symbol value
+            {
+                sort_key = SORT_KEY_VALUE;  // -p keeps table order wherever it is given
+            }
+            else if (strcmp(argv[i], LONG_OPTION_PRINT_SIZE) == 0)  // Print symbol sizes
+            {
+                print_size = FT_TRUE;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_SIZE_SORT) == 0)  // Sort sized symbols by size
+            {
+                filter.sym.sized_only = FT_TRUE;
+            }
+            else if (strncmp(argv[i], LONG_OPTION_TOP, LONG_OPTION_TOP_LEN) == 0)  // Keep only the N largest symbols
+            {
+                const char *num = argv[i] + LONG_OPTION_TOP_LEN;
+                size_t top = 0;
+                for (; (*num >= '0') && (*num <= '9') && (top <= (SIZE_MAX - 9) / 10); num++)
+                {
+                    top = top * 10 + (size_t)(*num - '0');
+                }
+                if ((*num != '\0') || (top == 0))
+                {
+                    return (Err_Print_BadLongOption(argv[i]));
+                }
+                filter.top = top;
+                filter.sym.sized_only = FT_TRUE;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_DEMANGLE) == 0)  // Demangle C++ symbol names
+            {
+                demangle = FT_TRUE;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_DIFF) == 0)  // Compare the symbols of two files
+            {
+                diff = FT_TRUE;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_WATCH) == 0)  // List changed files again until interrupted
+            {
+                watch = FT_TRUE;
+            }
+            else if (strncmp(argv[i], LONG_OPTION_MAX_MEMORY, LONG_OPTION_MAX_MEMORY_LEN) == 0)  // Bound the memory of symbol lists
+            {
+                if (symbol_sizeParse(argv[i] + LONG_OPTION_MAX_MEMORY_LEN, &max_memory) == FT_FALSE)
+                {
+                    return (Err_Print_BadLongOption(argv[i]));
+                }
+            }
+            else if (strcmp(argv[i], LONG_OPTION_ADDR) == 0)  // Map addresses to symbol+offset
+            {
+                addr = FT_TRUE;
+            }
+            else if (strncmp(argv[i], LONG_OPTION_START_ADDR, LONG_OPTION_START_ADDR_LEN) == 0)  // List symbols from an address
+            {
+                if (symbol_addrParse(argv[i] + LONG_OPTION_START_ADDR_LEN, &addr_start) == FT_FALSE)
+                {
+                    return (Err_Print_BadLongOption(argv[i]));
+                }
+                addr_range = FT_TRUE;
+            }
+            else if (strncmp(argv[i], LONG_OPTION_STOP_ADDR, LONG_OPTION_STOP_ADDR_LEN) == 0)  // List symbols below an address
+            {
+                if (symbol_addrParse(argv[i] + LONG_OPTION_STOP_ADDR_LEN, &addr_stop) == FT_FALSE)
+                {
+                    return (Err_Print_BadLongOption(argv[i]));
+                }
+                addr_range = FT_TRUE;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_DYNAMIC) == 0)  // Read the dynamic symbol table
+            {
+                symtab_name = SYMTAB_NAME_DYNAMIC;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_RESOLVE) == 0)  // Report providers and duplicates across inputs
+            {
+                resolve = FT_TRUE;
+            }
+            else if (strncmp(argv[i], LONG_OPTION_MATCH, LONG_OPTION_MATCH_LEN) == 0)  // Keep the names matching a pattern
+            {
+                if (symbol_matchAdd(&match, argv[i] + LONG_OPTION_MATCH_LEN, FT_FALSE) != 0)
+                {
+                    Match_free(&match);
+                    return (1);
+                }
+            }
+            else if (strncmp(argv[i], LONG_OPTION_MATCH_FILE, LONG_OPTION_MATCH_FILE_LEN) == 0)  // Patterns read from a file
+            {
+                if (symbol_matchAdd(&match, argv[i] + LONG_OPTION_MATCH_FILE_LEN, FT_TRUE) != 0)
+                {
+                    Match_free(&match);
+                    return (1);
+                }
+            }
+            else if (strcmp(argv[i], LONG_OPTION_FORMAT FORMAT_NAME_BINARY) == 0)  // Binary record stream
+            {
+                format = FORMAT_BINARY;
+            }
+            else if (strcmp(argv[i], LONG_OPTION_FORMAT FORMAT_NAME_TEXT) == 0)  // Default text output
+            {
+                format = FORMAT_TEXT;
+            }
+            else
+            {
+                return (Err_Print_BadLongOption(argv[i]));
+            }
+        }
+        else if (argv[i][0] == '-' && strlen(argv[i]) > 1)
         {
+            int arg_idx = i;  // Cluster being processed, i moves past the argument of -R or -j
             // Process each character in flag string
-            for (size_t j = 1; j < strlen(argv[i]); j++)
+            for (size_t j = 1; j < strlen(argv[arg_idx]); j++)
             {
-                char flag = argv[i][j];
+                char flag = argv[arg_idx][j];
                 switch (flag) {
                     case 'g':  // Show only global symbols
-                        global_only = FT_TRUE;
+                        filter.sym.global_only = FT_TRUE;
                         break;
                     case 'u':  // Show only undefined symbols
-                        undifined_only = FT_TRUE;
+                        filter.sym.undefined_only = FT_TRUE;
                         break;
                     case 'r':  // Reverse sort order
                         sort = REVERSE_SORT;
@@ -416,6 +1988,41 @@ int main (int argc, char **argv)
                     case 'p':  // No sorting
                         sort = NO_SORT;
                         break;
+                    case 'n':  // Sort by symbol value
+                        sort_key = SORT_KEY_VALUE;  // -p keeps table order wherever it is given
+                        break;
+                    case 'S':  // Print symbol sizes
+                        print_size = FT_TRUE;
+                        break;
+                    case 'C':  // Demangle C++ symbol names
+                        demangle = FT_TRUE;
+                        break;
+                    case 'D':  // Read the dynamic symbol table
+                        symtab_name = SYMTAB_NAME_DYNAMIC;
+                        break;
+                    case 'l':  // Print the source line of defined symbols
+                        lines = FT_TRUE;
+                        break;
+                    case SHORT_OPTION_RECURSIVE:  // List the ELF files below a directory, scanned once flags are read
+                        if ((argv[arg_idx][j + 1] == '\0') && (++i >= argc))
+                        {
+                            return (Err_Print_MissingArgument(&flag));
+                        }
+                        scan_num++;
+                        j = strlen(argv[arg_idx]);  // Rest of the cluster is the directory
+                        break;
+                    case SHORT_OPTION_JOBS:  // Format sorted output on N threads
+                        if ((argv[arg_idx][j + 1] == '\0') && (++i >= argc))
+                        {
+                            return (Err_Print_MissingArgument(&flag));
+                        }
+                        jobs_arg = (argv[arg_idx][j + 1] != '\0') ? &argv[arg_idx][j + 1] : argv[i];
+                        if (symbol_jobsParse(jobs_arg, &jobs) == FT_FALSE)
+                        {
+                            return (Err_Print_BadRange(&flag, jobs_arg, 1u, WRITER_RANGE_THREADS_MAX));
+                        }
+                        j = strlen(argv[arg_idx]);  // Rest of the cluster is the count
+                        break;
                     default:
                         return (Err_Print_BadOption(&flag));
                 }
@@ -427,29 +2034,137 @@ int main (int argc, char **argv)
         }
     }
 
+    // --resolve reads the global symbols of every input and prints one report instead of the lists
+    if (resolve == FT_TRUE)
+    {
+        filter = (symbol_filter_t){{FT_TRUE, FT_FALSE, FT_FALSE, NULL}, 0};
+        demangle = FT_FALSE;
+        if (Intern_enable() != IN_SUCCESS)
+        {
+            return (Err_Print_BadAlloc());
+        }
+    }
+
+    // Compile the --match patterns once; they are tested on the raw names, before -C demangles them
+    if (match != NULL)
+    {
+        int match_ret = Match_compile(match);
+        if (match_ret != MA_SUCCESS)
+        {
+            Match_free(&match);
+            return ((match_ret == MA_ERR_TOO_COMPLEX) ? Err_Print_BadPattern(LONG_OPTION_MATCH, FT_TRUE)
+                                                      : Err_Print_BadAlloc());
+        }
+        filter.sym.match = match;
+    }
+
+    // --diff keeps the names of both files alive after they are closed
+    if (diff == FT_TRUE)
+    {
+        if ((target_num != DIFF_FILE_NUM) || (scan_num != 0))
+        {
+            return (Err_Print_BadFileCount(LONG_OPTION_DIFF, DIFF_FILE_NUM));
+        }
+        if (Intern_enable() != IN_SUCCESS)
+        {
+            return (Err_Print_BadAlloc());
+        }
+    }
+
+    // --addr reads one file; the other targets are addresses
+    if ((addr == FT_TRUE) && (scan_num != 0))
+    {
+        return (Err_Print_BadFileCount(LONG_OPTION_ADDR, 1));
+    }
+
+    // --size-sort and --top order the kept symbols by size, unless -p keeps table order
+    if (filter.sym.sized_only == FT_TRUE)
+    {
+        sort_key = SORT_KEY_SIZE;
+    }
+
+    // Every file is printed through one writer context
+    if (Writer_ctxCreate(&writer, STDOUT_FILENO) != WR_SUCCESS)
+    {
+        return (Err_Print_BadAlloc());
+    }
+    if (print_size == FT_TRUE)
+    {
+        Writer_sizeModeSet(writer, WRITER_SIZE_COLUMN);
+    }
+    else if (filter.sym.sized_only == FT_TRUE)
+    {
+        Writer_sizeModeSet(writer, WRITER_SIZE_AS_VALUE);  // nm prints the size in place of the value
+    }
+
+    // Names are demangled for display only; sorting still uses the mangled names, like nm -C
+    if ((demangle == FT_TRUE) && (format == FORMAT_TEXT) && (Writer_NamePrint_demangleEnable(writer) != WR_SUCCESS))
+    {
+        return (Err_Print_BadAlloc());
+    }
+
+    // Scan the -R directories; their files follow the named ones, sorted by path within each directory
+    for (int i = 1; (i < argc) && (scan_num != 0); i++)
+    {
+        const char *root;
+        char option;
+        int scan_ret;
+
+        if ((argv[i][0] != '-') || (strlen(argv[i]) == 1) ||
+            (strncmp(argv[i], LONG_OPTION_PREFIX, LONG_OPTION_PREFIX_LEN) == 0))
+        {
+            continue;
+        }
+        root = symbol_optionArgGet(argv[i], argv[i + 1], &option);
+        if (root == NULL)
+        {
+            continue;
+        }
+        i += (root == argv[i + 1]) ? 1 : 0;  // Argument given as the next one
+        if (option != SHORT_OPTION_RECURSIVE)
+        {
+            continue;
+        }
+        scan_ret = Scan_run(root, &scan);
+        if (scan_ret == SC_ERR_OPEN_FAIL)
+        {
+            out |= Err_Print_Errno(root);
+        }
+        else if (scan_ret != SC_SUCCESS)
+        {
+            Scan_free(&scan);
+            return (Err_Print_BadAlloc());
+        }
+    }
+
     // Allocate memory for target file list
-    if (target_num != 0)
+    if ((target_num != 0) || (scan_num != 0))
     {
-        target_file = malloc(target_num * sizeof(char *));
+        target_file = malloc((target_num + scan.path_num + 1) * sizeof(char *));
         if (target_file != NULL)
         {
             size_t targat_cnt = 0;
-            // Collect target file names
-            for (int i = 1; i < argc; i++)
+            char option;
+            // Collect target file names, skipping the arguments given to -R and -j
+            for (int i = 1; (i < argc) && (targat_cnt < target_num); i++)
             {
                 if (argv[i][0] != '-' || strlen(argv[i]) == 1)
                 {
                     target_file[targat_cnt] = argv[i];
                     targat_cnt++;
-                    if(targat_cnt == target_num)
-                    {
-                        break;
-                    }
+                }
+                else if ((strncmp(argv[i], LONG_OPTION_PREFIX, LONG_OPTION_PREFIX_LEN) != 0) &&
+                         (symbol_optionArgGet(argv[i], argv[i + 1], &option) == argv[i + 1]))
+                {
+                    i++;
                 }
             }
+            memcpy(target_file + target_num, scan.paths, scan.path_num * sizeof(char *));
+            target_num += scan.path_num;
         }
         else
         {
+            Scan_free(&scan);
             return (Err_Print_BadAlloc());
         }
     }
@@ -468,64 +2183,69 @@ int main (int argc, char **argv)
         }
     }
 
+    run = (symbol_run_t){filter, sort, sort_key, format, demangle, resolve, symtab_name, max_memory, jobs, writer,
+                         addr_range, addr_start, addr_stop, lines};
+
+    // Look up addresses in the first target instead of listing it
+    if ((addr == FT_TRUE) && (diff == FT_FALSE))
+    {
+        out = symbol_addrLookup(target_file, target_num, &run);
+        target_num = 0;  // Nothing left to list
+    }
+
+    // Compare the two target files instead of listing them
+    if (diff == FT_TRUE)
+    {
+        Stats_fileBegin();
+        out = symbol_diff(target_file, &filter, symtab_name, writer);
+        Stats_fileEnd(LONG_OPTION_DIFF);
+        target_num = 0;  // Nothing left to list
+    }
+
     // Process each target file
     for (unsigned int i = 0; i < target_num; i++)
-    {        
-        ret = parseFile(target_file[i], &elf_symbol_table, &elf_sect_head, &file_bit);
-        out |= ret;
-        
-        // Handle parsing errors
-        if (ret == RET_FILE_ERR)
+    {
+        out |= symbol_fileProcess(target_file[i], i, ((target_num != 1) || (scan_num != 0)) ? FT_TRUE : FT_FALSE, &run);
+    }
+
+    // Keep listing the files that change; --resolve, --diff and --addr run once
+    if ((watch == FT_TRUE) && (resolve == FT_FALSE) && (target_num != 0))
+    {
+        if (Watch_run(target_file, target_num, WATCH_DEBOUNCE_MS, symbol_watchList, &run) != WA_SUCCESS)
         {
-            out |= Err_Print_Errno(target_file[i]);
+            out |= Err_Print_Errno(LONG_OPTION_WATCH);
         }
-        else if (ret == RET_PARSE_ERR)
+    }
+    // Print the --resolve report once every input is indexed
+    if (resolve == FT_TRUE)
+    {
+        int resolve_ret;
+
+        stage_start = Stats_stageBegin(STATS_STAGE_PRINT);
+        resolve_ret = Resolve_reportPrint(target_file);
+        if (resolve_ret == RS_ERR_MALLOC_FAIL)
         {
-            out |= Err_Print_BadFormat(target_file[i]);
+            out |= Err_Print_BadAlloc();
         }
-        else
+        else if (resolve_ret != RS_SUCCESS)
         {
-            // Print file name header for multiple files
-            if (target_num != 1)
-            {
-                write(1, "\n", 1);
-                write(1, target_file[i], strlen(target_file[i]));
-                write(1, ":\n", 2);
-            }
-            
-            // Load section header information
-            Writer_FlagPrint_sectionHeadLoad(&elf_sect_head);
-            
-            // Create symbol list
-            ret = symbol_list_create(&head, elf_symbol_table, global_only, undifined_only);
-            if (ret == RET_OK)
-            {
-                // Sort symbols if required
-                if (sort != NO_SORT)
-                {
-                    LinkedList_sort(&head, lineCmp);
-                }
-                // Print symbols
-                symbol_print(head, sort, file_bit);
-            }
-            else if (ret == RET_PARSE_ERR)
-            {
-                out |= Err_Print_BadFormat(target_file[i]);
-            }
-            else
-            {
-                out |= Err_Print_Errno(target_file[i]);
-            }
-            
-            // Clean up resources
-            LinkedList_delete(&head, free);
-            ElfParser_SymTable_free(&elf_symbol_table);
-            ElfParser_SectHead_free(&elf_sect_head);
+            out |= Err_Print_Errno(LONG_OPTION_RESOLVE);  // The report could not be written (errno set)
         }
+        Stats_stageEnd(STATS_STAGE_PRINT, stage_start);
+        Resolve_free();
+    }
+    Stats_totalPrint();
+    if (Trace_flush() != TR_SUCCESS)
+    {
+        out |= Err_Print_Errno(trace_path);
     }
+    Writer_ctxFree(&writer);
+    Intern_free();
+    Match_free(&match);
     
     // Clean up target file list
     free(target_file);
+    Scan_free(&scan);
     return (out);
 }
 
@@ -533,56 +2253,13 @@ int main (int argc, char **argv)
  * @brief Compares two symbol lines for sorting
  * @param[in] line1 First symbol line to compare
  * @param[in] line2 Second symbol line to compare
+ * @param[in] arg Writer context the names are resolved in
  * @return int Negative if line1 < line2, positive if line1 > line2, 0 if equal
  */
-int lineCmp(const writer_line_t *line1, const writer_line_t *line2)
+int lineCmp(const writer_line_t *line1, const writer_line_t *line2, const void *arg)
 {
-    size_t name1_cnt = 0;
-    size_t name2_cnt = 0;
-    char char1, char2;
-    
-    // Compare symbol names, ignoring underscores and converting lowercase to uppercase
-    while (line1->name[name1_cnt] != '\0')
-    {
-        // Skip underscores in first name
-        if (line1->name[name1_cnt] == '_')
-        {
-            name1_cnt++;
-            continue;
-        }
-        // Convert lowercase to uppercase
-        else if ((line1->name[name1_cnt] >= 'a') && (line1->name[name1_cnt] <= 'z'))
-        {
-            char1 = line1->name[name1_cnt] - ('a' - 'A');
-        }
-        else
-        {
-            char1 = line1->name[name1_cnt];
-        }
-
-        // Skip underscores in second name
-        if (line2->name[name2_cnt] == '_')
-        {
-            name2_cnt++;
-            continue;
-        }
-        // Convert lowercase to uppercase
-        else if ((line2->name[name2_cnt] >= 'a') && (line2->name[name2_cnt] <= 'z'))
-        {
-            char2 = line2->name[name2_cnt] - ('a' - 'A');
-        }
-        else
-        {
-            char2 = line2->name[name2_cnt];
-        }
+    const writer_ctx_t *writer = arg;
 
-        // Compare characters
-        if (char1 != char2)
-        {
-            break;
-        }
-        name1_cnt++;
-        name2_cnt++;
-    }
-    return(char1 - char2);
+    return (FtNm_nameCmp(Writer_lineNameGet(writer, line1), Writer_lineNameGet(writer, line2)));
 }
+
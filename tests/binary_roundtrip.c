@@ -0,0 +1,122 @@
+/**
+ * @file binary_roundtrip.c
+ * @brief Prints a binary ft_nm stream back in the text format
+ * @author Domen Banfi
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * This file contains a small client of the binary reader used by
+ * binary_roundtrip.sh: it reads the stream written by nm.out --format=binary
+ * from a file and prints every record the way nm.out prints it in text, so
+ * the two outputs can be compared byte for byte.
+ */
+
+#include "../Writer/inc_pub/writer_binary.h"
+#include "../Writer/inc_pub/writer_flagprint.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/**
+ * @brief Reads a whole file into memory
+ * @param[in] path Path of the file
+ * @param[out] len Number of bytes read
+ * @return char* Contents of the file, freed by the caller; NULL on failure
+ */
+static char *roundtrip_fileRead(const char *path, size_t *len)
+{
+    FILE *file = fopen(path, "rb");
+    char *buf = NULL;
+    long size;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        buf = malloc((size_t)size + 1);
+        if ((buf != NULL) && (fread(buf, 1, (size_t)size, file) != (size_t)size))
+        {
+            free(buf);
+            buf = NULL;
+        }
+        *len = (size_t)size;
+    }
+    fclose(file);
+    return buf;
+}
+
+/**
+ * @brief Prints the records of one block in the text format
+ * @param[in] block Block to print
+ * @return int 0 on success, 1 if a record is malformed
+ */
+static int roundtrip_blockPrint(const writer_binary_block_t *block)
+{
+    int digits = (block->header.bit_width == 32) ? 8 : 16;
+    writer_binary_record_t record;
+    const char *name;
+
+    for (uint64_t i = 0; i < block->header.record_count; i++)
+    {
+        if (Writer_BinaryRead_recordGet(block, i, &record, &name) != WR_SUCCESS)
+        {
+            return 1;
+        }
+        if (record.sect_head_idx == WRITER_FLAGPRINT_SHIDX_UNDEFINED)
+        {
+            printf("%*s %c %s\n", digits, "", record.flag, name);
+        }
+        else
+        {
+            printf("%0*" PRIx64 " %c %s\n", digits, record.value, record.flag, name);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    writer_binary_reader_t reader;
+    writer_binary_block_t block;
+    size_t len = 0, block_cnt = 0;
+    char *buf;
+    int ret = 0, next;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s STREAM\n", argv[0]);
+        return 2;
+    }
+    buf = roundtrip_fileRead(argv[1], &len);
+    if ((buf == NULL) || (Writer_BinaryRead_init(&reader, buf, len) != WR_SUCCESS))
+    {
+        perror(argv[1]);
+        free(buf);
+        return 2;
+    }
+
+    // Count the blocks first: nm.out names the files only when there are several
+    while ((next = Writer_BinaryRead_blockNext(&reader, &block)) == 1)
+    {
+        block_cnt++;
+    }
+    if (next != 0)
+    {
+        fprintf(stderr, "%s: malformed stream\n", argv[1]);
+        free(buf);
+        return 1;
+    }
+    Writer_BinaryRead_init(&reader, buf, len);
+    while ((ret == 0) && (Writer_BinaryRead_blockNext(&reader, &block) == 1))
+    {
+        if (block_cnt > 1)
+        {
+            printf("\n%.*s:\n", (int)block.header.path_len, block.path);
+        }
+        ret = roundtrip_blockPrint(&block);
+    }
+    free(buf);
+    return ret;
+}
@@ -0,0 +1,53 @@
+#!/bin/sh
+# Round trip of the binary output format: every listing written with
+# --format=binary and printed back by binary_roundtrip must match the text
+# listing of the same options, and a binary listing that cannot be written
+# must fail.
+#
+# usage: binary_roundtrip.sh NM READER OBJECT...
+
+NM=$1
+READER=$2
+shift 2
+TMP=${TMPDIR:-/tmp}/ftnm_roundtrip.$$
+FAIL=0
+
+trap 'rm -f "$TMP".bin "$TMP".txt "$TMP".out' EXIT
+
+roundtrip()
+{
+    "$NM" "$@" > "$TMP".txt 2>/dev/null
+    "$NM" --format=binary "$@" > "$TMP".bin 2>/dev/null
+    if ! "$READER" "$TMP".bin > "$TMP".out || ! cmp -s "$TMP".txt "$TMP".out
+    then
+        echo "FAIL: $*"
+        FAIL=1
+    fi
+}
+
+for file in "$@"
+do
+    for opts in "" "-p" "-r" "-n" "-g" "-u"
+    do
+        # shellcheck disable=SC2086
+        roundtrip $opts "$file"
+    done
+done
+roundtrip "$@"
+roundtrip -p "$@"
+
+if [ -w /dev/full ]
+then
+    for opts in "" "-p" "-n"
+    do
+        # shellcheck disable=SC2086
+        if "$NM" --format=binary $opts "$1" > /dev/full 2>/dev/null
+        then
+            echo "FAIL: write error not reported: $opts $1"
+            FAIL=1
+        fi
+    done
+fi
+
+[ "$FAIL" -eq 0 ] && echo "binary round trip: OK"
+exit "$FAIL"
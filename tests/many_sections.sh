@@ -0,0 +1,75 @@
+#!/bin/sh
+# Stress corpus: an object built with -ffunction-sections holding more
+# sections than e_shnum can count (SHN_LORESERVE, 0xff00). The ELF header
+# then keeps the section count and the section name table index in section 0,
+# and symbols take their section index from the SHT_SYMTAB_SHNDX table. The
+# values, names and order of the listing must match the host nm in every
+# layout. Flags are only checked for consistency, since ft_nm flags a symbol by
+# the name of its section and prints '?' for .text.<function>. Absolute and
+# common symbols must stay apart from the sections numbered 0xfff1 and 0xfff2.
+#
+# usage: many_sections.sh NM [FUNCTIONS]
+
+NM=$1
+COUNT=${2:-70000}
+CC=${CC:-cc}
+TMP=${TMPDIR:-/tmp}/ftnm_sections.$$
+FAIL=0
+
+trap 'rm -f "$TMP".c "$TMP".o "$TMP".ref "$TMP".out "$TMP".cut' EXIT
+
+awk -v count="$COUNT" 'BEGIN {
+    print "int stress_common;"
+    print "__asm__(\".globl stress_abs\\n.set stress_abs, 0x1234\");"
+    for (i = 0; i < count; i++)
+    {
+        printf "int stress_f%d(void) { return %d; }\n", i, i
+    }
+}' > "$TMP".c
+if ! "$CC" -c -fcommon -ffunction-sections -o "$TMP".o "$TMP".c
+then
+    echo "many sections: cannot build the corpus"
+    exit 1
+fi
+
+reference()
+{
+    if command -v nm > /dev/null 2>&1
+    then
+        nm "$@" "$TMP".o | cut -c1-17,20- > "$TMP".ref
+    else
+        "$NM" "$@" "$TMP".o | cut -c1-17,20- > "$TMP".ref  # Only checks that the layouts agree
+    fi
+}
+
+listing()
+{
+    if ! "$NM" "$@" "$TMP".o > "$TMP".out || ! cut -c1-17,20- "$TMP".out > "$TMP".cut ||
+       ! cmp -s "$TMP".ref "$TMP".cut
+    then
+        echo "FAIL: $*"
+        FAIL=1
+    fi
+}
+
+for opts in "-g" "-r" "-p" ""
+do
+    # shellcheck disable=SC2086
+    reference $opts
+    # shellcheck disable=SC2086
+    listing $opts
+done
+listing --max-memory=65536
+
+if [ "$(grep -c ' stress_f' "$TMP".out)" -ne "$COUNT" ] ||
+   [ "$(awk '/ stress_f/ { print $2 }' "$TMP".out | sort -u | wc -l)" -ne 1 ] ||
+   grep -q ' [AC] stress_f' "$TMP".out ||
+   ! grep -q '^0000000000001234 A stress_abs$' "$TMP".out ||
+   ! grep -q ' C stress_common$' "$TMP".out
+then
+    echo "FAIL: symbols missing or misflagged"
+    FAIL=1
+fi
+
+[ "$FAIL" -eq 0 ] && echo "many sections ($COUNT functions): OK"
+exit "$FAIL"